@@ -21,10 +21,19 @@
  *     For the async path the wall-clock of `resp()` is the timing signal —
  *     no extra annotation needed.
  *
- * Model-level behaviour otherwise matches cache_v3:
- *   - one refill in flight at a time (set_associative, line-granular)
- *   - CPU requests that miss during a pending refill are queued and replied to
- *     once their miss resolves; they are acknowledged upstream as GRANTED
+ * Model-level behaviour otherwise matches cache_v3, except that refills are
+ * non-blocking:
+ *   - up to `mshrs` line refills in flight (set_associative, line-granular),
+ *     each one tracked by a miss status holding register (MSHR)
+ *   - with more than one MSHR, hits proceed while refills are in flight
+ *     (hit-under-miss), misses to a
+ *     line already being refilled are merged into its MSHR, and misses to other
+ *     lines start their own refill if an MSHR is free (miss-under-miss)
+ *   - CPU requests waiting for a refill are acknowledged upstream as GRANTED
+ *     and replied to once it resolves
+ *   - a miss which can not get an MSHR, or whose set has all its ways being
+ *     refilled, is queued, together with the requests behind it, until a
+ *     refill completes
  *   - disable (via the `enable` wire) bypasses the cache: the CPU request is
  *     forwarded verbatim through the refill port (address transformed by
  *     refill_shift / refill_offset first)
@@ -45,14 +54,20 @@ static int ceil_log2(unsigned int n)
     return 32 - __builtin_clz(n - 1);
 }
 
+// Maximum number of ways, so that the ways of a set fit a 64-bit bitmap
+#define CACHE_MAX_WAYS 64
+
+// Miss status holding register, one per line refill in flight
 typedef struct
 {
-    uint32_t tag;
-    bool dirty;
-    uint8_t *data;
-    vp::Trace tag_event;
-    int64_t timestamp;
-} cache_line_t;
+    // Refill vehicle of this MSHR
+    vp::IoReq req;
+    // Index of the line being refilled (set * ways + way)
+    unsigned int line;
+    uint64_t tag;
+    // CPU requests waiting for the refill, replied to in order once it lands
+    std::vector<vp::IoReq *> targets;
+} cache_mshr_t;
 
 class Cache : public vp::Component
 {
@@ -81,11 +96,16 @@ private:
 
     vp::IoReqStatus handle_req(vp::IoReq *req);
     void check_state();
+    inline bool blocked();
 
-    cache_line_t *refill(int line_index, unsigned int addr, unsigned int tag,
-                          vp::IoReq *req, bool *pending);
-    cache_line_t *get_line(vp::IoReq *req, unsigned int *line_index,
-                            unsigned int *tag, unsigned int *line_offset);
+    int refill(unsigned int line_index, uint64_t addr, uint64_t tag,
+               vp::IoReq *req, bool *pending);
+    cache_mshr_t *mshr_get(vp::IoReq *req);
+    cache_mshr_t *mshr_find(uint64_t tag);
+    int get_line(vp::IoReq *req, unsigned int *line_index,
+                 uint64_t *tag, unsigned int *line_offset);
+    inline int find_way(unsigned int line_index, uint64_t tag);
+    inline uint8_t *line_data(unsigned int line);
 
     unsigned int step_lru();
     void enable(bool e);
@@ -113,15 +133,15 @@ private:
     vp::WireSlave<bool>     flush_line_itf;
     vp::WireSlave<uint32_t> flush_line_addr_itf;
 
-    // Internal refill vehicle (cache owns exactly one — only one refill in flight).
-    vp::IoReq refill_req;
+    // Miss status holding registers, and the ones not currently tracking a refill
+    std::vector<cache_mshr_t> mshrs;
+    std::vector<cache_mshr_t *> free_mshrs;
 
-    // FIFO of CPU requests that were acknowledged upstream (GRANTED) but not yet
-    // served. Two sources feed it:
-    //  - reqs arriving while a refill is already in flight (they re-enter via
-    //    fsm_handler once the refill resolves);
-    //  - the CPU req whose miss triggered the current refill (placed at the head
-    //    so the refill_resp path can pop it and reply to the master).
+    // FIFO of CPU requests that were acknowledged upstream (GRANTED) but could
+    // not be handled yet, because their miss could not get an MSHR or a victim
+    // way, because a refill was denied, or because they arrived behind such a
+    // request. They re-enter via fsm_handler once a refill resolves. Requests
+    // waiting for a refill in flight are in the targets of its MSHR instead.
     vp::Queue refill_pending_reqs;
 
     // GUI / VCD signals (match cache_v3)
@@ -143,13 +163,25 @@ private:
     // Flush-line wire staging (address arrives via a separate wire)
     uint32_t flush_line_addr = 0;
 
-    // Lines storage (nb_sets * nb_ways * cache_line_t).
-    cache_line_t *lines = nullptr;
-
-    // Refill state (only meaningful when pending_refill is set).
-    cache_line_t *refill_line = nullptr;
-    uint32_t      refill_tag = 0;
-    unsigned int  pending_line_offset = 0;
+    // Lines storage, as one array per field so that a lookup only touches the
+    // tags of the set. Line `way` of set `index` is at index * ways + way.
+    uint64_t *tags = nullptr;
+    // Cycle at which the line data is available, for synchronous refills
+    int64_t *timestamps = nullptr;
+    // Per-set bitmaps, bit i standing for way i. A line which is refilling is
+    // the target of an asynchronous refill: its data is being overwritten so
+    // it can neither hit nor be chosen as victim.
+    uint64_t *valid = nullptr;
+    uint64_t *refilling = nullptr;
+    // Data of all lines, line_size bytes each
+    uint8_t *data = nullptr;
+    // Per-line tag traces. They are kept apart from the line metadata since
+    // they are much bigger and only used when the traces are active.
+    vp::Trace *tag_events = nullptr;
+
+    // Set when the head of refill_pending_reqs could not get an MSHR or a
+    // victim way. Cleared when a refill completes, as resources are then free.
+    bool refill_stalled = false;
 
     // Set if a refill was denied by the downstream and must be retried on the
     // next retry() signal. Used only while a queued request is being drained —
@@ -196,26 +228,44 @@ Cache::Cache(vp::ComponentConf &config)
 
     this->new_master_port("flush_ack", &this->flush_ack_itf);
 
-    this->lines = new cache_line_t[this->nb_sets * this->cfg.ways];
+    if (this->cfg.ways > CACHE_MAX_WAYS)
+    {
+        this->trace.fatal("Unsupported number of ways (ways: %d, max: %d)\n",
+            this->cfg.ways, CACHE_MAX_WAYS);
+        return;
+    }
+
+    unsigned int nb_lines = this->nb_sets * this->cfg.ways;
+    this->tags = new uint64_t[nb_lines]();
+    this->timestamps = new int64_t[nb_lines];
+    this->valid = new uint64_t[this->nb_sets]();
+    this->refilling = new uint64_t[this->nb_sets]();
+    this->data = new uint8_t[(size_t)nb_lines << this->line_size_bits];
+    this->tag_events = new vp::Trace[nb_lines];
     for (unsigned int i = 0; i < this->nb_sets; i++)
     {
         for (unsigned int j = 0; j < this->cfg.ways; j++)
         {
-            cache_line_t *line = &this->lines[i * this->cfg.ways + j];
-            line->timestamp = -1;
-            line->tag = -1;
-            line->data = new uint8_t[this->cfg.line_size];
+            this->timestamps[i * this->cfg.ways + j] = -1;
             this->traces.new_trace_event(
                 "set_" + std::to_string(j) + "/line_" + std::to_string(i),
-                &line->tag_event, 32);
+                &this->tag_events[i * this->cfg.ways + j], 32);
         }
     }
 
+    int nb_mshrs = this->cfg.mshrs > 0 ? this->cfg.mshrs : 1;
+    this->mshrs.resize(nb_mshrs);
+    for (cache_mshr_t &mshr : this->mshrs)
+    {
+        mshr.targets.reserve(4);
+        this->free_mshrs.push_back(&mshr);
+    }
+
     this->fsm_event = this->event_new(&Cache::fsm_handler);
 
     this->trace.msg(vp::Trace::LEVEL_INFO,
-        "Instantiating cache (sets: %d, ways: %d, line_size: %d)\n",
-        this->nb_sets, this->cfg.ways, this->cfg.line_size);
+        "Instantiating cache (sets: %d, ways: %d, line_size: %d, mshrs: %d)\n",
+        this->nb_sets, this->cfg.ways, this->cfg.line_size, nb_mshrs);
 }
 
 
@@ -227,12 +277,44 @@ void Cache::reset(bool active)
         this->enabled = this->cfg.enabled;
         this->refill_event.release();
         this->refill_retry_pending = false;
+        this->refill_stalled = false;
         this->input_needs_retry = false;
         this->refill_timestamp = -1;
     }
 }
 
 
+cache_mshr_t *Cache::mshr_get(vp::IoReq *req)
+{
+    for (cache_mshr_t &mshr : this->mshrs)
+    {
+        if (req == &mshr.req)
+        {
+            return &mshr;
+        }
+    }
+    return nullptr;
+}
+
+
+cache_mshr_t *Cache::mshr_find(uint64_t tag)
+{
+    if (this->free_mshrs.size() == this->mshrs.size())
+    {
+        return nullptr;
+    }
+
+    for (cache_mshr_t &mshr : this->mshrs)
+    {
+        if (!mshr.targets.empty() && mshr.tag == tag)
+        {
+            return &mshr;
+        }
+    }
+    return nullptr;
+}
+
+
 // ---------------------------------------------------------------------------
 // Refill path (master-side response / retry)
 // ---------------------------------------------------------------------------
@@ -242,9 +324,11 @@ void Cache::refill_resp(vp::Block *__this, vp::IoReq *req)
     Cache *_this = (Cache *)__this;
 
     // Bypass path: the cache is disabled and we simply pass upstream requests
-    // through. The request we receive here is the CPU's own request (not our
-    // refill_req), so we forward the response to the CPU on our own slave port.
-    if (req != &_this->refill_req)
+    // through. The request we receive here is the CPU's own request (not one of
+    // the MSHR refill requests), so we forward the response to the CPU on our
+    // own slave port.
+    cache_mshr_t *mshr = _this->mshr_get(req);
+    if (mshr == nullptr)
     {
         _this->input_itf.resp(req);
         return;
@@ -261,39 +345,61 @@ void Cache::refill_resp(vp::Block *__this, vp::IoReq *req)
         return;
     }
 
-    // Cached-refill path. The CPU request whose miss triggered this refill is at
-    // the head of refill_pending_reqs (placed there by Cache::refill()).
-    vp_assert(!_this->refill_pending_reqs.empty(), &_this->trace,
+    // Cached-refill path. The CPU requests waiting for this line are the
+    // targets of the MSHR, in arrival order: the primary miss first, then the
+    // secondary misses merged into it.
+    vp_assert(!mshr->targets.empty(), &_this->trace,
         "Received refill response with no pending CPU request\n");
 
-    vp::IoReq *cpu_req = (vp::IoReq *)_this->refill_pending_reqs.pop();
-    uint8_t *data = cpu_req->get_data();
-    uint64_t size = cpu_req->get_size();
-    bool is_write = cpu_req->get_is_write();
-
     _this->trace.msg(vp::Trace::LEVEL_TRACE,
-        "Received refill response (cpu_req: %p, is_write: %d, data: %p, size: 0x%lx)\n",
-        cpu_req, is_write, data, size);
+        "Received refill response (addr: 0x%lx, nb_targets: %d)\n",
+        req->get_addr(), (int)mshr->targets.size());
 
-    _this->pending_refill.set(0);
     _this->refill_event.release();
 
-    if (data)
+    // The line is valid from now on, so that requests coming from the masters
+    // while we reply hit it instead of being merged into this MSHR.
+    unsigned int line = mshr->line;
+    unsigned int line_index = line / _this->cfg.ways;
+    uint64_t way_mask = 1ULL << (line % _this->cfg.ways);
+    _this->tags[line] = mshr->tag;
+    _this->valid[line_index] |= way_mask;
+    _this->refilling[line_index] &= ~way_mask;
+    uint8_t *line_buf = _this->line_data(line);
+
+    unsigned int line_mask = (1U << _this->line_size_bits) - 1;
+    for (size_t i = 0; i < mshr->targets.size(); i++)
     {
-        cache_line_t *line = _this->refill_line;
-        line->tag = _this->refill_tag;
+        vp::IoReq *cpu_req = mshr->targets[i];
+        uint8_t *data = cpu_req->get_data();
+        uint64_t size = cpu_req->get_size();
+        unsigned int line_offset = cpu_req->get_addr() & line_mask;
 
-        if (!is_write)
-        {
-            memcpy(data, &line->data[_this->pending_line_offset], size);
-        }
-        else
+        if (data)
         {
-            memcpy(&line->data[_this->pending_line_offset], data, size);
+            if (!cpu_req->get_is_write())
+            {
+                memcpy(data, &line_buf[line_offset], size);
+            }
+            else
+            {
+                memcpy(&line_buf[line_offset], data, size);
+            }
         }
+
+        _this->input_itf.resp(cpu_req);
     }
 
-    _this->input_itf.resp(cpu_req);
+    // Only release the MSHR once all its targets are replied, a master sending
+    // a new request from its response callback must not reuse it before.
+    mshr->targets.clear();
+    _this->free_mshrs.push_back(mshr);
+    if (_this->free_mshrs.size() == _this->mshrs.size())
+    {
+        _this->pending_refill.set(0);
+    }
+    _this->refill_stalled = false;
+
     _this->check_state();
 }
 
@@ -330,13 +436,14 @@ void Cache::refill_retry(vp::Block *__this, vp::IoRetryChannel)
 // ---------------------------------------------------------------------------
 
 // Kicked by check_state() whenever there is at least one queued CPU request and
-// no refill currently in flight. Pulls one request from the queue, runs it
-// through handle_req, and replies to the CPU if it resolves synchronously.
+// the resources it was waiting for may be available. Pulls one request from the
+// queue, runs it through handle_req, and replies to the CPU if it resolves
+// synchronously.
 void Cache::fsm_handler(vp::Block *__this, vp::ClockEvent *event)
 {
     Cache *_this = (Cache *)__this;
 
-    if (!_this->pending_refill.get() && !_this->refill_retry_pending
+    if (!_this->refill_stalled && !_this->refill_retry_pending && !_this->blocked()
         && !_this->refill_pending_reqs.empty())
     {
         vp::IoReq *req = (vp::IoReq *)_this->refill_pending_reqs.pop();
@@ -356,8 +463,9 @@ void Cache::fsm_handler(vp::Block *__this, vp::ClockEvent *event)
             // once refill_retry() clears refill_retry_pending.
             _this->refill_pending_reqs.push_front(req);
         }
-        // If GRANTED, Cache::refill() has already pushed cpu_req back at the
-        // head of refill_pending_reqs — refill_resp will pop and reply.
+        // If GRANTED, the request is either waiting in an MSHR, and refill_resp
+        // will reply, or Cache::refill() pushed it back at the head of the
+        // queue because it stalled.
     }
 
     _this->check_state();
@@ -373,7 +481,7 @@ void Cache::check_state()
     // re-checks next cycle -> the queued request is lost and the master hangs. The
     // fsm runs at +1, by which point the element is ready, so scheduling on
     // presence is correct.
-    if (!this->pending_refill.get() && !this->refill_retry_pending
+    if (!this->refill_stalled && !this->refill_retry_pending && !this->blocked()
         && this->refill_pending_reqs.has_reqs())
     {
         if (!this->fsm_event->is_enqueued())
@@ -384,39 +492,81 @@ void Cache::check_state()
 }
 
 
+// With a single MSHR, the cache keeps the timing of the blocking cache: no
+// request, not even a hit, is handled while its refill is in flight.
+inline bool Cache::blocked()
+{
+    return this->mshrs.size() == 1 && this->free_mshrs.empty();
+}
+
+
 // ---------------------------------------------------------------------------
 // Core cache logic (mirrors cache_v3, minus debug/atomics)
 // ---------------------------------------------------------------------------
 
-cache_line_t *Cache::refill(int line_index, unsigned int addr, unsigned int tag,
-                              vp::IoReq *cpu_req, bool *pending)
+int Cache::refill(unsigned int line_index, uint64_t addr, uint64_t tag,
+                  vp::IoReq *cpu_req, bool *pending)
 {
-    // Cache supports only one refill at a time. Queue the CPU req and back off.
-    if (this->pending_refill.get())
+    // Secondary miss, the line is already being refilled. Just wait for it.
+    cache_mshr_t *mshr = this->mshr_find(tag);
+    if (mshr)
     {
-        this->refill_pending_reqs.push_back(cpu_req);
+        this->trace.msg(vp::Trace::LEVEL_DEBUG,
+            "Merging miss into pending refill (addr: 0x%lx)\n", addr);
+        mshr->targets.push_back(cpu_req);
         *pending = true;
-        return nullptr;
+        return -1;
+    }
+
+    // No MSHR or no way available. Queue the CPU req at the head, since it is
+    // either a new request arriving with an empty queue or the head being
+    // drained, and back off until a refill completes. This is checked before
+    // stepping the LFSR, which only moves when a refill is issued, like when
+    // there was a single refill.
+    uint64_t all_ways = this->cfg.ways == 64 ? ~0ULL : (1ULL << this->cfg.ways) - 1;
+    uint64_t refilling = this->refilling[line_index];
+    if (this->free_mshrs.empty() || (refilling & all_ways) == all_ways)
+    {
+        this->trace.msg(vp::Trace::LEVEL_DEBUG,
+            "Stalling miss, no refill resource available (addr: 0x%lx)\n", addr);
+        this->refill_pending_reqs.push_front(cpu_req);
+        this->refill_stalled = true;
+        *pending = true;
+        return -1;
     }
 
+    // Skip the ways whose refill is in flight, their data buffer is in use
     unsigned int refill_way = this->step_lru() % this->cfg.ways;
-    cache_line_t *line = &this->lines[line_index * this->cfg.ways + refill_way];
+    unsigned int i = 0;
+    while ((refilling >> ((refill_way + i) % this->cfg.ways)) & 1)
+    {
+        i++;
+    }
+
+    refill_way = (refill_way + i) % this->cfg.ways;
+    unsigned int line = line_index * this->cfg.ways + refill_way;
+    uint64_t way_mask = 1ULL << refill_way;
+    mshr = this->free_mshrs.back();
 
-    uint32_t full_addr = ((addr & ~((1U << this->line_size_bits) - 1))
+    uint64_t full_addr = ((addr & ~((1ULL << this->line_size_bits) - 1))
                           << this->cfg.refill_shift) + this->cfg.refill_offset;
 
     this->trace.msg(vp::Trace::LEVEL_DEBUG,
-        "Refilling line (addr: 0x%x, index: %d, way: %d)\n",
+        "Refilling line (addr: 0x%lx, index: %d, way: %d)\n",
         full_addr, line_index, refill_way);
 
-    line->tag_event.event((uint8_t *)&full_addr);
+    if (this->tag_events[line].get_event_active())
+    {
+        uint32_t trace_addr = full_addr;
+        this->tag_events[line].event((uint8_t *)&trace_addr);
+    }
 
-    vp::IoReq *r = &this->refill_req;
+    vp::IoReq *r = &mshr->req;
     r->prepare();
     // A refill is a single whole-line burst. Reset the burst flags explicitly:
     // prepare() does not touch them, and a beat-streaming downstream (KIND_BEAT
-    // router / IoV2BeatAdapter) leaves is_first=0/is_last=1 on the shared
-    // refill_req after the previous response's last beat. Reusing it without a
+    // router / IoV2BeatAdapter) leaves is_first=0/is_last=1 on the MSHR
+    // request after the previous response's last beat. Reusing it without a
     // reset would send the next refill as a stray continuation beat.
     r->is_first = true;
     r->is_last = true;
@@ -424,7 +574,7 @@ cache_line_t *Cache::refill(int line_index, unsigned int addr, unsigned int tag,
     r->set_addr(full_addr);
     r->set_is_write(false);
     r->set_size(1U << this->line_size_bits);
-    r->set_data(line->data);
+    r->set_data(this->line_data(line));
 
     this->refill_event_clear_event.cancel();
 
@@ -432,14 +582,18 @@ cache_line_t *Cache::refill(int line_index, unsigned int addr, unsigned int tag,
 
     if (st == vp::IO_REQ_GRANTED)
     {
-        // The refill will be completed asynchronously. Park the CPU request at the
-        // head of the queue so refill_resp can pop it and reply to the master.
-        this->refill_pending_reqs.push_front(cpu_req);
-        this->refill_line = line;
-        this->refill_tag = tag;
+        // The refill will be completed asynchronously. The line being
+        // overwritten, it is invalidated until refill_resp tags it, and the CPU
+        // request waits in the MSHR so that refill_resp can reply to the master.
+        this->free_mshrs.pop_back();
+        this->valid[line_index] &= ~way_mask;
+        this->refilling[line_index] |= way_mask;
+        mshr->line = line;
+        mshr->tag = tag;
+        mshr->targets.push_back(cpu_req);
         this->pending_refill.set(1);
         *pending = true;
-        return nullptr;
+        return -1;
     }
 
     if (st == vp::IO_REQ_DENIED)
@@ -448,13 +602,14 @@ cache_line_t *Cache::refill(int line_index, unsigned int addr, unsigned int tag,
         // upstream (new inline req) or to keep the CPU req queued (drain path).
         this->refill_retry_pending = true;
         *pending = false;
-        return nullptr;
+        return -1;
     }
 
     // Synchronous success. Tag the line, account for serialisation with any
     // previously-started synchronous refill, and annotate the CPU request's
     // latency so the master paces itself correctly.
-    line->tag = tag;
+    this->tags[line] = tag;
+    this->valid[line_index] |= way_mask;
 
     int64_t now = this->clock.get_cycles();
     int64_t latency = 0;
@@ -469,7 +624,7 @@ cache_line_t *Cache::refill(int line_index, unsigned int addr, unsigned int tag,
 
     cpu_req->inc_latency(latency);
 
-    line->timestamp = now + latency;
+    this->timestamps[line] = now + latency;
 
     return line;
 }
@@ -478,13 +633,12 @@ cache_line_t *Cache::refill(int line_index, unsigned int addr, unsigned int tag,
 void Cache::flush_line_op(unsigned int addr)
 {
     this->trace.msg(vp::Trace::LEVEL_INFO, "Flushing cache line (addr: 0x%x)\n", addr);
-    unsigned int tag = addr >> this->line_size_bits;
+    uint64_t tag = addr >> this->line_size_bits;
     unsigned int line_index = tag & (this->nb_sets - 1);
-    for (unsigned int i = 0; i < this->cfg.ways; i++)
+    int way = this->find_way(line_index, tag);
+    if (way != -1)
     {
-        cache_line_t *line = &this->lines[line_index * this->cfg.ways + i];
-        if (line->tag == tag)
-            line->tag = -1;
+        this->valid[line_index] &= ~(1ULL << way);
     }
 }
 
@@ -492,13 +646,7 @@ void Cache::flush_line_op(unsigned int addr)
 void Cache::flush()
 {
     this->trace.msg(vp::Trace::LEVEL_INFO, "Flushing whole cache\n");
-    for (unsigned int i = 0; i < this->nb_sets; i++)
-    {
-        for (unsigned int j = 0; j < this->cfg.ways; j++)
-        {
-            this->lines[i * this->cfg.ways + j].tag = -1;
-        }
-    }
+    memset(this->valid, 0, this->nb_sets * sizeof(uint64_t));
 
     if (this->flush_ack_itf.is_bound())
     {
@@ -515,8 +663,30 @@ void Cache::enable(bool e)
 }
 
 
-cache_line_t *Cache::get_line(vp::IoReq *req, unsigned int *line_index,
-                                unsigned int *tag, unsigned int *line_offset)
+inline uint8_t *Cache::line_data(unsigned int line)
+{
+    return &this->data[(size_t)line << this->line_size_bits];
+}
+
+
+inline int Cache::find_way(unsigned int line_index, uint64_t tag)
+{
+    // Compare the whole set at once into a bitmap of matching ways, which the
+    // compiler can vectorize, instead of stopping at the first match
+    const uint64_t *set_tags = &this->tags[line_index * this->cfg.ways];
+    uint64_t match = 0;
+    for (unsigned int i = 0; i < this->cfg.ways; i++)
+    {
+        match |= (uint64_t)(set_tags[i] == tag) << i;
+    }
+    match &= this->valid[line_index];
+
+    return match ? __builtin_ctzll(match) : -1;
+}
+
+
+int Cache::get_line(vp::IoReq *req, unsigned int *line_index,
+                    uint64_t *tag, unsigned int *line_offset)
 {
     uint64_t offset = req->get_addr();
     uint64_t size = req->get_size();
@@ -529,47 +699,43 @@ cache_line_t *Cache::get_line(vp::IoReq *req, unsigned int *line_index,
     *line_offset = offset & (line_size - 1);
 
     this->trace.msg(vp::Trace::LEVEL_TRACE,
-        "Cache access (is_write: %d, addr: 0x%lx, size: 0x%lx, tag: 0x%x, "
+        "Cache access (is_write: %d, addr: 0x%lx, size: 0x%lx, tag: 0x%lx, "
         "index: %d, line_offset: 0x%x)\n",
         is_write, offset, size, *tag, *line_index, *line_offset);
 
-    cache_line_t *line = &this->lines[*line_index * this->cfg.ways];
-    for (unsigned int i = 0; i < this->cfg.ways; i++)
+    int way = this->find_way(*line_index, *tag);
+    if (way == -1)
     {
-        if (line->tag == *tag)
-        {
-            this->trace.msg(vp::Trace::LEVEL_TRACE, "Cache hit (way: %d)\n", i);
-            return line;
-        }
-        line++;
+        return -1;
     }
-    return nullptr;
+
+    this->trace.msg(vp::Trace::LEVEL_TRACE, "Cache hit (way: %d)\n", way);
+    return *line_index * this->cfg.ways + way;
 }
 
 
 vp::IoReqStatus Cache::handle_req(vp::IoReq *req)
 {
     unsigned int line_index;
-    unsigned int tag;
+    uint64_t tag;
     unsigned int line_offset;
     uint64_t size = req->get_size();
     uint8_t *data = req->get_data();
     bool is_write = req->get_is_write();
 
-    cache_line_t *hit_line = this->get_line(req, &line_index, &tag, &line_offset);
+    int hit_line = this->get_line(req, &line_index, &tag, &line_offset);
 
-    if (hit_line == nullptr)
+    if (hit_line == -1)
     {
         this->trace.msg(vp::Trace::LEVEL_DEBUG, "Cache miss\n");
         uint64_t offset = req->get_addr();
         this->refill_event.set(offset);
         bool pending = false;
         hit_line = this->refill(line_index, offset, tag, req, &pending);
-        if (hit_line == nullptr)
+        if (hit_line == -1)
         {
             if (pending)
             {
-                this->pending_line_offset = line_offset;
                 return vp::IO_REQ_GRANTED;
             }
             // Refill denied OR true error. The caller (input_req / fsm_handler)
@@ -583,9 +749,9 @@ vp::IoReqStatus Cache::handle_req(vp::IoReq *req)
         // earlier miss in this cycle), defer the timing of this access until the
         // refill would have landed.
         int64_t now = this->clock.get_cycles();
-        if (now < hit_line->timestamp)
+        if (now < this->timestamps[hit_line])
         {
-            req->inc_latency(hit_line->timestamp - now);
+            req->inc_latency(this->timestamps[hit_line] - now);
         }
     }
 
@@ -593,11 +759,11 @@ vp::IoReqStatus Cache::handle_req(vp::IoReq *req)
     {
         if (!is_write)
         {
-            memcpy(data, &hit_line->data[line_offset], size);
+            memcpy(data, &this->line_data(hit_line)[line_offset], size);
         }
         else
         {
-            memcpy(&hit_line->data[line_offset], data, size);
+            memcpy(&this->line_data(hit_line)[line_offset], data, size);
         }
     }
 
@@ -621,8 +787,8 @@ vp::IoReqStatus Cache::input_req(vp::Block *__this, vp::IoReq *req)
 
     // Bypass: forward the CPU request verbatim through the refill port after
     // address transformation. The response comes back on our refill_resp
-    // callback, which recognises a non-&refill_req req as a bypass forward
-    // and replies to the master on our own slave port.
+    // callback, which recognises a req not belonging to an MSHR as a bypass
+    // forward and replies to the master on our own slave port.
     if (!_this->enabled)
     {
         req->set_addr((offset << _this->cfg.refill_shift) + _this->cfg.refill_offset);
@@ -638,10 +804,11 @@ vp::IoReqStatus Cache::input_req(vp::Block *__this, vp::IoReq *req)
 
     _this->io_event.event((uint8_t *)&offset);
 
-    // Cached path. If a refill is pending we must not start another one: queue
-    // this request and ack upstream with GRANTED. When the current refill
-    // resolves, fsm_handler will re-enter handle_req for this request.
-    if (_this->pending_refill.get() || _this->refill_retry_pending)
+    // Cached path. Refills in flight do not block this request, unless the
+    // cache has a single MSHR, only the ones already queued do, to keep them in
+    // order, as well as a denied refill. Queue it and ack upstream with
+    // GRANTED, fsm_handler will re-enter handle_req for this request.
+    if (_this->refill_retry_pending || _this->blocked() || _this->refill_pending_reqs.has_reqs())
     {
         _this->refill_pending_reqs.push_back(req);
         _this->check_state();
@@ -41,6 +41,9 @@ class CacheConfig(Config):
         memory level.
     refill_latency : int
         Latency in cycles added to synchronous refill completions.
+    mshrs : int
+        Number of line refills which can be in flight at the same time. With a
+        single one, the cache is blocking.
     """
 
     size: int = cfg_field(default=0, dump=True, desc=(
@@ -71,6 +74,11 @@ class CacheConfig(Config):
         "Latency in cycles for a refill request to the next memory level"
     ))
 
+    mshrs: int = cfg_field(default=1, dump=True, desc=(
+        "Number of miss status holding registers, i.e. of line refills which can be in flight "
+        "at the same time"
+    ))
+
 
 class Cache(Component):
     """Set-associative cache on the io_v2 protocol.
@@ -125,7 +133,8 @@ class Cache(Component):
       ``timestamp`` is still in the future (because an earlier miss in
       the same cycle started a multi-cycle refill), the hit is stalled
       via ``req->inc_latency(timestamp - now)`` so the master paces
-      itself. Hits never stall an in-flight refill.
+      itself. Hits never wait for in-flight refills of other lines
+      (hit-under-miss).
     - **Miss, no refill pending**: a refill request is sent to the
       ``REFILL`` port. A synchronous ``IO_REQ_DONE`` from the downstream
       yields an inline ``IO_REQ_DONE`` on the input (with
@@ -134,12 +143,22 @@ class Cache(Component):
       accumulated latency). A ``IO_REQ_GRANTED`` parks the CPU request
       in an internal FIFO; the master sees ``IO_REQ_GRANTED`` and later
       receives ``resp()`` once the refill lands.
-    - **Miss, refill pending**: only one refill is ever in flight. A new
-      miss arriving mid-refill is acked as ``IO_REQ_GRANTED`` and
-      pushed to the FIFO. The internal ``fsm_handler`` drains the FIFO
-      one request per cycle once the current refill resolves — the next
-      miss in the FIFO may itself start a new refill, or be a hit if the
-      landing refill happened to bring in its line.
+    - **Miss, refill pending**: each asynchronous refill is tracked by a
+      miss status holding register (MSHR), up to :attr:`CacheConfig.mshrs`
+      of them in flight. A miss to a line already being refilled is acked
+      as ``IO_REQ_GRANTED`` and merged into its MSHR; all the requests
+      of an MSHR are replied to in order once the line lands. A miss to
+      another line starts its own refill if an MSHR is free
+      (miss-under-miss). With a single MSHR, the cache stays blocking:
+      every request arriving while the refill is in flight, hit or miss,
+      is queued until it lands.
+    - **Miss, no MSHR free**: the miss is acked as ``IO_REQ_GRANTED`` and
+      pushed to an internal FIFO, as well as every request arriving
+      behind it, to keep them in order. The same happens if all the ways
+      of its set are being refilled. The internal ``fsm_handler`` drains
+      the FIFO one request per cycle once a refill resolves — the next
+      request in the FIFO may itself start a new refill, or be a hit if
+      the landing refill happened to bring in its line.
     - **Bypass** (cache disabled): the CPU request is forwarded verbatim
       through ``REFILL`` after the address is rewritten by
       :attr:`CacheConfig.refill_shift` / :attr:`CacheConfig.refill_offset`.
@@ -215,10 +234,10 @@ class Cache(Component):
     Constraints and limitations
     ~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-    - **Single refill in flight.** A new miss arriving while a refill
-      is already outstanding is queued but never overlapped. For
-      workloads that expect multiple outstanding refills (MSHR-style
-      caches), use a different model.
+    - **Bounded refills in flight.** At most
+      :attr:`CacheConfig.mshrs` refills are outstanding; with the
+      default of ``1``, any request arriving while a refill is
+      outstanding, even a hit, is queued but never overlapped.
     - **No write-back.** Writes hit lines in place; there is no dirty
       bit and no eviction writeback traffic. A write that crosses a
       miss refills the line first, then mutates the refilled data.
@@ -279,6 +298,13 @@ class Cache(Component):
         the downstream's ``resp()`` fires is already the signal).
         Default: ``0``.
 
+    ``mshrs``
+        Number of miss status holding registers, i.e. of asynchronous
+        refills which can be in flight at the same time on ``REFILL``.
+        Only matters with a downstream replying ``IO_REQ_GRANTED``, since
+        synchronous refills complete inline. With ``1``, hits also wait
+        for the refill in flight, as in a blocking cache. Default: ``1``.
+
     Parameters
     ----------
     parent : Component
@@ -314,6 +340,7 @@ class Cache(Component):
             'refill_offset': config.refill_offset,
             'refill_shift': config.refill_shift,
             'enabled': config.enabled,
+            'mshrs': config.mshrs,
         })
 
     def i_INPUT(self) -> SlaveItf:
@@ -20,18 +20,35 @@
 
 #include <vp/vp.hpp>
 #include <vp/itf/io.hpp>
+#include <string.h>
+#include <algorithm>
 #include <vector>
 #include <thread>
 #include <unistd.h>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <gv/gvsoc.hpp>
 #include <vp/controller.hpp>
+#include "spsc_ring.hpp"
 
 static int nb_running = 0;
 
 #define MAX_MEMINFO 64
 
+// Maximum number of posted writes gathered before they are sent to the simulator
+#define MAX_BATCH 64
+// Maximum size of a write which can be posted
+#define MAX_POSTED_SIZE 64
+
+// Write which has already been replied to the emulated code and is waiting in the batch
+struct PostedWrite
+{
+    uint64_t addr;
+    int size;
+    uint8_t data[MAX_POSTED_SIZE];
+};
+
 class emulation : public vp::Component, public gv::Io_binding
 {
 
@@ -49,6 +66,8 @@ public:
 private:
     void sync_state(std::unique_lock<std::mutex> &lock);
     void check_state();
+    int exec_access(uint64_t addr, uint64_t size, bool is_write, uint8_t *data);
+    void flush_batch(gv::Io_request *req);
     static void clock_sync(vp::Block *__this, bool active);
     static void fetchen_sync(vp::Block *__this, bool active);
     static void bootaddr_sync(vp::Block *__this, uint32_t value);
@@ -83,14 +102,23 @@ private:
     gv::Io_user   *user;
 
     std::mutex mutex;
-    std::condition_variable cond;
+    // Where the emulation thread waits for the core to be active again. It first spins
+    // since the simulator usually reactivates it quickly, and only then sleeps.
+    emu::Parker parker;
 
     vp::IoReq core_req;
 
+    // Posted writes not yet sent to the simulator. They are all sent under a single engine
+    // lock, before the next access which needs an answer.
+    PostedWrite batch[MAX_BATCH];
+    int batch_count = 0;
+    int batch_size;
+
     bool reset_value;
     bool fetchen_value;
     bool clock_value;
-    bool is_active;
+    // Read without the mutex while spinning
+    std::atomic<bool> is_active;
     bool stalled;
     bool sleeping;
     bool irq_enabled;
@@ -165,6 +193,7 @@ emulation::emulation(vp::ComponentConf &config)
     this->fetchen_value = get_js_config()->get("fetch_enable")->get_bool();
     this->core_id = get_js_config()->get_child_int("core_id");
     this->cluster_id = get_js_config()->get_child_int("cluster_id");
+    this->batch_size = std::min(get_js_config()->get_child_int("batch_size"), MAX_BATCH);
 
 }
 
@@ -210,6 +239,15 @@ void emulation::access(gv::Io_request *req)
         "Received IO req  (offset: 0x%llx, size: 0x%x, type: %d)\n",
         req->addr, req->size, req->type);
 
+    bool is_rw = req->type == gv::Io_request_read || req->type == gv::Io_request_write;
+
+    // Any other request may depend on the posted writes, e.g. a WFI waiting for a write
+    // to a mailbox to be seen by another core.
+    if (!is_rw && this->batch_count)
+    {
+        this->flush_batch(NULL);
+    }
+
     // Sync state request
     if (req->type == 2)
     {
@@ -277,30 +315,100 @@ void emulation::access(gv::Io_request *req)
     // Read write request
     else
     {
-        this->core_req.init();
-        this->core_req.set_addr(req->addr);
-        this->core_req.set_size(req->size);
-        this->core_req.set_is_write(req->type == gv::Io_request_write);
-        this->core_req.set_data(req->data);
-
-        gv::Controller::get().engine_lock();
-        int err = this->data.req(&this->core_req);
-        gv::Controller::get().engine_unlock();
-
-        if (err == vp::IO_REQ_OK || err == vp::IO_REQ_INVALID)
+        // Small writes are posted: they are replied immediately and gathered, so that a
+        // sequence of them costs a single engine lock.
+        if (req->type == gv::Io_request_write && this->batch_size > 1 &&
+            req->size <= MAX_POSTED_SIZE)
         {
-            req->retval = err == vp::IO_REQ_INVALID ? gv::Io_request_ko : gv::Io_request_ok;
+            PostedWrite *write = &this->batch[this->batch_count++];
+            write->addr = req->addr;
+            write->size = req->size;
+            memcpy(write->data, req->data, req->size);
+
+            req->retval = gv::Io_request_ok;
             this->user->reply(req);
+
+            if (this->batch_count == this->batch_size)
+            {
+                this->flush_batch(NULL);
+            }
         }
         else
         {
-            std::unique_lock<std::mutex> lock(this->mutex);
-            this->stalled = true;
-            this->check_state();
-            this->sync_state(lock);
-            lock.unlock();
+            this->flush_batch(req);
+        }
+    }
+}
+
+// Must be called with the engine locked. Returns with the engine locked, the access is
+// completed even if the simulator answered asynchronously, in which case the status of the
+// initial request is returned.
+int emulation::exec_access(uint64_t addr, uint64_t size, bool is_write, uint8_t *data)
+{
+    this->core_req.init();
+    this->core_req.set_addr(addr);
+    this->core_req.set_size(size);
+    this->core_req.set_is_write(is_write);
+    this->core_req.set_data(data);
+
+    int err = this->data.req(&this->core_req);
+
+    if (err != vp::IO_REQ_OK && err != vp::IO_REQ_INVALID)
+    {
+        gv::Controller::get().engine_unlock();
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->stalled = true;
+        this->check_state();
+        // Only returns once data_response has reactivated the core
+        this->sync_state(lock);
+        lock.unlock();
+
+        gv::Controller::get().engine_lock();
+    }
+
+    return err;
+}
+
+// Sends the posted writes, and then the access req if any, under a single engine lock
+void emulation::flush_batch(gv::Io_request *req)
+{
+    // A stalled access goes through sync_state, which can call an interrupt handler doing
+    // accesses and thus come back here. The batch is taken out first so that the nested
+    // call starts from an empty one instead of sending the same writes again or growing
+    // the batch we are iterating on.
+    PostedWrite writes[MAX_BATCH];
+    int nb_writes = this->batch_count;
+    std::copy(this->batch, this->batch + nb_writes, writes);
+    this->batch_count = 0;
+
+    gv::Controller::get().engine_lock();
+
+    for (int i = 0; i < nb_writes; i++)
+    {
+        PostedWrite *write = &writes[i];
+        if (this->exec_access(write->addr, write->size, true, write->data) == vp::IO_REQ_INVALID)
+        {
+            this->trace.force_warning("Invalid posted write (addr: 0x%llx, size: 0x%x)\n",
+                (unsigned long long)write->addr, write->size);
         }
     }
+
+    int err = vp::IO_REQ_OK;
+    if (req)
+    {
+        err = this->exec_access(req->addr, req->size, req->type == gv::Io_request_write,
+            req->data);
+    }
+
+    gv::Controller::get().engine_unlock();
+
+    // As before batching, a stalled access is not replied
+    if (req && (err == vp::IO_REQ_OK || err == vp::IO_REQ_INVALID))
+    {
+        req->retval = err == vp::IO_REQ_INVALID ? gv::Io_request_ko : gv::Io_request_ok;
+        this->user->reply(req);
+    }
 }
 
 void emulation::sync_state(std::unique_lock<std::mutex> &lock)
@@ -338,7 +446,9 @@ void emulation::sync_state(std::unique_lock<std::mutex> &lock)
 
         while(!this->is_active)
         {
-            this->cond.wait(lock);
+            lock.unlock();
+            this->parker.wait([this]() { return this->is_active.load(std::memory_order_acquire); });
+            lock.lock();
         }
 
         nb_running++;
@@ -356,7 +466,7 @@ void emulation::check_state()
 {
     this->trace.msg(vp::Trace::LEVEL_DEBUG,
         "Checking core state (is_active: %d, reset: %d, fetchen: %d, clock: %d, stalled: %d, sleeping: %d)\n",
-        this->is_active, this->reset_value, this->fetchen_value, this->clock_value, this->stalled, this->sleeping
+        this->is_active.load(), this->reset_value, this->fetchen_value, this->clock_value, this->stalled, this->sleeping
     );
 
     if (this->is_active)
@@ -373,7 +483,7 @@ void emulation::check_state()
         {
             this->trace.msg(vp::Trace::LEVEL_DEBUG, "Activating core\n");
             this->is_active = true;
-            this->cond.notify_all();
+            this->parker.wake();
         }
     }
 }
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2020 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, ETH Zurich (germain.haugou@iis.ee.ethz.ch)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <stddef.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace emu {
+
+static inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/*
+ * Bounded single-producer / single-consumer ring.
+ *
+ * One thread only calls push, one thread only calls pop. Each side keeps a cached copy of
+ * the other side's index so that the shared cache lines are only read when the ring looks
+ * full or empty. N must be a power of 2.
+ */
+template<typename T, size_t N>
+class SpscRing
+{
+    static_assert(N != 0 && (N & (N - 1)) == 0, "Ring size must be a power of 2");
+
+public:
+    bool push(const T &value)
+    {
+        size_t head = this->head.load(std::memory_order_relaxed);
+        if (head - this->tail_cache == N)
+        {
+            this->tail_cache = this->tail.load(std::memory_order_acquire);
+            if (head - this->tail_cache == N) return false;
+        }
+        this->slots[head & (N - 1)] = value;
+        this->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &value)
+    {
+        size_t tail = this->tail.load(std::memory_order_relaxed);
+        if (tail == this->head_cache)
+        {
+            this->head_cache = this->head.load(std::memory_order_acquire);
+            if (tail == this->head_cache) return false;
+        }
+        value = this->slots[tail & (N - 1)];
+        this->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return this->tail.load(std::memory_order_acquire) ==
+            this->head.load(std::memory_order_acquire);
+    }
+
+private:
+    // Producer side
+    alignas(64) std::atomic<size_t> head{0};
+    size_t tail_cache = 0;
+    // Consumer side
+    alignas(64) std::atomic<size_t> tail{0};
+    size_t head_cache = 0;
+    alignas(64) T slots[N];
+};
+
+/*
+ * Spin-then-park wait on a condition.
+ *
+ * The waiter first spins for a bounded number of iterations, which is enough to catch a
+ * reply coming from the simulator thread without any system call, and then parks on a
+ * condition variable. The waker only takes the mutex when a waiter is actually parked.
+ * Spinning only pays off if the other side runs on another host core, so there is none
+ * on a single-core host.
+ */
+class Parker
+{
+public:
+    static int get_spin_count()
+    {
+        static const int spin_count = std::thread::hardware_concurrency() > 1 ? 4000 : 0;
+        return spin_count;
+    }
+
+    template<typename Pred>
+    void wait(Pred pred)
+    {
+        int spin_count = get_spin_count();
+        for (int i = 0; i < spin_count; i++)
+        {
+            if (pred()) return;
+            cpu_relax();
+        }
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->nb_parked.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!pred())
+        {
+            this->cond.wait(lock);
+        }
+        this->nb_parked.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // To be called after the condition has been made true
+    void wake()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (this->nb_parked.load(std::memory_order_relaxed) != 0)
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->cond.notify_all();
+        }
+    }
+
+private:
+    std::atomic<int> nb_parked{0};
+    std::mutex mutex;
+    std::condition_variable cond;
+};
+
+}
@@ -18,12 +18,24 @@ import gvsoc.systree as st
 import os.path
 
 class CoreEmulation(st.Component):
+    """Core running natively compiled code on a host thread.
+
+    Memory accesses of the native code go through the simulated ``data``
+    port. With ``batch_size`` greater than 1, writes of up to 64 bytes are
+    posted: they are acknowledged immediately and sent to the simulator in
+    groups of up to ``batch_size`` (maximum 64) under a single engine lock,
+    before any other access of the core. An invalid posted write can then
+    only be reported as a warning, and another core only sees a posted
+    write once the writing core does another access or fills its batch.
+    """
+
     def __init__(self,
             parent,
             name,
             cluster_id: int=0,
             core_id: int=0,
             fetch_enable: bool=False,
+            batch_size: int=1,
             *kargs, **kwargs):
 
         super().__init__(parent, name)
@@ -31,4 +43,5 @@ class CoreEmulation(st.Component):
         self.set_component('cpu.emulation.emulation')
 
         self.add_property('fetch_enable', fetch_enable)
+        self.add_property('batch_size', batch_size)
 
@@ -39,7 +39,7 @@
 #include <cpu/iss/include/memcheck.hpp>
 #include <cpu/iss/include/insn_cache.hpp>
 #include <cpu/iss/include/exec/exec_inorder.hpp>
-#include <cpu/iss/include/prefetch/prefetch_single_line.hpp>
+#include <cpu/iss/include/prefetch/prefetch.hpp>
 #include <cpu/iss/include/gdbserver.hpp>
 
 
@@ -35,5 +35,5 @@
 #include <cpu/iss/include/regfile_implem.hpp>
 #include <cpu/iss/include/irq/irq_external_implem.hpp>
 #include <cpu/iss/include/exec/exec_inorder_implem.hpp>
-#include <cpu/iss/include/prefetch/prefetch_single_line_implem.hpp>
+#include <cpu/iss/include/prefetch/prefetch_implem.hpp>
 #include <cpu/iss/include/gdbserver_implem.hpp>
\ No newline at end of file
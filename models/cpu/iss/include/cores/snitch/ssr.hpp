@@ -24,6 +24,12 @@
 
 #include "cpu/iss/include/types.hpp"
 
+// Maximum and default size in bytes of the bursts fetched by read streams. A burst never
+// holds more 64-bit elements than the data lane, which the hardware fills ahead of the core
+// anyway. Bursts are disabled by default.
+#define SSR_BURST_MAX_SIZE 32
+#define SSR_BURST_DEFAULT_SIZE 0
+
 
 class Ssr;
 
@@ -249,6 +255,25 @@ public:
 
     // When the data is not preloaded, set the flag to true.
     bool dm_not_preload = false;
+
+    // Burst buffer. Contiguous read streams fetch their next elements, up to the end of the
+    // burst and never past the end of the stream, in one request and serve them from here,
+    // with the latency of the burst request.
+    uint8_t burst_data[SSR_BURST_MAX_SIZE];
+    // Request used for bursts, so that a burst never reuses the element request
+    vp::IoReq burst_req;
+    iss_addr_t burst_base = 0;
+    int burst_len = 0;
+    bool burst_valid = false;
+    // Set when the port answered a burst asynchronously. The request stays with the target,
+    // so no other burst is sent on this data mover.
+    bool burst_disabled = false;
+    int64_t burst_latency = 0;
+    // Check if an access is fully inside the burst buffer
+    bool burst_hit(iss_addr_t addr, int size);
+    // Get the end of the stream if it reads a single contiguous range of elements of this
+    // size, or 0 if it does not
+    iss_addr_t burst_stream_end(int size);
 };
         
 
@@ -289,6 +314,9 @@ public:
     // Data fetch request
     vp::IoReq io_req;
 
+    // Size in bytes of the bursts fetched by read streams, 0 to fetch element by element
+    int burst_size = 0;
+
     // Three operands used in this round
     // Temporary variable stored for traces
     iss_freg_t ssr_fregs[3] = {0x0, 0x0, 0x0};
@@ -309,6 +337,11 @@ public:
     inline bool load_float(iss_addr_t addr, uint8_t *data_ptr, int size, int dm);
     inline bool store_float(iss_addr_t addr, uint8_t *data_ptr, int size, int dm);
 
+    // Fetch the stream elements from addr to the end of the burst into the burst buffer
+    bool burst_fill(iss_addr_t addr, int size, iss_addr_t stream_end, int dm);
+    // Drop the burst buffers overlapping a range written by a data mover
+    void burst_invalidate(iss_addr_t addr, int size);
+
     // Read or write in data mover
     iss_freg_t dm_read(int dm);
     bool dm_write(iss_freg_t value, int dm);
@@ -333,6 +366,10 @@ public:
     vp::ClockEvent *event_2;
 
 private:
+    DataMover *get_dm(int dm);
+    vp::IoMaster *get_port(int dm);
+    vp::ClockEvent *get_event(int dm);
+
     Iss &iss;
 
     vp::ClockEngine *engine;
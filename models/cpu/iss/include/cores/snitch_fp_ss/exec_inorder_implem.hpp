@@ -147,7 +147,10 @@ inline iss_reg_t Exec::insn_exec_fast(iss_insn_t *insn, iss_reg_t pc)
 
 inline bool Exec::can_switch_to_fast_mode()
 {
-    if (this->iss.gdbserver.is_enabled())
+    // Breakpoints are checked by stubs installed in the instruction handlers and watchpoints
+    // by the load-store unit, which are both also used in fast mode, so gdb only needs the
+    // full handler for stepping
+    if (this->step_mode.get())
     {
         return false;
     }
@@ -99,6 +99,9 @@ public:
 
     static void exec_instr(vp::Block *__this, vp::ClockEvent *event);
     static void exec_instr_check_all(vp::Block *__this, vp::ClockEvent *event);
+#if !defined(CONFIG_GVSOC_ISS_TIMED) && !defined(CONFIG_GVSOC_ISS_EXEC_SCOREBOARD)
+    static void exec_block(vp::Block *__this, vp::ClockEvent *event);
+#endif
 
     int64_t get_cycles();
 
@@ -163,6 +166,16 @@ public:
     bool pending_flush;
     int64_t stall_cycles;
 
+    // Maximum number of instructions executed within a single clock event when running
+    // untimed with basic-block execution enabled. 1 or less disables it.
+    int block_size;
+    // Set by anything which needs the current block to be interrupted after the current
+    // instruction, like a stall, a callback change or an instruction cache flush.
+    bool block_break;
+    // Number of instructions already executed in the current block, so that cycle reads
+    // done by the block instructions still see one cycle per instruction.
+    int64_t block_cycles;
+
     int stall_reg;
 
     inline void offload_insn(IssOffloadInsn<iss_reg_t> *insn);
@@ -79,7 +79,7 @@ static inline iss_reg_t iss_exec_stalled_insn(Iss *iss, iss_insn_t *insn, iss_re
 
 inline int64_t Exec::get_cycles()
 {
-    return this->iss.top.clock.get_cycles() + this->stall_cycles;
+    return this->iss.top.clock.get_cycles() + this->stall_cycles + this->block_cycles;
 }
 
 inline iss_insn_callback_t Exec::insn_trace_callback_get()
@@ -113,6 +113,7 @@ inline void Exec::insn_hold(vp::ClockEventMeth *meth)
     // Flag that we cannto execute instructions so that no one tries
     // to change the event callback
     this->insn_on_hold = true;
+    this->block_break = true;
     this->iss.exec.instr_event.set_callback(meth);
 }
 
@@ -157,7 +158,10 @@ inline iss_reg_t Exec::insn_exec_fast(iss_insn_t *insn, iss_reg_t pc)
 
 inline bool Exec::can_switch_to_fast_mode()
 {
-    if (this->iss.gdbserver.is_enabled())
+    // Breakpoints are checked by stubs installed in the instruction handlers and watchpoints
+    // by the load-store unit, which are both also used in fast mode, so gdb only needs the
+    // full handler for stepping
+    if (this->step_mode.get())
     {
         return false;
     }
@@ -180,6 +184,7 @@ inline void Exec::stalled_inc()
     {
         this->instr_event.disable();
     }
+    this->block_break = true;
     this->stalled.inc(1);
 }
 
@@ -232,6 +237,7 @@ inline void Exec::switch_to_full_mode()
 {
     // Only switch to full mode instruction if we are not currently executing instructions,
     // do not overwrite the event callback used for another activity
+    this->block_break = true;
     if (!this->insn_on_hold)
     {
         this->instr_event.set_callback(&Exec::exec_instr_check_all);
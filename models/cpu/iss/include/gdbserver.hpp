@@ -34,6 +34,12 @@ public:
     int size;
 };
 
+// Watchpoints are first filtered through a bitmap of the pages they cover, indexed by the
+// low bits of the page number, so that accesses to other pages do not walk the watchpoint
+// lists. Pages aliasing a watched one just take the full check.
+#define GDBSERVER_WATCH_PAGE_BITS 12
+#define GDBSERVER_WATCH_NB_PAGES 4096
+
 class Gdbserver : public vp::Gdbserver_core
 {
 public:
@@ -64,7 +70,7 @@ public:
     void enable_breakpoint(iss_addr_t addr);
     void disable_breakpoint(iss_addr_t addr);
     void enable_all_breakpoints();
-    bool watchpoint_check(bool is_write, iss_addr_t addr, int size);
+    inline bool watchpoint_check(bool is_write, iss_addr_t addr, int size);
 
     void handle_pending_io_access();
     static void handle_pending_io_access_stub(vp::Block *__this, vp::ClockEvent *event);
@@ -95,4 +101,37 @@ public:
     std::list<Watchpoint *> write_watchpoints;
     std::list<Watchpoint *> read_watchpoints;
     int id;
+
+private:
+    bool watchpoint_check_list(bool is_write, iss_addr_t addr, int size);
+    void watchpoint_pages_update();
+    static void watchpoint_pages_set(uint64_t *pages, std::list<Watchpoint *> &watchpoints);
+    static inline bool watchpoint_page_is_set(uint64_t *pages, iss_addr_t addr);
+
+    int nb_watchpoints = 0;
+    uint64_t write_watch_pages[GDBSERVER_WATCH_NB_PAGES / 64] = {};
+    uint64_t read_watch_pages[GDBSERVER_WATCH_NB_PAGES / 64] = {};
 };
+
+inline bool Gdbserver::watchpoint_page_is_set(uint64_t *pages, iss_addr_t addr)
+{
+    uint64_t page = (addr >> GDBSERVER_WATCH_PAGE_BITS) % GDBSERVER_WATCH_NB_PAGES;
+    return (pages[page / 64] >> (page % 64)) & 1;
+}
+
+inline bool Gdbserver::watchpoint_check(bool is_write, iss_addr_t addr, int size)
+{
+    if (likely(this->nb_watchpoints == 0))
+    {
+        return false;
+    }
+
+    // Accesses are at most a few bytes, so they span at most 2 pages
+    uint64_t *pages = is_write ? this->write_watch_pages : this->read_watch_pages;
+    if (!watchpoint_page_is_set(pages, addr) && !watchpoint_page_is_set(pages, addr + size - 1))
+    {
+        return false;
+    }
+
+    return this->watchpoint_check_list(is_write, addr, size);
+}
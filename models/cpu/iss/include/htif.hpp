@@ -35,6 +35,7 @@
 #include <limits.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 
@@ -116,7 +117,6 @@ private:
     bool target_access_async(iss_reg_t addr, int size, bool is_write, uint8_t *data);
     static void data_response(vp::Block *__this, vp::IoReq *req);
     void exec_syscall();
-    uint8_t read_uint8(iss_reg_t addr);
     static void htif_handler(vp::Block *__this, vp::ClockEvent *event);
 
     iss_reg_t sys_exit(iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t, iss_reg_t);
@@ -151,6 +151,8 @@ private:
     uint64_t syscall_args[8];
 
     std::vector<syscall_func_t> table;
+    // Host buffers of the guest buffer of the current syscall, when directly accessible
+    std::vector<struct iovec> iov;
 
     fds_t fds;
     std::string chroot;
@@ -23,6 +23,7 @@
 
 #include "cpu/iss/include/decode.hpp"
 #include "cpu/iss/include/types.hpp"
+#include "cpu/iss/include/insn_page_table.hpp"
 
 // The size of a page corresponds to the tlb page size with instructions of at least 2 bytes
 #define INSN_PAGE_BITS 9
@@ -49,11 +50,14 @@ public:
     inline void insn_init(iss_insn_t *insn, iss_addr_t addr);
     InsnPage *page_get(iss_reg_t paddr);
 
+    // Incremented each time the instruction cache is flushed or the address mapping changes,
+    // to invalidate the links between instructions used for block execution.
+    int block_gen;
 
 private:
     InsnPage *current_insn_page;
     iss_reg_t current_insn_page_base;
-    std::unordered_map<iss_reg_t, InsnPage *>pages;
+    InsnPageTable<InsnPage, iss_reg_t> pages;
 
     Iss &iss;
 };
@@ -76,6 +80,8 @@ inline void InsnCache::insn_init(iss_insn_t *insn, iss_addr_t addr)
     insn->handler = iss_decode_pc_handler;
     insn->fast_handler = iss_decode_pc_handler;
     insn->addr = addr;
+    insn->block_next = NULL;
+    insn->trace_id = -1;
 #if defined(CONFIG_GVSOC_ISS_RI5KY) || defined(CONFIG_GVSOC_ISS_HWLOOP)
     insn->hwloop_handler = NULL;
 #endif
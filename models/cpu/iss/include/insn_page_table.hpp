@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+// Number of page index bits resolved by each level of the radix table
+#define INSN_PAGE_TABLE_RADIX_BITS 12
+#define INSN_PAGE_TABLE_RADIX_SIZE (1 << INSN_PAGE_TABLE_RADIX_BITS)
+// Number of entries of the direct-mapped cache of last accessed pages, must be a power of 2
+#define INSN_PAGE_TABLE_VICTIM_SIZE 64
+// Number of pages allocated at once
+#define INSN_PAGE_TABLE_SLAB_SIZE 8
+
+/*
+ * Table of instruction pages, indexed by physical page index.
+ *
+ * Pages are found through a multi-level radix table, with a small direct-mapped cache of the
+ * last accessed pages in front so that jumping between a few pages does not walk the table.
+ * Pages are allocated from slabs of several pages. Flushing the table drops all pages in one
+ * shot and keeps the slabs, so that they are reused without any new allocation.
+ */
+template<typename Page, typename Addr>
+class InsnPageTable
+{
+public:
+    // index_bits is the number of significant bits of the page indexes
+    InsnPageTable(int index_bits);
+    ~InsnPageTable();
+
+    // Return the page with the specified index or NULL if it has not been allocated
+    inline Page *get(Addr index);
+    // Allocate the page with the specified index, which must not already be allocated.
+    // The content of the page is not initialized.
+    Page *alloc(Addr index);
+    // Drop all pages, their memory is kept for next allocations
+    void flush();
+    // Drop all pages and free all the memory
+    void release();
+
+private:
+    struct Victim
+    {
+        Addr index;
+        Page *page;
+    };
+
+    Page *lookup(Addr index);
+    void victims_flush();
+
+    int nb_levels;
+    void **root;
+    Victim victims[INSN_PAGE_TABLE_VICTIM_SIZE];
+    // Radix nodes allocated below the root
+    std::vector<void **> nodes;
+    std::vector<Page *> slabs;
+    // Slab currently used for allocation and position of the next free page inside it
+    int slab_index;
+    int slab_pos;
+};
+
+
+
+template<typename Page, typename Addr>
+InsnPageTable<Page, Addr>::InsnPageTable(int index_bits)
+{
+    this->nb_levels = (index_bits + INSN_PAGE_TABLE_RADIX_BITS - 1) / INSN_PAGE_TABLE_RADIX_BITS;
+    if (this->nb_levels == 0)
+    {
+        this->nb_levels = 1;
+    }
+    this->root = new void *[INSN_PAGE_TABLE_RADIX_SIZE]();
+    this->slab_index = -1;
+    this->slab_pos = INSN_PAGE_TABLE_SLAB_SIZE;
+    this->victims_flush();
+}
+
+template<typename Page, typename Addr>
+InsnPageTable<Page, Addr>::~InsnPageTable()
+{
+    this->release();
+    delete[] this->root;
+}
+
+template<typename Page, typename Addr>
+inline Page *InsnPageTable<Page, Addr>::get(Addr index)
+{
+    Victim *victim = &this->victims[index & (INSN_PAGE_TABLE_VICTIM_SIZE - 1)];
+    if (__builtin_expect(victim->index == index, 1))
+    {
+        return victim->page;
+    }
+
+    Page *page = this->lookup(index);
+    if (page != NULL)
+    {
+        victim->index = index;
+        victim->page = page;
+    }
+    return page;
+}
+
+template<typename Page, typename Addr>
+Page *InsnPageTable<Page, Addr>::lookup(Addr index)
+{
+    void **node = this->root;
+    int shift = (this->nb_levels - 1) * INSN_PAGE_TABLE_RADIX_BITS;
+
+    for (int i=0; i<this->nb_levels - 1; i++)
+    {
+        node = (void **)node[(index >> shift) & (INSN_PAGE_TABLE_RADIX_SIZE - 1)];
+        if (node == NULL)
+        {
+            return NULL;
+        }
+        shift -= INSN_PAGE_TABLE_RADIX_BITS;
+    }
+
+    return (Page *)node[index & (INSN_PAGE_TABLE_RADIX_SIZE - 1)];
+}
+
+template<typename Page, typename Addr>
+Page *InsnPageTable<Page, Addr>::alloc(Addr index)
+{
+    void **node = this->root;
+    int shift = (this->nb_levels - 1) * INSN_PAGE_TABLE_RADIX_BITS;
+
+    for (int i=0; i<this->nb_levels - 1; i++)
+    {
+        void **slot = &node[(index >> shift) & (INSN_PAGE_TABLE_RADIX_SIZE - 1)];
+        if (*slot == NULL)
+        {
+            void **child = new void *[INSN_PAGE_TABLE_RADIX_SIZE]();
+            this->nodes.push_back(child);
+            *slot = child;
+        }
+        node = (void **)*slot;
+        shift -= INSN_PAGE_TABLE_RADIX_BITS;
+    }
+
+    if (this->slab_pos == INSN_PAGE_TABLE_SLAB_SIZE)
+    {
+        this->slab_index++;
+        this->slab_pos = 0;
+        if (this->slab_index == (int)this->slabs.size())
+        {
+            this->slabs.push_back(new Page[INSN_PAGE_TABLE_SLAB_SIZE]);
+        }
+    }
+
+    Page *page = &this->slabs[this->slab_index][this->slab_pos++];
+
+    node[index & (INSN_PAGE_TABLE_RADIX_SIZE - 1)] = page;
+
+    Victim *victim = &this->victims[index & (INSN_PAGE_TABLE_VICTIM_SIZE - 1)];
+    victim->index = index;
+    victim->page = page;
+
+    return page;
+}
+
+template<typename Page, typename Addr>
+void InsnPageTable<Page, Addr>::victims_flush()
+{
+    for (int i=0; i<INSN_PAGE_TABLE_VICTIM_SIZE; i++)
+    {
+        // Use an index which can not be hit by this entry
+        this->victims[i].index = i + 1;
+        this->victims[i].page = NULL;
+    }
+}
+
+template<typename Page, typename Addr>
+void InsnPageTable<Page, Addr>::flush()
+{
+    for (void **node: this->nodes)
+    {
+        delete[] node;
+    }
+    this->nodes.clear();
+
+    memset(this->root, 0, sizeof(void *) * INSN_PAGE_TABLE_RADIX_SIZE);
+
+    this->slab_index = -1;
+    this->slab_pos = INSN_PAGE_TABLE_SLAB_SIZE;
+
+    this->victims_flush();
+}
+
+template<typename Page, typename Addr>
+void InsnPageTable<Page, Addr>::release()
+{
+    this->flush();
+
+    for (Page *slab: this->slabs)
+    {
+        delete[] slab;
+    }
+    this->slabs.clear();
+}
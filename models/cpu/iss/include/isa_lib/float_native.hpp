@@ -21,38 +21,373 @@
 
 #pragma once
 
+#include <cmath>
+#include <string.h>
+
 #include "cpu/iss/include/iss_core.hpp"
 #include "cpu/iss/include/isa_lib/int.h"
 #include "cpu/iss/include/isa_lib/macros.h"
+#include "cpu/iss/softfloat/softfloat.h"
+#include "cpu/iss/include/isa_lib/float_softfloat_common.h"
+
+/*
+ * Native float library.
+ *
+ * Binary32 and binary64 operations are executed by the host FPU, with the host rounding mode
+ * set from the instruction mode, and the IEEE exception flags raised by the host collected
+ * into fflags. NaN results are canonicalized as RISC-V requires.
+ *
+ * Softfloat is used for the cases where the host does not behave like RISC-V:
+ *   - roundTiesToAway (RMM), which hosts do not implement,
+ *   - NaN operands, since hosts propagate NaN payloads and do not all raise invalid on
+ *     0 * inf + qNaN,
+ *   - fused operations on hosts without FMA, which would have to emulate them anyway,
+ *   - hosts other than x86_64, which may detect tininess before rounding while RISC-V
+ *     detects it after rounding, or compute with extended precision.
+ * Half-precision formats always go through softfloat.
+ *
+ * On x86_64, the rounding mode and the flags are accessed directly in MXCSR rather than
+ * through <cfenv>, whose functions also synchronize the x87 state and cost more than the
+ * operation itself. The host operations are fenced with empty asm statements so that the
+ * compiler cannot move them across the MXCSR accesses, as it does not model them.
+ */
+
+#if defined(__x86_64__)
+#define FLOAT_NATIVE_HOST 1
+#include <immintrin.h>
+#else
+#define FLOAT_NATIVE_HOST 0
+#endif
+
+// MXCSR fields
+#define FLOAT_NATIVE_MXCSR_FLAGS     0x3F
+#define FLOAT_NATIVE_MXCSR_INVALID   0x01
+#define FLOAT_NATIVE_MXCSR_DIVBYZERO 0x04
+#define FLOAT_NATIVE_MXCSR_OVERFLOW  0x08
+#define FLOAT_NATIVE_MXCSR_UNDERFLOW 0x10
+#define FLOAT_NATIVE_MXCSR_INEXACT   0x20
+#define FLOAT_NATIVE_MXCSR_RC_BIT    13
+#define FLOAT_NATIVE_MXCSR_RC        (3 << FLOAT_NATIVE_MXCSR_RC_BIT)
+
+template<typename T>
+static inline T float_native_fence(T value)
+{
+    asm volatile("" : "+m"(value));
+    return value;
+}
+
+static inline float float_native_f32(uint32_t value)
+{
+    float result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+static inline uint32_t float_native_u32(float value)
+{
+    uint32_t result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+static inline double float_native_f64(uint64_t value)
+{
+    double result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+static inline uint64_t float_native_u64(double value)
+{
+    uint64_t result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+static inline bool float_native_has_fma()
+{
+#if FLOAT_NATIVE_HOST
+    static const bool has_fma = __builtin_cpu_supports("fma");
+    return has_fma;
+#else
+    return false;
+#endif
+}
+
+// Resolve the instruction rounding mode and return the MXCSR rounding control, or -1 if the
+// host cannot round this way and softfloat must be used. The resolved mode is also given to
+// softfloat.
+static inline int float_native_round(Iss *iss, uint32_t mode)
+{
+    float_set_rounding_mode(iss, mode);
+
+#if FLOAT_NATIVE_HOST
+    switch (iss->core.float_mode)
+    {
+        case softfloat_round_near_even: return 0;
+        case softfloat_round_min:       return 1;
+        case softfloat_round_max:       return 2;
+        case softfloat_round_minMag:    return 3;
+    }
+#endif
+    return -1;
+}
+
+// Clear the host flags and set the host rounding mode. Returns the MXCSR value to restore.
+static inline uint32_t float_native_begin(int round)
+{
+#if FLOAT_NATIVE_HOST
+    uint32_t mxcsr = _mm_getcsr();
+    _mm_setcsr((mxcsr & ~(FLOAT_NATIVE_MXCSR_FLAGS | FLOAT_NATIVE_MXCSR_RC)) |
+        (round << FLOAT_NATIVE_MXCSR_RC_BIT));
+    return mxcsr;
+#else
+    return 0;
+#endif
+}
+
+// Move the host exception flags to fflags and restore MXCSR
+static inline void float_native_end(Iss *iss, uint32_t mxcsr)
+{
+#if FLOAT_NATIVE_HOST
+    uint32_t host_flags = _mm_getcsr();
+    _mm_setcsr(mxcsr);
+
+    if (host_flags & FLOAT_NATIVE_MXCSR_FLAGS)
+    {
+        uint32_t flags = 0;
+        if (host_flags & FLOAT_NATIVE_MXCSR_INEXACT)   flags |= softfloat_flag_inexact;
+        if (host_flags & FLOAT_NATIVE_MXCSR_UNDERFLOW) flags |= softfloat_flag_underflow;
+        if (host_flags & FLOAT_NATIVE_MXCSR_OVERFLOW)  flags |= softfloat_flag_overflow;
+        if (host_flags & FLOAT_NATIVE_MXCSR_DIVBYZERO) flags |= softfloat_flag_infinite;
+        if (host_flags & FLOAT_NATIVE_MXCSR_INVALID)   flags |= softfloat_flag_invalid;
+        iss->csr.fcsr.fflags |= flags;
+    }
+#endif
+}
+
+// Operations, with the same sign conventions as the RISC-V instructions
+enum float_native_op_e
+{
+    FLOAT_NATIVE_ADD,
+    FLOAT_NATIVE_SUB,
+    FLOAT_NATIVE_MADD,   // a * b + c
+    FLOAT_NATIVE_MSUB,   // a * b - c
+    FLOAT_NATIVE_NMADD,  // -(a * b) - c
+    FLOAT_NATIVE_NMSUB,  // -(a * b) + c
+};
+
+static constexpr bool float_native_is_fused(float_native_op_e op)
+{
+    return op != FLOAT_NATIVE_ADD && op != FLOAT_NATIVE_SUB;
+}
+
+// Fused operations are compiled for FMA hosts whatever the build flags, so that they map to
+// one instruction instead of the libm emulation. They are only called if the host has FMA.
+template<float_native_op_e op, typename T>
+#if FLOAT_NATIVE_HOST
+__attribute__((target("fma")))
+#endif
+static T float_native_exec_fused(T a, T b, T c)
+{
+    switch (op)
+    {
+        case FLOAT_NATIVE_MSUB:  c = -c; break;
+        case FLOAT_NATIVE_NMADD: a = -a; c = -c; break;
+        case FLOAT_NATIVE_NMSUB: a = -a; break;
+        default: break;
+    }
+
+    if constexpr (sizeof(T) == 4)
+    {
+        return __builtin_fmaf(a, b, c);
+    }
+    else
+    {
+        return __builtin_fma(a, b, c);
+    }
+}
+
+template<float_native_op_e op, typename T>
+static inline T float_native_exec(T a, T b, T c)
+{
+    a = float_native_fence(a);
+    b = float_native_fence(b);
+    c = float_native_fence(c);
+
+    T result;
+    switch (op)
+    {
+        case FLOAT_NATIVE_ADD: result = a + b; break;
+        case FLOAT_NATIVE_SUB: result = a - b; break;
+        default:               result = float_native_exec_fused<op, T>(a, b, c); break;
+    }
+
+    return float_native_fence(result);
+}
+
+template<typename U, int FRAC_BITS>
+static inline uint32_t float_native_exp(U value)
+{
+    return (value >> FRAC_BITS) & ((1 << (sizeof(U) * 8 - 1 - FRAC_BITS)) - 1);
+}
+
+template<typename U, int FRAC_BITS>
+static inline bool float_native_is_normal(U value)
+{
+    uint32_t exp = float_native_exp<U, FRAC_BITS>(value);
+    return exp != 0 && exp != (1U << (sizeof(U) * 8 - 1 - FRAC_BITS)) - 1;
+}
+
+// True if the result of the fast path can be kept. A fused operation whose exact result is
+// just below the minimum normal can round up to it, and must then still raise underflow since
+// tininess is detected after rounding. The magnitude of the exact result is not known anymore,
+// so results equal to the minimum normal go through the MXCSR path.
+template<float_native_op_e op, typename U, int FRAC_BITS>
+static inline bool float_native_fast_result_ok(U value)
+{
+    if (float_native_is_fused(op) && (U)(value << 1) == ((U)1 << (FRAC_BITS + 1)))
+    {
+        return false;
+    }
+    return float_native_is_normal<U, FRAC_BITS>(value);
+}
+
+template<typename U, int FRAC_BITS>
+static inline bool float_native_is_normal_or_zero(U value)
+{
+    return float_native_is_normal<U, FRAC_BITS>(value) || (value << 1) == 0;
+}
+
+/*
+ * Return true if the operation can be executed without touching MXCSR, as long as it
+ * gives a normal result, which is checked afterwards.
+ *
+ * With round to nearest even, which is the host mode, and only normal or zero operands,
+ * an operation with a normal result cannot raise invalid, divide by zero, overflow or
+ * underflow. It can only raise inexact, which does not need to be captured if it is already
+ * set in fflags, since flags are sticky. This is the usual case once a program has done a
+ * few float operations. The host is expected to run with the default MXCSR, without
+ * flush-to-zero.
+ */
+template<typename U, int FRAC_BITS>
+static inline bool float_native_fast_ok(Iss *iss, U a, U b, U c)
+{
+    return (iss->csr.fcsr.fflags & softfloat_flag_inexact) &&
+        float_native_is_normal_or_zero<U, FRAC_BITS>(a) &&
+        float_native_is_normal_or_zero<U, FRAC_BITS>(b) &&
+        float_native_is_normal_or_zero<U, FRAC_BITS>(c);
+}
+
+template<float_native_op_e op>
+static inline bool float_native_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode,
+    uint32_t &result)
+{
+    int round = float_native_round(iss, mode);
+    if (round < 0 || is_nan_32(a) || is_nan_32(b) || is_nan_32(c) ||
+        (float_native_is_fused(op) && !float_native_has_fma()))
+    {
+        return false;
+    }
+
+    // Without MXCSR accesses if the result is normal, see float_native_fast_ok and
+    // float_native_fast_result_ok
+    if (round == 0 && float_native_fast_ok<uint32_t, 23>(iss, a, b, c))
+    {
+        uint32_t value = float_native_u32(float_native_exec<op>(float_native_f32(a), float_native_f32(b), float_native_f32(c)));
+        if (likely((float_native_fast_result_ok<op, uint32_t, 23>(value))))
+        {
+            result = value;
+            return true;
+        }
+    }
+
+    uint32_t mxcsr = float_native_begin(round);
+    float value = float_native_exec<op>(float_native_f32(a), float_native_f32(b),
+        float_native_f32(c));
+    float_native_end(iss, mxcsr);
+
+    result = sanitize_32(float_native_u32(value));
+    return true;
+}
+
+template<float_native_op_e op>
+static inline bool float_native_64(Iss *iss, uint64_t a, uint64_t b, uint64_t c, uint32_t mode,
+    uint64_t &result)
+{
+    int round = float_native_round(iss, mode);
+    if (round < 0 || is_nan_64(a) || is_nan_64(b) || is_nan_64(c) ||
+        (float_native_is_fused(op) && !float_native_has_fma()))
+    {
+        return false;
+    }
+
+    // Without MXCSR accesses if the result is normal, see float_native_fast_ok and
+    // float_native_fast_result_ok
+    if (round == 0 && float_native_fast_ok<uint64_t, 52>(iss, a, b, c))
+    {
+        uint64_t value = float_native_u64(float_native_exec<op>(float_native_f64(a), float_native_f64(b), float_native_f64(c)));
+        if (likely((float_native_fast_result_ok<op, uint64_t, 52>(value))))
+        {
+            result = value;
+            return true;
+        }
+    }
+
+    uint32_t mxcsr = float_native_begin(round);
+    double value = float_native_exec<op>(float_native_f64(a), float_native_f64(b),
+        float_native_f64(c));
+    float_native_end(iss, mxcsr);
+
+    result = sanitize_64(float_native_u64(value));
+    return true;
+}
 
 static inline uint32_t float_add_32(Iss *iss, uint32_t a, uint32_t b, uint32_t mode)
 {
-    float result = *(float *)&a + *(float *)&b;
-    return *(uint32_t *)&result;
+    uint32_t result;
+    if (likely(float_native_32<FLOAT_NATIVE_ADD>(iss, a, b, 0, mode, result))) return result;
+    return sanitize_32(f32_add(iss, {.v=a}, {.v=b}).v);
 }
 
 static inline uint32_t float_sub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t mode)
 {
-    return LIB_FF_CALL3(lib_flexfloat_sub_round, a, b, 8, 23, mode);
+    uint32_t result;
+    if (likely(float_native_32<FLOAT_NATIVE_SUB>(iss, a, b, 0, mode, result))) return result;
+    return sanitize_32(f32_sub(iss, {.v=a}, {.v=b}).v);
 }
 
 static inline uint32_t float_madd_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
 {
-    return LIB_FF_CALL4(lib_flexfloat_madd_round, a, b, c, 8, 23, mode);
+    uint32_t result;
+    if (likely(float_native_32<FLOAT_NATIVE_MADD>(iss, a, b, c, mode, result))) return result;
+    return sanitize_32(f32_mulAdd(iss, {.v=a}, {.v=b}, {.v=c}).v);
 }
 
 static inline uint32_t float_msub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
 {
-    return LIB_FF_CALL4(lib_flexfloat_msub_round, a, b, c, 8, 23, mode);
+    uint32_t result;
+    if (likely(float_native_32<FLOAT_NATIVE_MSUB>(iss, a, b, c, mode, result))) return result;
+    return sanitize_32(f32_mulSub(iss, {.v=a}, {.v=b}, {.v=c}).v);
 }
 
 static inline uint32_t float_nmadd_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
 {
-    return LIB_FF_CALL4(lib_flexfloat_nmadd_round, a, b, c, 8, 23, mode);
+    uint32_t result;
+    if (likely(float_native_32<FLOAT_NATIVE_NMADD>(iss, a, b, c, mode, result))) return result;
+    return sanitize_32(f32_NmulSub(iss, {.v=a}, {.v=b}, {.v=c}).v);
 }
 
 static inline uint32_t float_nmsub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
 {
-    return LIB_FF_CALL4(lib_flexfloat_nmsub_round, a, b, c, 8, 23, mode);
+    uint32_t result;
+    if (likely(float_native_32<FLOAT_NATIVE_NMSUB>(iss, a, b, c, mode, result))) return result;
+    return sanitize_32(f32_NmulAdd(iss, {.v=a}, {.v=b}, {.v=c}).v);
 }
 
+static inline uint64_t float_madd_64(Iss *iss, uint64_t a, uint64_t b, uint64_t c, uint32_t mode)
+{
+    uint64_t result;
+    if (likely(float_native_64<FLOAT_NATIVE_MADD>(iss, a, b, c, mode, result))) return result;
+    return sanitize_64(f64_mulAdd(iss, {.v=a}, {.v=b}, {.v=c}).v);
+}
@@ -25,63 +25,7 @@
 #include "cpu/iss/include/isa_lib/int.h"
 #include "cpu/iss/include/isa_lib/macros.h"
 #include "cpu/iss/softfloat/softfloat.h"
-
-static int is_nan_32(uint32_t f) {
-    uint32_t exp = (f >> 23) & 0xFF;
-    uint32_t frac = f & 0x7FFFFF;
-    return (exp == 0xFF && frac != 0);
-}
-
-static uint32_t sanitize_32(uint32_t value)
-{
-    if (is_nan_32(value))
-    {
-        return 0x7FC00000;
-    }
-    return value;
-}
-
-static int is_nan_16(uint32_t f) {
-    uint32_t exp = (f >> 10) & 0x1F;
-    uint32_t frac = f & 0x3FF;
-    return (exp == 0x1F && frac != 0);
-}
-
-static uint32_t sanitize_16(uint32_t value)
-{
-    if (is_nan_16(value))
-    {
-        return 0x7E00;
-    }
-    return value;
-}
-
-static int is_nan_16alt(uint32_t f) {
-    uint32_t exp = (f >> 7) & 0xFF;
-    uint32_t frac = f & 0x7F;
-    return (exp == 0xFF && frac != 0);
-}
-
-static uint32_t sanitize_16alt(uint32_t value)
-{
-    if (is_nan_16alt(value))
-    {
-        return 0x7FC0;
-    }
-    return value;
-}
-
-static inline void float_set_rounding_mode(Iss *iss, int mode)
-{
-    if ((mode == 7) || (mode == 5))
-    {
-        // mode == 7: normal behavior
-        // mode == 5: bfloat16: normal behavior,
-        // mode == 5: non-bfloat16: illegal value -> don't care.
-        mode = iss->csr.fcsr.frm;
-    }
-    iss->core.float_mode = mode;
-}
+#include "cpu/iss/include/isa_lib/float_softfloat_common.h"
 
 static inline uint32_t float_add_32(Iss *iss, uint32_t a, uint32_t b, uint32_t mode)
 {
@@ -119,60 +63,8 @@ static inline uint32_t float_nmsub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t
     return sanitize_32(f32_NmulAdd(iss, {.v=a}, {.v=b}, {.v=c}).v);
 }
 
-
-
-static inline uint32_t float_madd_16(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
-{
-    float_set_rounding_mode(iss, mode);
-    return sanitize_16(f16_mulAdd(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
-}
-
-static inline uint32_t float_msub_16(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
-{
-    float_set_rounding_mode(iss, mode);
-    return sanitize_16(f16_mulSub(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
-}
-
-static inline uint32_t float_nmadd_16(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
-{
-    float_set_rounding_mode(iss, mode);
-    return sanitize_16(f16_NmulSub(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
-}
-
-static inline uint32_t float_nmsub_16(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
-{
-    float_set_rounding_mode(iss, mode);
-    return sanitize_16(f16_NmulAdd(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
-}
-
-
-
-static inline uint32_t float_madd_16alt(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
-{
-    float_set_rounding_mode(iss, mode);
-    return sanitize_16alt(bf16_mulAdd(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
-}
-
-static inline uint32_t float_msub_16alt(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
-{
-    float_set_rounding_mode(iss, mode);
-    return sanitize_16alt(bf16_mulSub(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
-}
-
-static inline uint32_t float_nmadd_16alt(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
-{
-    float_set_rounding_mode(iss, mode);
-    return sanitize_16alt(bf16_NmulSub(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
-}
-
-static inline uint32_t float_nmsub_16alt(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
-{
-    float_set_rounding_mode(iss, mode);
-    return sanitize_16alt(bf16_NmulAdd(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
-}
-
 static inline uint64_t float_madd_64(Iss *iss, uint64_t a, uint64_t b, uint64_t c, uint32_t mode)
 {
     float_set_rounding_mode(iss, mode);
-    return f64_mulAdd(iss, {.v=a}, {.v=b}, {.v=c}).v;
+    return sanitize_64(f64_mulAdd(iss, {.v=a}, {.v=b}, {.v=c}).v);
 }
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include "cpu/iss/include/iss_core.hpp"
+#include "cpu/iss/include/isa_lib/int.h"
+#include "cpu/iss/include/isa_lib/macros.h"
+#include "cpu/iss/softfloat/softfloat.h"
+
+// Helpers and half-precision operations shared by the softfloat and native float libraries,
+// the native one only having a host path for binary32 and binary64.
+
+static int is_nan_32(uint32_t f) {
+    uint32_t exp = (f >> 23) & 0xFF;
+    uint32_t frac = f & 0x7FFFFF;
+    return (exp == 0xFF && frac != 0);
+}
+
+static uint32_t sanitize_32(uint32_t value)
+{
+    if (is_nan_32(value))
+    {
+        return 0x7FC00000;
+    }
+    return value;
+}
+
+static int is_nan_16(uint32_t f) {
+    uint32_t exp = (f >> 10) & 0x1F;
+    uint32_t frac = f & 0x3FF;
+    return (exp == 0x1F && frac != 0);
+}
+
+static uint32_t sanitize_16(uint32_t value)
+{
+    if (is_nan_16(value))
+    {
+        return 0x7E00;
+    }
+    return value;
+}
+
+static int is_nan_16alt(uint32_t f) {
+    uint32_t exp = (f >> 7) & 0xFF;
+    uint32_t frac = f & 0x7F;
+    return (exp == 0xFF && frac != 0);
+}
+
+static uint32_t sanitize_16alt(uint32_t value)
+{
+    if (is_nan_16alt(value))
+    {
+        return 0x7FC0;
+    }
+    return value;
+}
+
+static int is_nan_64(uint64_t f) {
+    uint64_t exp = (f >> 52) & 0x7FF;
+    uint64_t frac = f & 0xFFFFFFFFFFFFFULL;
+    return (exp == 0x7FF && frac != 0);
+}
+
+static uint64_t sanitize_64(uint64_t value)
+{
+    if (is_nan_64(value))
+    {
+        return 0x7FF8000000000000ULL;
+    }
+    return value;
+}
+
+static inline void float_set_rounding_mode(Iss *iss, int mode)
+{
+    if ((mode == 7) || (mode == 5))
+    {
+        // mode == 7: normal behavior
+        // mode == 5: bfloat16: normal behavior,
+        // mode == 5: non-bfloat16: illegal value -> don't care.
+        mode = iss->csr.fcsr.frm;
+    }
+    iss->core.float_mode = mode;
+}
+
+static inline uint32_t float_madd_16(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    float_set_rounding_mode(iss, mode);
+    return sanitize_16(f16_mulAdd(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
+}
+
+static inline uint32_t float_msub_16(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    float_set_rounding_mode(iss, mode);
+    return sanitize_16(f16_mulSub(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
+}
+
+static inline uint32_t float_nmadd_16(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    float_set_rounding_mode(iss, mode);
+    return sanitize_16(f16_NmulSub(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
+}
+
+static inline uint32_t float_nmsub_16(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    float_set_rounding_mode(iss, mode);
+    return sanitize_16(f16_NmulAdd(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
+}
+
+
+
+static inline uint32_t float_madd_16alt(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    float_set_rounding_mode(iss, mode);
+    return sanitize_16alt(bf16_mulAdd(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
+}
+
+static inline uint32_t float_msub_16alt(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    float_set_rounding_mode(iss, mode);
+    return sanitize_16alt(bf16_mulSub(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
+}
+
+static inline uint32_t float_nmadd_16alt(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    float_set_rounding_mode(iss, mode);
+    return sanitize_16alt(bf16_NmulSub(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
+}
+
+static inline uint32_t float_nmsub_16alt(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    float_set_rounding_mode(iss, mode);
+    return sanitize_16alt(bf16_NmulAdd(iss, {.v=(uint16_t)a}, {.v=(uint16_t)b}, {.v=(uint16_t)c}).v);
+}
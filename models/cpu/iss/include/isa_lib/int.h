@@ -1430,6 +1430,7 @@ static inline unsigned int lib_VEC_PACK_SC_HL_16(Iss *s, unsigned int a, unsigne
 // Floating-Point Emulation
 
 #include "cpu/iss/flexfloat/flexfloat.h"
+#include "cpu/iss/include/isa_lib/smallfloat.hpp"
 #include <stdint.h>
 #include <math.h>
 #include <fenv.h>
@@ -1753,7 +1754,7 @@ static inline void restoreFFRoundingMode(unsigned long int mode)
     fesetround(mode);
 }
 
-static inline unsigned long int lib_flexfloat_madd_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
+static inline unsigned long int lib_flexfloat_madd_round_generic(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
 {
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_madd(s, a, b, c, e, m);
@@ -1761,7 +1762,7 @@ static inline unsigned long int lib_flexfloat_madd_round(Iss *s, unsigned long i
     return result;
 }
 
-static inline unsigned long int lib_flexfloat_msub_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
+static inline unsigned long int lib_flexfloat_msub_round_generic(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
 {
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_msub(s, a, b, c, e, m);
@@ -1769,7 +1770,7 @@ static inline unsigned long int lib_flexfloat_msub_round(Iss *s, unsigned long i
     return result;
 }
 
-static inline unsigned long int lib_flexfloat_nmadd_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
+static inline unsigned long int lib_flexfloat_nmadd_round_generic(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
 {
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_nmadd(s, a, b, c, e, m);
@@ -1777,7 +1778,7 @@ static inline unsigned long int lib_flexfloat_nmadd_round(Iss *s, unsigned long
     return result;
 }
 
-static inline unsigned long int lib_flexfloat_nmsub_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
+static inline unsigned long int lib_flexfloat_nmsub_round_generic(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
 {
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_nmsub(s, a, b, c, e, m);
@@ -1785,7 +1786,7 @@ static inline unsigned long int lib_flexfloat_nmsub_round(Iss *s, unsigned long
     return result;
 }
 
-static inline unsigned long int lib_flexfloat_add_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
+static inline unsigned long int lib_flexfloat_add_round_generic(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
 {
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_add(s, a, b, e, m);
@@ -1793,7 +1794,7 @@ static inline unsigned long int lib_flexfloat_add_round(Iss *s, unsigned long in
     return result;
 }
 
-static inline unsigned long int lib_flexfloat_sub_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
+static inline unsigned long int lib_flexfloat_sub_round_generic(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
 {
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_sub(s, a, b, e, m);
@@ -1801,7 +1802,7 @@ static inline unsigned long int lib_flexfloat_sub_round(Iss *s, unsigned long in
     return result;
 }
 
-static inline unsigned long int lib_flexfloat_mul_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
+static inline unsigned long int lib_flexfloat_mul_round_generic(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
 {
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_mul(s, a, b, e, m);
@@ -1809,7 +1810,7 @@ static inline unsigned long int lib_flexfloat_mul_round(Iss *s, unsigned long in
     return result;
 }
 
-static inline unsigned long int lib_flexfloat_div_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
+static inline unsigned long int lib_flexfloat_div_round_generic(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
 {
     int old = setFFRoundingMode(s, round);
     unsigned long int result = lib_flexfloat_div(s, a, b, e, m);
@@ -1817,6 +1818,49 @@ static inline unsigned long int lib_flexfloat_div_round(Iss *s, unsigned long in
     return result;
 }
 
+// Small formats go through the small-float engine, which falls back to the generic
+// functions above whenever it cannot give the exact flexfloat result by itself
+
+static inline unsigned long int lib_flexfloat_madd_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
+{
+    return smallfloat_exec3<SMALLFLOAT_MADD>(s, a, b, c, e, m, round, lib_flexfloat_madd_round_generic);
+}
+
+static inline unsigned long int lib_flexfloat_msub_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
+{
+    return smallfloat_exec3<SMALLFLOAT_MSUB>(s, a, b, c, e, m, round, lib_flexfloat_msub_round_generic);
+}
+
+static inline unsigned long int lib_flexfloat_nmadd_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
+{
+    return smallfloat_exec3<SMALLFLOAT_NMADD>(s, a, b, c, e, m, round, lib_flexfloat_nmadd_round_generic);
+}
+
+static inline unsigned long int lib_flexfloat_nmsub_round(Iss *s, unsigned long int a, unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round)
+{
+    return smallfloat_exec3<SMALLFLOAT_NMSUB>(s, a, b, c, e, m, round, lib_flexfloat_nmsub_round_generic);
+}
+
+static inline unsigned long int lib_flexfloat_add_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
+{
+    return smallfloat_exec2<SMALLFLOAT_ADD>(s, a, b, e, m, round, lib_flexfloat_add_round_generic);
+}
+
+static inline unsigned long int lib_flexfloat_sub_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
+{
+    return smallfloat_exec2<SMALLFLOAT_SUB>(s, a, b, e, m, round, lib_flexfloat_sub_round_generic);
+}
+
+static inline unsigned long int lib_flexfloat_mul_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
+{
+    return smallfloat_exec2<SMALLFLOAT_MUL>(s, a, b, e, m, round, lib_flexfloat_mul_round_generic);
+}
+
+static inline unsigned long int lib_flexfloat_div_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
+{
+    return smallfloat_exec2<SMALLFLOAT_DIV>(s, a, b, e, m, round, lib_flexfloat_div_round_generic);
+}
+
 static inline unsigned long int lib_flexfloat_avg_round(Iss *s, unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, unsigned long int round)
 {
     int old = setFFRoundingMode(s, round);
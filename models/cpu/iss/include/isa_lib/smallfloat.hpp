@@ -0,0 +1,438 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+/*
+ * Small-float engine, used by the flexfloat library functions of int.h for the formats of
+ * at most 16 bits (fp16, bf16, fp8 and their alternate forms).
+ *
+ * The results and the flags are exactly the ones of flexfloat, which stays the reference:
+ *   - 8-bit formats: add, sub, mul and div have only 65536 operand pairs per rounding mode,
+ *     so their results and flags are memoized in tables filled lazily by flexfloat itself.
+ *   - other small formats, and fused operations on 8-bit formats: operands are converted
+ *     to double through tables for 8-bit formats, F16C for fp16 when the host has it, or
+ *     bit manipulations. When the double result is exact, which is checked from the
+ *     exponents of the operands, and rounds to a normal number, flexfloat only rounds it
+ *     the IEEE way and raises inexact, which is done here without any access to the host
+ *     floating-point environment.
+ * Everything else, like special operands, subnormal, zero or overflowing results, RMM and
+ * invalid dynamic rounding modes, goes through flexfloat.
+ *
+ * Included by int.h, which provides the ISS state.
+ */
+
+// Operations with 2 operands, also the index of their memoization tables
+enum smallfloat_op2_e
+{
+    SMALLFLOAT_ADD,
+    SMALLFLOAT_SUB,
+    SMALLFLOAT_MUL,
+    SMALLFLOAT_DIV,
+    SMALLFLOAT_NB_OP2
+};
+
+// Fused operations, with the same sign conventions as the flexfloat functions
+enum smallfloat_op3_e
+{
+    SMALLFLOAT_MADD,   // a * b + c
+    SMALLFLOAT_MSUB,   // a * b - c
+    SMALLFLOAT_NMADD,  // -(a * b + c)
+    SMALLFLOAT_NMSUB,  // -(a * b) + c
+};
+
+typedef unsigned long int (*smallfloat_generic2_t)(Iss *s, unsigned long int a,
+    unsigned long int b, uint8_t e, uint8_t m, unsigned long int round);
+typedef unsigned long int (*smallfloat_generic3_t)(Iss *s, unsigned long int a,
+    unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round);
+
+#define SMALLFLOAT_FRAC_MASK ((1ULL << 52) - 1)
+
+static inline double smallfloat_f64(uint64_t value)
+{
+    double result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+static inline uint64_t smallfloat_u64(double value)
+{
+    uint64_t result;
+    memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+// Return true for the formats handled by the engine
+static inline bool smallfloat_is_small(uint8_t e, uint8_t m)
+{
+    return e >= 2 && e <= 8 && m >= 2 && e + m + 1 <= 16;
+}
+
+// Resolve the instruction rounding mode, returns -1 if flexfloat must handle it
+static inline int smallfloat_round_mode(Iss *iss, unsigned long int round)
+{
+    if (round == 7)
+    {
+        round = iss->csr.fcsr.frm;
+    }
+    return round <= 3 ? round : -1;
+}
+
+// Sign-extend a result from its sign bit, as flexfloat_get_bits does
+static inline unsigned long int smallfloat_sign_extend(uint64_t bits, uint8_t e, uint8_t m)
+{
+    if ((bits >> (e + m)) & 1)
+    {
+        bits |= ~0ULL << (e + m);
+    }
+    return bits;
+}
+
+// Convert a finite value to double, which is always exact
+static inline double smallfloat_decode_finite(uint64_t bits, uint8_t e, uint8_t m)
+{
+    int bias = (1 << (e - 1)) - 1;
+    uint64_t exp = (bits >> m) & ((1 << e) - 1);
+    uint64_t frac = bits & ((1ULL << m) - 1);
+    uint64_t sign = (bits >> (e + m)) & 1;
+    double value;
+
+    if (exp == 0)
+    {
+        value = ldexp((double)frac, 1 - bias - m);
+    }
+    else
+    {
+        value = smallfloat_f64(((exp - bias + 1023) << 52) | (frac << (52 - m)));
+    }
+
+    return sign ? -value : value;
+}
+
+// Conversion tables of the 8-bit formats, indexed by exponent width
+inline const double *smallfloat_decode_table_8(uint8_t e)
+{
+    static double tables[8][256];
+    static bool init[8];
+
+    if (!init[e])
+    {
+        for (int i=0; i<256; i++)
+        {
+            tables[e][i] = smallfloat_decode_finite(i, e, 7 - e);
+        }
+        init[e] = true;
+    }
+
+    return tables[e];
+}
+
+// Convert a value to double. Returns false for infinities and NaNs.
+static inline bool smallfloat_decode(uint64_t bits, uint8_t e, uint8_t m, double &value)
+{
+    if (((bits >> m) & ((1 << e) - 1)) == (uint64_t)((1 << e) - 1))
+    {
+        return false;
+    }
+
+    if (e + m == 7)
+    {
+        value = smallfloat_decode_table_8(e)[bits & 0xff];
+    }
+#if defined(__F16C__)
+    else if (e == 5 && m == 10)
+    {
+        value = _cvtsh_ss(bits & 0xffff);
+    }
+#endif
+    else if (e == 8 && m == 7)
+    {
+        uint32_t value_32 = (bits & 0xffff) << 16;
+        float value_f;
+        memcpy(&value_f, &value_32, sizeof(value_f));
+        value = value_f;
+    }
+    else
+    {
+        value = smallfloat_decode_finite(bits, e, m);
+    }
+
+    return true;
+}
+
+static inline int smallfloat_msb(uint64_t bits)
+{
+    return (int)((bits >> 52) & 0x7ff) - 1023;
+}
+
+static inline int smallfloat_lsb(uint64_t bits)
+{
+    return smallfloat_msb(bits) - 52 + __builtin_ctzll((bits & SMALLFLOAT_FRAC_MASK) | (1ULL << 52));
+}
+
+// Return true if the sum of 2 doubles, which are zero or normal, is exact
+static inline bool smallfloat_exact_sum(double a, double b)
+{
+    if (a == 0 || b == 0)
+    {
+        return true;
+    }
+
+    uint64_t a_bits = smallfloat_u64(a);
+    uint64_t b_bits = smallfloat_u64(b);
+    int msb = std::max(smallfloat_msb(a_bits), smallfloat_msb(b_bits));
+    int lsb = std::min(smallfloat_lsb(a_bits), smallfloat_lsb(b_bits));
+
+    // The sum may need one more bit than the biggest operand
+    return msb + 2 - lsb <= 53;
+}
+
+// Round an exact non-zero double to the format the way flexfloat_sanitize does. Only
+// succeeds if the value is normal in the format before and after rounding, in which case
+// inexact is the only possible flag.
+static inline bool smallfloat_encode(Iss *iss, double value, uint8_t e, uint8_t m, int mode,
+    unsigned long int &result)
+{
+    uint64_t bits = smallfloat_u64(value);
+    uint64_t sign = bits >> 63;
+    int bias = (1 << (e - 1)) - 1;
+    int inf_exp = (1 << e) - 1;
+    int exp = smallfloat_msb(bits) + bias;
+
+    if (exp <= 0 || exp >= inf_exp)
+    {
+        return false;
+    }
+
+    int shift = 52 - m;
+    uint64_t frac_52 = bits & SMALLFLOAT_FRAC_MASK;
+    uint64_t frac = frac_52 >> shift;
+    bool round_bit = (frac_52 >> (shift - 1)) & 1;
+    bool sticky_bit = (frac_52 & ((1ULL << (shift - 1)) - 1)) != 0;
+    bool inc;
+
+    switch (mode)
+    {
+        case 0:  inc = round_bit && (sticky_bit || (frac & 1)); break;
+        case 2:  inc = (round_bit || sticky_bit) && sign; break;
+        case 3:  inc = (round_bit || sticky_bit) && !sign; break;
+        default: inc = false; break;
+    }
+
+    if (inc)
+    {
+        frac++;
+        if (frac >> m)
+        {
+            frac = 0;
+            exp++;
+            if (exp >= inf_exp)
+            {
+                return false;
+            }
+        }
+    }
+
+    if (round_bit || sticky_bit)
+    {
+        iss->csr.fcsr.fflags |= 1;
+    }
+
+    result = smallfloat_sign_extend((sign << (e + m)) | ((uint64_t)exp << m) | frac, e, m);
+    return true;
+}
+
+template<smallfloat_op2_e op>
+static inline bool smallfloat_exec2_fast(Iss *iss, unsigned long int a, unsigned long int b,
+    uint8_t e, uint8_t m, int mode, unsigned long int &result)
+{
+    double x, y, value;
+
+    if (!smallfloat_decode(a, e, m, x) || !smallfloat_decode(b, e, m, y))
+    {
+        return false;
+    }
+
+    switch (op)
+    {
+        case SMALLFLOAT_SUB:
+            y = -y;
+            // fall through
+        case SMALLFLOAT_ADD:
+            if (!smallfloat_exact_sum(x, y))
+            {
+                return false;
+            }
+            value = x + y;
+            if (value == 0)
+            {
+                // Exact zero, the sign is the common one of 2 zeros, otherwise positive
+                // except when rounding down
+                bool sign = x == 0 && y == 0 && signbit(x) == signbit(y) ? signbit(x) : mode == 2;
+                result = smallfloat_sign_extend((uint64_t)sign << (e + m), e, m);
+                return true;
+            }
+            break;
+
+        case SMALLFLOAT_MUL:
+            // Products of small formats always fit a double
+            value = x * y;
+            if (value == 0)
+            {
+                result = smallfloat_sign_extend((uint64_t)signbit(value) << (e + m), e, m);
+                return true;
+            }
+            break;
+
+        default:
+            return false;
+    }
+
+    return smallfloat_encode(iss, value, e, m, mode, result);
+}
+
+// Memoization table of an operation on an 8-bit format. Entries hold the result in bits 0
+// to 7, the flags in bits 8 to 12, and bit 15 is set once the entry is valid.
+inline uint16_t *smallfloat_table_8(smallfloat_op2_e op, uint8_t e, int mode)
+{
+    static std::vector<uint16_t> tables[SMALLFLOAT_NB_OP2][8][4];
+
+    std::vector<uint16_t> &table = tables[op][e][mode];
+    if (table.size() == 0)
+    {
+        table.resize(1 << 16, 0);
+    }
+    return table.data();
+}
+
+static inline unsigned long int smallfloat_lookup2_8(Iss *iss, smallfloat_op2_e op,
+    unsigned long int a, unsigned long int b, uint8_t e, uint8_t m, int mode,
+    smallfloat_generic2_t generic)
+{
+    uint16_t *entry = &smallfloat_table_8(op, e, mode)[((a & 0xff) << 8) | (b & 0xff)];
+
+    if (unlikely(*entry == 0))
+    {
+        // Capture the flags raised by this operation alone
+        unsigned int fflags = iss->csr.fcsr.fflags;
+        iss->csr.fcsr.fflags = 0;
+        unsigned long int result = generic(iss, a & 0xff, b & 0xff, e, m, mode);
+        *entry = 0x8000 | (iss->csr.fcsr.fflags << 8) | (result & 0xff);
+        iss->csr.fcsr.fflags = fflags;
+    }
+
+    iss->csr.fcsr.fflags |= (*entry >> 8) & 0x1f;
+    return smallfloat_sign_extend(*entry & 0xff, e, m);
+}
+
+template<smallfloat_op2_e op>
+static inline unsigned long int smallfloat_exec2(Iss *iss, unsigned long int a,
+    unsigned long int b, uint8_t e, uint8_t m, unsigned long int round,
+    smallfloat_generic2_t generic)
+{
+    int mode = smallfloat_round_mode(iss, round);
+
+    if (mode >= 0 && smallfloat_is_small(e, m))
+    {
+        if (e + m == 7)
+        {
+            return smallfloat_lookup2_8(iss, op, a, b, e, m, mode, generic);
+        }
+
+        unsigned long int result;
+        if (likely(smallfloat_exec2_fast<op>(iss, a, b, e, m, mode, result)))
+        {
+            return result;
+        }
+    }
+
+    return generic(iss, a, b, e, m, round);
+}
+
+template<smallfloat_op3_e op>
+static inline bool smallfloat_exec3_fast(Iss *iss, unsigned long int a, unsigned long int b,
+    unsigned long int c, uint8_t e, uint8_t m, int mode, unsigned long int &result)
+{
+    double x, y, z;
+
+    if (!smallfloat_decode(a, e, m, x) || !smallfloat_decode(b, e, m, y) ||
+        !smallfloat_decode(c, e, m, z))
+    {
+        return false;
+    }
+
+    if (op == SMALLFLOAT_NMSUB)
+    {
+        x = -x;
+    }
+    else if (op == SMALLFLOAT_MSUB)
+    {
+        z = -z;
+    }
+
+    // The product is exact, only the sum may need rounding
+    double product = x * y;
+    if (!smallfloat_exact_sum(product, z))
+    {
+        return false;
+    }
+
+    double value = product + z;
+    if (value == 0)
+    {
+        return false;
+    }
+
+    if (op == SMALLFLOAT_NMADD)
+    {
+        value = -value;
+    }
+
+    return smallfloat_encode(iss, value, e, m, mode, result);
+}
+
+template<smallfloat_op3_e op>
+static inline unsigned long int smallfloat_exec3(Iss *iss, unsigned long int a,
+    unsigned long int b, unsigned long int c, uint8_t e, uint8_t m, unsigned long int round,
+    smallfloat_generic3_t generic)
+{
+    int mode = smallfloat_round_mode(iss, round);
+
+    if (mode >= 0 && smallfloat_is_small(e, m))
+    {
+        unsigned long int result;
+        if (likely(smallfloat_exec3_fast<op>(iss, a, b, c, e, m, mode, result)))
+        {
+            return result;
+        }
+    }
+
+    return generic(iss, a, b, c, e, m, round);
+}
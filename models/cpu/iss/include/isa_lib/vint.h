@@ -26,6 +26,7 @@
 
 #include "cpu/iss/flexfloat/flexfloat.h"
 #include "int.h"
+#include "vint_engine.hpp"
 #include <stdint.h>
 #include <math.h>
 #include <fenv.h>
@@ -587,2786 +588,99 @@ INLINE void ff_sgnj(flexfloat_t *dest, const flexfloat_t *a,const flexfloat_t *b
 
 
 
-static inline void lib_ADDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-        res = data1+data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_ADDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1+data2;
-
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_ADDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data1+data2;
-
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_SUBVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data2 - data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_SUBVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data2 - data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_RSUBVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ 
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data1 - data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_RSUBVI   (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data1 - data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_ANDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data1 & data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_ANDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ 
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 & data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_ANDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){  
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 & data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_ORVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data1 | data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_ORVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 | data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_ORVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 | data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_XORVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data1 ^ data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_XORVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 ^ data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_XORVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = sim;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data1 ^ data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MINVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = (data1 > data2)?data2:data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MINVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = (data1 > data2)?data2:data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MINUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbsU(iss, SEW, vs1, i, &data1);
-        myAbsU(iss, SEW, vs2, i, &data2);
-
-        res = (data1 > data2)?data2:data1;
-
-        intToBinU(SEW, res, resBin);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MINUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbsU(iss, SEW, vs2, i, &data2);
-        
-        res = (data1 > data2)?data2:data1;
-        
-        intToBinU(SEW, res, resBin);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MAXVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = (data1 > data2)?data1:data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MAXVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = (data1 > data2)?data1:data2;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MAXUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbsU(iss, SEW, vs1, i, &data1);
-        myAbsU(iss, SEW, vs2, i, &data2);
-
-        res = (data1 > data2)?data1:data2;
-
-        intToBinU(SEW, res, resBin);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MAXUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbsU(iss, SEW, vs2, i, &data2);
-        
-        res = (data1 > data2)?data1:data2;
-        
-        intToBinU(SEW, res, resBin);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MULVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MULVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MULHVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-
-    intToBin(64, rs1, data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MULHSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, rs1, data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn == 1){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
-        }
-    }
-}
-
-static inline void lib_MVVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, res;
-    bool bin[8];
-    bool resBin[64];
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        myAbs(iss, SEW, vs1, i, &data1);
-        
-        res = data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MVVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t res;
-    bool bin[8];
-    bool resBin[64];
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        res = rs1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MVVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
-    int64_t res;
-    bool bin[8];
-    bool resBin[64];
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        
-        res = sim;
-        intToBin(SEW, abs(res), resBin);
-        if(sim < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MVSX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t res;
-    bool resBin[64];
-    res = rs1;
-    if(VSTART < VL){
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(vm){
-            writeToVReg(iss, SEW, vd, 0, resBin);
-        }else{
-            printf("MVSX VM=0 is RESERVED\n");
-        }
-    }
-}
-
-static inline iss_reg_t lib_MVXS     (Iss *iss, int vs2, bool vm){
-
-    int64_t data1;
-
-    myAbs(iss, SEW, vs2, 0, &data1);
-
-    return iss_reg_t(data1);
-}
-
-static inline void lib_WMULVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-
-    intToBin(64, rs1, data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn){
-            twosComplement(SEW*2,resBin);
-            sgn = 0;
-        }
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMULSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128];
-    bool sgn = 0;
-
-    intToBin(64, rs1, data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
-
-        if(sgn == 1){
-            twosComplement(SEW*2,resBin);
-        }
-        sgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MACCVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW, vd , i, data3);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(sgn){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MACCVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW, vd , i, data3);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;
-        }
-
-        extend2x(SEW, data3, data3Ext, true);
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MADDVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vd , i, data2);
-        buildDataBin(iss, SEW, vs2, i, data3);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(sgn){
-            twosComplement(SEW*2,mulOutBin);
-            sgn = 0;
-        }
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_MADDVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vd , i, data2);
-        buildDataBin(iss, SEW, vs2 , i, data3);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-
-        extend2x(SEW, data3, data3Ext, true);
-
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_NMSACVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW, vd , i, data3);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(!sgn){//compare with VMACC
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_NMSACVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW, vd , i, data3);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(!((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1))){//compare with VMACC
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_NMSUBVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs1, i, data1);
-        buildDataBin(iss, SEW, vd , i, data2);
-        buildDataBin(iss, SEW, vs2, i, data3);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(!sgn){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_NMSUBVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64], data3[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vd , i, data2);
-        buildDataBin(iss, SEW, vs2 , i, data3);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3[SEW-1]){
-            twosComplement(SEW,data3);
-            vdSgn = !vdSgn;            
-        }
-
-        extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if(!((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1))){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW  , vs1, i, data1);
-        buildDataBin(iss, SEW  , vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;            
-        }
-        // extend2x(SEW, data3, data3Ext, true);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(sgn){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;
-        }
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        buildDataBin(iss, SEW  , vs1, i, data1);
-        buildDataBin(iss, SEW  , vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCUSVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        if(data2[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data2);
-        }
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;
-        }
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if(sgn == 1){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCSUVV(Iss *iss, int vs1, int vs2    , int vd, bool vm){
-/*
-        1H 1L
-        2H 2L
-    -------------
-    0   0   M0H M0L
-    0   M1H M1L 0   
-    0   M2H M2L 0   
-    M3H M3L 0   0
-*/
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW  , vs1, i, data1);
-        buildDataBin(iss, SEW  , vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-
-        if(data1[SEW-1]){
-            sgn = !sgn;
-            twosComplement(SEW,data1);
-        }
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;            
-        }
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-        if(sgn){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_WMACCSUVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    bool data1[64], data2[64];
-    bool data1H[32], data1L[32], data2H[32], data2L[32];
-    bool M0[64], M1[64], M2[64], M3[64];
-    bool bin[8];
-    bool resBin[128], mulOutBin[128], data3Ext[128];
-    bool sgn = 0;
-    bool vdSgn = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        buildDataBin(iss, SEW, vs2, i, data2);
-        buildDataBin(iss, SEW*2, vd , i, data3Ext);
-        if(data3Ext[SEW*2-1]){
-            twosComplement(SEW*2,data3Ext);
-            vdSgn = !vdSgn;
-        }
-        for(int j = 0;j < SEW/2;j++){
-            data1L[j] = data1[j];
-            data2L[j] = data2[j];
-            data1H[j] = data1[j+SEW/2];
-            data2H[j] = data2[j+SEW/2];
-        }
-
-        binMul(SEW/2,data1L,data2L,M0);
-        binMul(SEW/2,data1L,data2H,M1);
-        binMul(SEW/2,data1H,data2L,M2);
-        binMul(SEW/2,data1H,data2H,M3);
-        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
-
-        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
-            twosComplement(SEW*2,mulOutBin);
-        }
-        sgn = 0;
-        if(!vdSgn){
-            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
-        }else{
-            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
-        }
-        vdSgn = 0;
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW*2, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_REDSUMVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res += data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_REDANDVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res &= data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_REDORVS  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res |= data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_REDXORVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;    
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res ^= data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_REDMINVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res = (res < data2)?res:data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_REDMINUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbsU(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbsU(iss, SEW, vs2, i, &data2);
-            res = (res < data2)?res:data2;
-        }
-    }
-    intToBinU(SEW, res, resBin);
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_REDMAXVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbs(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbs(iss, SEW, vs2, i, &data2);
-            res = (res > data2)?res:data2;
-        }
-    }
-    intToBin(SEW, abs(res), resBin);
-    if(res < 0){
-        twosComplement(SEW, resBin);
-    }
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_REDMAXUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    myAbsU(iss, SEW, vs1, 0, &data1);
-    res = data1;
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            myAbsU(iss, SEW, vs2, i, &data2);
-            res = (res > data2)?res:data2;
-        }
-    }
-    intToBinU(SEW, res, resBin);
-    writeToVReg(iss, SEW, vd, 0, resBin);    
-}
-
-static inline void lib_SLIDEUPVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    int64_t OFFSET;
-    bool bin[8];
-   
-    OFFSET = rs1;
-    int s = MAX(VSTART,OFFSET); 
-
-    for (int i = s; i < VL; i++){
-        intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-
-        if(!mask(vm,bin)){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-OFFSET)*t+j];
-            }
-        }
-    }
-}
-
-static inline void lib_SLIDEUPVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    int64_t OFFSET;
-    bool bin[8];
-    OFFSET = sim;
-    int s = MAX(VSTART,OFFSET); 
-
-    for (int i = s; i < VL; i++){
-        intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        if(!mask(vm,bin)){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-OFFSET)*t+j];
-            }
-        }
-    }
-}
-
-static inline void lib_SLIDEDWVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    int64_t OFFSET;
-    bool bin[8];
-    OFFSET = rs1;
-    int s = MAX(VSTART,OFFSET); 
-
-    for (int i = VSTART; i < VL; i++){
-        if(i+OFFSET >= VLMAX){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = 0;
-            }            
-        }else{
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-
-            if(!mask(vm,bin)){
-                for(int j = 0; j <  t ; j++){
-                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+OFFSET)*t+j];
-                }
-            }
-        }
-    }
-}
-
-static inline void lib_SLIDEDWVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    int64_t OFFSET;
-    bool bin[8];
-    OFFSET = sim;
-
-    int s = MAX(VSTART,OFFSET); 
-
-    for (int i = VSTART; i < VL; i++){
-        if(i+OFFSET >= VLMAX){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = 0;
-            }            
-        }else{
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-            
-            if(!mask(vm,bin)){
-                for(int j = 0; j <  t ; j++){
-                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+OFFSET)*t+j];
-                }
-            }
-        }
-    }
-}
-
-static inline void lib_SLIDE1UVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    bool bin[8];
-    bool data1[64];
-   
-    int s = MAX(VSTART,1); 
-    intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][0],bin);
-
-    int i = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-    if(rs1 < 0){
-        twosComplement(64,data1);
-    }
-    if(VSTART == 0){
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, 0, data1);
-        }
-    }
-    for (int i = s; i < VL; i++){
-        if(!((i-s)%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i-s)/8],bin);
-        }
-        
-        if(!mask(vm,bin)){
-            for(int j = 0; j <  t ; j++){
-                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-1)*t+j];
-            }
-        }
-    }
-}
-
-static inline void lib_SLIDE1DVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
-    int t = SEW/8;
-    bool bin[8];
-    bool data1[64];
-    
-    intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][0],bin);
-
-    int i = 0;
-    intToBin(64, abs((int64_t)rs1), data1);
-    if(rs1 < 0){
-        twosComplement(64,data1);
-    }
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        if(!mask(vm,bin)){
-            if(i == VL-1){
-                writeToVReg(iss, SEW, vd, VL-1, data1);   
-            }else{
-                for(int j = 0; j <  t ; j++){
-                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+1)*t+j];
-                }
-            }
-        }
-    }
-}
-
-static inline void lib_DIVVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data2/data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_DIVVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data2/data1;
-
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_DIVUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbsU(iss, SEW, vs1, i, &data1);
-        myAbsU(iss, SEW, vs2, i, &data2);
-
-        res = data2/data1;
-
-        intToBin(SEW, res, resBin);
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_DIVUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    uint64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbsU(iss, SEW, vs2, i, &data2);
-        
-        res = data2/data1;
-
-
-        intToBin(SEW, res, resBin);
-
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_REMVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs1, i, &data1);
-        myAbs(iss, SEW, vs2, i, &data2);
-
-        res = data2%data1;
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_REMVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    int64_t data1, data2, res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbs(iss, SEW, vs2, i, &data2);
-        
-        res = data2%data1;
-
-
-        intToBin(SEW, abs(res), resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_REMUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
-    uint64_t data1, data2;
-    int64_t res;
-    bool bin[8];
-    bool resBin[64];
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbsU(iss, SEW, vs1, i, &data1);
-        myAbsU(iss, SEW, vs2, i, &data2);
-
-        res = data2%data1;
-        intToBin(SEW, res, resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
-
-static inline void lib_REMUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
-    uint64_t data1, data2;
-    int64_t res;
-    bool bin[8];
-    bool resBin[64];
-    
-    data1 = rs1;
-
-    for (int i = VSTART; i < VL; i++){
-        if(!(i%8)){
-            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
-        }
-
-        myAbsU(iss, SEW, vs2, i, &data2);
-        
-        res = data2%data1;
-
-
-        intToBin(SEW, res, resBin);
-        if(res < 0){
-            twosComplement(SEW, resBin);
-        }
-        if(!mask(vm,bin)){
-            writeToVReg(iss, SEW, vd, i, resBin);
-        }
-    }
-}
+// Integer instructions are executed by the word-level engine of vint_engine.hpp, which only
+// needs a snapshot of the vector unit state.
+static inline VintState vint_state(Iss *iss){
+    VintState state;
+    state.vregs     = &iss->spatz.vregfile.vregs[0][0];
+    state.vreg_size = NB_VEL;
+    state.sew       = SEW;
+    state.vstart    = VSTART;
+    state.vl        = VL;
+    state.vlmax     = VLMAX;
+    return state;
+}
+
+static inline void lib_ADDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_ADDVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_ADDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_ADDVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_ADDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){ vint_ADDVX(vint_state(iss), vs2, sim, vd, vm); }
+static inline void lib_SUBVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_SUBVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_SUBVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_SUBVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_RSUBVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_RSUBVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_RSUBVI   (Iss *iss, int vs2, int64_t sim, int vd, bool vm){ vint_RSUBVX(vint_state(iss), vs2, sim, vd, vm); }
+static inline void lib_ANDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_ANDVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_ANDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_ANDVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_ANDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){ vint_ANDVX(vint_state(iss), vs2, sim, vd, vm); }
+static inline void lib_ORVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_ORVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_ORVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_ORVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_ORVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){ vint_ORVX(vint_state(iss), vs2, sim, vd, vm); }
+static inline void lib_XORVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_XORVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_XORVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_XORVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_XORVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){ vint_XORVX(vint_state(iss), vs2, sim, vd, vm); }
+static inline void lib_MINVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MINVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MINVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MINVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MINUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MINUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MINUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MINUVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MAXVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MAXVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MAXVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MAXVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MAXUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MAXUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MAXUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MAXUVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MULVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MULVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MULVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MULVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MULHVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MULHVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MULHVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MULHVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MULHUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MULHUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MULHUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MULHUVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MULHSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MULHSUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MULHSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MULHSUVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MVVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MVVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MVVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MVVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MVVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){ vint_MVVX(vint_state(iss), vs2, sim, vd, vm); }
+static inline void lib_MVSX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MVSX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline iss_reg_t lib_MVXS     (Iss *iss, int vs2, bool vm){ return iss_reg_t(vint_MVXS(vint_state(iss), vs2, vm)); }
+static inline void lib_WMULVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_WMULVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_WMULVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_WMULVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_WMULUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_WMULUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_WMULUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_WMULUVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_WMULSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_WMULSUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_WMULSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_WMULSUVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MACCVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MACCVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MACCVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MACCVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_MADDVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_MADDVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_MADDVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_MADDVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_NMSACVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_NMSACVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_NMSACVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_NMSACVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_NMSUBVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_NMSUBVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_NMSUBVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_NMSUBVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_WMACCVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_WMACCVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_WMACCVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_WMACCVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_WMACCUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_WMACCUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_WMACCUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_WMACCUVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_WMACCUSVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_WMACCUSVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_WMACCSUVV(Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_WMACCSUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_WMACCSUVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_WMACCSUVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_REDSUMVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REDSUMVS(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_REDANDVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REDANDVS(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_REDORVS  (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REDORVS(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_REDXORVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REDXORVS(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_REDMINVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REDMINVS(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_REDMINUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REDMINUVS(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_REDMAXVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REDMAXVS(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_REDMAXUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REDMAXUVS(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_SLIDEUPVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_SLIDEUPVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_SLIDEUPVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){ vint_SLIDEUPVX(vint_state(iss), vs2, sim, vd, vm); }
+static inline void lib_SLIDEDWVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_SLIDEDWVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_SLIDEDWVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){ vint_SLIDEDWVX(vint_state(iss), vs2, sim, vd, vm); }
+static inline void lib_SLIDE1UVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_SLIDE1UVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_SLIDE1DVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_SLIDE1DVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_DIVVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_DIVVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_DIVVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_DIVVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_DIVUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_DIVUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_DIVUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_DIVUVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_REMVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REMVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_REMVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_REMVX(vint_state(iss), vs2, rs1, vd, vm); }
+static inline void lib_REMUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){ vint_REMUVV(vint_state(iss), vs1, vs2, vd, vm); }
+static inline void lib_REMUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ vint_REMUVX(vint_state(iss), vs2, rs1, vd, vm); }
 
 static inline void lib_FADDVV   (Iss *iss, int vs1,     int vs2, int vd, bool vm){
     bool bin[8];
@@ -0,0 +1,541 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VINT_ENGINE_HPP
+#define VINT_ENGINE_HPP
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Word-level engine for the RVV integer instructions.
+ *
+ * Elements are read and written as native int8..int64 lanes of the vector register file,
+ * and the mask register is consumed one byte (8 elements) at a time. Each instruction is
+ * instantiated once per SEW so that the unmasked loops can be auto-vectorized by the host
+ * compiler.
+ *
+ * Scalar operands follow the semantics of the former bit-serial library so that results
+ * stay bit-exact:
+ *  - add, sub, logic and low-half multiplies only depend on the low SEW bits of the scalar.
+ *  - min, max, div and rem compare or divide with the full 64-bit scalar.
+ *  - high-half and widening multiplies use the low SEW bits of the scalar magnitude, and
+ *    its sign for the signed variants.
+ *
+ * This header does not depend on the ISS so that it can be exercised on the host by
+ * tests/cpu/iss/vint.
+ */
+
+// State of the vector unit needed to execute one instruction
+struct VintState
+{
+    uint8_t *vregs;     // Register file, registers are contiguous so that LMUL groups can be
+                        // accessed as a single array
+    int vreg_size;      // Size in bytes of one vector register
+    int sew;            // Element width in bits
+    int vstart;
+    int vl;
+    int vlmax;
+};
+
+template<int SEW> struct VintSew;
+
+// For each SEW, S and U are the element types, WS and WU the 2*SEW types used by widening
+// instructions and P a type able to hold the full 2*SEW product modulo its own width.
+template<> struct VintSew<8>
+{
+    static const int bits = 8;
+    typedef int8_t S;
+    typedef uint8_t U;
+    typedef int16_t WS;
+    typedef uint16_t WU;
+    typedef uint64_t P;
+};
+
+template<> struct VintSew<16>
+{
+    static const int bits = 16;
+    typedef int16_t S;
+    typedef uint16_t U;
+    typedef int32_t WS;
+    typedef uint32_t WU;
+    typedef uint64_t P;
+};
+
+template<> struct VintSew<32>
+{
+    static const int bits = 32;
+    typedef int32_t S;
+    typedef uint32_t U;
+    typedef int64_t WS;
+    typedef uint64_t WU;
+    typedef uint64_t P;
+};
+
+template<> struct VintSew<64>
+{
+    static const int bits = 64;
+    typedef int64_t S;
+    typedef uint64_t U;
+    typedef __int128 WS;
+    typedef unsigned __int128 WU;
+    typedef unsigned __int128 P;
+};
+
+// Instantiates the statement for the current SEW, with V bound to the matching VintSew
+#define VINT_SEW_DISPATCH(sew, ...)                                       \
+    switch (sew)                                                          \
+    {                                                                     \
+        case 8:  { typedef VintSew<8>  V; __VA_ARGS__; break; }           \
+        case 16: { typedef VintSew<16> V; __VA_ARGS__; break; }           \
+        case 32: { typedef VintSew<32> V; __VA_ARGS__; break; }           \
+        case 64: { typedef VintSew<64> V; __VA_ARGS__; break; }           \
+        default: printf("This SEW(%d) is not supported\n", sew); break;   \
+    }
+
+
+static inline uint8_t *vint_reg(const VintState &s, int reg)
+{
+    return s.vregs + reg * s.vreg_size;
+}
+
+template<typename T>
+static inline T vint_get(const uint8_t *reg, int index)
+{
+    T value;
+    memcpy(&value, reg + (size_t)index * sizeof(T), sizeof(T));
+    return value;
+}
+
+template<typename T>
+static inline void vint_set(uint8_t *reg, int index, T value)
+{
+    memcpy(reg + (size_t)index * sizeof(T), &value, sizeof(T));
+}
+
+static inline bool vint_active(const uint8_t *v0, int index, bool vm)
+{
+    return vm || ((v0[index >> 3] >> (index & 7)) & 1);
+}
+
+// Calls body(i) for every active element of [start, end), in increasing order.
+// Masks are handled one byte at a time, fully enabled bytes go through the same straight
+// loop as unmasked instructions and fully disabled bytes are skipped.
+template<typename F>
+static inline void vint_foreach(const uint8_t *v0, int start, int end, bool vm, F body)
+{
+    if (vm)
+    {
+        for (int i = start; i < end; i++)
+        {
+            body(i);
+        }
+        return;
+    }
+
+    int i = start;
+    while (i < end)
+    {
+        int base = i & ~7;
+        int group_end = base + 8 < end ? base + 8 : end;
+        unsigned int mask = v0[i >> 3] & (0xffu << (i & 7)) & (0xffu >> (base + 8 - group_end));
+
+        if (mask == 0xff)
+        {
+            for (int j = base; j < base + 8; j++)
+            {
+                body(j);
+            }
+        }
+        else
+        {
+            while (mask)
+            {
+                body(base + __builtin_ctz(mask));
+                mask &= mask - 1;
+            }
+        }
+
+        i = group_end;
+    }
+}
+
+
+// Low SEW bits of the magnitude of a scalar operand
+template<typename V>
+static inline typename V::U vint_scalar_abs(int64_t x)
+{
+    return (typename V::U)(x < 0 ? 0 - (uint64_t)x : (uint64_t)x);
+}
+
+// Low SEW bits of the magnitude of a scalar operand, carrying the sign of the scalar
+template<typename V>
+static inline typename V::WS vint_scalar_signed(int64_t x)
+{
+    typename V::WS mag = vint_scalar_abs<V>(x);
+    return x < 0 ? (typename V::WS)-mag : mag;
+}
+
+// Exact 2*SEW bits product of two operands already extended to 2*SEW
+template<typename V>
+static inline typename V::P vint_mul_wide(typename V::WS a, typename V::WS b)
+{
+    return (typename V::P)a * (typename V::P)b;
+}
+
+
+/*
+ * Element operations. a is the vs2 element, b the vs1 element or the scalar, d the vd
+ * element. Arithmetic goes through uint64_t so that it wraps instead of overflowing.
+ */
+
+struct VintOpAdd  { template<typename T> T operator()(T a, T b) const { return (T)((uint64_t)a + (uint64_t)b); } };
+struct VintOpSub  { template<typename T> T operator()(T a, T b) const { return (T)((uint64_t)a - (uint64_t)b); } };
+struct VintOpRsub { template<typename T> T operator()(T a, T b) const { return (T)((uint64_t)b - (uint64_t)a); } };
+struct VintOpAnd  { template<typename T> T operator()(T a, T b) const { return a & b; } };
+struct VintOpOr   { template<typename T> T operator()(T a, T b) const { return a | b; } };
+struct VintOpXor  { template<typename T> T operator()(T a, T b) const { return a ^ b; } };
+struct VintOpMin  { template<typename T> T operator()(T a, T b) const { return a < b ? a : b; } };
+struct VintOpMax  { template<typename T> T operator()(T a, T b) const { return a > b ? a : b; } };
+struct VintOpMul  { template<typename T> T operator()(T a, T b) const { return (T)((uint64_t)a * (uint64_t)b); } };
+struct VintOpMv   { template<typename T> T operator()(T /* a */, T b) const { return b; } };
+
+// Division by zero and signed overflow follow the RISC-V rules
+struct VintOpDiv
+{
+    template<typename T> T operator()(T a, T b) const
+    {
+        if (b == 0) return (T)-1;
+        if ((T)-1 < 0 && b == (T)-1) return (T)(0 - (uint64_t)a);
+        return a / b;
+    }
+};
+
+struct VintOpRem
+{
+    template<typename T> T operator()(T a, T b) const
+    {
+        if (b == 0) return a;
+        if ((T)-1 < 0 && b == (T)-1) return 0;
+        return a % b;
+    }
+};
+
+// Multiply-add family, b is vs1 or the scalar
+struct VintOpMacc  { template<typename T> T operator()(T d, T b, T a) const { return (T)((uint64_t)d + (uint64_t)b * (uint64_t)a); } };
+struct VintOpMadd  { template<typename T> T operator()(T d, T b, T a) const { return (T)((uint64_t)b * (uint64_t)d + (uint64_t)a); } };
+struct VintOpNmsac { template<typename T> T operator()(T d, T b, T a) const { return (T)((uint64_t)d - (uint64_t)b * (uint64_t)a); } };
+struct VintOpNmsub { template<typename T> T operator()(T d, T b, T a) const { return (T)((uint64_t)a - (uint64_t)b * (uint64_t)d); } };
+
+// Destinations of the 2*SEW product computed by the high-half and widening multiplies
+template<typename V>
+struct VintStoreHigh
+{
+    void operator()(uint8_t *vd, int i, typename V::P p) const
+    {
+        vint_set<typename V::U>(vd, i, (typename V::U)(p >> V::bits));
+    }
+};
+
+template<typename V>
+struct VintStoreWide
+{
+    void operator()(uint8_t *vd, int i, typename V::P p) const
+    {
+        vint_set<typename V::WU>(vd, i, (typename V::WU)p);
+    }
+};
+
+template<typename V>
+struct VintStoreWideAcc
+{
+    void operator()(uint8_t *vd, int i, typename V::P p) const
+    {
+        vint_set<typename V::WU>(vd, i, (typename V::WU)(vint_get<typename V::WU>(vd, i) + (typename V::WU)p));
+    }
+};
+
+
+/*
+ * Kernels
+ */
+
+// vd[i] = op(vs2[i], vs1[i])
+template<typename T, typename Op>
+static inline void vint_vv(const VintState &s, int vs1, int vs2, int vd, bool vm, Op op)
+{
+    const uint8_t *b = vint_reg(s, vs1);
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+
+    vint_foreach(vint_reg(s, 0), s.vstart, s.vl, vm, [&](int i) {
+        vint_set<T>(d, i, op(vint_get<T>(a, i), vint_get<T>(b, i)));
+    });
+}
+
+// vd[i] = op(vs2[i], x), the element is extended to the type of the scalar before the
+// operation and truncated back to SEW afterwards
+template<typename T, typename C, typename Op>
+static inline void vint_vx(const VintState &s, C x, int vs2, int vd, bool vm, Op op)
+{
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+
+    vint_foreach(vint_reg(s, 0), s.vstart, s.vl, vm, [&](int i) {
+        vint_set<T>(d, i, (T)op((C)vint_get<T>(a, i), x));
+    });
+}
+
+// vd[i] = op(vd[i], vs1[i], vs2[i])
+template<typename T, typename Op>
+static inline void vint_vvv(const VintState &s, int vs1, int vs2, int vd, bool vm, Op op)
+{
+    const uint8_t *b = vint_reg(s, vs1);
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+
+    vint_foreach(vint_reg(s, 0), s.vstart, s.vl, vm, [&](int i) {
+        vint_set<T>(d, i, op(vint_get<T>(d, i), vint_get<T>(b, i), vint_get<T>(a, i)));
+    });
+}
+
+// vd[i] = op(vd[i], x, vs2[i])
+template<typename T, typename Op>
+static inline void vint_vxv(const VintState &s, T x, int vs2, int vd, bool vm, Op op)
+{
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+
+    vint_foreach(vint_reg(s, 0), s.vstart, s.vl, vm, [&](int i) {
+        vint_set<T>(d, i, op(vint_get<T>(d, i), x, vint_get<T>(a, i)));
+    });
+}
+
+// store(vd, i, vs2[i] * vs1[i]) with vs2 elements read as TA and vs1 elements as TB
+template<typename V, typename TA, typename TB, typename Store>
+static inline void vint_mul_vv(const VintState &s, int vs1, int vs2, int vd, bool vm, Store store)
+{
+    const uint8_t *b = vint_reg(s, vs1);
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+
+    vint_foreach(vint_reg(s, 0), s.vstart, s.vl, vm, [&](int i) {
+        store(d, i, vint_mul_wide<V>(vint_get<TA>(a, i), vint_get<TB>(b, i)));
+    });
+}
+
+// store(vd, i, vs2[i] * x) with vs2 elements read as TA
+template<typename V, typename TA, typename Store>
+static inline void vint_mul_vx(const VintState &s, typename V::WS x, int vs2, int vd, bool vm, Store store)
+{
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+
+    vint_foreach(vint_reg(s, 0), s.vstart, s.vl, vm, [&](int i) {
+        store(d, i, vint_mul_wide<V>(vint_get<TA>(a, i), x));
+    });
+}
+
+// vd[0] = op(...op(op(vs1[0], vs2[i0]), vs2[i1])..., vs2[in]) over the active elements
+template<typename T, typename Op>
+static inline void vint_red(const VintState &s, int vs1, int vs2, int vd, bool vm, Op op)
+{
+    const uint8_t *a = vint_reg(s, vs2);
+    T acc = vint_get<T>(vint_reg(s, vs1), 0);
+
+    vint_foreach(vint_reg(s, 0), s.vstart, s.vl, vm, [&](int i) {
+        acc = op(acc, vint_get<T>(a, i));
+    });
+
+    vint_set<T>(vint_reg(s, vd), 0, acc);
+}
+
+template<typename T>
+static inline void vint_slideup(const VintState &s, int64_t offset, int vs2, int vd, bool vm)
+{
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+    int64_t start = offset > s.vstart ? offset : s.vstart;
+
+    if (start >= s.vl) return;
+
+    vint_foreach(vint_reg(s, 0), (int)start, s.vl, vm, [&](int i) {
+        vint_set<T>(d, i, vint_get<T>(a, (int)(i - offset)));
+    });
+}
+
+// Elements sourced from beyond VLMAX are zeroed whatever the mask
+template<typename T>
+static inline void vint_slidedown(const VintState &s, int64_t offset, int vs2, int vd, bool vm)
+{
+    const uint8_t *v0 = vint_reg(s, 0);
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+
+    for (int i = s.vstart; i < s.vl; i++)
+    {
+        if (i + offset >= s.vlmax)
+        {
+            vint_set<T>(d, i, 0);
+        }
+        else if (vint_active(v0, i, vm))
+        {
+            vint_set<T>(d, i, vint_get<T>(a, (int)(i + offset)));
+        }
+    }
+}
+
+template<typename T>
+static inline void vint_slide1up(const VintState &s, T x, int vs2, int vd, bool vm)
+{
+    const uint8_t *v0 = vint_reg(s, 0);
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+
+    if (s.vstart == 0 && vint_active(v0, 0, vm))
+    {
+        vint_set<T>(d, 0, x);
+    }
+
+    vint_foreach(v0, s.vstart > 1 ? s.vstart : 1, s.vl, vm, [&](int i) {
+        vint_set<T>(d, i, vint_get<T>(a, i - 1));
+    });
+}
+
+template<typename T>
+static inline void vint_slide1down(const VintState &s, T x, int vs2, int vd, bool vm)
+{
+    const uint8_t *a = vint_reg(s, vs2);
+    uint8_t *d = vint_reg(s, vd);
+    int last = s.vl - 1;
+
+    vint_foreach(vint_reg(s, 0), s.vstart, s.vl, vm, [&](int i) {
+        vint_set<T>(d, i, i == last ? x : vint_get<T>(a, i + 1));
+    });
+}
+
+
+/*
+ * Instructions, with the same operands as the lib_* entry points of vint.h
+ */
+
+static inline void vint_ADDVV   (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::S>(s, vs1, vs2, vd, vm, VintOpAdd())); }
+static inline void vint_ADDVX   (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (V::S)rs1, vs2, vd, vm, VintOpAdd())); }
+static inline void vint_SUBVV   (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::S>(s, vs1, vs2, vd, vm, VintOpSub())); }
+static inline void vint_SUBVX   (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (V::S)rs1, vs2, vd, vm, VintOpSub())); }
+static inline void vint_RSUBVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (V::S)rs1, vs2, vd, vm, VintOpRsub())); }
+static inline void vint_ANDVV   (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::S>(s, vs1, vs2, vd, vm, VintOpAnd())); }
+static inline void vint_ANDVX   (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (V::S)rs1, vs2, vd, vm, VintOpAnd())); }
+static inline void vint_ORVV    (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::S>(s, vs1, vs2, vd, vm, VintOpOr())); }
+static inline void vint_ORVX    (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (V::S)rs1, vs2, vd, vm, VintOpOr())); }
+static inline void vint_XORVV   (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::S>(s, vs1, vs2, vd, vm, VintOpXor())); }
+static inline void vint_XORVX   (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (V::S)rs1, vs2, vd, vm, VintOpXor())); }
+
+static inline void vint_MINVV   (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::S>(s, vs1, vs2, vd, vm, VintOpMin())); }
+static inline void vint_MINVX   (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (int64_t)rs1, vs2, vd, vm, VintOpMin())); }
+static inline void vint_MINUVV  (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::U>(s, vs1, vs2, vd, vm, VintOpMin())); }
+static inline void vint_MINUVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::U>(s, (uint64_t)rs1, vs2, vd, vm, VintOpMin())); }
+static inline void vint_MAXVV   (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::S>(s, vs1, vs2, vd, vm, VintOpMax())); }
+static inline void vint_MAXVX   (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (int64_t)rs1, vs2, vd, vm, VintOpMax())); }
+static inline void vint_MAXUVV  (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::U>(s, vs1, vs2, vd, vm, VintOpMax())); }
+static inline void vint_MAXUVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::U>(s, (uint64_t)rs1, vs2, vd, vm, VintOpMax())); }
+
+static inline void vint_MULVV   (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::U>(s, vs1, vs2, vd, vm, VintOpMul())); }
+static inline void vint_MULVX   (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::U>(s, (V::U)rs1, vs2, vd, vm, VintOpMul())); }
+static inline void vint_MULHVV  (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_mul_vv<V, V::S, V::S>(s, vs1, vs2, vd, vm, VintStoreHigh<V>())); }
+static inline void vint_MULHVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::S>(s, vint_scalar_signed<V>(rs1), vs2, vd, vm, VintStoreHigh<V>())); }
+static inline void vint_MULHUVV (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_mul_vv<V, V::U, V::U>(s, vs1, vs2, vd, vm, VintStoreHigh<V>())); }
+static inline void vint_MULHUVX (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::U>(s, vint_scalar_abs<V>(rs1), vs2, vd, vm, VintStoreHigh<V>())); }
+static inline void vint_MULHSUVV(const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_mul_vv<V, V::S, V::U>(s, vs1, vs2, vd, vm, VintStoreHigh<V>())); }
+static inline void vint_MULHSUVX(const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::S>(s, vint_scalar_abs<V>(rs1), vs2, vd, vm, VintStoreHigh<V>())); }
+
+static inline void vint_MVVV    (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::U>(s, vs1, vs2, vd, vm, VintOpMv())); }
+static inline void vint_MVVX    (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::U>(s, (V::U)rs1, vs2, vd, vm, VintOpMv())); }
+
+// vmv.s.x and vmv.x.s keep the operand layout of the other instructions but have no vs2,
+// respectively no mask, operand
+static inline void vint_MVSX    (const VintState &s, int /* vs2 */, int64_t rs1, int vd, bool vm)
+{
+    if (s.vstart < s.vl)
+    {
+        if (vm)
+        {
+            VINT_SEW_DISPATCH(s.sew, vint_set<V::U>(vint_reg(s, vd), 0, (V::U)rs1));
+        }
+        else
+        {
+            printf("MVSX VM=0 is RESERVED\n");
+        }
+    }
+}
+
+static inline int64_t vint_MVXS (const VintState &s, int vs2, bool /* vm */)
+{
+    int64_t result = 0;
+    VINT_SEW_DISPATCH(s.sew, result = vint_get<V::S>(vint_reg(s, vs2), 0));
+    return result;
+}
+
+static inline void vint_WMULVV  (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_mul_vv<V, V::S, V::S>(s, vs1, vs2, vd, vm, VintStoreWide<V>())); }
+static inline void vint_WMULVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::S>(s, vint_scalar_signed<V>(rs1), vs2, vd, vm, VintStoreWide<V>())); }
+static inline void vint_WMULUVV (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_mul_vv<V, V::U, V::U>(s, vs1, vs2, vd, vm, VintStoreWide<V>())); }
+static inline void vint_WMULUVX (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::U>(s, vint_scalar_abs<V>(rs1), vs2, vd, vm, VintStoreWide<V>())); }
+static inline void vint_WMULSUVV(const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_mul_vv<V, V::S, V::U>(s, vs1, vs2, vd, vm, VintStoreWide<V>())); }
+static inline void vint_WMULSUVX(const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::S>(s, vint_scalar_abs<V>(rs1), vs2, vd, vm, VintStoreWide<V>())); }
+
+static inline void vint_MACCVV  (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vvv<V::U>(s, vs1, vs2, vd, vm, VintOpMacc())); }
+static inline void vint_MACCVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vxv<V::U>(s, (V::U)rs1, vs2, vd, vm, VintOpMacc())); }
+static inline void vint_MADDVV  (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vvv<V::U>(s, vs1, vs2, vd, vm, VintOpMadd())); }
+static inline void vint_MADDVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vxv<V::U>(s, (V::U)rs1, vs2, vd, vm, VintOpMadd())); }
+static inline void vint_NMSACVV (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vvv<V::U>(s, vs1, vs2, vd, vm, VintOpNmsac())); }
+static inline void vint_NMSACVX (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vxv<V::U>(s, (V::U)rs1, vs2, vd, vm, VintOpNmsac())); }
+static inline void vint_NMSUBVV (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vvv<V::U>(s, vs1, vs2, vd, vm, VintOpNmsub())); }
+static inline void vint_NMSUBVX (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vxv<V::U>(s, (V::U)rs1, vs2, vd, vm, VintOpNmsub())); }
+
+static inline void vint_WMACCVV  (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_mul_vv<V, V::S, V::S>(s, vs1, vs2, vd, vm, VintStoreWideAcc<V>())); }
+static inline void vint_WMACCVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::S>(s, vint_scalar_signed<V>(rs1), vs2, vd, vm, VintStoreWideAcc<V>())); }
+static inline void vint_WMACCUVV (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_mul_vv<V, V::U, V::U>(s, vs1, vs2, vd, vm, VintStoreWideAcc<V>())); }
+static inline void vint_WMACCUVX (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::U>(s, vint_scalar_abs<V>(rs1), vs2, vd, vm, VintStoreWideAcc<V>())); }
+static inline void vint_WMACCUSVX(const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::S>(s, vint_scalar_abs<V>(rs1), vs2, vd, vm, VintStoreWideAcc<V>())); }
+static inline void vint_WMACCSUVV(const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_mul_vv<V, V::U, V::S>(s, vs1, vs2, vd, vm, VintStoreWideAcc<V>())); }
+static inline void vint_WMACCSUVX(const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_mul_vx<V, V::U>(s, vint_scalar_signed<V>(rs1), vs2, vd, vm, VintStoreWideAcc<V>())); }
+
+static inline void vint_REDSUMVS (const VintState &s, int vs1, int vs2, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_red<V::S>(s, vs1, vs2, vd, vm, VintOpAdd())); }
+static inline void vint_REDANDVS (const VintState &s, int vs1, int vs2, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_red<V::S>(s, vs1, vs2, vd, vm, VintOpAnd())); }
+static inline void vint_REDORVS  (const VintState &s, int vs1, int vs2, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_red<V::S>(s, vs1, vs2, vd, vm, VintOpOr())); }
+static inline void vint_REDXORVS (const VintState &s, int vs1, int vs2, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_red<V::S>(s, vs1, vs2, vd, vm, VintOpXor())); }
+static inline void vint_REDMINVS (const VintState &s, int vs1, int vs2, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_red<V::S>(s, vs1, vs2, vd, vm, VintOpMin())); }
+static inline void vint_REDMINUVS(const VintState &s, int vs1, int vs2, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_red<V::U>(s, vs1, vs2, vd, vm, VintOpMin())); }
+static inline void vint_REDMAXVS (const VintState &s, int vs1, int vs2, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_red<V::S>(s, vs1, vs2, vd, vm, VintOpMax())); }
+static inline void vint_REDMAXUVS(const VintState &s, int vs1, int vs2, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_red<V::U>(s, vs1, vs2, vd, vm, VintOpMax())); }
+
+static inline void vint_SLIDEUPVX(const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_slideup<V::U>(s, rs1, vs2, vd, vm)); }
+static inline void vint_SLIDEDWVX(const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_slidedown<V::U>(s, rs1, vs2, vd, vm)); }
+static inline void vint_SLIDE1UVX(const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_slide1up<V::U>(s, (V::U)rs1, vs2, vd, vm)); }
+static inline void vint_SLIDE1DVX(const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_slide1down<V::U>(s, (V::U)rs1, vs2, vd, vm)); }
+
+static inline void vint_DIVVV   (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::S>(s, vs1, vs2, vd, vm, VintOpDiv())); }
+static inline void vint_DIVVX   (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (int64_t)rs1, vs2, vd, vm, VintOpDiv())); }
+static inline void vint_DIVUVV  (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::U>(s, vs1, vs2, vd, vm, VintOpDiv())); }
+static inline void vint_DIVUVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::U>(s, (uint64_t)rs1, vs2, vd, vm, VintOpDiv())); }
+static inline void vint_REMVV   (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::S>(s, vs1, vs2, vd, vm, VintOpRem())); }
+static inline void vint_REMVX   (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::S>(s, (int64_t)rs1, vs2, vd, vm, VintOpRem())); }
+static inline void vint_REMUVV  (const VintState &s, int vs1, int vs2, int vd, bool vm)     { VINT_SEW_DISPATCH(s.sew, vint_vv<V::U>(s, vs1, vs2, vd, vm, VintOpRem())); }
+static inline void vint_REMUVX  (const VintState &s, int vs2, int64_t rs1, int vd, bool vm) { VINT_SEW_DISPATCH(s.sew, vint_vx<V::U>(s, (uint64_t)rs1, vs2, vd, vm, VintOpRem())); }
+
+#endif
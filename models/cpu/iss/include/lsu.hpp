@@ -23,6 +23,9 @@
 
 #include <cpu/iss/include/types.hpp>
 #include <vp/signal.hpp>
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+#include <utils/dmi.hpp>
+#endif
 
 #ifndef CONFIG_GVSOC_ISS_SNITCH
 #define ADDR_MASK (~(ISS_REG_WIDTH / 8 - 1))
@@ -35,6 +38,41 @@
 
 class IssWrapper;
 
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+
+// Number of address ranges remembered by the LSU, either directly accessible or not
+#define CONFIG_GVSOC_ISS_LSU_DMI_NB_ENTRIES 4
+// Size of the range remembered as not directly accessible when DMI is refused
+#define CONFIG_GVSOC_ISS_LSU_DMI_HOLE_SIZE 0x1000
+
+struct LsuDmiEntry
+{
+    uint64_t base;
+    uint64_t end;
+    // NULL if the range can not be directly accessed and must go through the data port
+    uint8_t *host;
+    bool writable;
+};
+
+// Table of the direct memory interface grants obtained through the data port
+class LsuDmi : public DmiListener
+{
+public:
+    void start(vp::MasterPort *port);
+    // Return the host pointer for the access or NULL if it must go through the data port
+    inline uint8_t *get(iss_addr_t addr, int size, bool is_write);
+    void dmi_invalidate() override;
+
+private:
+    uint8_t *miss(iss_addr_t addr, int size, bool is_write);
+
+    DmiIf *dmi_if = NULL;
+    LsuDmiEntry entries[CONFIG_GVSOC_ISS_LSU_DMI_NB_ENTRIES];
+    int next_entry = 0;
+};
+
+#endif
+
 class Lsu
 {
 public:
@@ -145,6 +183,9 @@ public:
     uint8_t *mem_array;
     iss_addr_t memory_start;
     iss_addr_t memory_end;
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+    LsuDmi dmi;
+#endif
 
 private:
     static void store_resume(void *_this, vp::IoReq *req);
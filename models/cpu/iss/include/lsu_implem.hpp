@@ -81,6 +81,11 @@ inline void Lsu::free_req(vp::IoReq *req, int64_t cyclestamp)
 template<typename T>
 inline bool Lsu::load(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
+    if (this->iss.gdbserver.watchpoint_check(false, addr, size))
+    {
+        return true;
+    }
+
     iss_addr_t phys_addr;
     bool use_mem_array;
 #ifdef CONFIG_GVSOC_ISS_MMU
@@ -102,6 +107,17 @@ inline bool Lsu::load(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
     }
 #endif
 
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+    uint8_t *host = this->dmi.get(phys_addr, size, false);
+    if (host)
+    {
+        this->iss.regfile.set_reg(reg, *(T *)host);
+        this->iss.regfile.memcheck_set_valid(reg, true);
+
+        return false;
+    }
+#endif
+
     // First set register to zero for zero-extension
     this->iss.regfile.set_reg(reg, 0);
     // Due to zero extension, whole register is valid, except the part which will be
@@ -203,6 +219,11 @@ inline void Lsu::elw(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 template<typename T>
 inline bool Lsu::load_signed(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
+    if (this->iss.gdbserver.watchpoint_check(false, addr, size))
+    {
+        return true;
+    }
+
     iss_addr_t phys_addr;
     bool use_mem_array;
 #ifdef CONFIG_GVSOC_ISS_MMU
@@ -224,6 +245,17 @@ inline bool Lsu::load_signed(iss_insn_t *insn, iss_addr_t addr, int size, int re
     }
 #endif
 
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+    uint8_t *host = this->dmi.get(phys_addr, size, false);
+    if (host)
+    {
+        this->iss.regfile.set_reg(reg, *(T *)host);
+        this->iss.regfile.memcheck_set_valid(reg, true);
+
+        return false;
+    }
+#endif
+
     int err;
     int64_t latency;
     int req_id;
@@ -296,6 +328,11 @@ inline bool Lsu::load_signed(iss_insn_t *insn, iss_addr_t addr, int size, int re
 template<typename T>
 inline bool Lsu::store(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
+    if (this->iss.gdbserver.watchpoint_check(true, addr, size))
+    {
+        return true;
+    }
+
     iss_addr_t phys_addr;
     bool use_mem_array;
 #ifdef CONFIG_GVSOC_ISS_MMU
@@ -317,6 +354,16 @@ inline bool Lsu::store(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
     }
 #endif
 
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+    uint8_t *host = this->dmi.get(phys_addr, size, true);
+    if (host)
+    {
+        *(T *)host = this->iss.regfile.get_reg(reg);
+
+        return false;
+    }
+#endif
+
 #ifdef CONFIG_GVSOC_ISS_SCOREBOARD
     // Since the input register is passed through its index and accessed through a pointer,
     // we need to take care of the scoreboard
@@ -377,10 +424,6 @@ inline bool Lsu::store(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 template<typename T>
 inline bool Lsu::load_perf(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
-    if (this->iss.gdbserver.watchpoint_check(false, addr, size))
-    {
-        return true;
-    }
     this->iss.timing.event_load_account(1);
     return this->load<T>(insn, addr, size, reg);
 }
@@ -394,10 +437,6 @@ inline void Lsu::elw_perf(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 template<typename T>
 inline bool Lsu::load_signed_perf(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
-    if (this->iss.gdbserver.watchpoint_check(false, addr, size))
-    {
-        return true;
-    }
     this->iss.timing.event_load_account(1);
     return this->load_signed<T>(insn, addr, size, reg);
 }
@@ -405,10 +444,6 @@ inline bool Lsu::load_signed_perf(iss_insn_t *insn, iss_addr_t addr, int size, i
 template<typename T>
 inline bool Lsu::store_perf(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
-    if (this->iss.gdbserver.watchpoint_check(true, addr, size))
-    {
-        return true;
-    }
     this->iss.timing.event_store_account(1);
     return this->store<T>(insn, addr, size, reg);
 }
@@ -433,6 +468,11 @@ inline void Lsu::stack_access_check(int reg, iss_addr_t addr)
 template<typename T>
 inline bool Lsu::load_float(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
+    if (this->iss.gdbserver.watchpoint_check(false, addr, size))
+    {
+        return true;
+    }
+
     iss_addr_t phys_addr;
     bool use_mem_array;
 #ifdef CONFIG_GVSOC_ISS_MMU
@@ -454,6 +494,16 @@ inline bool Lsu::load_float(iss_insn_t *insn, iss_addr_t addr, int size, int reg
     }
 #endif
 
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+    uint8_t *host = this->dmi.get(phys_addr, size, false);
+    if (host)
+    {
+        this->iss.regfile.set_freg(reg, iss_get_float_value(*(T *)host, size * 8));
+
+        return false;
+    }
+#endif
+
     int err;
     int64_t latency;
     int req_id;
@@ -518,6 +568,11 @@ inline bool Lsu::load_float(iss_insn_t *insn, iss_addr_t addr, int size, int reg
 template<typename T>
 inline bool Lsu::store_float(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
+    if (this->iss.gdbserver.watchpoint_check(true, addr, size))
+    {
+        return true;
+    }
+
     iss_addr_t phys_addr;
     bool use_mem_array;
 #ifdef CONFIG_GVSOC_ISS_MMU
@@ -539,6 +594,16 @@ inline bool Lsu::store_float(iss_insn_t *insn, iss_addr_t addr, int size, int re
     }
 #endif
 
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+    uint8_t *host = this->dmi.get(phys_addr, size, true);
+    if (host)
+    {
+        *(T *)host = this->iss.regfile.get_freg(reg);
+
+        return false;
+    }
+#endif
+
 #ifdef CONFIG_GVSOC_ISS_SCOREBOARD
     // Since the input register is passed through its index and accessed through a pointer,
     // we need to take care of the scoreboard
@@ -598,10 +663,6 @@ inline bool Lsu::store_float(iss_insn_t *insn, iss_addr_t addr, int size, int re
 template<typename T>
 inline bool Lsu::load_float_perf(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
-    if (this->iss.gdbserver.watchpoint_check(false, addr, size))
-    {
-        return true;
-    }
     this->iss.timing.event_load_account(1);
     return this->load_float<T>(insn, addr, size, reg);
 }
@@ -609,10 +670,29 @@ inline bool Lsu::load_float_perf(iss_insn_t *insn, iss_addr_t addr, int size, in
 template<typename T>
 inline bool Lsu::store_float_perf(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
-    if (this->iss.gdbserver.watchpoint_check(true, addr, size))
-    {
-        return true;
-    }
     this->iss.timing.event_store_account(1);
     return this->store_float<T>(insn, addr, size, reg);
 }
+
+
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+
+inline uint8_t *LsuDmi::get(iss_addr_t addr, int size, bool is_write)
+{
+    for (int i=0; i<CONFIG_GVSOC_ISS_LSU_DMI_NB_ENTRIES; i++)
+    {
+        LsuDmiEntry *entry = &this->entries[i];
+        if (addr >= entry->base && (uint64_t)addr + size <= entry->end)
+        {
+            if (entry->host == NULL || (is_write && !entry->writable))
+            {
+                return NULL;
+            }
+            return entry->host + (addr - entry->base);
+        }
+    }
+
+    return this->miss(addr, size, is_write);
+}
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Line storage and replacement policy of the multi-line instruction prefetchers of iss and
+ * iss_v2.
+ *
+ * Holds NB_LINES lines of LINE_SIZE bytes, each tagged with its aligned address and owning
+ * the request used to refill it, so that a demand refill and a next-line prefetch can be in
+ * flight at the same time. It also tracks the line being executed, the one the core waits for
+ * and the one being prefetched, and decides what to refill and prefetch. The prefetchers only
+ * add the ISS-specific parts on top of it: sending the requests, stalling the core and
+ * accounting the timing.
+ *
+ * Lines are replaced in round-robin order. Lines with a pending refill are never replaced
+ * since their request is still in flight, and neither is the line being executed. When
+ * BRANCH_TARGETS is set, lines refilled after a jump are skipped as long as other lines can
+ * be replaced, so that the targets of loops survive the sequential prefetches of their body.
+ */
+template<typename Req, int LINE_SIZE, int NB_LINES, bool BRANCH_TARGETS>
+class PrefetchLines
+{
+public:
+    static_assert((LINE_SIZE & (LINE_SIZE - 1)) == 0, "Prefetch line size must be a power of 2");
+    static_assert(NB_LINES >= 2, "Multi-line prefetcher needs at least 2 lines");
+
+    class Line
+    {
+    public:
+        uint8_t data[LINE_SIZE];
+        // Aligned address of the line, -1 if the line is empty
+        uint64_t tag = (uint64_t)-1;
+        // True while the refill request is in flight
+        bool pending = false;
+        // True if the line was refilled by a next-line prefetch and not used yet
+        bool prefetched = false;
+        // True if the line holds the target of a jump
+        bool is_target = false;
+        // Cycle where the data of a prefetched line is actually available
+        int64_t ready_cycle = 0;
+        Req req;
+    };
+
+    // Line being executed, NULL if there is none
+    Line *current = NULL;
+    // Line the core is waiting for, when it is stalled on a pending refill
+    Line *wait_line = NULL;
+    // Line being prefetched, while its request is pending
+    Line *prefetch_line = NULL;
+
+    static uint64_t align(uint64_t addr)
+    {
+        return addr & ~(uint64_t)(LINE_SIZE - 1);
+    }
+
+    // Return the line containing the given address, or NULL if it is not in the buffer
+    Line *lookup(uint64_t addr)
+    {
+        uint64_t tag = align(addr);
+        for (int i=0; i<NB_LINES; i++)
+        {
+            if (this->lines[i].tag == tag)
+            {
+                return &this->lines[i];
+            }
+        }
+        return NULL;
+    }
+
+    // Make the line containing the given address the current one. Returns true if it is in
+    // the buffer. Otherwise a line is allocated for it, which the caller must refill.
+    bool enter(uint64_t addr)
+    {
+        Line *line = this->lookup(addr);
+        if (line != NULL)
+        {
+            line->prefetched = false;
+            this->current = line;
+            return true;
+        }
+
+        bool is_jump = this->current == NULL || align(addr) != this->current->tag + LINE_SIZE;
+
+        // The current line is not needed anymore and can be replaced. There is always a line
+        // available since at most one prefetch is in flight.
+        line = this->alloc(addr, NULL);
+        line->is_target = is_jump;
+        this->current = line;
+        return false;
+    }
+
+    // Get called when the refill of the current line could not be sent
+    void enter_failed()
+    {
+        this->current->tag = (uint64_t)-1;
+        this->current = NULL;
+    }
+
+    // Get called when the refill of the current line is pending, or when it was hit while
+    // its prefetch is still in flight, the core waits for it
+    void enter_pending()
+    {
+        this->current->pending = true;
+        this->wait_line = this->current;
+    }
+
+    // Return the part of the prefetch latency of the current line which was not covered by
+    // the execution of the previous lines, which the core still has to wait for
+    int64_t enter_latency(int64_t now)
+    {
+        int64_t latency = this->current->ready_cycle > now ? this->current->ready_cycle - now : 0;
+        this->current->ready_cycle = 0;
+        return latency;
+    }
+
+    // Allocate the line following the current one, to be prefetched by the caller. Returns
+    // NULL if there is nothing to prefetch: a prefetch is already in flight, the line is
+    // already in the buffer or it is in another page of page_size bytes (0 for no page),
+    // whose physical address is not the next one.
+    Line *prefetch_alloc(uint64_t page_size)
+    {
+        // Only one prefetch at a time, so that a demand refill always finds a free line
+        if (this->prefetch_line != NULL || this->current == NULL)
+        {
+            return NULL;
+        }
+
+        uint64_t next_addr = this->current->tag + LINE_SIZE;
+
+        if ((page_size != 0 && (next_addr & (page_size - 1)) == 0) ||
+            this->lookup(next_addr) != NULL)
+        {
+            return NULL;
+        }
+
+        Line *line = this->alloc(next_addr, this->current);
+        if (line != NULL)
+        {
+            line->prefetched = true;
+        }
+        return line;
+    }
+
+    // Get called with the result of the prefetch request of a line: ready at ready_cycle if
+    // it was answered synchronously, pending or invalid. An invalid line is dropped, the fault
+    // is only raised if the core executes it.
+    void prefetch_sent(Line *line, bool pending, bool invalid, int64_t ready_cycle)
+    {
+        if (invalid)
+        {
+            line->tag = (uint64_t)-1;
+        }
+        else if (pending)
+        {
+            line->pending = true;
+            this->prefetch_line = line;
+        }
+        else
+        {
+            line->ready_cycle = ready_cycle;
+        }
+    }
+
+    // Get called when the response of a refill is received. Returns true if the core was
+    // waiting for this line, otherwise the line is only ready at ready_cycle.
+    bool response(Req *req, int64_t ready_cycle)
+    {
+        Line *line = this->get_line(req);
+
+        line->pending = false;
+        if (line == this->prefetch_line)
+        {
+            this->prefetch_line = NULL;
+        }
+
+        if (line != this->wait_line)
+        {
+            line->ready_cycle = ready_cycle;
+            return false;
+        }
+
+        this->wait_line = NULL;
+        return true;
+    }
+
+    // Empty all lines. A line with a pending refill keeps its request, its data will just be
+    // dropped when the response is received.
+    void flush()
+    {
+        for (int i=0; i<NB_LINES; i++)
+        {
+            this->lines[i].tag = (uint64_t)-1;
+        }
+        this->current = NULL;
+    }
+
+    // Forget the pending refills, on reset
+    void reset()
+    {
+        this->flush();
+        this->wait_line = NULL;
+        this->prefetch_line = NULL;
+    }
+
+private:
+    // Return the line owning the given request
+    Line *get_line(Req *req)
+    {
+        for (int i=0; i<NB_LINES; i++)
+        {
+            if (&this->lines[i].req == req)
+            {
+                return &this->lines[i];
+            }
+        }
+        return NULL;
+    }
+
+    // Allocate a line for the given address. Returns NULL if all lines are busy, which can only
+    // happen for prefetches since at most one demand refill is in flight.
+    Line *alloc(uint64_t addr, Line *current)
+    {
+        Line *victim = NULL;
+
+        // First try to keep the jump targets, then take any line which can be replaced
+        for (int pass=BRANCH_TARGETS ? 0 : 1; pass<2 && victim == NULL; pass++)
+        {
+            for (int i=0; i<NB_LINES; i++)
+            {
+                Line *line = &this->lines[(this->next_victim + i) % NB_LINES];
+                if (line != current && !line->pending && (pass == 1 || !line->is_target))
+                {
+                    victim = line;
+                    this->next_victim = (this->next_victim + i + 1) % NB_LINES;
+                    break;
+                }
+            }
+        }
+
+        if (victim != NULL)
+        {
+            victim->tag = align(addr);
+            victim->prefetched = false;
+            victim->is_target = false;
+            victim->ready_cycle = 0;
+        }
+
+        return victim;
+    }
+
+    Line lines[NB_LINES];
+    int next_victim = 0;
+};
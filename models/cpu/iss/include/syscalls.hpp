@@ -25,9 +25,16 @@
 #include <vp/vp.hpp>
 #include <cpu/iss/include/types.hpp>
 #include <cpu/iss/include/htif.hpp>
+#include <sys/uio.h>
+#include <vector>
 
 
 class IssWrapper;
+class DmiIf;
+namespace vp { class DebugMemIf; }
+
+// Size of the host buffer used to copy guest buffers which can not be directly accessed
+#define SYSCALLS_CHUNK_SIZE 0x10000
 
 
 class Syscalls
@@ -42,6 +49,9 @@ public:
     void handle_riscv_ebreak();
 
     bool user_access(iss_addr_t addr, uint8_t *data, iss_addr_t size, bool is_write);
+    // Resolve a guest buffer into host buffers, returns false if it is not fully in memories
+    // giving direct access, in which case user_access must be used instead
+    bool user_map(iss_addr_t addr, iss_addr_t size, bool is_write, std::vector<struct iovec> &iov);
     std::string read_user_string(iss_addr_t addr, int len = -1);
 
     vp::Trace trace;
@@ -52,6 +62,18 @@ public:
     Htif htif;
 
 private:
+    void backdoors_resolve();
+    bool user_access_io(iss_addr_t addr, uint8_t *data, iss_addr_t size, bool is_write);
+    int64_t host_io(int fd, std::vector<struct iovec> &iov, bool to_file, bool &error);
+
     Iss &iss;
     int64_t latency;
+    // Call fsync after each semi-hosted write, to make them durable
+    bool sync_writes = false;
+    // Components behind the data port giving direct or backdoor access to memories, resolved
+    // on first use since bindings are not known at build time
+    bool backdoors_resolved = false;
+    DmiIf *dmi_if = NULL;
+    vp::DebugMemIf *debug_mem = NULL;
+    std::vector<struct iovec> iov;
 };
@@ -24,6 +24,7 @@
 
 #include <vp/vp.hpp>
 #include <cpu/iss/include/types.hpp>
+#include <cpu/iss/include/trace_binary.hpp>
 
 
 
@@ -34,6 +35,7 @@ public:
 
     void build();
     void reset(bool active);
+    void stop();
 
     void insn_trace_callback();
     void dump_debug_traces();
@@ -62,6 +64,21 @@ public:
     bool has_str_dump = false;
     std::string str_dump;
 
+    // Binary instruction trace, used instead of the text one when a file prefix is specified
+    std::string binary_prefix;
+    IssTraceBinWriter binary;
+    // Instructions already described in the binary trace, indexed by their trace_id. The
+    // decoder item and opcode are kept to detect instructions which have been decoded again.
+    struct BinaryDef
+    {
+        iss_insn_t *insn;
+        iss_decoder_item_t *decoder_item;
+        iss_reg_t opcode;
+    };
+    std::vector<BinaryDef> binary_defs;
+    // Number of ELF binaries already described in the binary trace
+    int binary_nb_elfs;
+
 private:
 
     Iss &iss;
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+/*
+ * Binary instruction trace format.
+ *
+ * When the binary instruction trace is enabled, each core writes the instructions it traces to
+ * its own file instead of formatting them as text. The file is decoded offline by the
+ * iss_insn_trace_decode tool, which can produce exactly the text of the insn trace.
+ *
+ * The file starts with a header:
+ *   u32 magic, u16 version, u8 register width, u8 FP width, u32 flags, u32 VLEN, str core path
+ *
+ * followed by records, each starting with a u8 tag:
+ *
+ *   ISS_TRACE_BIN_TAG_ELF: ELF binary registered for debug info (func:line column)
+ *     str path
+ *
+ *   ISS_TRACE_BIN_TAG_DEF: decoded instruction, emitted the first time it is traced
+ *     u32 id, u64 opcode, str label, u8 nb_args, u8 args_order[nb_args],
+ *     then for each argument:
+ *       u8 type, u32 decoder flags, u8 dump_name, u32 instruction flags, str name, i64 a, i64 b
+ *     with a being the register index for registers, the value for immediates, the base register
+ *     index for indirect accesses, and b the immediate for indirect immediates and the offset
+ *     register index for indirect registers.
+ *
+ *   ISS_TRACE_BIN_TAG_EXEC: executed instruction
+ *     u32 def id, u8 exec flags, u8 mode, u64 time, u64 cycles, u64 pc,
+ *     [u64 reg_dump] if ISS_TRACE_BIN_EXEC_REG_DUMP, [str str_dump] if ISS_TRACE_BIN_EXEC_STR_DUMP,
+ *     [u8 sewb, u8 lmul, u8 exp, u8 mant] if ISS_TRACE_BIN_EXEC_VECTOR,
+ *     then for each argument, the values given by iss_trace_bin_exec_arg_nb_values, each one
+ *     being a u64 value followed by a u64 memcheck value, or VLEN/8*lmul bytes for vector
+ *     registers.
+ *
+ * Except for vector registers and the string dump, the size of an execution record only
+ * depends on its definition. Strings are a u16 length followed by the characters. All fields
+ * are in host byte order.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#define ISS_TRACE_BIN_MAGIC   0x4e425349    // "ISBN"
+#define ISS_TRACE_BIN_VERSION 1
+
+#define ISS_TRACE_BIN_TAG_ELF  1
+#define ISS_TRACE_BIN_TAG_DEF  2
+#define ISS_TRACE_BIN_TAG_EXEC 3
+
+// Header flags, giving the settings used to format the text trace
+#define ISS_TRACE_BIN_FLAG_LONG           (1 << 0)
+#define ISS_TRACE_BIN_FLAG_FLOAT_HEX      (1 << 1)
+#define ISS_TRACE_BIN_FLAG_MEMCHECK       (1 << 2)
+#define ISS_TRACE_BIN_FLAG_HAS_DOUBLE     (1 << 3)
+#define ISS_TRACE_BIN_FLAG_SINGLE_REGFILE (1 << 4)
+
+// Execution record flags
+#define ISS_TRACE_BIN_EXEC_REG_DUMP (1 << 0)
+#define ISS_TRACE_BIN_EXEC_STR_DUMP (1 << 1)
+#define ISS_TRACE_BIN_EXEC_VECTOR   (1 << 2)
+
+// Size of the buffer used to write the trace file
+#define ISS_TRACE_BIN_BUFFER_SIZE (1 << 20)
+
+// Argument types and flags are the ones of iss_decoder_arg_type_e and iss_decoder_arg_flag_e,
+// they are duplicated here so that the format can be used without the ISS headers
+#define ISS_TRACE_BIN_ARG_NONE         0
+#define ISS_TRACE_BIN_ARG_OUT_REG      1
+#define ISS_TRACE_BIN_ARG_IN_REG       2
+#define ISS_TRACE_BIN_ARG_UIMM         3
+#define ISS_TRACE_BIN_ARG_SIMM         4
+#define ISS_TRACE_BIN_ARG_INDIRECT_IMM 5
+#define ISS_TRACE_BIN_ARG_INDIRECT_REG 6
+#define ISS_TRACE_BIN_ARG_FLAG         7
+
+#define ISS_TRACE_BIN_ARG_FLAG_POSTINC   (1 << 1)
+#define ISS_TRACE_BIN_ARG_FLAG_PREINC    (1 << 2)
+#define ISS_TRACE_BIN_ARG_FLAG_FREG      (1 << 4)
+#define ISS_TRACE_BIN_ARG_FLAG_REG64     (1 << 5)
+#define ISS_TRACE_BIN_ARG_FLAG_DUMP_NAME (1 << 6)
+#define ISS_TRACE_BIN_ARG_FLAG_VREG      (1 << 7)
+#define ISS_TRACE_BIN_ARG_FLAG_ELEM_32   (1 << 8)
+#define ISS_TRACE_BIN_ARG_FLAG_ELEM_16   (1 << 9)
+#define ISS_TRACE_BIN_ARG_FLAG_ELEM_16A  (1 << 10)
+#define ISS_TRACE_BIN_ARG_FLAG_ELEM_8    (1 << 11)
+#define ISS_TRACE_BIN_ARG_FLAG_ELEM_8A   (1 << 12)
+#define ISS_TRACE_BIN_ARG_FLAG_ELEM_64   (1 << 13)
+#define ISS_TRACE_BIN_ARG_FLAG_VEC       (1 << 14)
+#define ISS_TRACE_BIN_ARG_FLAG_ELEM_SEW  (1 << 15)
+
+// Number of value slots of an argument in execution records.
+// Register: its value. Indirect immediate: base register value. Indirect register: base then
+// offset register values. Vector registers have no slot, their content is dumped instead.
+static inline int iss_trace_bin_exec_arg_nb_values(int type, uint32_t flags)
+{
+    if (type == ISS_TRACE_BIN_ARG_OUT_REG || type == ISS_TRACE_BIN_ARG_IN_REG)
+    {
+        return flags & ISS_TRACE_BIN_ARG_FLAG_VREG ? 0 : 1;
+    }
+    else if (type == ISS_TRACE_BIN_ARG_INDIRECT_IMM)
+    {
+        return 1;
+    }
+    else if (type == ISS_TRACE_BIN_ARG_INDIRECT_REG)
+    {
+        return 2;
+    }
+    return 0;
+}
+
+/*
+ * Buffered writer of a binary trace file.
+ * Records are built directly in the buffer, which is written to the file once full.
+ */
+class IssTraceBinWriter
+{
+public:
+    ~IssTraceBinWriter() { this->close(); }
+
+    bool open(const char *path)
+    {
+        this->file = fopen(path, "wb");
+        if (this->file == NULL)
+        {
+            return false;
+        }
+        this->buffer.resize(ISS_TRACE_BIN_BUFFER_SIZE);
+        this->pos = 0;
+        return true;
+    }
+
+    void close()
+    {
+        if (this->file)
+        {
+            this->flush();
+            fclose(this->file);
+            this->file = NULL;
+        }
+    }
+
+    bool is_open() { return this->file != NULL; }
+
+    void flush()
+    {
+        if (this->pos)
+        {
+            fwrite(this->buffer.data(), 1, this->pos, this->file);
+            this->pos = 0;
+        }
+    }
+
+    // Must be called before writing a record, with its maximum size, so that the put
+    // methods do not have to check the buffer size
+    inline void reserve(size_t size)
+    {
+        if (this->pos + size > this->buffer.size())
+        {
+            this->flush();
+            if (size > this->buffer.size())
+            {
+                this->buffer.resize(size);
+            }
+        }
+    }
+
+    template<typename T> inline void put(T value)
+    {
+        memcpy(&this->buffer[this->pos], &value, sizeof(T));
+        this->pos += sizeof(T);
+    }
+
+    inline void put_data(const void *data, size_t size)
+    {
+        memcpy(&this->buffer[this->pos], data, size);
+        this->pos += size;
+    }
+
+    // Maximum size of a string once written
+    static inline size_t str_size(const char *str) { return 2 + strnlen(str, 0xffff); }
+
+    inline void put_str(const char *str)
+    {
+        uint16_t len = strnlen(str, 0xffff);
+        this->put<uint16_t>(len);
+        this->put_data(str, len);
+    }
+
+private:
+    FILE *file = NULL;
+    std::vector<uint8_t> buffer;
+    size_t pos = 0;
+};
@@ -0,0 +1,619 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+/*
+ * Text formatting of the instruction trace.
+ *
+ * This is used both by the ISS (src/trace.cpp), on the instruction being executed, and by the
+ * binary trace decoder (tools/insn_trace_decode.cpp), on the content of the trace file, so
+ * that the decoder gives exactly the text of the insn trace.
+ *
+ * The functions are templates on a source class giving access to the trace settings, to the
+ * instruction and to the values saved when it was executed:
+ *
+ *   int reg_width(), int fp_width(), bool float_hex(), bool memcheck(), bool has_double(),
+ *   bool single_regfile()
+ *   uint64_t float_to_f64(uint64_t value, int exp, int mant)
+ *       Value widened to a double, returned as its bits
+ *   bool debug_info(uint64_t pc, const char **func, int *line)
+ *       False if the func:line column is not dumped, otherwise sets func to "-" and line to 0
+ *       if the pc is unknown
+ *   uint64_t opcode(), const char *label(), int nb_args(), int arg_order(int i)
+ *   IssTraceFmtArg arg(int id)
+ *   uint64_t pc(), int mode(), bool has_reg_dump(), uint64_t reg_dump(), const char *str_dump()
+ *       str_dump returns NULL if there is none
+ *   uint64_t value(int id, int slot), uint64_t check(int id, int slot)
+ *       Saved value and memcheck value of the argument slots (see
+ *       iss_trace_bin_exec_arg_nb_values)
+ *   uint8_t *varg(int id), int vlen(), int vsewb(), int vlmul(), int vexp(), int vmant()
+ *       Saved content of vector registers, NULL if vectors are not supported
+ *
+ * Argument types and flags are the ones of the binary trace, which are the ones of the ISS
+ * decoder.
+ */
+
+#pragma once
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cpu/iss/include/trace_binary.hpp"
+
+#define ISS_TRACE_FMT_DEBUG_INFO_WIDTH 32
+#define ISS_TRACE_FMT_NB_REGS 32
+
+struct IssTraceFmtArg
+{
+    int type;
+    uint32_t flags;
+    // True if the register name is dumped
+    bool dump_name;
+    uint32_t insn_flags;
+    // Dumped instead of the immediate if insn_flags has ISS_TRACE_BIN_ARG_FLAG_DUMP_NAME
+    const char *name;
+    // Register index for registers, value for immediates, base register index for indirect
+    // accesses
+    int64_t a;
+    // Immediate for indirect immediates, offset register index for indirect registers
+    int64_t b;
+};
+
+static inline char iss_trace_fmt_mode(int mode)
+{
+    switch (mode)
+    {
+    case 0:
+        return 'U';
+    case 1:
+        return 'S';
+    case 2:
+        return 'H';
+    case 3:
+        return 'M';
+    }
+    return ' ';
+}
+
+// Same as PRIxFULLREG
+template<class Src>
+static inline int iss_trace_fmt_fullreg(Src &src, char *buff, uint64_t value)
+{
+    if (src.reg_width() == 64)
+        return sprintf(buff, "%16.16" PRIx64, value);
+    else
+        return sprintf(buff, "%8.8" PRIx32, (uint32_t)value);
+}
+
+// Same as PRIdREG, which is hexadecimal on 64 bits
+template<class Src>
+static inline int iss_trace_fmt_dreg(Src &src, char *buff, int64_t value)
+{
+    if (src.reg_width() == 64)
+        return sprintf(buff, "%" PRIx64, (uint64_t)value);
+    else
+        return sprintf(buff, "%" PRId32, (int32_t)value);
+}
+
+template<class Src>
+static inline int iss_trace_fmt_reg(Src &src, uint32_t flags, char *buff, unsigned int reg,
+    bool is_long = true)
+{
+    if (is_long)
+    {
+        if (flags & ISS_TRACE_BIN_ARG_FLAG_VREG)
+        {
+            return sprintf(buff, "v%d", reg);
+        }
+        else
+        {
+            if (!src.single_regfile() && (flags & ISS_TRACE_BIN_ARG_FLAG_FREG))
+            {
+                return sprintf(buff, "f%d", reg);
+            }
+            else
+            {
+                if (reg == 0)
+                    return sprintf(buff, "0");
+                else if (reg == 1)
+                    return sprintf(buff, "ra");
+                else if (reg == 2)
+                    return sprintf(buff, "sp");
+                else if (reg >= 8 && reg <= 9)
+                    return sprintf(buff, "s%d", reg - 8);
+                else if (reg >= 18 && reg <= 27)
+                    return sprintf(buff, "s%d", reg - 16);
+                else if (reg == 4)
+                    return sprintf(buff, "tp");
+                else if (reg >= 10 && reg <= 17)
+                    return sprintf(buff, "a%d", reg - 10);
+                else if (reg >= 5 && reg <= 7)
+                    return sprintf(buff, "t%d", reg - 5);
+                else if (reg >= 28 && reg <= 31)
+                    return sprintf(buff, "t%d", reg - 25);
+                else if (reg == 3)
+                    return sprintf(buff, "gp");
+                else if (reg >= ISS_TRACE_FMT_NB_REGS)
+                    return sprintf(buff, "f%d", reg - ISS_TRACE_FMT_NB_REGS);
+            }
+        }
+    }
+
+    return sprintf(buff, "x%d", reg);
+}
+
+static inline char *iss_trace_fmt_reg_value_check(char *buff, int size, uint64_t saved_value,
+    uint64_t check_saved_value)
+{
+    for (int i=size*2-1; i>=0; i--)
+    {
+        uint8_t check = (check_saved_value >> (i*4)) & 0xF;
+        uint8_t value = (saved_value >> (i*4)) & 0xF;
+        if (check == 0xF)
+        {
+            buff += sprintf(buff, "%1.1x", value);
+        }
+        else
+        {
+            buff += sprintf(buff, "X");
+        }
+    }
+    buff += sprintf(buff, " ");
+
+    return buff;
+}
+
+template<class Src>
+static inline double iss_trace_fmt_to_double(Src &src, uint64_t value, int exp, int mant)
+{
+    uint64_t value_64 = src.float_to_f64(value, exp, mant);
+    double result;
+    memcpy(&result, &value_64, sizeof(result));
+    return result;
+}
+
+template<class Src>
+static char *iss_trace_fmt_vector(Src &src, char *buff, bool is_float, uint8_t *saved_arg)
+{
+    if (saved_arg == NULL)
+    {
+        return buff;
+    }
+
+    buff += sprintf(buff, "[");
+
+    int width = src.vsewb();
+    unsigned int lmul = src.vlmul();
+
+    for (int i=src.vlen()/8/width*lmul - 1; i>=0; i--)
+    {
+        uint64_t value;
+        memcpy(&value, &saved_arg[i*width], sizeof(value));
+
+        if (is_float && !src.float_hex())
+        {
+            buff += sprintf(buff, "%f", iss_trace_fmt_to_double(src, value, src.vexp(),
+                src.vmant()));
+        }
+        else
+        {
+            uint64_t mask;
+            if (width >= 8)
+            {
+                mask = ~0ULL;
+            }
+            else
+            {
+                mask = (1ULL << (width * 8)) - 1;
+            }
+
+            buff += sprintf(buff, "%0*llx", width*2, (unsigned long long)(value & mask));
+        }
+        if (i != 0)
+        {
+            buff += sprintf(buff, ", ");
+        }
+    }
+
+    buff += sprintf(buff, "] ");
+
+    return buff;
+}
+
+template<class Src>
+static char *iss_trace_fmt_float_vector(Src &src, char *buff, int full_width, int width,
+    int exp, int mant, bool is_vec, uint64_t value)
+{
+    if (!is_vec || full_width == width)
+    {
+        if (width == 64)
+        {
+            double result;
+            memcpy(&result, &value, sizeof(result));
+            buff += sprintf(buff, "%f ", result);
+        }
+        else
+        {
+            buff += sprintf(buff, "%f ", iss_trace_fmt_to_double(src, value, exp, mant));
+        }
+    }
+    else
+    {
+        buff += sprintf(buff, "[");
+
+        for (int i=full_width / width - 1; i>=0; i--)
+        {
+            buff += sprintf(buff, "%f", iss_trace_fmt_to_double(src, value >> (i*width), exp,
+                mant));
+            if (i != 0)
+            {
+                buff += sprintf(buff, ", ");
+            }
+        }
+
+        buff += sprintf(buff, "] ");
+    }
+
+    return buff;
+}
+
+template<class Src>
+static char *iss_trace_fmt_reg_value(Src &src, char *buff, bool is_out, int reg,
+    uint64_t saved_value, uint64_t check_saved_value, uint32_t flags, bool is_long,
+    uint8_t *saved_varg)
+{
+    char regStr[16];
+    iss_trace_fmt_reg(src, flags, regStr, reg, is_long);
+    if (is_long)
+        buff += sprintf(buff, "%3.3s", regStr);
+    else
+        buff += sprintf(buff, "%s", regStr);
+
+    if (is_out)
+        buff += sprintf(buff, "=");
+    else
+        buff += sprintf(buff, ":");
+
+    uint64_t reg_mask = src.reg_width() == 64 ? ~0ULL : 0xffffffffULL;
+    bool check = src.memcheck() && (check_saved_value & reg_mask) != reg_mask;
+
+    if (flags & ISS_TRACE_BIN_ARG_FLAG_REG64)
+    {
+        if (check)
+            buff = iss_trace_fmt_reg_value_check(buff, 8, saved_value, check_saved_value);
+        else
+            buff += sprintf(buff, "%16.16" PRIx64 " ", saved_value);
+    }
+    else if (flags & ISS_TRACE_BIN_ARG_FLAG_VREG)
+    {
+        buff = iss_trace_fmt_vector(src, buff, flags & ISS_TRACE_BIN_ARG_FLAG_FREG, saved_varg);
+    }
+    else if (flags & ISS_TRACE_BIN_ARG_FLAG_FREG)
+    {
+        bool float_hex = src.float_hex();
+        bool is_vec = flags & ISS_TRACE_BIN_ARG_FLAG_VEC;
+        int fp_width = src.fp_width();
+
+        if (!float_hex && flags & ISS_TRACE_BIN_ARG_FLAG_ELEM_SEW)
+            buff = iss_trace_fmt_float_vector(src, buff, fp_width, 64, 11, 52, false, saved_value);
+        else if (!float_hex && flags & ISS_TRACE_BIN_ARG_FLAG_ELEM_64)
+            buff = iss_trace_fmt_float_vector(src, buff, fp_width, 64, 11, 52, is_vec, saved_value);
+        else if (!float_hex && flags & ISS_TRACE_BIN_ARG_FLAG_ELEM_32)
+            buff = iss_trace_fmt_float_vector(src, buff, fp_width, 32, 8, 23, is_vec, saved_value);
+        else if (!float_hex && flags & ISS_TRACE_BIN_ARG_FLAG_ELEM_16)
+            buff = iss_trace_fmt_float_vector(src, buff, fp_width, 16, 5, 10, is_vec, saved_value);
+        else if (!float_hex && flags & ISS_TRACE_BIN_ARG_FLAG_ELEM_16A)
+            buff = iss_trace_fmt_float_vector(src, buff, fp_width, 16, 8, 7, is_vec, saved_value);
+        else if (!float_hex && flags & ISS_TRACE_BIN_ARG_FLAG_ELEM_8)
+            buff = iss_trace_fmt_float_vector(src, buff, fp_width, 8, 5, 2, is_vec, saved_value);
+        else if (!float_hex && flags & ISS_TRACE_BIN_ARG_FLAG_ELEM_8A)
+            buff = iss_trace_fmt_float_vector(src, buff, fp_width, 8, 4, 3, is_vec, saved_value);
+        else if (src.has_double())
+            buff += sprintf(buff, "%16.16" PRIx64 " ", saved_value);
+        else
+            buff += sprintf(buff, "%8.8" PRIx32 " ", (uint32_t)saved_value);
+    }
+    else
+    {
+        if (check)
+            buff = iss_trace_fmt_reg_value_check(buff, src.reg_width() / 8, saved_value,
+                check_saved_value);
+        else
+        {
+            buff += iss_trace_fmt_fullreg(src, buff, saved_value);
+            buff += sprintf(buff, " ");
+        }
+    }
+    return buff;
+}
+
+// Values of the output (dump_out) or input registers of an argument
+template<class Src>
+static char *iss_trace_fmt_arg_value(Src &src, char *buff, int id, int dump_out, bool is_long)
+{
+    IssTraceFmtArg arg = src.arg(id);
+    uint8_t *saved_varg = src.varg(id);
+    uint64_t reg_mask = src.reg_width() == 64 ? ~0ULL : 0xffffffffULL;
+
+    if ((arg.type == ISS_TRACE_BIN_ARG_OUT_REG || arg.type == ISS_TRACE_BIN_ARG_IN_REG) &&
+        (arg.a != 0 || arg.flags & ISS_TRACE_BIN_ARG_FLAG_FREG ||
+        arg.flags & ISS_TRACE_BIN_ARG_FLAG_VREG))
+    {
+        if ((dump_out && arg.type == ISS_TRACE_BIN_ARG_OUT_REG) ||
+            (!dump_out && arg.type == ISS_TRACE_BIN_ARG_IN_REG))
+        {
+            buff = iss_trace_fmt_reg_value(src, buff, arg.type == ISS_TRACE_BIN_ARG_OUT_REG,
+                arg.a, src.value(id, 0), src.check(id, 0), arg.flags, is_long, saved_varg);
+        }
+    }
+    else if (arg.type == ISS_TRACE_BIN_ARG_INDIRECT_IMM)
+    {
+        if (!dump_out)
+            buff = iss_trace_fmt_reg_value(src, buff, 0, arg.a, src.value(id, 0),
+                src.check(id, 0), arg.flags, is_long, saved_varg);
+        uint64_t addr;
+        if (arg.flags & ISS_TRACE_BIN_ARG_FLAG_POSTINC)
+        {
+            addr = src.value(id, 0);
+            if (dump_out)
+                buff = iss_trace_fmt_reg_value(src, buff, 1, arg.a, (addr + arg.b) & reg_mask,
+                    src.check(id, 0), arg.flags, is_long, saved_varg);
+        }
+        else
+        {
+            addr = src.value(id, 0) + arg.b;
+        }
+        if (!dump_out)
+        {
+            buff += sprintf(buff, " PA:");
+            buff += iss_trace_fmt_fullreg(src, buff, addr);
+            buff += sprintf(buff, " ");
+        }
+    }
+    else if (arg.type == ISS_TRACE_BIN_ARG_INDIRECT_REG)
+    {
+        if (!dump_out)
+            buff = iss_trace_fmt_reg_value(src, buff, 0, arg.b, src.value(id, 1),
+                src.check(id, 1), arg.flags, is_long, saved_varg);
+        if (!dump_out)
+            buff = iss_trace_fmt_reg_value(src, buff, 0, arg.a, src.value(id, 0),
+                src.check(id, 0), arg.flags, is_long, saved_varg);
+        uint64_t addr;
+        if (arg.flags & ISS_TRACE_BIN_ARG_FLAG_POSTINC)
+        {
+            addr = src.value(id, 0);
+            if (dump_out)
+                buff = iss_trace_fmt_reg_value(src, buff, 1, arg.a,
+                    (addr + src.value(id, 1)) & reg_mask, src.check(id, 1), arg.flags, is_long,
+                    saved_varg);
+        }
+        else
+        {
+            addr = src.value(id, 0) + src.value(id, 1);
+        }
+        if (!dump_out)
+        {
+            buff += sprintf(buff, " PA:");
+            buff += iss_trace_fmt_fullreg(src, buff, addr);
+            buff += sprintf(buff, " ");
+        }
+    }
+    return buff;
+}
+
+// Assembly of an argument. prev_type is the type of the previous dumped argument, or -1.
+template<class Src>
+static char *iss_trace_fmt_arg(Src &src, char *buff, int id, int *prev_type, bool is_long)
+{
+    IssTraceFmtArg arg = src.arg(id);
+
+    if (*prev_type != -1 && *prev_type != ISS_TRACE_BIN_ARG_NONE &&
+        *prev_type != ISS_TRACE_BIN_ARG_FLAG &&
+        ((arg.type != ISS_TRACE_BIN_ARG_IN_REG && arg.type != ISS_TRACE_BIN_ARG_OUT_REG) ||
+        arg.dump_name))
+    {
+        if (is_long)
+            buff += sprintf(buff, ", ");
+        else
+            buff += sprintf(buff, ",");
+    }
+
+    if (arg.type != ISS_TRACE_BIN_ARG_NONE)
+    {
+        if (arg.type == ISS_TRACE_BIN_ARG_OUT_REG || arg.type == ISS_TRACE_BIN_ARG_IN_REG)
+        {
+            if (arg.dump_name)
+                buff += iss_trace_fmt_reg(src, arg.flags, buff, arg.a, is_long);
+        }
+        else if (arg.type == ISS_TRACE_BIN_ARG_UIMM)
+        {
+            if (arg.insn_flags & ISS_TRACE_BIN_ARG_FLAG_DUMP_NAME)
+                buff += sprintf(buff, "%s", arg.name);
+            else if (src.reg_width() == 64)
+                buff += sprintf(buff, "0x%" PRIx64, (uint64_t)arg.a);
+            else
+                buff += sprintf(buff, "0x%" PRIx32, (uint32_t)arg.a);
+        }
+        else if (arg.type == ISS_TRACE_BIN_ARG_SIMM)
+        {
+            if (arg.insn_flags & ISS_TRACE_BIN_ARG_FLAG_DUMP_NAME)
+                buff += sprintf(buff, "%s", arg.name);
+            else
+                buff += iss_trace_fmt_dreg(src, buff, arg.a);
+        }
+        else if (arg.type == ISS_TRACE_BIN_ARG_INDIRECT_IMM)
+        {
+            buff += iss_trace_fmt_dreg(src, buff, arg.b);
+            buff += sprintf(buff, "(");
+            if (arg.flags & ISS_TRACE_BIN_ARG_FLAG_PREINC)
+                buff += sprintf(buff, "!");
+            buff += iss_trace_fmt_reg(src, arg.flags, buff, arg.a, is_long);
+            if (arg.flags & ISS_TRACE_BIN_ARG_FLAG_POSTINC)
+                buff += sprintf(buff, "!");
+            buff += sprintf(buff, ")");
+        }
+        else if (arg.type == ISS_TRACE_BIN_ARG_INDIRECT_REG)
+        {
+            buff += iss_trace_fmt_reg(src, arg.flags, buff, arg.b, is_long);
+            buff += sprintf(buff, "(");
+            if (arg.flags & ISS_TRACE_BIN_ARG_FLAG_PREINC)
+                buff += sprintf(buff, "!");
+            buff += iss_trace_fmt_reg(src, arg.flags, buff, arg.a, is_long);
+            if (arg.flags & ISS_TRACE_BIN_ARG_FLAG_POSTINC)
+                buff += sprintf(buff, "!");
+            buff += sprintf(buff, ")");
+        }
+        *prev_type = arg.type;
+    }
+    return buff;
+}
+
+// func:line column of long traces
+static inline char *iss_trace_fmt_debug(const char *func, int line, char *buff)
+{
+    int line_len = sprintf(buff, ":%d", line);
+    if (line_len > 5)
+        line_len = 5;
+    int max_name_len = ISS_TRACE_FMT_DEBUG_INFO_WIDTH - line_len;
+
+    int len = snprintf(buff, max_name_len + 1, "%s", func);
+    if (len > max_name_len)
+        len = max_name_len;
+
+    len += sprintf(buff + len, ":%d", line);
+
+    if (len > ISS_TRACE_FMT_DEBUG_INFO_WIDTH)
+        len = ISS_TRACE_FMT_DEBUG_INFO_WIDTH;
+
+    for (int i = len; i < ISS_TRACE_FMT_DEBUG_INFO_WIDTH + 1; i++)
+    {
+        sprintf(buff + i, " ");
+    }
+
+    return buff + ISS_TRACE_FMT_DEBUG_INFO_WIDTH + 1;
+}
+
+// Assembly part of the instruction (arguments only), without any padding
+template<class Src>
+static char *iss_trace_fmt_asm(Src &src, char *buff, bool is_long)
+{
+    int prev_type = -1;
+    for (int i = 0; i < src.nb_args(); i++)
+    {
+        buff = iss_trace_fmt_arg(src, buff, src.arg_order(i), &prev_type, is_long);
+    }
+    return buff;
+}
+
+template<class Src>
+static char *iss_trace_fmt_values(Src &src, char *buff, int dump_out, bool is_long)
+{
+    for (int i = 0; i < src.nb_args(); i++)
+    {
+        buff = iss_trace_fmt_arg_value(src, buff, src.arg_order(i), dump_out, is_long);
+    }
+    return buff;
+}
+
+// Full line of the insn trace. Events only have the instruction, without the mode, the pc,
+// the padding and the register values.
+template<class Src>
+static char *iss_trace_fmt_insn(Src &src, char *buff, bool is_long, bool is_event)
+{
+    static int max_len = 20;
+    static int max_arg_len = 17;
+    int len;
+
+    const char *func;
+    int line;
+    if (is_long && src.debug_info(src.pc(), &func, &line))
+    {
+        buff = iss_trace_fmt_debug(func, line, buff);
+    }
+
+    if (src.has_reg_dump())
+    {
+        buff += iss_trace_fmt_fullreg(src, buff, src.reg_dump());
+        buff += sprintf(buff, " ");
+    }
+
+    if (src.str_dump())
+    {
+        buff += sprintf(buff, "%s ", src.str_dump());
+    }
+
+    if (!is_event)
+    {
+        buff += sprintf(buff, "%c ", iss_trace_fmt_mode(src.mode()));
+        buff += iss_trace_fmt_fullreg(src, buff, src.pc());
+        buff += sprintf(buff, " ");
+    }
+
+    if (!is_long)
+    {
+        buff += iss_trace_fmt_fullreg(src, buff, src.opcode());
+        buff += sprintf(buff, " ");
+    }
+
+    char *start_buff = buff;
+
+    buff += sprintf(buff, "%s ", src.label());
+
+    if (is_long)
+    {
+        len = buff - start_buff;
+
+        if (len > max_len)
+            max_len = len;
+        else
+        {
+            memset(buff, ' ', max_len - len);
+            buff += max_len - len;
+        }
+    }
+
+    start_buff = buff;
+    buff = iss_trace_fmt_asm(src, buff, is_long);
+    if (src.nb_args() != 0)
+        buff += sprintf(buff, " ");
+
+    if (!is_event)
+    {
+        len = buff - start_buff;
+
+        if (len > max_arg_len)
+            max_arg_len = len;
+        else
+        {
+            memset(buff, ' ', max_arg_len - len);
+            buff += max_arg_len - len;
+        }
+
+        buff = iss_trace_fmt_values(src, buff, 1, is_long);
+        buff = iss_trace_fmt_values(src, buff, 0, is_long);
+
+        buff += sprintf(buff, "\n");
+    }
+
+    *buff = 0;
+
+    return buff;
+}
@@ -250,6 +250,7 @@ typedef struct iss_decoder_range_set_s
 {
     int nb_ranges;
     iss_decoder_range_t ranges[ISS_MAX_DECODE_RANGES];
+    int bits;           // Width of the extracted value, used for sign extension
 } iss_decoder_range_set_t;
 
 typedef enum
@@ -377,6 +378,10 @@ typedef struct iss_decoder_item_s
             int width;
             int nb_groups;
             iss_decoder_item_t **groups;
+            // Sub-items directly indexed by the group opcode, with the "others" item in
+            // every slot not matching any sub-item. NULL for wide groups, which are
+            // decoded by scanning groups.
+            iss_decoder_item_t **table;
         } group;
     } u;
 
@@ -407,6 +412,10 @@ typedef struct iss_insn_s
     iss_reg_t (*stall_fast_handler)(Iss *, iss_insn_t *, iss_reg_t);
     iss_reg_t (*breakpoint_saved_handler)(Iss *, iss_insn_t *, iss_reg_t);
     iss_reg_t (*breakpoint_saved_fast_handler)(Iss *, iss_insn_t *, iss_reg_t);
+    iss_insn_t *block_next;      // Instruction executed after this one the last time, used for block execution
+    iss_reg_t block_next_pc;     // PC of block_next
+    int block_gen;               // Instruction cache generation when block_next was set
+    int trace_id;                // Identifier of the instruction in the binary trace, -1 if not dumped yet
     int size;
     int nb_out_reg;
     int nb_in_reg;
@@ -59,7 +59,10 @@ class Range(object):
     def gen_info(self, isaFile):
         dump(isaFile, '{ .type=ISS_DECODER_VALUE_TYPE_RANGE, .u= { .range_set= {.nb_ranges=1, .ranges={ ')
         self.gen(isaFile)
-        dump(isaFile, '} } } }, ')
+        dump(isaFile, '}, .bits=%d } } }, ' % self.get_bits())
+
+    def get_bits(self):
+        return self.width + self.shift
 
     def len(self):
         return 1
@@ -78,7 +81,7 @@ class Ranges(object):
         dump(isaFile, '{ .type=ISS_DECODER_VALUE_TYPE_RANGE, .u= { .range_set= {.nb_ranges=%d, .ranges={ ' % (len(self.ranges)))
         for range in self.ranges:
             range.gen(isaFile)
-        dump(isaFile, '} } } }, ')
+        dump(isaFile, '}, .bits=%d } } }, ' % max(range.get_bits() for range in self.ranges))
 
     def len(self):
         return len(self.ranges)
@@ -491,6 +494,10 @@ class DecodeLeaf(object):
 
 
 
+# Groups whose opcode is at most this wide get a direct-indexed dispatch table,
+# wider ones only have a few sub-items and are decoded by scanning them
+DECODER_TABLE_MAX_WIDTH = 8
+
 class DecodeTree(object):
     def __init__(self, isa, instrs, mask=0xffffffff, opcode='0'):
         self.opcode = opcode
@@ -631,6 +638,24 @@ class DecodeTree(object):
         else:
             return list(self.subtrees.values())[0].get_name()
 
+    def get_table(self):
+        # Returns the sub-item selected by each value of the group opcode, following
+        # the same rules as the scan done by the decoder: the first sub-item with the
+        # same opcode wins, otherwise the "others" one is taken.
+        if self.opcode_width > DECODER_TABLE_MAX_WIDTH:
+            return None
+
+        others = self.subtrees.get('OTHERS')
+        table = [others] * (1 << self.opcode_width)
+        for opcode, subtree in reversed(list(self.subtrees.items())):
+            if opcode == 'OTHERS':
+                continue
+            index = int(subtree.opcode, 2)
+            if index < len(table):
+                table[index] = subtree
+
+        return table
+
     def gen(self, isaFile, isa):
 
         if len(self.subtrees) != 0:
@@ -656,6 +681,13 @@ class DecodeTree(object):
 
                 dump(isaFile, ' };\n')
 
+                table = self.get_table()
+                if table is not None:
+                    dump(isaFile, 'static iss_decoder_item_t *%s_table[] = {' % self.get_name());
+                    for subtree in table:
+                        dump(isaFile, ' NULL,' if subtree is None else ' &%s,' % subtree.get_name())
+                    dump(isaFile, ' };\n')
+
                 dump(isaFile, 'static iss_decoder_item_t %s = {\n' % (self.get_name()))
                 dump(isaFile, '  .is_insn=false,\n')
                 dump(isaFile, '  .is_active=false,\n')
@@ -666,7 +698,8 @@ class DecodeTree(object):
                 dump(isaFile, '      .bit=%d,\n' % self.firstBit)
                 dump(isaFile, '      .width=%d,\n' % self.opcode_width)
                 dump(isaFile, '      .nb_groups=%d,\n' % len(self.subtrees))
-                dump(isaFile, '      .groups=%s_groups\n' % self.get_name())
+                dump(isaFile, '      .groups=%s_groups,\n' % self.get_name())
+                dump(isaFile, '      .table=%s\n' % ('NULL' if table is None else '%s_table' % self.get_name()))
                 dump(isaFile, '    }\n')
                 dump(isaFile, '  }\n')
                 dump(isaFile, '};\n')
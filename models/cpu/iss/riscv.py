@@ -76,6 +76,35 @@ class RiscvCommon(st.Component):
         starts it (default: False).
     boot_addr : int, optional
         Address of the first instruction (default: 0)
+    insn_block_size : int, optional
+        Maximum number of instructions executed in a single cycle event when the ISS is not timed,
+        values greater than 1 enable basic-block execution, which improves simulation speed but
+        delays interrupts and external events to the end of the block (default: 1).
+    dmi : bool, optional
+        True if the LSU should ask the memories behind its data port for a direct host pointer, so
+        that most data accesses are done without any request. This bypasses the timing, statistics
+        and traces of the memory path and is only enabled when the ISS is not timed (default: False).
+    insn_trace_binary : str, optional
+        If specified, the instruction trace is written in binary format instead of text, into
+        <insn_trace_binary><core path>.bin, which is much faster and smaller. The text trace can be
+        rebuilt with the iss_insn_trace_decode tool (default: None).
+    prefetcher_nb_lines : int, optional
+        If specified, the single-line prefetcher is replaced by a prefetch buffer with this number
+        of lines, looked up by tag. Must be at least 2 (default: None).
+    prefetcher_next_line : bool, optional
+        With the multi-line prefetcher, prefetch the next line as soon as the core enters a line
+        (default: True).
+    prefetcher_branch_targets : bool, optional
+        With the multi-line prefetcher, keep the lines of jump targets when lines are replaced, so
+        that loop heads stay in the buffer (default: False).
+    syscalls_fsync : bool, optional
+        True if the files written by semi-hosting are synced to disk after each write, so that
+        they are complete even if the simulation is killed. This is much slower for programs
+        writing a lot of data (default: False).
+    ssr_burst_size : int, optional
+        On cores with stream semantic registers, size in bytes of the bursts used by contiguous
+        read streams to fetch their next elements in a single request. Must be a power of 2 up
+        to 32, 0 fetches element by element (default: 0).
 
     """
 
@@ -120,6 +149,14 @@ class RiscvCommon(st.Component):
             zdinx: bool=False,
             fp_width: int | None = None,
             modules: list[IssModule] = [],
+            insn_block_size: int=1,
+            dmi: bool=False,
+            insn_trace_binary: str | None=None,
+            prefetcher_nb_lines: int | None=None,
+            prefetcher_next_line: bool=True,
+            prefetcher_branch_targets: bool=False,
+            syscalls_fsync: bool=False,
+            ssr_burst_size: int=0,
             config=None
         ):
 
@@ -151,9 +188,16 @@ class RiscvCommon(st.Component):
             wrapper
         ])
 
+        # The multi-line prefetcher is added even with custom sources since prefetch.hpp selects
+        # it from prefetcher_nb_lines. The single-line source builds to nothing in this case, so
+        # custom source lists can keep it.
+        if prefetcher_nb_lines is not None:
+            self.add_sources(["cpu/iss/src/prefetch/prefetch_multi_line.cpp"])
+        elif not custom_sources:
+            self.add_sources(["cpu/iss/src/prefetch/prefetch_single_line.cpp"])
+
         if not custom_sources:
             self.add_sources([
-                "cpu/iss/src/prefetch/prefetch_single_line.cpp",
                 "cpu/iss/src/csr.cpp",
                 "cpu/iss/src/exec/exec_inorder.cpp",
                 "cpu/iss/src/decode.cpp",
@@ -190,8 +234,24 @@ class RiscvCommon(st.Component):
             'fetch_enable': fetch_enable,
             'boot_addr': boot_addr,
             'has_double': isa.has_isa('rvd'),
+            'insn_block_size': insn_block_size,
         })
 
+        if insn_trace_binary is not None:
+            self.add_properties({
+                'insn_trace_binary': insn_trace_binary,
+            })
+
+        if syscalls_fsync:
+            self.add_properties({
+                'syscalls_fsync': True,
+            })
+
+        if ssr_burst_size != 0:
+            self.add_properties({
+                'ssr_burst_size': ssr_burst_size,
+            })
+
         fp_size = fp_width if fp_width is not None else  64 if isa.has_isa('rvd') else 32
         self.add_c_flags([f'-DCONFIG_GVSOC_ISS_FP_WIDTH={fp_size}'])
 
@@ -251,6 +311,13 @@ class RiscvCommon(st.Component):
         if prefetcher_size is not None:
             self.add_c_flags([f'-DCONFIG_GVSOC_ISS_PREFETCHER_SIZE={prefetcher_size}'])
 
+        if prefetcher_nb_lines is not None:
+            self.add_c_flags([
+                f'-DCONFIG_GVSOC_ISS_PREFETCHER_NB_LINES={prefetcher_nb_lines}',
+                f'-DCONFIG_GVSOC_ISS_PREFETCHER_NEXT_LINE={int(prefetcher_next_line)}',
+                f'-DCONFIG_GVSOC_ISS_PREFETCHER_BRANCH_TARGETS={int(prefetcher_branch_targets)}',
+            ])
+
         # When not explicitly set, derive the timing model from the
         # hierarchical timing level: only 'functional' disables it ('cycle'
         # snaps to 'timed', the ISS has no finer-grained model).
@@ -262,12 +329,16 @@ class RiscvCommon(st.Component):
         if timed:
             self.add_c_flags(['-DCONFIG_GVSOC_ISS_TIMED=1'])
 
+        if dmi and not timed and not scoreboard:
+            self.add_c_flags(['-DCONFIG_GVSOC_ISS_LSU_DMI=1'])
+
         if not float_lib in ['flexfloat', 'native', 'softfloat']:
             raise RuntimeError(f'Unsupported float lib: {float_lib}')
 
         self.add_c_flags([f'-DCONFIG_GVSOC_ISS_FLOAT_USE_{float_lib.upper()}=1'])
 
-        if float_lib == 'softfloat':
+        # The native library falls back to softfloat for the cases the host cannot handle
+        if float_lib in ['softfloat', 'native']:
             self.add_sources([
                 "cpu/iss/softfloat/softfloat_state.cpp",
                 "cpu/iss/softfloat/softfloat_raiseFlags.cpp",
@@ -309,6 +380,7 @@ class RiscvCommon(st.Component):
                 "cpu/iss/softfloat/s_mulAddF64.cpp",
                 "cpu/iss/softfloat/s_mulAddF16.cpp",
                 "cpu/iss/softfloat/f32_add.cpp",
+                "cpu/iss/softfloat/f32_sub.cpp",
                 "cpu/iss/softfloat/f64_mulAdd.cpp",
                 "cpu/iss/softfloat/f32_mulAdd.cpp",
                 "cpu/iss/softfloat/f16_mulAdd.cpp",
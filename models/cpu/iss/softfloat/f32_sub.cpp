@@ -47,7 +47,7 @@ float32_t f32_sub( Iss *iss, float32_t a, float32_t b )
     union ui32_f32 uB;
     uint_fast32_t uiB;
 #if ! defined INLINE_LEVEL || (INLINE_LEVEL < 1)
-    float32_t (*magsFuncPtr)( uint_fast32_t, uint_fast32_t );
+    float32_t (*magsFuncPtr)( Iss *iss, uint_fast32_t, uint_fast32_t );
 #endif
 
     uA.f = a;
@@ -63,7 +63,7 @@ float32_t f32_sub( Iss *iss, float32_t a, float32_t b )
 #else
     magsFuncPtr =
         signF32UI( uiA ^ uiB ) ? softfloat_addMagsF32 : softfloat_subMagsF32;
-    return (*magsFuncPtr)( uiA, uiB );
+    return (*magsFuncPtr)( iss, uiA, uiB );
 #endif
 
 }
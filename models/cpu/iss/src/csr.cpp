@@ -241,7 +241,7 @@ bool Csr::mcycle_access(bool is_write, iss_reg_t &value)
 {
     if (!is_write)
     {
-        value = this->iss.top.clock.get_cycles();
+        value = this->iss.top.clock.get_cycles() + this->iss.exec.block_cycles;
     }
     return false;
 }
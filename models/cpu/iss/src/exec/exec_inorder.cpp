@@ -74,6 +74,9 @@ void Exec::build()
 
     this->bootaddr_offset = this->iss.top.get_js_config()->get_child_int("bootaddr_offset");
 
+    this->block_size = this->iss.top.get_js_config()->get_child_int("insn_block_size");
+    this->block_break = false;
+    this->block_cycles = 0;
 
     this->current_insn = 0;
     this->stall_insn = 0;
@@ -102,6 +105,7 @@ void Exec::reset(bool active)
         this->irq_locked = 0;
         this->insn_on_hold = false;
         this->stall_cycles = 0;
+        this->block_cycles = 0;
         this->cache_sync = false;
 
         // Always increase the stall when reset is asserted since stall count is set to 0
@@ -235,6 +239,76 @@ void Exec::exec_instr(vp::Block *__this, vp::ClockEvent *event)
 }
 
 
+#if !defined(CONFIG_GVSOC_ISS_TIMED) && !defined(CONFIG_GVSOC_ISS_EXEC_SCOREBOARD)
+
+// Untimed variant of exec_instr which executes a whole block of instructions within the same
+// clock event. Each instruction keeps a link to the instruction which followed it the last
+// time it was executed, so that straight-line code and loops do not go through the
+// instruction cache lookup. The block is interrupted as soon as something needs the full
+// handler (exception, interrupt, stall, flush, etc), and the cycles of the executed
+// instructions are accounted in bulk by stalling the clock event.
+void Exec::exec_block(vp::Block *__this, vp::ClockEvent *event)
+{
+    Iss *const iss = (Iss *)__this;
+    Exec *const _this = &iss->exec;
+
+    _this->trace.msg(vp::Trace::LEVEL_TRACE, "Handling instruction block with fast handler\n");
+
+    iss_reg_t pc = _this->current_insn;
+    iss_reg_t index;
+    iss_insn_t *insn = iss->insn_cache.get_insn(pc, index);
+    if (insn == NULL) return;
+
+    int nb_insns = 0;
+    _this->block_break = false;
+
+    while (1)
+    {
+        iss->exec.insn_exec_profiling();
+
+        iss_reg_t next_pc = insn->fast_handler(iss, insn, pc);
+        _this->current_insn = next_pc;
+
+        _this->asm_trace_event.event_string(insn->desc->label, false);
+        _this->insn_exec_power(insn);
+        iss->regfile.memcheck_fault();
+
+        _this->block_cycles = ++nb_insns;
+
+        if (_this->block_break || nb_insns == _this->block_size)
+        {
+            break;
+        }
+
+        iss_insn_t *next = insn->block_next;
+        if (unlikely(next == NULL || insn->block_next_pc != next_pc ||
+            insn->block_gen != iss->insn_cache.block_gen))
+        {
+            next = iss->insn_cache.get_insn(next_pc, index);
+            if (next == NULL) break;
+
+            insn->block_next = next;
+            insn->block_next_pc = next_pc;
+            insn->block_gen = iss->insn_cache.block_gen;
+        }
+
+        insn = next;
+        pc = next_pc;
+    }
+
+    _this->block_cycles = 0;
+
+    // The first instruction is accounted by this event, the others are accounted by delaying
+    // the next one.
+    if (nb_insns > 1)
+    {
+        event->stall_cycle_set(nb_insns - 1);
+    }
+}
+
+#endif
+
+
 #if defined(CONFIG_GVSOC_ISS_RI5KY) || defined(CONFIG_GVSOC_ISS_HWLOOP)
 
 // TODO HW loop methods could be moved to ri5cy specific code by using inheritance
@@ -318,7 +392,16 @@ void Exec::exec_instr_check_all(vp::Block *__this, vp::ClockEvent *event)
     // if HW counters are disabled as they are checked with the slow handler
     if (_this->can_switch_to_fast_mode())
     {
-        _this->instr_event.set_callback(&Exec::exec_instr);
+#if !defined(CONFIG_GVSOC_ISS_TIMED) && !defined(CONFIG_GVSOC_ISS_EXEC_SCOREBOARD)
+        if (_this->block_size > 1)
+        {
+            _this->instr_event.set_callback(&Exec::exec_block);
+        }
+        else
+#endif
+        {
+            _this->instr_event.set_callback(&Exec::exec_instr);
+        }
     }
 
     _this->insn_exec_profiling();
@@ -359,7 +359,7 @@ void Gdbserver::gdbserver_breakpoint_remove(uint64_t addr)
 
 
 
-bool Gdbserver::watchpoint_check(bool is_write, iss_addr_t addr, int size)
+bool Gdbserver::watchpoint_check_list(bool is_write, iss_addr_t addr, int size)
 {
     std::list<Watchpoint *> &watchpoints = is_write ? this->write_watchpoints : this->read_watchpoints;
     for (auto wp: watchpoints)
@@ -388,6 +388,8 @@ void Gdbserver::gdbserver_watchpoint_insert(bool is_write, uint64_t addr, int si
 
     std::list<Watchpoint *> &watchpoints = is_write ? this->write_watchpoints : this->read_watchpoints;
     watchpoints.push_back(new Watchpoint(addr, size));
+
+    this->watchpoint_pages_update();
 }
 
 
@@ -404,6 +406,7 @@ void Gdbserver::gdbserver_watchpoint_remove(bool is_write, uint64_t addr, int si
     {
         if (addr + size >= (*it)->addr && addr < (*it)->addr + (*it)->size)
         {
+            delete *it;
             it = watchpoints.erase(it);
         }
         else
@@ -411,6 +414,41 @@ void Gdbserver::gdbserver_watchpoint_remove(bool is_write, uint64_t addr, int si
             ++it;
         }
     }
+
+    this->watchpoint_pages_update();
+}
+
+
+
+void Gdbserver::watchpoint_pages_set(uint64_t *pages, std::list<Watchpoint *> &watchpoints)
+{
+    std::fill(pages, pages + GDBSERVER_WATCH_NB_PAGES / 64, 0);
+
+    for (auto wp: watchpoints)
+    {
+        if (wp->size <= 0) continue;
+
+        uint64_t first = wp->addr >> GDBSERVER_WATCH_PAGE_BITS;
+        uint64_t last = ((uint64_t)wp->addr + wp->size - 1) >> GDBSERVER_WATCH_PAGE_BITS;
+        // Once all pages are set, there is no need to go further
+        last = std::min(last, first + GDBSERVER_WATCH_NB_PAGES - 1);
+
+        for (uint64_t page = first; page <= last; page++)
+        {
+            uint64_t index = page % GDBSERVER_WATCH_NB_PAGES;
+            pages[index / 64] |= (uint64_t)1 << (index % 64);
+        }
+    }
+}
+
+
+
+void Gdbserver::watchpoint_pages_update()
+{
+    watchpoint_pages_set(this->write_watch_pages, this->write_watchpoints);
+    watchpoint_pages_set(this->read_watch_pages, this->read_watchpoints);
+
+    this->nb_watchpoints = this->write_watchpoints.size() + this->read_watchpoints.size();
 }
 
 
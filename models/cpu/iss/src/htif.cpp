@@ -138,13 +138,6 @@ void Htif::target_access(iss_reg_t addr, int size, bool is_write, uint8_t *data)
     this->iss.syscalls.user_access(addr, data, size, is_write);
 }
 
-uint8_t Htif::read_uint8(iss_reg_t addr)
-{
-    uint8_t value;
-    this->target_access(addr, 1, false, &value);
-    return value;
-}
-
 std::string Htif::do_chroot(const char* fn)
 {
   if (!chroot.empty() && *fn == '/')
@@ -230,17 +223,8 @@ iss_reg_t Htif::sys_faccessat(iss_reg_t dirfd, iss_reg_t pname, iss_reg_t len, i
 
 iss_reg_t Htif::sys_chdir(iss_reg_t path, iss_reg_t a1, iss_reg_t a2, iss_reg_t a3, iss_reg_t a4, iss_reg_t a5, iss_reg_t a6)
 {
-    size_t size = 0;
-    while (this->read_uint8(path + size++))
-        ;
-    std::vector<char> buf(size);
-    for (size_t offset = 0;; offset++)
-    {
-        buf[offset] = this->read_uint8(path + offset);
-        if (!buf[offset])
-        break;
-    }
-    return sysret_errno(chdir(buf.data()));
+    std::string buf = this->iss.syscalls.read_user_string(path);
+    return sysret_errno(chdir(buf.c_str()));
 }
 
 iss_reg_t Htif::sys_openat(iss_reg_t dirfd, iss_reg_t pname, iss_reg_t len, iss_reg_t flags, iss_reg_t mode, iss_reg_t a5, iss_reg_t a6)
@@ -268,6 +252,10 @@ iss_reg_t Htif::sys_lseek(iss_reg_t fd, iss_reg_t ptr, iss_reg_t dir, iss_reg_t
 
 iss_reg_t Htif::sys_read(iss_reg_t fd, iss_reg_t pbuf, iss_reg_t len, iss_reg_t a3, iss_reg_t a4, iss_reg_t a5, iss_reg_t a6)
 {
+    // Buffers in memories giving direct access are read from the file without any copy
+    if (this->iss.syscalls.user_map(pbuf, len, true, this->iov))
+        return sysret_errno(readv(fds.lookup(fd), this->iov.data(), this->iov.size()));
+
     std::vector<char> buf(len);
     ssize_t ret = read(fds.lookup(fd), buf.data(), len);
     iss_reg_t ret_errno = sysret_errno(ret);
@@ -278,6 +266,9 @@ iss_reg_t Htif::sys_read(iss_reg_t fd, iss_reg_t pbuf, iss_reg_t len, iss_reg_t
 
 iss_reg_t Htif::sys_pread(iss_reg_t fd, iss_reg_t pbuf, iss_reg_t len, iss_reg_t off, iss_reg_t a4, iss_reg_t a5, iss_reg_t a6)
 {
+    if (this->iss.syscalls.user_map(pbuf, len, true, this->iov))
+        return sysret_errno(preadv(fds.lookup(fd), this->iov.data(), this->iov.size(), off));
+
     std::vector<char> buf(len);
     ssize_t ret = pread(fds.lookup(fd), buf.data(), len, off);
     iss_reg_t ret_errno = sysret_errno(ret);
@@ -288,6 +279,9 @@ iss_reg_t Htif::sys_pread(iss_reg_t fd, iss_reg_t pbuf, iss_reg_t len, iss_reg_t
 
 iss_reg_t Htif::sys_pwrite(iss_reg_t fd, iss_reg_t pbuf, iss_reg_t len, iss_reg_t off, iss_reg_t a4, iss_reg_t a5, iss_reg_t a6)
 {
+    if (this->iss.syscalls.user_map(pbuf, len, false, this->iov))
+        return sysret_errno(pwritev(fds.lookup(fd), this->iov.data(), this->iov.size(), off));
+
     std::vector<char> buf(len);
     this->target_access(pbuf, len, false, (uint8_t *)buf.data());
     iss_reg_t ret = sysret_errno(pwrite(fds.lookup(fd), buf.data(), len, off));
@@ -311,6 +305,10 @@ iss_reg_t Htif::sys_fstatat(iss_reg_t dirfd, iss_reg_t pname, iss_reg_t len, iss
 
 iss_reg_t Htif::sys_write(iss_reg_t fd, iss_reg_t pbuf, iss_reg_t len, iss_reg_t a3, iss_reg_t a4, iss_reg_t a5, iss_reg_t a6)
 {
+    // Buffers in memories giving direct access are written to the file without any copy
+    if (this->iss.syscalls.user_map(pbuf, len, false, this->iov))
+        return sysret_errno(writev(fds.lookup(fd), this->iov.data(), this->iov.size()));
+
     std::vector<char> buf(len);
     this->target_access(pbuf, len, false, (uint8_t *)buf.data());
 
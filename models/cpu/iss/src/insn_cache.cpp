@@ -23,18 +23,20 @@
 #include <string.h>
 
 InsnCache::InsnCache(Iss &iss)
-    : iss(iss)
+    : pages(sizeof(iss_reg_t) * 8 - INSN_PAGE_BITS), iss(iss)
 {
 }
 
 void InsnCache::stop()
 {
     this->flush();
+    this->pages.release();
 }
 
 void InsnCache::build()
 {
     this->current_insn_page_base = -INSN_PAGE_SIZE*2;
+    this->block_gen = 0;
 }
 
 bool InsnCache::insn_is_decoded(iss_insn_t *insn)
@@ -48,12 +50,7 @@ void InsnCache::flush()
 {
     this->iss.prefetcher.flush();
 
-    for (auto page: this->pages)
-    {
-        delete page.second;
-    }
-
-    this->pages.clear();
+    this->pages.flush();
 
     this->mode_flush();
 
@@ -71,6 +68,10 @@ void InsnCache::flush()
 void InsnCache::mode_flush()
 {
     this->current_insn_page_base = -INSN_PAGE_SIZE*2;
+    this->block_gen++;
+    // The instruction being executed may belong to a flushed page, the current block
+    // must stop after it
+    this->iss.exec.block_break = true;
 }
 
 
@@ -87,15 +88,13 @@ void Decode::flush_cache_sync(vp::Block *__this, bool active)
 InsnPage *InsnCache::page_get(iss_reg_t paddr)
 {
     iss_reg_t index = paddr >> INSN_PAGE_BITS;
-    InsnPage *page = this->pages[index];
+    InsnPage *page = this->pages.get(index);
     if (page != NULL)
     {
         return page;
     }
 
-    page = new InsnPage;
-
-    this->pages[index] = page;
+    page = this->pages.alloc(index);
 
     iss_reg_t addr = index << INSN_PAGE_BITS;
     for (int i=0; i<INSN_PAGE_SIZE; i++)
@@ -378,8 +378,61 @@ void Lsu::start()
 #ifdef CONFIG_GVSOC_ISS_MEMORY
     this->meminfo.sync_back((void **)&this->mem_array);
 #endif
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+    this->dmi.start(&this->data);
+#endif
+}
+
+#ifdef CONFIG_GVSOC_ISS_LSU_DMI
+
+void LsuDmi::start(vp::MasterPort *port)
+{
+    this->dmi_if = dmi_if_get(port);
+    this->dmi_invalidate();
+}
+
+void LsuDmi::dmi_invalidate()
+{
+    for (int i=0; i<CONFIG_GVSOC_ISS_LSU_DMI_NB_ENTRIES; i++)
+    {
+        this->entries[i].base = UINT64_MAX;
+        this->entries[i].end = 0;
+        this->entries[i].host = NULL;
+    }
 }
 
+uint8_t *LsuDmi::miss(iss_addr_t addr, int size, bool is_write)
+{
+    LsuDmiEntry *entry = &this->entries[this->next_entry];
+    this->next_entry = (this->next_entry + 1) % CONFIG_GVSOC_ISS_LSU_DMI_NB_ENTRIES;
+
+    DmiGrant grant;
+    if (this->dmi_if && this->dmi_if->dmi_get(addr, grant, this) &&
+        (uint64_t)addr + size <= grant.base + grant.size)
+    {
+        entry->base = grant.base;
+        entry->end = grant.base + grant.size;
+        entry->host = grant.host;
+        entry->writable = grant.writable;
+
+        if (is_write && !grant.writable)
+        {
+            return NULL;
+        }
+        return grant.host + (addr - grant.base);
+    }
+
+    // Remember the area around the access is not directly accessible, to not query it
+    // again for each access, like for peripherals
+    entry->base = addr & ~(uint64_t)(CONFIG_GVSOC_ISS_LSU_DMI_HOLE_SIZE - 1);
+    entry->end = entry->base + CONFIG_GVSOC_ISS_LSU_DMI_HOLE_SIZE;
+    entry->host = NULL;
+
+    return NULL;
+}
+
+#endif
+
 void Lsu::store_resume(Lsu *lsu, vp::IoReq *req)
 {
     // For now we don't have to do anything as the register was written directly
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#include <vp/vp.hpp>
+#include <cpu/iss/include/iss.hpp>
+
+Prefetcher::Prefetcher(Iss &iss)
+    : iss(iss)
+{
+}
+
+void Prefetcher::build()
+{
+    this->iss.top.traces.new_trace("prefetcher", &this->trace, vp::DEBUG);
+    this->fetch_itf.set_resp_meth(&Prefetcher::fetch_response);
+    this->iss.top.new_master_port("fetch", &fetch_itf, (vp::Block *)this);
+}
+
+void Prefetcher::reset(bool active)
+{
+    if (active)
+    {
+        this->lines.reset();
+        this->buffer_start_addr = -1;
+        this->prefetch_insn = NULL;
+    }
+}
+
+bool Prefetcher::fetch_refill(iss_insn_t *insn, iss_addr_t addr, int index)
+{
+    // We get here either if the instruction is entirely outside the current line or if it is
+    // only partially within.
+    if (this->prefetch_insn == insn)
+    {
+        return true;
+    }
+
+    this->prefetch_insn = NULL;
+
+    // If the instruction is entirely outside the current line, first get the line of the
+    // lower part
+    if (unlikely(index < 0 || index >= ISS_PREFETCHER_SIZE))
+    {
+        if (int err = this->enter_line(addr))
+        {
+            if (err == -1)
+            {
+                // In case of a pending refill, we have to register a callback and leave,
+                // we'll get notified when the response is received
+                this->handle_stall(fetch_resume_after_low_refill, insn);
+            }
+            return false;
+        }
+        index = addr - this->buffer_start_addr;
+    }
+
+    // Now check if we can fully get the instruction from the current line, or it is only
+    // partially inside.
+    return this->fetch_check_overflow(insn, index);
+}
+
+void Prefetcher::fetch_resume_after_low_refill(Prefetcher *_this)
+{
+    iss_addr_t addr = _this->prefetch_insn->addr;
+    int index = addr - _this->buffer_start_addr;
+    _this->fetch_check_overflow(_this->prefetch_insn, index);
+}
+
+bool Prefetcher::fetch_check_overflow(iss_insn_t *insn, int index)
+{
+    iss_addr_t addr = insn->addr;
+
+    // Check if we overflow the current line. If not, the instruction fetch is over
+    if (likely(index + ISS_OPCODE_MAX_SIZE <= ISS_PREFETCHER_SIZE))
+    {
+        insn->opcode = *(iss_opcode_t *)&this->data[index];
+    }
+    else
+    {
+        // Case where the opcode is between 2 lines. The first part is taken from the current
+        // line, and the second one from the next line once it becomes the current one.
+        iss_opcode_t opcode = 0;
+
+        // Compute address of next line
+        iss_addr_t next_addr = (this->current_pc + ISS_PREFETCHER_SIZE - 1) & ~(ISS_PREFETCHER_SIZE - 1);
+        iss_reg_t next_phys_addr;
+        // Number of bytes of the opcode which fits the first line
+        int nb_bytes = next_addr - addr;
+        iss_addr_t mask = ((1ULL << (nb_bytes*8)) - 1);
+        // Copy first part from first line
+        opcode = *(iss_opcode_t *)&this->data[index] & mask;
+#ifdef CONFIG_GVSOC_ISS_MMU
+        if (this->iss.mmu.insn_virt_to_phys(next_addr, next_phys_addr))
+        {
+            return false;
+        }
+#else
+        next_phys_addr = next_addr;
+#endif
+
+        // Get next line, usually already prefetched
+        if (int err = this->enter_line(next_phys_addr))
+        {
+            // Stall the core if the fetch is pending
+            // We need to remember the opcode since the first line may be replaced
+            if (err == -1)
+            {
+                this->fetch_stall_opcode = opcode;
+                this->handle_stall(fetch_resume_after_high_refill, insn);
+            }
+            return false;
+        }
+        // If the line is available now, append the second part from second line to the previous
+        // opcode and decode it
+        opcode = (opcode  & mask) | ((*(iss_opcode_t *)&this->data[0]) << (nb_bytes*8));
+
+        insn->opcode = opcode;
+    }
+
+    return true;
+}
+
+void Prefetcher::fetch_resume_after_high_refill(Prefetcher *_this)
+{
+    iss_addr_t addr = _this->prefetch_insn->addr;
+    iss_addr_t next_addr = (addr + ISS_PREFETCHER_SIZE - 1) & ~(ISS_PREFETCHER_SIZE - 1);
+    // Number of bytes of the opcode which fits the first line
+    int nb_bytes = next_addr - addr;
+
+    // And append the second part from second line
+    _this->prefetch_insn->opcode = _this->fetch_stall_opcode | ((*(iss_opcode_t *)&_this->data[0]) << (nb_bytes * 8));
+}
+
+int Prefetcher::enter_line(iss_addr_t addr)
+{
+    if (!this->lines.enter(addr))
+    {
+        Lines::Line *line = this->lines.current;
+        this->data = line->data;
+        this->buffer_start_addr = line->tag;
+
+        int err = this->send_fetch_req(&line->req, line->tag, line->data, ISS_PREFETCHER_SIZE, false);
+        if (err == 1)
+        {
+            this->lines.enter_failed();
+            this->buffer_start_addr = -1;
+            return err;
+        }
+        else if (err == -1)
+        {
+            this->lines.enter_pending();
+        }
+
+        this->prefetch_next_line();
+        return err;
+    }
+
+    Lines::Line *line = this->lines.current;
+
+    this->trace.msg(vp::Trace::LEVEL_TRACE, "Prefetch buffer hit (addr: 0x%lx)\n", line->tag);
+
+    this->data = line->data;
+    this->buffer_start_addr = line->tag;
+
+    if (line->pending)
+    {
+        // The prefetch of this line is still in flight, the core has to wait for it
+        this->lines.enter_pending();
+        return -1;
+    }
+
+    this->account_latency(this->lines.enter_latency(this->iss.top.clock.get_cycles()));
+
+    this->prefetch_next_line();
+    return 0;
+}
+
+void Prefetcher::prefetch_next_line()
+{
+#if CONFIG_GVSOC_ISS_PREFETCHER_NEXT_LINE
+#ifdef CONFIG_GVSOC_ISS_MMU
+    Lines::Line *line = this->lines.prefetch_alloc(1 << MMU_PGSHIFT);
+#else
+    Lines::Line *line = this->lines.prefetch_alloc(0);
+#endif
+    if (line == NULL)
+    {
+        return;
+    }
+
+    vp::IoReq *req = &line->req;
+
+    this->trace.msg(vp::Trace::LEVEL_TRACE, "Prefetch request (addr: 0x%lx, size: 0x%x)\n",
+        line->tag, ISS_PREFETCHER_SIZE);
+
+    req->init();
+    req->set_addr(line->tag);
+    req->set_size(ISS_PREFETCHER_SIZE);
+    req->set_is_write(false);
+    req->set_data(line->data);
+
+    vp::IoReqStatus err = this->fetch_itf.req(req);
+    this->lines.prefetch_sent(line, err != vp::IO_REQ_OK && err != vp::IO_REQ_INVALID,
+        err == vp::IO_REQ_INVALID, this->iss.top.clock.get_cycles() + req->get_latency());
+#endif
+}
+
+int Prefetcher::send_fetch_req(vp::IoReq *req, uint64_t addr, uint8_t *data, uint64_t size, bool is_write)
+{
+    this->trace.msg(vp::Trace::LEVEL_TRACE, "Fetch request (addr: 0x%lx, size: 0x%lx)\n", addr, size);
+
+    req->init();
+    req->set_addr(addr);
+    req->set_size(size);
+    req->set_is_write(is_write);
+    req->set_data(data);
+    vp::IoReqStatus err = this->fetch_itf.req(req);
+    if (err != vp::IO_REQ_OK)
+    {
+        if (err == vp::IO_REQ_INVALID)
+        {
+#ifndef CONFIG_GVSOC_ISS_RISCV_EXCEPTIONS
+            this->trace.force_warning("Invalid fetch request (addr: 0x%x, size: 0x%x)\n", addr, size);
+#endif
+            this->iss.exception.raise(this->iss.exec.current_insn, ISS_EXCEPT_INSN_FAULT);
+            return 1;
+        }
+        else
+        {
+            this->trace.msg(vp::Trace::LEVEL_TRACE, "Waiting for asynchronous response\n");
+            return -1;
+        }
+    }
+
+    this->account_latency(req->get_latency());
+
+    return 0;
+}
+
+void Prefetcher::account_latency(int64_t latency)
+{
+    // Refills and lines entered before their prefetch is over stall the core the same way
+    if (latency > 0)
+    {
+        this->iss.timing.stall_fetch_account(latency);
+    }
+}
+
+void Prefetcher::fetch_response(vp::Block *__this, vp::IoReq *req)
+{
+    Prefetcher *_this = (Prefetcher *)__this;
+
+    _this->trace.msg(vp::Trace::LEVEL_TRACE, "Received fetch response (addr: 0x%lx)\n", req->get_addr());
+
+    // If the prefetch is received before the core needs it, only the remaining latency will
+    // be seen
+    if (!_this->lines.response(req, _this->iss.top.clock.get_cycles() + req->get_latency()))
+    {
+        return;
+    }
+
+    // Since a pending response can also include a latency, we need to account it
+    // as a stall
+    _this->account_latency(req->get_latency());
+
+    // Now unstall the core and call the fetch callback so that we can continue the refill
+    // operation
+    _this->iss.exec.stalled_dec();
+    if (_this->fetch_stall_callback)
+    {
+        _this->fetch_stall_callback(_this);
+    }
+
+    // The core has entered the line, the next one can now be prefetched
+    _this->prefetch_next_line();
+}
@@ -22,6 +22,9 @@
 #include <vp/vp.hpp>
 #include <cpu/iss/include/iss.hpp>
 
+// Custom source lists may still contain this file when the multi-line prefetcher is selected
+#ifndef CONFIG_GVSOC_ISS_PREFETCHER_NB_LINES
+
 Prefetcher::Prefetcher(Iss &iss)
     : iss(iss)
 {
@@ -208,3 +211,4 @@ void Prefetcher::fetch_response(vp::Block *__this, vp::IoReq *req)
     }
 }
 
+#endif
@@ -21,6 +21,8 @@
  */
 
 
+#include <string.h>
+#include <algorithm>
 #include <cpu/iss/include/cores/snitch/ssr.hpp>
 #include "cpu/iss/include/iss.hpp"
 #include ISS_CORE_INC(class.hpp)
@@ -79,6 +81,34 @@ iss_reg_t DataMover::addr_gen_unit(bool is_write)
 }
 
 
+// Get called to check if a read can be served from the burst buffer.
+bool DataMover::burst_hit(iss_addr_t addr, int size)
+{
+    return this->burst_valid && addr >= this->burst_base &&
+        addr + size <= this->burst_base + this->burst_len;
+}
+
+
+// Get called on a burst buffer miss to know how far a burst can read.
+// Strides are increments from the previous address, the one of the outermost dimension which
+// wrapped being applied, so the stream reads a single contiguous range when all the strides
+// of its dimensions are the element size. Other streams are fetched element by element,
+// so that a burst never reads anything the stream would not read itself.
+iss_addr_t DataMover::burst_stream_end(int size)
+{
+    iss_addr_t nb_elems = 1;
+    for (int i=0; i<=this->config.DIM; i++)
+    {
+        if (this->config.REG_STRIDES[i] != size)
+        {
+            return 0;
+        }
+        nb_elems *= (iss_addr_t)this->config.REG_BOUNDS[i] + 1;
+    }
+    return this->config.REG_RPTR[this->config.DIM] + nb_elems * size;
+}
+
+
 // Get called when the loop counter is updated after a memory access finishes.
 void DataMover::update_cnt()
 {
@@ -157,6 +187,40 @@ void Ssr::build()
     this->iss.top.new_master_port("ssr_dm0", &ssr_dm0, (vp::Block *)this);
     this->iss.top.new_master_port("ssr_dm1", &ssr_dm1, (vp::Block *)this);
     this->iss.top.new_master_port("ssr_dm2", &ssr_dm2, (vp::Block *)this);
+
+    // The requests are fully initialized once, only their per-access fields are set afterwards
+    this->io_req.init();
+    this->dm0.burst_req.init();
+    this->dm1.burst_req.init();
+    this->dm2.burst_req.init();
+
+    js::Config *burst_config = this->iss.top.get_js_config()->get("ssr_burst_size");
+    this->burst_size = burst_config != NULL ? burst_config->get_int() : SSR_BURST_DEFAULT_SIZE;
+    if (this->burst_size < 0 || this->burst_size > SSR_BURST_MAX_SIZE ||
+        (this->burst_size & (this->burst_size - 1)) != 0)
+    {
+        this->trace.force_warning("Invalid SSR burst size, bursts are disabled (size: %d, max: %d)\n",
+            this->burst_size, SSR_BURST_MAX_SIZE);
+        this->burst_size = 0;
+    }
+}
+
+
+DataMover *Ssr::get_dm(int dm)
+{
+    return dm == 0 ? &this->dm0 : dm == 1 ? &this->dm1 : &this->dm2;
+}
+
+
+vp::IoMaster *Ssr::get_port(int dm)
+{
+    return dm == 0 ? &this->ssr_dm0 : dm == 1 ? &this->ssr_dm1 : &this->ssr_dm2;
+}
+
+
+vp::ClockEvent *Ssr::get_event(int dm)
+{
+    return dm == 0 ? this->event_0 : dm == 1 ? this->event_1 : this->event_2;
 }
 
 
@@ -171,6 +235,11 @@ void Ssr::enable()
         this->dm1.ssr_done = 0;
         this->dm2.ssr_done = 0;
 
+        // Memory may have been modified by the core while the streams were disabled
+        this->dm0.burst_valid = false;
+        this->dm1.burst_valid = false;
+        this->dm2.burst_valid = false;
+
         // Enable clock events for pre-reading and post-writing
         this->event_0->enable();
         this->event_1->enable();
@@ -201,6 +270,15 @@ void Ssr::cfg_write(iss_insn_t *insn, int reg, int ssr, iss_reg_t value)
     // Clear the corresponding data lane when SSR is enabled and configured again
     this->clear_ssr(ssr);
 
+    // Drop the bursts fetched for the previous streams
+    for (int i=0; i<3; i++)
+    {
+        if (ssr == i || ssr == 31)
+        {
+            this->get_dm(i)->burst_valid = false;
+        }
+    }
+
     if (ssr > 2 && ssr != 31)
     {
         // Invalid data mover index
@@ -535,7 +613,7 @@ int Ssr::data_req(iss_addr_t addr, uint8_t *data_ptr, int size, bool is_write, i
 {
     this->trace.msg("Data request (addr: 0x%lx, size: 0x%x, is_write: %d, data_mover: %d)\n", addr, size, is_write, dm);
     vp::IoReq *req = &this->io_req;
-    req->init();
+    req->prepare();
     req->set_addr(addr);
     req->set_size(size);
     req->set_is_write(is_write);
@@ -618,12 +696,102 @@ int Ssr::data_req(iss_addr_t addr, uint8_t *data_ptr, int size, bool is_write, i
 }
 
 
+// Get called when a contiguous read stream misses its burst buffer.
+// The elements from addr to the end of the aligned burst, or to the end of the stream if it
+// comes first, are fetched with a single request on the data mover port.
+bool Ssr::burst_fill(iss_addr_t addr, int size, iss_addr_t stream_end, int dm)
+{
+    DataMover *mover = this->get_dm(dm);
+    iss_addr_t end = std::min((addr & ~(iss_addr_t)(this->burst_size - 1)) + this->burst_size,
+        stream_end);
+
+    // Only the stream elements are read, and there is nothing to gain if the burst would
+    // only hold the requested one
+    if (addr < mover->config.REG_RPTR[mover->config.DIM] || end <= addr + size)
+    {
+        return false;
+    }
+
+    this->trace.msg(vp::Trace::LEVEL_TRACE, "Burst request (addr: 0x%lx, size: 0x%x, data_mover: %d)\n",
+        addr, (int)(end - addr), dm);
+
+    vp::IoReq *req = &mover->burst_req;
+    req->prepare();
+    req->set_addr(addr);
+    req->set_size(end - addr);
+    req->set_is_write(false);
+    req->set_data(mover->burst_data);
+
+    int err = this->get_port(dm)->req(req);
+    if (err == vp::IO_REQ_INVALID)
+    {
+        // The element request reports the error with the address of the faulty element
+        this->trace.msg(vp::Trace::LEVEL_TRACE, "Burst request failed, falling back to element request\n");
+        return false;
+    }
+    else if (err != vp::IO_REQ_OK)
+    {
+        // The target now owns the burst request until it answers, which the data movers do
+        // not wait for, so bursts are stopped on this data mover.
+        this->trace.msg(vp::Trace::LEVEL_TRACE, "Burst request answered asynchronously, disabling bursts on data mover %d\n", dm);
+        mover->burst_disabled = true;
+        return false;
+    }
+
+    mover->burst_valid = true;
+    mover->burst_base = addr;
+    mover->burst_len = end - addr;
+    mover->burst_latency = req->get_latency();
+    return true;
+}
+
+
+// Get called when a data mover writes to memory, so that read streams do not return stale data.
+void Ssr::burst_invalidate(iss_addr_t addr, int size)
+{
+    for (int i=0; i<3; i++)
+    {
+        DataMover *mover = this->get_dm(i);
+        if (mover->burst_valid && addr < mover->burst_base + mover->burst_len &&
+            addr + size > mover->burst_base)
+        {
+            mover->burst_valid = false;
+        }
+    }
+}
+
+
 // Get called when the fifo reads data from memory.
 inline bool Ssr::load_float(iss_addr_t addr, uint8_t *data_ptr, int size, int dm)
 {
     iss_addr_t phys_addr = addr;
     bool use_mem_array = false;
 
+    if (this->burst_size != 0)
+    {
+        DataMover *mover = this->get_dm(dm);
+
+        if (!mover->burst_hit(addr, size) && !mover->burst_disabled)
+        {
+            iss_addr_t stream_end = mover->burst_stream_end(size);
+            if (stream_end != 0 && addr + size <= stream_end)
+            {
+                this->burst_fill(addr, size, stream_end, dm);
+            }
+        }
+
+        if (mover->burst_hit(addr, size))
+        {
+            // Served locally. The latency of the burst is applied to each element, like it
+            // would be for an element request, so that the data lane timing is unchanged.
+            this->trace.msg("Data request served from burst (addr: 0x%lx, size: 0x%x, data_mover: %d)\n",
+                addr, size, dm);
+            memcpy(data_ptr, &mover->burst_data[addr - mover->burst_base], size);
+            this->get_event(dm)->stall_cycle_set(mover->burst_latency);
+            return false;
+        }
+    }
+
     int err = 0;
     int64_t latency = 0;
     if ((err = this->data_req(phys_addr, (uint8_t *)data_ptr, size, false, latency, dm)) == 0)
@@ -654,6 +822,11 @@ inline bool Ssr::store_float(iss_addr_t addr, uint8_t *data_ptr, int size, int d
     iss_addr_t phys_addr = addr;
     bool use_mem_array = false;
 
+    if (this->burst_size != 0)
+    {
+        this->burst_invalidate(addr, size);
+    }
+
     int err = 0;
     int64_t latency = 0;
     if ((err = this->data_req(phys_addr, (uint8_t *)data_ptr, size, true, latency, dm)) == 0)
@@ -54,6 +54,11 @@ FpuLsu::FpuLsu(IssWrapper &top, Iss &iss)
 template<typename T>
 bool FpuLsu::load_float(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
+    if (this->iss.gdbserver.watchpoint_check(false, addr, size))
+    {
+        return true;
+    }
+
     iss_addr_t phys_addr = addr;
     bool use_mem_array;
 
@@ -120,6 +125,11 @@ bool FpuLsu::load_float(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 template<typename T>
 bool FpuLsu::store_float(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
+    if (this->iss.gdbserver.watchpoint_check(true, addr, size))
+    {
+        return true;
+    }
+
     iss_addr_t phys_addr = addr;
     bool use_mem_array;
 
@@ -184,10 +194,6 @@ bool FpuLsu::store_float(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 template<typename T>
 bool FpuLsu::load_float_perf(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
-    if (this->iss.gdbserver.watchpoint_check(false, addr, size))
-    {
-        return true;
-    }
     this->iss.timing.event_load_account(1);
     return this->load_float<T>(insn, addr, size, reg);
 }
@@ -195,10 +201,6 @@ bool FpuLsu::load_float_perf(iss_insn_t *insn, iss_addr_t addr, int size, int re
 template<typename T>
 bool FpuLsu::store_float_perf(iss_insn_t *insn, iss_addr_t addr, int size, int reg)
 {
-    if (this->iss.gdbserver.watchpoint_check(true, addr, size))
-    {
-        return true;
-    }
     this->iss.timing.event_store_account(1);
     return this->store_float<T>(insn, addr, size, reg);
 }
@@ -72,6 +72,11 @@ void Exec::build()
 
     this->bootaddr_offset = this->iss.top.get_js_config()->get_child_int("bootaddr_offset");
 
+    // Block execution is not supported by this core, only keep the state consistent
+    this->block_size = 1;
+    this->block_break = false;
+    this->block_cycles = 0;
+
 
     this->current_insn = 0;
     this->stall_insn = 0;
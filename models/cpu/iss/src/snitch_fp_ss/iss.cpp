@@ -40,6 +40,7 @@ void IssWrapper::start()
 void IssWrapper::stop()
 {
     this->iss.insn_cache.stop();
+    this->iss.trace.stop();
     this->iss.gdbserver.stop();
 }
 
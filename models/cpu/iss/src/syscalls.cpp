@@ -28,7 +28,10 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <limits.h>
 #include <vp/itf/io.hpp>
+#include <vp/debug_mem.hpp>
+#include <utils/dmi.hpp>
 
 #ifndef O_BINARY
 #define O_BINARY 0
@@ -50,6 +53,9 @@ void Syscalls::build()
         this->pcer_info[i].name = "";
     }
 
+    js::Config *sync_writes = iss.top.get_js_config()->get("syscalls_fsync");
+    this->sync_writes = sync_writes != NULL && sync_writes->get_bool();
+
     this->htif.build();
 }
 
@@ -116,7 +122,87 @@ void Syscalls::handle_ebreak()
     }
 }
 
+void Syscalls::backdoors_resolve()
+{
+    if (this->backdoors_resolved) return;
+    this->backdoors_resolved = true;
+
+    this->dmi_if = dmi_if_get(&this->iss.lsu.data);
+
+    std::vector<vp::SlavePort *> finals = this->iss.lsu.data.get_final_ports();
+    if (!finals.empty() && finals[0]->get_owner() != nullptr)
+    {
+        this->debug_mem = finals[0]->get_owner()->debug_mem_if();
+    }
+}
+
+bool Syscalls::user_map(iss_addr_t addr, iss_addr_t size, bool is_write,
+    std::vector<struct iovec> &iov)
+{
+    this->backdoors_resolve();
+
+    iov.clear();
+
+    if (this->dmi_if == NULL) return false;
+
+    while (size != 0)
+    {
+        // Grants are only used during the syscall, no need to be told when they are dropped
+        DmiGrant grant;
+        if (!this->dmi_if->dmi_get(addr, grant, NULL) || (is_write && !grant.writable) ||
+            iov.size() == IOV_MAX)
+        {
+            return false;
+        }
+
+        uint64_t offset = addr - grant.base;
+        uint64_t iter_size = std::min((uint64_t)size, grant.size - offset);
+
+        iov.push_back({ grant.host + offset, iter_size });
+
+        if (grant.latency > this->latency)
+        {
+            this->latency = grant.latency;
+        }
+
+        addr += iter_size;
+        size -= iter_size;
+    }
+
+    return true;
+}
+
 bool Syscalls::user_access(iss_addr_t addr, uint8_t *buffer, iss_addr_t size, bool is_write)
+{
+    // Memories giving direct access are copied from the host
+    if (this->user_map(addr, size, is_write, this->iov))
+    {
+        for (struct iovec &host: this->iov)
+        {
+            if (is_write)
+            {
+                memcpy(host.iov_base, buffer, host.iov_len);
+            }
+            else
+            {
+                memcpy(buffer, host.iov_base, host.iov_len);
+            }
+            buffer += host.iov_len;
+        }
+        return false;
+    }
+
+    // Then the zero-time backdoor also used by the gdbserver
+    if (this->debug_mem && !this->debug_mem->debug_mem_access(addr, buffer, size, is_write))
+    {
+        return false;
+    }
+
+    // Regions without any backdoor are accessed byte per byte through debug requests
+    return this->user_access_io(addr, buffer, size, is_write);
+}
+
+bool Syscalls::user_access_io(iss_addr_t addr, uint8_t *buffer, iss_addr_t size, bool is_write)
 {
     vp::IoReq *req = &this->iss.lsu.debug_req;
     std::string str = "";
@@ -159,10 +245,69 @@ bool Syscalls::user_access(iss_addr_t addr, uint8_t *buffer, iss_addr_t size, bo
     return false;
 }
 
+int64_t Syscalls::host_io(int fd, std::vector<struct iovec> &iov, bool to_file, bool &error)
+{
+    int64_t done = 0;
+    size_t index = 0;
+
+    error = false;
+
+    // Stop at the first short transfer, like the end of a file
+    while (index < iov.size())
+    {
+        ssize_t size = to_file ? writev(fd, &iov[index], iov.size() - index) :
+            readv(fd, &iov[index], iov.size() - index);
+        if (size <= 0)
+        {
+            error = size < 0;
+            break;
+        }
+
+        done += size;
+
+        while (index < iov.size() && (size_t)size >= iov[index].iov_len)
+        {
+            size -= iov[index].iov_len;
+            index++;
+        }
+        if (size > 0)
+        {
+            break;
+        }
+    }
+
+    return done;
+}
+
 std::string Syscalls::read_user_string(iss_addr_t addr, int size)
 {
     vp::IoReq *req = &this->iss.lsu.debug_req;
     std::string str = "";
+
+    // Look for the end of the string directly in the memories giving direct access
+    this->backdoors_resolve();
+    DmiGrant grant;
+    while (size != 0 && this->dmi_if && this->dmi_if->dmi_get(addr, grant, NULL))
+    {
+        uint8_t *host = grant.host + (addr - grant.base);
+        uint64_t len = grant.size - (addr - grant.base);
+        if (size > 0 && len > (uint64_t)size)
+        {
+            len = size;
+        }
+
+        uint8_t *end = (uint8_t *)memchr(host, 0, len);
+        if (end)
+        {
+            return str.append((char *)host, end - host);
+        }
+
+        str.append((char *)host, len);
+        addr += len;
+        if (size > 0)
+            size -= len;
+    }
+
     while (size != 0)
     {
         uint8_t buffer;
@@ -258,28 +403,39 @@ void Syscalls::handle_riscv_ebreak()
             return;
         }
 
-        uint8_t buffer[1024];
         int size = args[2];
         iss_reg_t addr = args[1];
-        while (size)
-        {
-            int iter_size = 1024;
-            if (size < 1024)
-                iter_size = size;
 
-            if (this->user_access(addr, buffer, iter_size, false))
+        // Buffers in memories giving direct access are written to the file without any copy
+        if (this->user_map(addr, size, false, this->iov))
+        {
+            bool error;
+            size -= this->host_io(args[0], this->iov, true, error);
+        }
+        else
+        {
+            std::vector<uint8_t> buffer(std::min(size, SYSCALLS_CHUNK_SIZE));
+            while (size)
             {
-                this->iss.regfile.regs[10] = -1;
-                return;
-            }
+                int iter_size = std::min(size, SYSCALLS_CHUNK_SIZE);
 
-            if (write(args[0], (void *)(long)buffer, iter_size) != iter_size)
-                break;
+                if (this->user_access(addr, buffer.data(), iter_size, false))
+                {
+                    this->iss.regfile.regs[10] = -1;
+                    return;
+                }
 
-            fsync(args[0]);
+                if (write(args[0], buffer.data(), iter_size) != iter_size)
+                    break;
 
-            size -= iter_size;
-            addr += iter_size;
+                size -= iter_size;
+                addr += iter_size;
+            }
+        }
+
+        if (this->sync_writes)
+        {
+            fsync(args[0]);
         }
 
         this->iss.regfile.regs[10] = size;
@@ -295,16 +451,24 @@ void Syscalls::handle_riscv_ebreak()
             return;
         }
 
-        uint8_t buffer[1024];
         int size = args[2];
         iss_reg_t addr = args[1];
+
+        // Buffers in memories giving direct access are read from the file without any copy
+        if (this->user_map(addr, size, true, this->iov))
+        {
+            bool error;
+            size -= this->host_io(args[0], this->iov, false, error);
+            this->iss.regfile.regs[10] = error ? -1 : size;
+            break;
+        }
+
+        std::vector<uint8_t> buffer(std::min(size, SYSCALLS_CHUNK_SIZE));
         while (size)
         {
-            int iter_size = 1024;
-            if (size < 1024)
-                iter_size = size;
+            int iter_size = std::min(size, SYSCALLS_CHUNK_SIZE);
 
-            int read_size = read(args[0], (void *)(long)buffer, iter_size);
+            int read_size = read(args[0], buffer.data(), iter_size);
 
             if (read_size <= 0)
             {
@@ -319,7 +483,7 @@ void Syscalls::handle_riscv_ebreak()
                 }
             }
 
-            if (this->user_access(addr, buffer, read_size, true))
+            if (this->user_access(addr, buffer.data(), read_size, true))
             {
                 this->iss.regfile.regs[10] = -1;
                 return;
@@ -20,6 +20,7 @@
  */
 
 #include "cpu/iss/include/iss.hpp"
+#include "cpu/iss/include/trace_format.hpp"
 #include <string.h>
 #include <algorithm>
 #include <vector>
@@ -66,6 +67,13 @@ void Trace::build()
     }
 #endif
 
+    // The binary trace file is only opened when the first instruction is dumped, so that
+    // nothing is created if the instruction trace is not active
+    js::Config *binary_config = this->iss.top.get_js_config()->get("insn_trace_binary");
+    if (binary_config != NULL)
+    {
+        this->binary_prefix = binary_config->get_str();
+    }
 }
 
 void Trace::reset(bool active)
@@ -78,9 +86,12 @@ void Trace::reset(bool active)
     }
 }
 
-#define PC_INFO_ARRAY_SIZE (64 * 1024)
+void Trace::stop()
+{
+    this->binary.close();
+}
 
-#define MAX_DEBUG_INFO_WIDTH 32
+#define PC_INFO_ARRAY_SIZE (64 * 1024)
 
 class iss_pc_info
 {
@@ -226,550 +237,191 @@ void iss_register_debug_elf(Iss *iss, const char *binary)
 #endif
 }
 
-static inline char iss_trace_get_mode(int mode)
-{
-    switch (mode)
-    {
-    case 0:
-        return 'U';
-    case 1:
-        return 'S';
-    case 2:
-        return 'H';
-    case 3:
-        return 'M';
-    }
-    return ' ';
-}
-
-static inline int iss_trace_dump_reg(Iss *iss, iss_insn_t *insn, iss_decoder_arg_t *arg, char *buff, unsigned int reg, bool is_long = true)
-{
-    if (is_long)
-    {
-        if (arg->flags & ISS_DECODER_ARG_FLAG_VREG)
-        {
-            return sprintf(buff, "v%d", reg);
-        }
-        else
-        {
-#ifndef ISS_SINGLE_REGFILE
-            if (arg->flags & ISS_DECODER_ARG_FLAG_FREG)
-            {
-                return sprintf(buff, "f%d", reg);
-            }
-            else
-#endif
-            {
-                if (reg == 0)
-                {
-                    return sprintf(buff, "0");
-                }
-                else if (reg == 1)
-                {
-                    return sprintf(buff, "ra");
-                }
-                else if (reg == 2)
-                {
-                    return sprintf(buff, "sp");
-                }
-                else if (reg >= 8 && reg <= 9)
-                {
-                    return sprintf(buff, "s%d", reg - 8);
-                }
-                else if (reg >= 18 && reg <= 27)
-                {
-                    return sprintf(buff, "s%d", reg - 16);
-                }
-                else if (reg == 4)
-                {
-                    return sprintf(buff, "tp");
-                }
-                else if (reg >= 10 && reg <= 17)
-                {
-                    return sprintf(buff, "a%d", reg - 10);
-                }
-                else if (reg >= 5 && reg <= 7)
-                {
-                    return sprintf(buff, "t%d", reg - 5);
-                }
-                else if (reg >= 28 && reg <= 31)
-                {
-                    return sprintf(buff, "t%d", reg - 25);
-                }
-                else if (reg == 3)
-                {
-                    return sprintf(buff, "gp");
-                }
-                else if (reg >= ISS_NB_REGS)
-                {
-                    return sprintf(buff, "f%d", reg - ISS_NB_REGS);
-                }
-            }
-        }
-    }
-
-    return sprintf(buff, "x%d", reg);
-}
-
-static char *iss_trace_dump_reg_value_check(Iss *iss, char *buff, int size, uint64_t saved_value, uint64_t check_saved_value)
-{
-    uint8_t *check = (uint8_t *)&check_saved_value;
-    uint8_t *value = (uint8_t *)&saved_value;
-    for (int i=size*2-1; i>=0; i--)
-    {
-        uint8_t check = (check_saved_value >> (i*4)) & 0xF;
-        uint8_t value = (saved_value >> (i*4)) & 0xF;
-        if (check == 0xF)
-        {
-            buff += sprintf(buff, "%1.1x", value);
-        }
-        else
-        {
-            buff += sprintf(buff, "X");
-        }
-    }
-    buff += sprintf(buff, " ");
-
-    return buff;
-}
-
-static char *dump_vector(Iss *iss, char *buff, int reg, bool is_float, uint8_t *saved_arg)
+// The formatting code (trace_format.hpp) uses the argument types and flags of the binary trace
+static_assert(ISS_TRACE_BIN_ARG_NONE == ISS_DECODER_ARG_TYPE_NONE &&
+    ISS_TRACE_BIN_ARG_OUT_REG == ISS_DECODER_ARG_TYPE_OUT_REG &&
+    ISS_TRACE_BIN_ARG_IN_REG == ISS_DECODER_ARG_TYPE_IN_REG &&
+    ISS_TRACE_BIN_ARG_UIMM == ISS_DECODER_ARG_TYPE_UIMM &&
+    ISS_TRACE_BIN_ARG_SIMM == ISS_DECODER_ARG_TYPE_SIMM &&
+    ISS_TRACE_BIN_ARG_INDIRECT_IMM == ISS_DECODER_ARG_TYPE_INDIRECT_IMM &&
+    ISS_TRACE_BIN_ARG_INDIRECT_REG == ISS_DECODER_ARG_TYPE_INDIRECT_REG &&
+    ISS_TRACE_BIN_ARG_FLAG == ISS_DECODER_ARG_TYPE_FLAG, "Binary trace argument types mismatch");
+static_assert(ISS_TRACE_BIN_ARG_FLAG_POSTINC == ISS_DECODER_ARG_FLAG_POSTINC &&
+    ISS_TRACE_BIN_ARG_FLAG_PREINC == ISS_DECODER_ARG_FLAG_PREINC &&
+    ISS_TRACE_BIN_ARG_FLAG_FREG == ISS_DECODER_ARG_FLAG_FREG &&
+    ISS_TRACE_BIN_ARG_FLAG_REG64 == ISS_DECODER_ARG_FLAG_REG64 &&
+    ISS_TRACE_BIN_ARG_FLAG_DUMP_NAME == ISS_DECODER_ARG_FLAG_DUMP_NAME &&
+    ISS_TRACE_BIN_ARG_FLAG_VREG == ISS_DECODER_ARG_FLAG_VREG &&
+    ISS_TRACE_BIN_ARG_FLAG_ELEM_32 == ISS_DECODER_ARG_FLAG_ELEM_32 &&
+    ISS_TRACE_BIN_ARG_FLAG_ELEM_16 == ISS_DECODER_ARG_FLAG_ELEM_16 &&
+    ISS_TRACE_BIN_ARG_FLAG_ELEM_16A == ISS_DECODER_ARG_FLAG_ELEM_16A &&
+    ISS_TRACE_BIN_ARG_FLAG_ELEM_8 == ISS_DECODER_ARG_FLAG_ELEM_8 &&
+    ISS_TRACE_BIN_ARG_FLAG_ELEM_8A == ISS_DECODER_ARG_FLAG_ELEM_8A &&
+    ISS_TRACE_BIN_ARG_FLAG_ELEM_64 == ISS_DECODER_ARG_FLAG_ELEM_64 &&
+    ISS_TRACE_BIN_ARG_FLAG_VEC == ISS_DECODER_ARG_FLAG_VEC &&
+    ISS_TRACE_BIN_ARG_FLAG_ELEM_SEW == ISS_DECODER_ARG_FLAG_ELEM_SEW,
+    "Binary trace argument flags mismatch");
+
+// Gives the trace formatter (trace_format.hpp) access to the instruction being traced and
+// to the values saved while it was executed
+class IssTraceFmtSrc
 {
-#ifdef CONFIG_ISS_HAS_VECTOR
-    buff += sprintf(buff, "[");
-
-    int width = iss->vector.sewb;
-    unsigned int lmul = iss->vector.lmul;
-
-    for (int i=CONFIG_ISS_VLEN/8/width*lmul - 1; i>=0; i--)
-    {
-        uint8_t *vreg = &((uint8_t *)saved_arg)[i*width];
-        uint64_t value = *(uint64_t *)vreg;
-
-        bool float_hex = iss->top.traces.get_trace_engine()->get_trace_float_hex();
-
-        if (is_float && !float_hex)
-        {
-            uint64_t value_64 = LIB_FF_CALL4(lib_flexfloat_cvt_ff_ff_round, value,
-                iss->vector.exp, iss->vector.mant, 11, 52, 0);
-            buff += sprintf(buff, "%f", *(double *)&value_64);
-        }
-        else
-        {
-            uint64_t mask;
-            if (width >= 8)
-            {
-                mask = ~0ULL;
-            }
-            else
-            {
-                mask = (1ULL << (width * 8)) - 1;
-            }
-
-            buff += sprintf(buff, "%0*llx", width*2, value & mask);
-        }
-        if (i != 0)
-        {
-            buff += sprintf(buff, ", ");
-        }
-    }
-
-    buff += sprintf(buff, "] ");
+public:
+    IssTraceFmtSrc(Iss *iss, iss_insn_t *insn, iss_reg_t pc, iss_insn_arg_t *saved_args,
+        int mode)
+        : iss(iss), insn(insn), saved_args(saved_args), insn_pc(pc), insn_mode(mode) {}
+
+    int reg_width() { return ISS_REG_WIDTH; }
+    int fp_width() { return CONFIG_GVSOC_ISS_FP_WIDTH; }
+    bool float_hex() { return this->iss->top.traces.get_trace_engine()->get_trace_float_hex(); }
+    bool memcheck() { return this->iss->top.traces.get_trace_engine()->is_memcheck_enabled(); }
+    bool has_double() { return this->iss->decode.has_double; }
+#ifdef ISS_SINGLE_REGFILE
+    bool single_regfile() { return true; }
+#else
+    bool single_regfile() { return false; }
 #endif
 
-    return buff;
-}
-
-static char *dump_float_vector(Iss *iss, char *buff, int full_width, int width, int exp, int mant, bool is_vec, iss_freg_t value)
-{
-    if (!is_vec || full_width == width)
+    uint64_t float_to_f64(uint64_t value, int exp, int mant)
     {
-        uint64_t value_64;
-        if (width == 64)
-        {
-            value_64 = value;
-        }
-        else
-        {
-            value_64 = LIB_FF_CALL4(lib_flexfloat_cvt_ff_ff_round, value, exp, mant, 11, 52, 0);
-        }
-
-        buff += sprintf(buff, "%f ", *(double *)&value_64);
-    }
-    else
-    {
-        buff += sprintf(buff, "[");
-
-        for (int i=full_width / width - 1; i>=0; i--)
-        {
-            uint64_t value_64 = LIB_FF_CALL4(lib_flexfloat_cvt_ff_ff_round, value >> (i*width), exp, mant, 11, 52, 0);
-            buff += sprintf(buff, "%f", *(double *)&value_64);
-            if (i != 0)
-            {
-                buff += sprintf(buff, ", ");
-            }
-        }
-
-        buff += sprintf(buff, "] ");
+        Iss *iss = this->iss;
+        return LIB_FF_CALL4(lib_flexfloat_cvt_ff_ff_round, value, exp, mant, 11, 52, 0);
     }
 
-    return buff;
-}
-
-static char *iss_trace_dump_reg_value(Iss *iss, iss_insn_t *insn, char *buff, bool is_out, int reg,
-    uint64_t saved_value, uint64_t check_saved_value, iss_decoder_arg_t *arg,
-    iss_decoder_arg_t **prev_arg, bool is_long, uint8_t *saved_varg)
-{
-    char regStr[16];
-    iss_trace_dump_reg(iss, insn, arg, regStr, reg, is_long);
-    if (is_long)
-        buff += sprintf(buff, "%3.3s", regStr);
-    else
-        buff += sprintf(buff, "%s", regStr);
-
-    if (is_out)
-        buff += sprintf(buff, "=");
-    else
-        buff += sprintf(buff, ":");
-    if (arg->flags & ISS_DECODER_ARG_FLAG_REG64)
-    {
-        if (iss->top.traces.get_trace_engine()->is_memcheck_enabled() && (iss_reg_t)check_saved_value != (iss_reg_t)-1)
-        {
-            buff = iss_trace_dump_reg_value_check(iss, buff, sizeof(iss_reg64_t), saved_value, check_saved_value);
-        }
-        else
-        {
-            buff += sprintf(buff, "%" PRIxFULLREG64 " ", saved_value);
-        }
-    }
-    else if (arg->flags & ISS_DECODER_ARG_FLAG_VREG)
+    bool debug_info(uint64_t pc, const char **func, int *line)
     {
-        buff = dump_vector(iss, buff, reg, arg->flags & ISS_DECODER_ARG_FLAG_FREG, saved_varg);
-    }
-    else if (arg->flags & ISS_DECODER_ARG_FLAG_FREG)
-    {
-        bool float_hex = iss->top.traces.get_trace_engine()->get_trace_float_hex();
+        if (binaries.size() == 0)
+            return false;
 
-        if (!float_hex && arg->flags & ISS_DECODER_ARG_FLAG_ELEM_SEW)
-        {
-            buff = dump_float_vector(iss, buff, CONFIG_GVSOC_ISS_FP_WIDTH, 64, 11, 52, false, saved_value);
-        }
-        else if (!float_hex && arg->flags & ISS_DECODER_ARG_FLAG_ELEM_64)
-        {
-            buff = dump_float_vector(iss, buff, CONFIG_GVSOC_ISS_FP_WIDTH, 64, 11, 52, arg->flags & ISS_DECODER_ARG_FLAG_VEC, saved_value);
-        }
-        else if (!float_hex && arg->flags & ISS_DECODER_ARG_FLAG_ELEM_32)
-        {
-            buff = dump_float_vector(iss, buff, CONFIG_GVSOC_ISS_FP_WIDTH, 32, 8, 23, arg->flags & ISS_DECODER_ARG_FLAG_VEC, saved_value);
-        }
-        else if (!float_hex && arg->flags & ISS_DECODER_ARG_FLAG_ELEM_16)
-        {
-            buff = dump_float_vector(iss, buff, CONFIG_GVSOC_ISS_FP_WIDTH, 16, 5, 10, arg->flags & ISS_DECODER_ARG_FLAG_VEC, saved_value);
-        }
-        else if (!float_hex && arg->flags & ISS_DECODER_ARG_FLAG_ELEM_16A)
-        {
-            buff = dump_float_vector(iss, buff, CONFIG_GVSOC_ISS_FP_WIDTH, 16, 8, 7, arg->flags & ISS_DECODER_ARG_FLAG_VEC, saved_value);
-        }
-        else if (!float_hex && arg->flags & ISS_DECODER_ARG_FLAG_ELEM_8)
-        {
-            buff = dump_float_vector(iss, buff, CONFIG_GVSOC_ISS_FP_WIDTH, 8, 5, 2, arg->flags & ISS_DECODER_ARG_FLAG_VEC, saved_value);
-        }
-        else if (!float_hex && arg->flags & ISS_DECODER_ARG_FLAG_ELEM_8A)
-        {
-            buff = dump_float_vector(iss, buff, CONFIG_GVSOC_ISS_FP_WIDTH, 8, 4, 3, arg->flags & ISS_DECODER_ARG_FLAG_VEC, saved_value);
-        }
-        else
+        *func = "-";
+        *line = 0;
+        iss_pc_info *pc_info = iss_pc_info_get(pc);
+        if (pc_info && pc_info->valid)
         {
-            if (iss->decode.has_double)
-            {
-                buff += sprintf(buff, "%16.16lx ", (uint64_t)saved_value);
-            }
-            else
-            {
-                buff += sprintf(buff, "%8.8x ", (uint32_t)saved_value);
-            }
+            *func = pc_info->inline_func;
+            *line = pc_info->line;
         }
+        return true;
     }
-    else
-    {
-        if (iss->top.traces.get_trace_engine()->is_memcheck_enabled() && (iss_reg_t)check_saved_value != (iss_reg_t)-1)
-        {
-            buff = iss_trace_dump_reg_value_check(iss, buff, sizeof(iss_reg_t), saved_value, check_saved_value);
-        }
-        else
-        {
-            buff += sprintf(buff, "%" PRIxFULLREG " ", (iss_reg_t)saved_value);
-        }
-    }
-    return buff;
-}
 
-static char *iss_trace_dump_arg_value(Iss *iss, iss_insn_t *insn, char *buff,
-    iss_insn_arg_t *insn_arg, iss_decoder_arg_t *arg, iss_insn_arg_t *saved_arg,
-    iss_decoder_arg_t **prev_arg, int dump_out, bool is_long, uint8_t *saved_varg)
-{
-    if ((arg->type == ISS_DECODER_ARG_TYPE_OUT_REG || arg->type == ISS_DECODER_ARG_TYPE_IN_REG) && (insn_arg->u.reg.index != 0 || arg->flags & ISS_DECODER_ARG_FLAG_FREG || arg->flags & ISS_DECODER_ARG_FLAG_VREG))
-    {
-        if ((dump_out && arg->type == ISS_DECODER_ARG_TYPE_OUT_REG) || (!dump_out && arg->type == ISS_DECODER_ARG_TYPE_IN_REG))
-        {
-            buff = iss_trace_dump_reg_value(iss, insn, buff, arg->type == ISS_DECODER_ARG_TYPE_OUT_REG, insn_arg->u.reg.index,
-                (arg->flags & ISS_DECODER_ARG_FLAG_REG64) || (arg->flags & ISS_DECODER_ARG_FLAG_FREG) ? saved_arg->u.reg.value_64 : saved_arg->u.reg.value,
-                (arg->flags & ISS_DECODER_ARG_FLAG_REG64) ? saved_arg->u.reg.memcheck_value_64 : saved_arg->u.reg.memcheck_value,
-                arg, prev_arg, is_long, saved_varg);
-        }
-    }
-    else if (arg->type == ISS_DECODER_ARG_TYPE_INDIRECT_IMM)
-    {
-        if (!dump_out)
-            buff = iss_trace_dump_reg_value(iss, insn, buff, 0, insn_arg->u.indirect_imm.reg_index,
-                saved_arg->u.indirect_imm.reg_value, saved_arg->u.indirect_imm.memcheck_reg_value, arg, prev_arg, is_long, saved_varg);
-        iss_addr_t addr;
-        if (arg->flags & ISS_DECODER_ARG_FLAG_POSTINC)
-        {
-            addr = saved_arg->u.indirect_imm.reg_value;
-            if (dump_out)
-                buff = iss_trace_dump_reg_value(iss, insn, buff, 1,
-                    insn_arg->u.indirect_imm.reg_index, addr + insn_arg->u.indirect_imm.imm, saved_arg->u.indirect_imm.memcheck_reg_value, arg, prev_arg, is_long, saved_varg);
-        }
-        else
-        {
-            addr = saved_arg->u.indirect_imm.reg_value + insn_arg->u.indirect_imm.imm;
-        }
-        if (!dump_out)
-            buff += sprintf(buff, " PA:%" PRIxFULLREG " ", addr);
-    }
-    else if (arg->type == ISS_DECODER_ARG_TYPE_INDIRECT_REG)
-    {
-        if (!dump_out)
-            buff = iss_trace_dump_reg_value(iss, insn, buff, 0, insn_arg->u.indirect_reg.offset_reg_index,
-                saved_arg->u.indirect_reg.offset_reg_value, saved_arg->u.indirect_reg.memcheck_offset_reg_value, arg, prev_arg, is_long, saved_varg);
-        if (!dump_out)
-            buff = iss_trace_dump_reg_value(iss, insn, buff, 0, insn_arg->u.indirect_reg.base_reg_index,
-                saved_arg->u.indirect_reg.base_reg_value, saved_arg->u.indirect_reg.memcheck_base_reg_value, arg, prev_arg, is_long, saved_varg);
-        iss_addr_t addr;
-        if (arg->flags & ISS_DECODER_ARG_FLAG_POSTINC)
-        {
-            addr = saved_arg->u.indirect_reg.base_reg_value;
-            if (dump_out)
-                buff = iss_trace_dump_reg_value(iss, insn, buff, 1,
-                    insn_arg->u.indirect_reg.base_reg_index, addr + insn_arg->u.indirect_reg.offset_reg_value, saved_arg->u.indirect_reg.memcheck_offset_reg_value, arg, prev_arg, is_long, saved_varg);
-        }
-        else
-        {
-            addr = saved_arg->u.indirect_reg.base_reg_value + saved_arg->u.indirect_reg.offset_reg_value;
-        }
-        if (!dump_out)
-            buff += sprintf(buff, " PA:%" PRIxFULLREG " ", addr);
-    }
-    *prev_arg = arg;
-    return buff;
-}
+    uint64_t opcode() { return this->insn->opcode; }
+    const char *label() { return this->insn->decoder_item->u.insn.label; }
+    int nb_args() { return this->insn->decoder_item->u.insn.nb_args; }
+    int arg_order(int i) { return this->insn->decoder_item->u.insn.args_order[i]; }
 
-static char *iss_trace_dump_arg(Iss *iss, iss_insn_t *insn, char *buff, iss_insn_arg_t *insn_arg, iss_decoder_arg_t *arg, iss_decoder_arg_t **prev_arg, bool is_long)
-{
-    if (*prev_arg != NULL && (*prev_arg)->type != ISS_DECODER_ARG_TYPE_NONE && (*prev_arg)->type != ISS_DECODER_ARG_TYPE_FLAG && ((arg->type != ISS_DECODER_ARG_TYPE_IN_REG && arg->type != ISS_DECODER_ARG_TYPE_OUT_REG) || arg->u.reg.dump_name))
+    IssTraceFmtArg arg(int id)
     {
-        if (is_long)
-            buff += sprintf(buff, ", ");
-        else
-            buff += sprintf(buff, ",");
-    }
+        iss_decoder_arg_t *arg = &this->insn->decoder_item->u.insn.args[id];
+        iss_insn_arg_t *insn_arg = &this->insn->args[id];
+        IssTraceFmtArg result = { arg->type, (uint32_t)arg->flags, false,
+            (uint32_t)insn_arg->flags, insn_arg->name, 0, 0 };
 
-    if (arg->type != ISS_DECODER_ARG_TYPE_NONE)
-    {
-        if (arg->type == ISS_DECODER_ARG_TYPE_OUT_REG || arg->type == ISS_DECODER_ARG_TYPE_IN_REG)
-        {
-            if (arg->u.reg.dump_name)
-                buff += iss_trace_dump_reg(iss, insn, arg, buff, insn_arg->u.reg.index, is_long);
-        }
-        else if (arg->type == ISS_DECODER_ARG_TYPE_UIMM)
-        {
-            if (insn_arg->flags & ISS_DECODER_ARG_FLAG_DUMP_NAME)
-            {
-                buff += sprintf(buff, "%s", insn_arg->name);
-            }
-            else
-            {
-                buff += sprintf(buff, "0x%" PRIxREG, insn_arg->u.uim.value);
-            }
-        }
-        else if (arg->type == ISS_DECODER_ARG_TYPE_SIMM)
-        {
-            if (insn_arg->flags & ISS_DECODER_ARG_FLAG_DUMP_NAME)
-            {
-                buff += sprintf(buff, "%s", insn_arg->name);
-            }
-            else
-            {
-                buff += sprintf(buff, "%" PRIdREG, insn_arg->u.sim.value);
-            }
-        }
-        else if (arg->type == ISS_DECODER_ARG_TYPE_INDIRECT_IMM)
+        switch (arg->type)
         {
-            buff += sprintf(buff, "%" PRIdREG "(", insn_arg->u.indirect_imm.imm);
-            if (arg->flags & ISS_DECODER_ARG_FLAG_PREINC)
-                buff += sprintf(buff, "!");
-            buff += iss_trace_dump_reg(iss, insn, arg, buff, insn_arg->u.indirect_imm.reg_index, is_long);
-            if (arg->flags & ISS_DECODER_ARG_FLAG_POSTINC)
-                buff += sprintf(buff, "!");
-            buff += sprintf(buff, ")");
+            case ISS_DECODER_ARG_TYPE_OUT_REG:
+            case ISS_DECODER_ARG_TYPE_IN_REG:
+                result.a = insn_arg->u.reg.index;
+                result.dump_name = arg->u.reg.dump_name;
+                break;
+            case ISS_DECODER_ARG_TYPE_UIMM:
+                result.a = insn_arg->u.uim.value;
+                break;
+            case ISS_DECODER_ARG_TYPE_SIMM:
+                result.a = insn_arg->u.sim.value;
+                break;
+            case ISS_DECODER_ARG_TYPE_INDIRECT_IMM:
+                result.a = insn_arg->u.indirect_imm.reg_index;
+                result.b = insn_arg->u.indirect_imm.imm;
+                break;
+            case ISS_DECODER_ARG_TYPE_INDIRECT_REG:
+                result.a = insn_arg->u.indirect_reg.base_reg_index;
+                result.b = insn_arg->u.indirect_reg.offset_reg_index;
+                break;
+            default:
+                break;
         }
-        else if (arg->type == ISS_DECODER_ARG_TYPE_INDIRECT_REG)
-        {
-            buff += iss_trace_dump_reg(iss, insn, arg, buff, insn_arg->u.indirect_reg.offset_reg_index, is_long);
-            buff += sprintf(buff, "(");
-            if (arg->flags & ISS_DECODER_ARG_FLAG_PREINC)
-                buff += sprintf(buff, "!");
-            buff += iss_trace_dump_reg(iss, insn, arg, buff, insn_arg->u.indirect_reg.base_reg_index, is_long);
-            if (arg->flags & ISS_DECODER_ARG_FLAG_POSTINC)
-                buff += sprintf(buff, "!");
-            buff += sprintf(buff, ")");
-        }
-        *prev_arg = arg;
-    }
-    return buff;
-}
-
-static char *trace_dump_debug(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *buff)
-{
-    char *name = (char *)"-";
-    char *file = (char *)"-";
-    uint32_t line = 0;
-    char *inline_func = (char *)"-";
-    iss_pc_info *pc_info = iss_pc_info_get(pc);
-    if (pc_info && pc_info->valid)
-    {
-        name = pc_info->func;
-        file = pc_info->file;
-        line = pc_info->line;
-        inline_func = pc_info->inline_func;
-    }
-
-    int line_len = sprintf(buff, ":%d", line);
-    if (line_len > 5)
-        line_len = 5;
-    int max_name_len = MAX_DEBUG_INFO_WIDTH - line_len;
-
-    int len = snprintf(buff, max_name_len + 1, "%s", inline_func);
-    if (len > max_name_len)
-        len = max_name_len;
-
-    len += sprintf(buff + len, ":%d", line);
-
-    char *start_buff = buff;
-
-    if (len > MAX_DEBUG_INFO_WIDTH)
-        len = MAX_DEBUG_INFO_WIDTH;
-
-    for (int i = len; i < MAX_DEBUG_INFO_WIDTH + 1; i++)
-    {
-        sprintf(buff + i, " ");
-    }
-
-    return buff + MAX_DEBUG_INFO_WIDTH + 1;
-}
-
-static void iss_trace_dump_insn(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *buff,
-    int buffer_size, iss_insn_arg_t *saved_args, bool is_long, int mode, bool is_event)
-{
-    char *init_buff = buff;
-    static int max_len = 20;
-    static int max_arg_len = 17;
-    int len;
-
-    if (is_long)
-    {
-        if (binaries.size())
-            buff = trace_dump_debug(iss, insn, pc, buff);
+        return result;
     }
 
-    if (iss->trace.has_reg_dump)
+    uint64_t pc() { return this->insn_pc; }
+    int mode() { return this->insn_mode; }
+    bool has_reg_dump() { return this->iss->trace.has_reg_dump; }
+    uint64_t reg_dump() { return this->iss->trace.reg_dump; }
+    const char *str_dump()
     {
-        buff += sprintf(buff, "%" PRIxFULLREG " ", iss->trace.reg_dump);
+        return this->iss->trace.has_str_dump ? this->iss->trace.str_dump.c_str() : NULL;
     }
 
-    if (iss->trace.has_str_dump)
+    uint64_t value(int id, int slot)
     {
-        buff += sprintf(buff, "%s ", iss->trace.str_dump.c_str());
-    }
-
-    if (!is_event)
-    {
-        buff += sprintf(buff, "%c %" PRIxFULLREG " ", iss_trace_get_mode(mode), pc);
-    }
-
-    if (!is_long)
-    {
-        buff += sprintf(buff, "%" PRIxFULLREG " ", insn->opcode);
-    }
-
-    char *start_buff = buff;
-
-    buff += sprintf(buff, "%s ", insn->decoder_item->u.insn.label);
-
-    if (is_long)
-    {
-        len = buff - start_buff;
-
-        if (len > max_len)
-            max_len = len;
-        else
+        iss_decoder_arg_t *arg = &this->insn->decoder_item->u.insn.args[id];
+        iss_insn_arg_t *saved_arg = &this->saved_args[id];
+        switch (arg->type)
         {
-            memset(buff, ' ', max_len - len);
-            buff += max_len - len;
+            case ISS_DECODER_ARG_TYPE_OUT_REG:
+            case ISS_DECODER_ARG_TYPE_IN_REG:
+                return (arg->flags & ISS_DECODER_ARG_FLAG_REG64) ||
+                    (arg->flags & ISS_DECODER_ARG_FLAG_FREG) ?
+                    saved_arg->u.reg.value_64 : saved_arg->u.reg.value;
+            case ISS_DECODER_ARG_TYPE_INDIRECT_IMM:
+                return saved_arg->u.indirect_imm.reg_value;
+            case ISS_DECODER_ARG_TYPE_INDIRECT_REG:
+                return slot == 0 ? saved_arg->u.indirect_reg.base_reg_value :
+                    saved_arg->u.indirect_reg.offset_reg_value;
+            default:
+                return 0;
         }
     }
 
-    iss_decoder_arg_t *prev_arg = NULL;
-    start_buff = buff;
-    int nb_args = insn->decoder_item->u.insn.nb_args;
-    for (int i = 0; i < nb_args; i++)
-    {
-        int arg_id = insn->decoder_item->u.insn.args_order[i];
-        buff = iss_trace_dump_arg(iss, insn, buff, &insn->args[arg_id], &insn->decoder_item->u.insn.args[arg_id], &prev_arg, is_long);
-    }
-    if (nb_args != 0)
-        buff += sprintf(buff, " ");
-
-    if (!is_event)
+    uint64_t check(int id, int slot)
     {
-        len = buff - start_buff;
-
-        if (len > max_arg_len)
-            max_arg_len = len;
-        else
+        iss_decoder_arg_t *arg = &this->insn->decoder_item->u.insn.args[id];
+        iss_insn_arg_t *saved_arg = &this->saved_args[id];
+        switch (arg->type)
         {
-            memset(buff, ' ', max_arg_len - len);
-            buff += max_arg_len - len;
+            case ISS_DECODER_ARG_TYPE_OUT_REG:
+            case ISS_DECODER_ARG_TYPE_IN_REG:
+                return arg->flags & ISS_DECODER_ARG_FLAG_REG64 ?
+                    saved_arg->u.reg.memcheck_value_64 : saved_arg->u.reg.memcheck_value;
+            case ISS_DECODER_ARG_TYPE_INDIRECT_IMM:
+                return saved_arg->u.indirect_imm.memcheck_reg_value;
+            case ISS_DECODER_ARG_TYPE_INDIRECT_REG:
+                return slot == 0 ? saved_arg->u.indirect_reg.memcheck_base_reg_value :
+                    saved_arg->u.indirect_reg.memcheck_offset_reg_value;
+            default:
+                return 0;
         }
     }
 
-    if (!is_event)
-    {
-        prev_arg = NULL;
-        for (int i = 0; i < nb_args; i++)
-        {
-            int arg_id = insn->decoder_item->u.insn.args_order[i];
 #ifdef CONFIG_ISS_HAS_VECTOR
-            uint8_t *saved_vargs = iss->trace.saved_vargs[arg_id];
+    uint8_t *varg(int id) { return this->iss->trace.saved_vargs[id]; }
+    int vlen() { return CONFIG_ISS_VLEN; }
+    int vsewb() { return this->iss->vector.sewb; }
+    int vlmul() { return this->iss->vector.lmul; }
+    int vexp() { return this->iss->vector.exp; }
+    int vmant() { return this->iss->vector.mant; }
 #else
-            uint8_t *saved_vargs = NULL;
+    uint8_t *varg(int id) { return NULL; }
+    int vlen() { return 0; }
+    int vsewb() { return 1; }
+    int vlmul() { return 1; }
+    int vexp() { return 0; }
+    int vmant() { return 0; }
 #endif
-            buff = iss_trace_dump_arg_value(iss, insn, buff, &insn->args[arg_id], &insn->decoder_item->u.insn.args[arg_id], &saved_args[arg_id], &prev_arg, 1, is_long, saved_vargs);
-        }
-        for (int i = 0; i < nb_args; i++)
-        {
-            int arg_id = insn->decoder_item->u.insn.args_order[i];
-#ifdef CONFIG_ISS_HAS_VECTOR
-            uint8_t *saved_vargs = iss->trace.saved_vargs[arg_id];
-#else
-            uint8_t *saved_vargs = NULL;
-#endif
-            buff = iss_trace_dump_arg_value(iss, insn, buff, &insn->args[arg_id], &insn->decoder_item->u.insn.args[arg_id], &saved_args[arg_id], &prev_arg, 0, is_long, saved_vargs);
-        }
 
-        buff += sprintf(buff, "\n");
-    }
+private:
+    Iss *iss;
+    iss_insn_t *insn;
+    iss_insn_arg_t *saved_args;
+    iss_reg_t insn_pc;
+    int insn_mode;
+};
+
+static void iss_trace_dump_insn(Iss *iss, iss_insn_t *insn, iss_reg_t pc, char *buff,
+    iss_insn_arg_t *saved_args, bool is_long, int mode, bool is_event)
+{
+    IssTraceFmtSrc src(iss, insn, pc, saved_args, mode);
+    iss_trace_fmt_insn(src, buff, is_long, is_event);
 }
 
 static void iss_trace_save_varg(Iss *iss, iss_insn_t *insn, iss_insn_arg_t *insn_arg, iss_decoder_arg_t *arg, uint8_t *saved_arg, bool save_out)
@@ -853,15 +505,265 @@ void iss_trace_save_args(Iss *iss, iss_insn_t *insn, bool save_out)
     }
 }
 
+static void iss_trace_binary_open(Iss *iss)
+{
+    Trace *trace = &iss->trace;
+    IssTraceBinWriter *writer = &trace->binary;
+    std::string core_path = iss->top.get_path();
+
+    // Each core has its own file, named after the prefix and the core path
+    std::string path = core_path + ".bin";
+    std::replace(path.begin(), path.end(), '/', '.');
+    path = trace->binary_prefix + path;
+
+    if (!writer->open(path.c_str()))
+    {
+        trace->insn_trace.fatal("Unable to open binary instruction trace (path: %s)\n", path.c_str());
+        return;
+    }
+
+    uint32_t flags = 0;
+    if (iss->top.traces.get_trace_engine()->get_format() == TRACE_FORMAT_LONG)
+        flags |= ISS_TRACE_BIN_FLAG_LONG;
+    if (iss->top.traces.get_trace_engine()->get_trace_float_hex())
+        flags |= ISS_TRACE_BIN_FLAG_FLOAT_HEX;
+    if (iss->top.traces.get_trace_engine()->is_memcheck_enabled())
+        flags |= ISS_TRACE_BIN_FLAG_MEMCHECK;
+    if (iss->decode.has_double)
+        flags |= ISS_TRACE_BIN_FLAG_HAS_DOUBLE;
+#ifdef ISS_SINGLE_REGFILE
+    flags |= ISS_TRACE_BIN_FLAG_SINGLE_REGFILE;
+#endif
+
+#ifdef CONFIG_ISS_HAS_VECTOR
+    uint32_t vlen = CONFIG_ISS_VLEN;
+#else
+    uint32_t vlen = 0;
+#endif
+
+    writer->reserve(16 + IssTraceBinWriter::str_size(core_path.c_str()));
+    writer->put<uint32_t>(ISS_TRACE_BIN_MAGIC);
+    writer->put<uint16_t>(ISS_TRACE_BIN_VERSION);
+    writer->put<uint8_t>(ISS_REG_WIDTH);
+    writer->put<uint8_t>(CONFIG_GVSOC_ISS_FP_WIDTH);
+    writer->put<uint32_t>(flags);
+    writer->put<uint32_t>(vlen);
+    writer->put_str(core_path.c_str());
+
+    trace->binary_defs.clear();
+    trace->binary_nb_elfs = 0;
+}
+
+// Return the identifier of the instruction in the binary trace, and describe it first if
+// it is traced for the first time
+static int iss_trace_binary_def(Iss *iss, iss_insn_t *insn)
+{
+    Trace *trace = &iss->trace;
+    IssTraceBinWriter *writer = &trace->binary;
+    int id = insn->trace_id;
+
+    if (id >= 0 && id < (int)trace->binary_defs.size() && trace->binary_defs[id].insn == insn &&
+        trace->binary_defs[id].decoder_item == insn->decoder_item &&
+        trace->binary_defs[id].opcode == insn->opcode)
+    {
+        return id;
+    }
+
+    id = trace->binary_defs.size();
+    trace->binary_defs.push_back({insn, insn->decoder_item, insn->opcode});
+    insn->trace_id = id;
+
+    iss_decoder_insn_t *decoder = &insn->decoder_item->u.insn;
+    int nb_args = decoder->nb_args;
+
+    size_t size = 14 + IssTraceBinWriter::str_size(decoder->label) + nb_args * 29;
+    for (int i = 0; i < nb_args; i++)
+    {
+        if (insn->args[i].flags & ISS_DECODER_ARG_FLAG_DUMP_NAME)
+            size += IssTraceBinWriter::str_size(insn->args[i].name);
+    }
+
+    writer->reserve(size);
+    writer->put<uint8_t>(ISS_TRACE_BIN_TAG_DEF);
+    writer->put<uint32_t>(id);
+    writer->put<uint64_t>(insn->opcode);
+    writer->put_str(decoder->label);
+    writer->put<uint8_t>(nb_args);
+    writer->put_data(decoder->args_order, nb_args);
+
+    for (int i = 0; i < nb_args; i++)
+    {
+        iss_decoder_arg_t *arg = &decoder->args[i];
+        iss_insn_arg_t *insn_arg = &insn->args[i];
+        int64_t a = 0, b = 0;
+        bool dump_name = false;
+
+        switch (arg->type)
+        {
+            case ISS_DECODER_ARG_TYPE_OUT_REG:
+            case ISS_DECODER_ARG_TYPE_IN_REG:
+                a = insn_arg->u.reg.index;
+                dump_name = arg->u.reg.dump_name;
+                break;
+            case ISS_DECODER_ARG_TYPE_UIMM:
+                a = insn_arg->u.uim.value;
+                break;
+            case ISS_DECODER_ARG_TYPE_SIMM:
+                a = insn_arg->u.sim.value;
+                break;
+            case ISS_DECODER_ARG_TYPE_INDIRECT_IMM:
+                a = insn_arg->u.indirect_imm.reg_index;
+                b = insn_arg->u.indirect_imm.imm;
+                break;
+            case ISS_DECODER_ARG_TYPE_INDIRECT_REG:
+                a = insn_arg->u.indirect_reg.base_reg_index;
+                b = insn_arg->u.indirect_reg.offset_reg_index;
+                break;
+            default:
+                break;
+        }
+
+        writer->put<uint8_t>(arg->type);
+        writer->put<uint32_t>(arg->flags);
+        writer->put<uint8_t>(dump_name);
+        writer->put<uint32_t>(insn_arg->flags);
+        writer->put_str(insn_arg->flags & ISS_DECODER_ARG_FLAG_DUMP_NAME ? insn_arg->name : "");
+        writer->put<int64_t>(a);
+        writer->put<int64_t>(b);
+    }
+
+    return id;
+}
+
+// Binary counterpart of iss_trace_dump_insn, which only writes what is needed to rebuild
+// the text trace offline
+static void iss_trace_binary_dump(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
+{
+    Trace *trace = &iss->trace;
+    IssTraceBinWriter *writer = &trace->binary;
+
+    if (!writer->is_open())
+    {
+        iss_trace_binary_open(iss);
+        if (!writer->is_open())
+            return;
+    }
+
+    // Binaries are needed offline for the debug info column of long traces
+    while (trace->binary_nb_elfs < (int)binaries.size())
+    {
+        const char *elf = binaries[trace->binary_nb_elfs++].c_str();
+        writer->reserve(1 + IssTraceBinWriter::str_size(elf));
+        writer->put<uint8_t>(ISS_TRACE_BIN_TAG_ELF);
+        writer->put_str(elf);
+    }
+
+    int id = iss_trace_binary_def(iss, insn);
+    iss_decoder_insn_t *decoder = &insn->decoder_item->u.insn;
+    int nb_args = decoder->nb_args;
+
+    uint8_t flags = 0;
+    size_t size = 39 + nb_args * 32;
+    if (trace->has_reg_dump)
+    {
+        flags |= ISS_TRACE_BIN_EXEC_REG_DUMP;
+        size += 8;
+    }
+    if (trace->has_str_dump)
+    {
+        flags |= ISS_TRACE_BIN_EXEC_STR_DUMP;
+        size += IssTraceBinWriter::str_size(trace->str_dump.c_str());
+    }
+#ifdef CONFIG_ISS_HAS_VECTOR
+    unsigned int lmul = iss->vector.lmul;
+    int vsize = CONFIG_ISS_VLEN/8*lmul;
+    for (int i = 0; i < nb_args; i++)
+    {
+        if (decoder->args[i].flags & ISS_DECODER_ARG_FLAG_VREG)
+        {
+            flags |= ISS_TRACE_BIN_EXEC_VECTOR;
+            size += vsize;
+        }
+    }
+    size += 4;
+#endif
+
+    writer->reserve(size);
+    writer->put<uint8_t>(ISS_TRACE_BIN_TAG_EXEC);
+    writer->put<uint32_t>(id);
+    writer->put<uint8_t>(flags);
+    writer->put<uint8_t>(trace->priv_mode);
+    writer->put<uint64_t>(iss->top.time.get_time());
+    writer->put<uint64_t>(iss->top.clock.get_cycles() + iss->exec.block_cycles);
+    writer->put<uint64_t>(pc);
+
+    if (trace->has_reg_dump)
+        writer->put<uint64_t>(trace->reg_dump);
+    if (trace->has_str_dump)
+        writer->put_str(trace->str_dump.c_str());
+
+#ifdef CONFIG_ISS_HAS_VECTOR
+    if (flags & ISS_TRACE_BIN_EXEC_VECTOR)
+    {
+        writer->put<uint8_t>(iss->vector.sewb);
+        writer->put<uint8_t>(lmul);
+        writer->put<uint8_t>(iss->vector.exp);
+        writer->put<uint8_t>(iss->vector.mant);
+    }
+#endif
+
+    for (int i = 0; i < nb_args; i++)
+    {
+        iss_decoder_arg_t *arg = &decoder->args[i];
+        iss_insn_arg_t *saved_arg = &trace->saved_args[i];
+
+        if (arg->type == ISS_DECODER_ARG_TYPE_OUT_REG || arg->type == ISS_DECODER_ARG_TYPE_IN_REG)
+        {
+            if (arg->flags & ISS_DECODER_ARG_FLAG_VREG)
+            {
+#ifdef CONFIG_ISS_HAS_VECTOR
+                writer->put_data(trace->saved_vargs[i], vsize);
+#endif
+            }
+            else
+            {
+                // Same values as the ones given to iss_trace_dump_reg_value
+                writer->put<uint64_t>((arg->flags & ISS_DECODER_ARG_FLAG_REG64) || (arg->flags & ISS_DECODER_ARG_FLAG_FREG) ?
+                    saved_arg->u.reg.value_64 : saved_arg->u.reg.value);
+                writer->put<uint64_t>(arg->flags & ISS_DECODER_ARG_FLAG_REG64 ?
+                    saved_arg->u.reg.memcheck_value_64 : saved_arg->u.reg.memcheck_value);
+            }
+        }
+        else if (arg->type == ISS_DECODER_ARG_TYPE_INDIRECT_IMM)
+        {
+            writer->put<uint64_t>(saved_arg->u.indirect_imm.reg_value);
+            writer->put<uint64_t>(saved_arg->u.indirect_imm.memcheck_reg_value);
+        }
+        else if (arg->type == ISS_DECODER_ARG_TYPE_INDIRECT_REG)
+        {
+            writer->put<uint64_t>(saved_arg->u.indirect_reg.base_reg_value);
+            writer->put<uint64_t>(saved_arg->u.indirect_reg.memcheck_base_reg_value);
+            writer->put<uint64_t>(saved_arg->u.indirect_reg.offset_reg_value);
+            writer->put<uint64_t>(saved_arg->u.indirect_reg.memcheck_offset_reg_value);
+        }
+    }
+}
+
 void iss_trace_dump(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 {
     if (!insn->is_macro_op || iss->top.traces.get_trace_engine()->get_format() == TRACE_FORMAT_LONG)
     {
-        char buffer[32*1024];
-
         iss_trace_save_args(iss, insn, true);
 
-        iss_trace_dump_insn(iss, insn, pc, buffer, 1024, iss->trace.saved_args,
+        if (!iss->trace.binary_prefix.empty())
+        {
+            iss_trace_binary_dump(iss, insn, pc);
+            return;
+        }
+
+        char buffer[32*1024];
+
+        iss_trace_dump_insn(iss, insn, pc, buffer, iss->trace.saved_args,
             iss->top.traces.get_trace_engine()->get_format() == TRACE_FORMAT_LONG, iss->trace.priv_mode, 0);
 
         iss->trace.insn_trace.msg(buffer);
@@ -872,7 +774,7 @@ void iss_event_dump(Iss *iss, iss_insn_t *insn, iss_reg_t pc)
 {
     char buffer[1024];
 
-    iss_trace_dump_insn(iss, insn, pc, buffer, 1024, iss->trace.saved_args, false, iss->trace.priv_mode, 1);
+    iss_trace_dump_insn(iss, insn, pc, buffer, iss->trace.saved_args, false, iss->trace.priv_mode, 1);
 
     char *current = buffer;
     while (*current)
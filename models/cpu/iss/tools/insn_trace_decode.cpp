@@ -0,0 +1,678 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+/*
+ * Decoder of the binary instruction traces written by the ISS (see trace_binary.hpp).
+ *
+ * By default, each instruction is printed exactly as the text insn trace would have printed
+ * it, the formatting code (trace_format.hpp) being shared with src/trace.cpp and working on
+ * the content of the trace instead of the ISS state. Instructions can be filtered by PC range or by function, and
+ * dumped as CSV instead of text.
+ *
+ * The func:line column of long traces and the function filter need libdw, the decoder is
+ * built without them if ISS_TRACE_DECODE_NO_LIBDW is defined.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "cpu/iss/include/trace_binary.hpp"
+#include "cpu/iss/include/trace_format.hpp"
+#include "cpu/iss/flexfloat/flexfloat.h"
+
+#if !defined(ISS_TRACE_DECODE_NO_LIBDW)
+#include <elfutils/libdwfl.h>
+#endif
+
+#define MAX_ARGS 8
+
+struct TraceArg
+{
+    uint8_t type;
+    uint32_t flags;
+    bool dump_name;
+    uint32_t insn_flags;
+    std::string name;
+    int64_t a;
+    int64_t b;
+};
+
+struct TraceDef
+{
+    bool valid = false;
+    uint64_t opcode;
+    std::string label;
+    int nb_args;
+    uint8_t args_order[MAX_ARGS];
+    TraceArg args[MAX_ARGS];
+};
+
+struct TraceExec
+{
+    uint8_t flags;
+    uint8_t mode;
+    uint64_t time;
+    uint64_t cycles;
+    uint64_t pc;
+    uint64_t reg_dump;
+    std::string str_dump;
+    unsigned int sewb;
+    unsigned int lmul;
+    uint8_t exp;
+    uint8_t mant;
+    // Value and memcheck value of each slot of each argument
+    uint64_t values[MAX_ARGS][2];
+    uint64_t checks[MAX_ARGS][2];
+    // Vector registers, with some padding since elements are read as 64 bits
+    std::vector<uint8_t> vargs[MAX_ARGS];
+};
+
+class TraceReader
+{
+public:
+    TraceReader(FILE *file) : file(file), buffer(ISS_TRACE_BIN_BUFFER_SIZE) {}
+
+    // Return false at the end of the file
+    bool read(void *data, size_t size)
+    {
+        uint8_t *dest = (uint8_t *)data;
+        while (size)
+        {
+            if (this->pos == this->end)
+            {
+                this->end = fread(this->buffer.data(), 1, this->buffer.size(), this->file);
+                this->pos = 0;
+                if (this->end == 0)
+                {
+                    return false;
+                }
+            }
+            size_t chunk = std::min(size, this->end - this->pos);
+            memcpy(dest, &this->buffer[this->pos], chunk);
+            this->pos += chunk;
+            dest += chunk;
+            size -= chunk;
+        }
+        return true;
+    }
+
+    template<typename T> T get()
+    {
+        T value;
+        if (!this->read(&value, sizeof(T)))
+        {
+            this->truncated = true;
+            memset(&value, 0, sizeof(T));
+        }
+        return value;
+    }
+
+    std::string get_str()
+    {
+        uint16_t len = this->get<uint16_t>();
+        std::string str(len, '\0');
+        if (len && !this->read(&str[0], len))
+        {
+            this->truncated = true;
+        }
+        return str;
+    }
+
+    bool truncated = false;
+
+private:
+    FILE *file;
+    std::vector<uint8_t> buffer;
+    size_t pos = 0;
+    size_t end = 0;
+};
+
+// Trace settings, taken from the file header
+static int reg_width;
+static int fp_width;
+static uint32_t vlen;
+static bool is_long;
+static bool float_hex;
+static bool memcheck;
+static bool has_double;
+static bool single_regfile;
+
+
+
+/*
+ * Debug info, same resolution as iss_pc_info_get in src/trace.cpp
+ */
+
+struct PcInfo
+{
+    bool valid;
+    std::string func;
+    std::string file;
+    int line;
+};
+
+static std::vector<std::string> binaries;
+// Indexed by the lower 32 bits of the PC, like the ISS cache
+static std::unordered_map<uint32_t, PcInfo> pc_infos;
+
+#if !defined(ISS_TRACE_DECODE_NO_LIBDW)
+static Dwfl *dwfl = NULL;
+static char *dwfl_debuginfo_path = NULL;
+static const Dwfl_Callbacks dwfl_callbacks = {
+    dwfl_build_id_find_elf,
+    dwfl_standard_find_debuginfo,
+    dwfl_offline_section_address,
+    &dwfl_debuginfo_path,
+};
+#endif
+
+static void register_elf(const std::string &binary)
+{
+    binaries.push_back(binary);
+
+#if !defined(ISS_TRACE_DECODE_NO_LIBDW)
+    if (dwfl == NULL)
+    {
+        dwfl = dwfl_begin(&dwfl_callbacks);
+        if (dwfl == NULL)
+        {
+            fprintf(stderr, "Unable to initialize libdw for debug info (binary: %s)\n", binary.c_str());
+            return;
+        }
+    }
+
+    dwfl_report_begin_add(dwfl);
+    Dwfl_Module *mod = dwfl_report_offline(dwfl, binary.c_str(), binary.c_str(), -1);
+    dwfl_report_end(dwfl, NULL, NULL);
+
+    if (mod == NULL)
+    {
+        fprintf(stderr, "Unable to load debug info from binary: %s (%s)\n",
+            binary.c_str(), dwfl_errmsg(-1));
+    }
+#endif
+}
+
+static PcInfo *get_pc_info(uint64_t addr)
+{
+    auto it = pc_infos.find((uint32_t)addr);
+    if (it != pc_infos.end())
+    {
+        return &it->second;
+    }
+
+    PcInfo info = { false, "-", "-", 0 };
+
+#if !defined(ISS_TRACE_DECODE_NO_LIBDW)
+    if (dwfl != NULL)
+    {
+        Dwfl_Module *mod = dwfl_addrmodule(dwfl, addr);
+        if (mod != NULL)
+        {
+            const char *func = dwfl_module_addrname(mod, addr);
+            const char *file = NULL;
+            int line = 0;
+            Dwfl_Line *dwline = dwfl_module_getsrc(mod, addr);
+            if (dwline != NULL)
+            {
+                file = dwfl_lineinfo(dwline, NULL, &line, NULL, NULL, NULL);
+            }
+            if (func != NULL || file != NULL)
+            {
+                info = { true, func ? func : "-", file ? file : "-", line };
+            }
+        }
+    }
+#endif
+
+    return &(pc_infos[(uint32_t)addr] = info);
+}
+
+
+/*
+ * Text formatting, shared with src/trace.cpp through trace_format.hpp
+ */
+
+// Gives the trace formatter access to the settings of the trace file and to the instruction
+// definition and execution being decoded
+class TraceSrc
+{
+public:
+    TraceSrc(TraceDef *def, TraceExec *exec) : def(def), exec(exec) {}
+
+    int reg_width() { return ::reg_width; }
+    int fp_width() { return ::fp_width; }
+    bool float_hex() { return ::float_hex; }
+    bool memcheck() { return ::memcheck; }
+    bool has_double() { return ::has_double; }
+    bool single_regfile() { return ::single_regfile; }
+
+    // Same conversion as lib_flexfloat_cvt_ff_ff_round, with round to nearest
+    uint64_t float_to_f64(uint64_t value, int exp, int mant)
+    {
+        int old = fegetround();
+        fesetround(FE_TONEAREST);
+        flexfloat_t ff_a, ff_res;
+        flexfloat_desc_t env = (flexfloat_desc_t){(uint8_t)exp, (uint8_t)mant};
+        ff_init(&ff_a, env);
+        ff_init(&ff_res, env);
+        flexfloat_set_bits(&ff_a, value);
+        ff_cast(&ff_res, &ff_a, (flexfloat_desc_t){11, 52});
+        fesetround(old);
+        return flexfloat_get_bits(&ff_res);
+    }
+
+    bool debug_info(uint64_t pc, const char **func, int *line)
+    {
+        if (binaries.size() == 0)
+            return false;
+
+        PcInfo *pc_info = get_pc_info(pc);
+        *func = pc_info->valid ? pc_info->func.c_str() : "-";
+        *line = pc_info->valid ? pc_info->line : 0;
+        return true;
+    }
+
+    uint64_t opcode() { return this->def->opcode; }
+    const char *label() { return this->def->label.c_str(); }
+    int nb_args() { return this->def->nb_args; }
+    int arg_order(int i) { return this->def->args_order[i]; }
+
+    IssTraceFmtArg arg(int id)
+    {
+        TraceArg *arg = &this->def->args[id];
+        return { arg->type, arg->flags, arg->dump_name, arg->insn_flags, arg->name.c_str(),
+            arg->a, arg->b };
+    }
+
+    uint64_t pc() { return this->exec->pc; }
+    int mode() { return this->exec->mode; }
+    bool has_reg_dump() { return this->exec->flags & ISS_TRACE_BIN_EXEC_REG_DUMP; }
+    uint64_t reg_dump() { return this->exec->reg_dump; }
+    const char *str_dump()
+    {
+        return this->exec->flags & ISS_TRACE_BIN_EXEC_STR_DUMP ? this->exec->str_dump.c_str() : NULL;
+    }
+
+    uint64_t value(int id, int slot) { return this->exec->values[id][slot]; }
+    uint64_t check(int id, int slot) { return this->exec->checks[id][slot]; }
+    uint8_t *varg(int id) { return ::vlen ? this->exec->vargs[id].data() : NULL; }
+    int vlen() { return ::vlen; }
+    int vsewb() { return this->exec->sewb; }
+    int vlmul() { return this->exec->lmul; }
+    int vexp() { return this->exec->exp; }
+    int vmant() { return this->exec->mant; }
+
+private:
+    TraceDef *def;
+    TraceExec *exec;
+};
+
+static void csv_escape(FILE *out, const char *str)
+{
+    fputc('"', out);
+    for (; *str; str++)
+    {
+        if (*str == '"')
+            fputc('"', out);
+        fputc(*str, out);
+    }
+    fputc('"', out);
+}
+
+static void dump_csv(FILE *out, TraceDef *def, TraceExec *exec, char *buff)
+{
+    TraceSrc src(def, exec);
+
+    fprintf(out, "%" PRIu64 ",%" PRIu64 ",%c,0x%" PRIx64 ",0x%" PRIx64 ",", exec->time, exec->cycles,
+        iss_trace_fmt_mode(exec->mode), exec->pc, def->opcode);
+
+    *iss_trace_fmt_asm(src, buff, true) = 0;
+    fprintf(out, "%s,", def->label.c_str());
+    csv_escape(out, buff);
+    fprintf(out, ",");
+    *iss_trace_fmt_values(src, buff, 1, true) = 0;
+    csv_escape(out, buff);
+    fprintf(out, ",");
+    *iss_trace_fmt_values(src, buff, 0, true) = 0;
+    csv_escape(out, buff);
+    fprintf(out, "\n");
+}
+
+
+/*
+ * Filters
+ */
+
+struct PcRange
+{
+    uint64_t start;
+    uint64_t end;
+};
+
+static std::vector<PcRange> pc_ranges;
+static std::vector<std::string> funcs;
+
+static bool is_filtered_in(uint64_t pc)
+{
+    if (pc_ranges.size() == 0 && funcs.size() == 0)
+    {
+        return true;
+    }
+
+    for (PcRange &range : pc_ranges)
+    {
+        if (pc >= range.start && pc < range.end)
+        {
+            return true;
+        }
+    }
+
+    if (funcs.size())
+    {
+        PcInfo *info = get_pc_info(pc);
+        for (std::string &func : funcs)
+        {
+            if (info->valid && info->func == func)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] <trace file>\n"
+        "\n"
+        "Options:\n"
+        "  --format=text|csv      Output format (default: text, same as the ISS insn trace)\n"
+        "  --pc=<start>[:<end>]   Only dump instructions whose PC is in [start, end), or equal to\n"
+        "                         start if end is not specified. Can be given several times\n"
+        "  --func=<name>          Only dump instructions of this function. Can be given several times\n"
+        "  --prefix               Prefix text lines with the time, the cycles and the core path\n"
+        "  -o <file>              Output file (default: stdout)\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    const char *input = NULL;
+    const char *output = NULL;
+    bool csv = false;
+    bool prefix = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        char *arg = argv[i];
+        if (strncmp(arg, "--format=", 9) == 0)
+        {
+            if (strcmp(arg + 9, "csv") == 0)
+                csv = true;
+            else if (strcmp(arg + 9, "text") != 0)
+            {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        else if (strncmp(arg, "--pc=", 5) == 0)
+        {
+            char *end;
+            uint64_t start = strtoull(arg + 5, &end, 0);
+            uint64_t stop = *end == ':' ? strtoull(end + 1, NULL, 0) : start + 1;
+            pc_ranges.push_back({start, stop});
+        }
+        else if (strncmp(arg, "--func=", 7) == 0)
+        {
+#if defined(ISS_TRACE_DECODE_NO_LIBDW)
+            fprintf(stderr, "Function filtering needs libdw support\n");
+            return 1;
+#endif
+            funcs.push_back(arg + 7);
+        }
+        else if (strcmp(arg, "--prefix") == 0)
+        {
+            prefix = true;
+        }
+        else if (strcmp(arg, "-o") == 0 && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (arg[0] != '-' && input == NULL)
+        {
+            input = arg;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (input == NULL)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *file = fopen(input, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Unable to open trace file: %s\n", input);
+        return 1;
+    }
+
+    FILE *out = stdout;
+    if (output != NULL)
+    {
+        out = fopen(output, "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "Unable to open output file: %s\n", output);
+            return 1;
+        }
+    }
+
+    TraceReader reader(file);
+
+    uint32_t magic = reader.get<uint32_t>();
+    uint16_t version = reader.get<uint16_t>();
+    if (magic != ISS_TRACE_BIN_MAGIC || version != ISS_TRACE_BIN_VERSION)
+    {
+        fprintf(stderr, "Not a binary instruction trace or unsupported version: %s\n", input);
+        return 1;
+    }
+
+    reg_width = reader.get<uint8_t>();
+    fp_width = reader.get<uint8_t>();
+    uint32_t flags = reader.get<uint32_t>();
+    vlen = reader.get<uint32_t>();
+    std::string core_path = reader.get_str();
+
+    is_long = flags & ISS_TRACE_BIN_FLAG_LONG;
+    float_hex = flags & ISS_TRACE_BIN_FLAG_FLOAT_HEX;
+    memcheck = flags & ISS_TRACE_BIN_FLAG_MEMCHECK;
+    has_double = flags & ISS_TRACE_BIN_FLAG_HAS_DOUBLE;
+    single_regfile = flags & ISS_TRACE_BIN_FLAG_SINGLE_REGFILE;
+
+    std::vector<TraceDef> defs;
+    TraceExec exec;
+    // A vector argument takes at most 8 registers, plus 8 bytes since elements are read as
+    // 64 bits values
+    for (int i = 0; i < MAX_ARGS; i++)
+    {
+        exec.vargs[i].resize(vlen + 8);
+    }
+    std::vector<char> buffer(1 << 20);
+
+    if (csv)
+    {
+        fprintf(out, "time,cycles,mode,pc,opcode,label,args,out_values,in_values\n");
+    }
+
+    while (1)
+    {
+        uint8_t tag;
+        if (!reader.read(&tag, 1))
+        {
+            break;
+        }
+
+        if (tag == ISS_TRACE_BIN_TAG_ELF)
+        {
+            register_elf(reader.get_str());
+        }
+        else if (tag == ISS_TRACE_BIN_TAG_DEF)
+        {
+            uint32_t id = reader.get<uint32_t>();
+            if (id >= defs.size())
+            {
+                defs.resize(id + 1);
+            }
+            TraceDef *def = &defs[id];
+            def->valid = true;
+            def->opcode = reader.get<uint64_t>();
+            def->label = reader.get_str();
+            def->nb_args = reader.get<uint8_t>();
+            if (def->nb_args > MAX_ARGS)
+            {
+                fprintf(stderr, "Invalid number of arguments in trace file\n");
+                return 1;
+            }
+            reader.read(def->args_order, def->nb_args);
+            for (int i = 0; i < def->nb_args; i++)
+            {
+                TraceArg *arg = &def->args[i];
+                arg->type = reader.get<uint8_t>();
+                arg->flags = reader.get<uint32_t>();
+                arg->dump_name = reader.get<uint8_t>();
+                arg->insn_flags = reader.get<uint32_t>();
+                arg->name = reader.get_str();
+                arg->a = reader.get<int64_t>();
+                arg->b = reader.get<int64_t>();
+            }
+        }
+        else if (tag == ISS_TRACE_BIN_TAG_EXEC)
+        {
+            uint32_t id = reader.get<uint32_t>();
+            if (id >= defs.size() || !defs[id].valid)
+            {
+                fprintf(stderr, "Reference to undefined instruction in trace file (id: %d)\n", id);
+                return 1;
+            }
+            TraceDef *def = &defs[id];
+
+            exec.flags = reader.get<uint8_t>();
+            exec.mode = reader.get<uint8_t>();
+            exec.time = reader.get<uint64_t>();
+            exec.cycles = reader.get<uint64_t>();
+            exec.pc = reader.get<uint64_t>();
+            if (exec.flags & ISS_TRACE_BIN_EXEC_REG_DUMP)
+                exec.reg_dump = reader.get<uint64_t>();
+            if (exec.flags & ISS_TRACE_BIN_EXEC_STR_DUMP)
+                exec.str_dump = reader.get_str();
+            if (exec.flags & ISS_TRACE_BIN_EXEC_VECTOR)
+            {
+                exec.sewb = reader.get<uint8_t>();
+                exec.lmul = reader.get<uint8_t>();
+                exec.exp = reader.get<uint8_t>();
+                exec.mant = reader.get<uint8_t>();
+                if (exec.sewb == 0 || exec.lmul > 8)
+                {
+                    fprintf(stderr, "Invalid vector configuration in trace file\n");
+                    return 1;
+                }
+            }
+
+            for (int i = 0; i < def->nb_args; i++)
+            {
+                TraceArg *arg = &def->args[i];
+                if ((arg->type == ISS_TRACE_BIN_ARG_OUT_REG || arg->type == ISS_TRACE_BIN_ARG_IN_REG) &&
+                    (arg->flags & ISS_TRACE_BIN_ARG_FLAG_VREG))
+                {
+                    size_t size = vlen / 8 * exec.lmul;
+                    reader.read(exec.vargs[i].data(), size);
+                    memset(exec.vargs[i].data() + size, 0, exec.vargs[i].size() - size);
+                }
+                else
+                {
+                    int nb_values = iss_trace_bin_exec_arg_nb_values(arg->type, arg->flags);
+                    for (int j = 0; j < nb_values; j++)
+                    {
+                        exec.values[i][j] = reader.get<uint64_t>();
+                        exec.checks[i][j] = reader.get<uint64_t>();
+                    }
+                }
+            }
+
+            if (reader.truncated)
+            {
+                break;
+            }
+
+            if (!is_filtered_in(exec.pc))
+            {
+                continue;
+            }
+
+            if (csv)
+            {
+                dump_csv(out, def, &exec, buffer.data());
+            }
+            else
+            {
+                if (prefix)
+                {
+                    fprintf(out, "%" PRIu64 ": %" PRIu64 ": [%s/insn] ", exec.time, exec.cycles, core_path.c_str());
+                }
+                TraceSrc src(def, &exec);
+                iss_trace_fmt_insn(src, buffer.data(), is_long, false);
+                fputs(buffer.data(), out);
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Invalid record in trace file (tag: %d)\n", tag);
+            return 1;
+        }
+    }
+
+    if (reader.truncated)
+    {
+        fprintf(stderr, "Trace file is truncated, last instruction is dropped\n");
+    }
+
+    fclose(file);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    return 0;
+}
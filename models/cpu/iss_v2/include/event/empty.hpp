@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou (germain.haugou@gmail.com)
+ */
+
+#pragma once
+
+#include <cpu/iss_v2/include/event/event.hpp>
+
+// Null event sink. It keeps the state, PC and power events of Events, which are handled
+// outside of the accounting, but shadows every accounting hook with an empty one so that
+// the calls made for each instruction compile to nothing. Only the pipeline stalls of taken
+// branches and jumps are kept since they are timing, not accounting.
+class EventsEmpty : public Events
+{
+public:
+
+    EventsEmpty(Iss &iss) : Events(iss, false) {}
+
+    inline bool needs_full_mode() { return false; }
+
+    inline void event_cycle_enable() {}
+    inline void event_cycle_disable() {}
+    inline void event_instr_account() {}
+    inline void event_fetch_account() {}
+    inline void event_imiss_account(int incr) {}
+    inline void event_imiss_start() {}
+    inline void event_imiss_stop() {}
+    inline void event_load_account(int incr) {}
+    inline void event_rvc_account(int incr) {}
+    inline void event_store_account(int incr) {}
+    inline void event_branch_account() {}
+    inline void event_taken_branch_account();
+    inline void event_jump_account();
+    inline void event_misaligned_account(int incr) {}
+
+#ifdef CONFIG_GVSOC_STATS_ACTIVE
+    inline void dur_window_open(iss_insn_t *insn, int64_t stall_now) {}
+    inline void dur_window_close(int64_t stall_now) {}
+#endif
+};
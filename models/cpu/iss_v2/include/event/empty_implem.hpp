@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou (germain.haugou@gmail.com)
+ */
+
+#pragma once
+
+#include <vp/vp.hpp>
+
+inline void EventsEmpty::event_taken_branch_account()
+{
+#if defined(CONFIG_GVSOC_ISS_TAKEN_BRANCH_STALL_CYCLES)
+    this->iss.exec.stall_cycles_inc(2);
+#endif
+}
+
+inline void EventsEmpty::event_jump_account()
+{
+#if defined(CONFIG_GVSOC_ISS_JUMP_STALL_CYCLES)
+    this->iss.exec.stall_cycles_inc(1);
+#endif
+}
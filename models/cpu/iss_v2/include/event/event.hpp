@@ -90,16 +90,31 @@ private:
 };
 #endif
 
+// Event sink of the core, bound at compile time through CONFIG_GVSOC_ISS_EVENT: the core
+// holds it by value as iss.timing, so the accounting methods are not virtual and are inlined
+// at each call site. A per-core events class derives from this one and shadows the hooks it
+// needs, and is selected by the event module of the core. EventsEmpty is the null sink,
+// where all accounting compiles to nothing.
 class Events
 {
 public:
 
-    Events(Iss &iss);
+    Events(Iss &iss) : Events(iss, true) {}
 
     void start() {}
     void stop() {}
     void reset(bool active);
 
+    // True if the accounting needs the full instruction handler, the only one reporting
+    // retired instructions and their durations. The core then does not switch to the fast
+    // handler, which does no per-instruction accounting.
+    inline bool needs_full_mode();
+
+    // Called when the software starts or stops the statistics (semihosting). The core only
+    // stays on the full handler while they are counting.
+    void stats_start();
+    void stats_stop();
+
     inline void stall_fetch_account(int count){}
     inline void stall_taken_branch_account(){}
     inline void stall_insn_account(int cycles){}
@@ -114,29 +129,29 @@ public:
     inline void insn_stall_start(){}
     inline void insn_stall_stop(){}
 
-    virtual inline void event_cycle_enable();
-    virtual inline void event_cycle_disable();
-    virtual inline void event_instr_account();
-    virtual inline void event_fetch_account();
-    virtual inline void event_imiss_account(int incr);
-    virtual inline void event_imiss_start();
-    virtual inline void event_imiss_stop();
-    virtual inline void event_load_account(int incr);
-    virtual inline void event_rvc_account(int incr);
-    virtual inline void event_store_account(int incr);
-    virtual inline void event_branch_account();
-    virtual inline void event_taken_branch_account();
-    virtual inline void event_jump_account();
+    inline void event_cycle_enable();
+    inline void event_cycle_disable();
+    inline void event_instr_account();
+    inline void event_fetch_account();
+    inline void event_imiss_account(int incr);
+    inline void event_imiss_start();
+    inline void event_imiss_stop();
+    inline void event_load_account(int incr);
+    inline void event_rvc_account(int incr);
+    inline void event_store_account(int incr);
+    inline void event_branch_account();
+    inline void event_taken_branch_account();
+    inline void event_jump_account();
     // Called once per executed JALR with the rs1 register index. Lets a
     // core (e.g. Ri5kyEvents) charge the taken-jump pipeline flush and
     // detect the RI5CY-style jr_stall (rs1 produced by a recent
     // instruction). Default: no-op.
-    virtual inline void event_jalr_account(int rs1) {}
+    inline void event_jalr_account(int rs1) {}
     // Called when an instruction retires, with the retiring insn. Lets a
     // core track the previous instruction's destination register so the
     // jalr-with-producer hazard can be detected by event_jalr_account.
     // Default: no-op.
-    virtual inline void event_retire_account(iss_insn_t *insn) {}
+    inline void event_retire_account(iss_insn_t *insn) {}
     // Called when a retiring insn carries a non-zero per-instruction
     // latency (set by the decoder, typically via a setup pass that walks
     // get_insns_from_tag(...) and assigns u.insn.latency = N). The hook
@@ -145,17 +160,17 @@ public:
     // ID->EX port), scoreboard-timestamp only (dependency-aware), resource
     // contention, etc. Default: no-op, so cores that don't tag any insn
     // and don't override this pay nothing beyond the latency != 0 check.
-    virtual inline void event_insn_latency_account(iss_insn_t *insn, int latency) {}
+    inline void event_insn_latency_account(iss_insn_t *insn, int latency) {}
     // Called by the shared rv32m.hpp div/divu/rem/remu handlers with the
     // live operand values, so per-core events classes can model
     // operand-dependent latency (e.g. the RI5CY divider's serial
     // bit-iteration loop whose cycle count depends on the divisor's
     // leading-zero count). Default: no-op.
-    virtual inline void event_div_account(iss_reg_t dividend, iss_reg_t divisor,
+    inline void event_div_account(iss_reg_t dividend, iss_reg_t divisor,
                                           bool is_signed, bool is_rem) {}
-    virtual inline void event_misaligned_account(int incr);
-    virtual inline void event_apu_contention_account(int incr){}
-    virtual inline void event_load_load_account(int incr){}
+    inline void event_misaligned_account(int incr);
+    inline void event_apu_contention_account(int incr){}
+    inline void event_load_load_account(int incr){}
     // Called by Regfile::scoreboard_insn_check whenever an instruction
     // is stalled by the scoreboard, with the opaque reason byte that
     // was stored when the blocking register was invalidated (see
@@ -163,7 +178,7 @@ public:
     // and fire the matching producer-specific stall counter
     // (e.g. PCCR_LD_STALL for ISS_STALL_REASON_LOAD on Ri5ky). The
     // scoreboard itself never names a producer. Default: no-op.
-    virtual inline void event_scoreboard_stall(uint8_t reason) {}
+    inline void event_scoreboard_stall(uint8_t reason) {}
 
     inline void event_trace_account(unsigned int event, int cycles){}
     inline void event_trace_set(unsigned int event){}
@@ -187,6 +202,10 @@ public:
 
 protected:
 
+    // counters is false for sinks which do not account any event, so that their statistics
+    // are not registered
+    Events(Iss &iss, bool counters);
+
     Iss &iss;
 
     vp::Event event_cycles;
@@ -207,7 +226,11 @@ protected:
     // Engine statistics, dumped to stats.txt when run with --stats. One
     // counter per countable event, registered in the constructor and
     // incremented from the matching event_*_account() in event_implem.hpp.
+    // The increments are not conditioned on stats_enabled: a counter which
+    // is not registered is simply never dumped, and this keeps a test out of
+    // every accounting call.
     bool stats_enabled = false;   // cached in ctor: true only when --stats is active
+    bool stats_active = false;    // true while stats are enabled and not stopped by software
     vp::StatScalar stat_instr;
     vp::StatScalar stat_fetch;
     vp::StatScalar stat_imiss;
@@ -236,7 +259,7 @@ protected:
     // miss excluded (it happens during the fetch, before the window opens, and
     // any synchronous-fetch stall is cancelled by the dur_open_stall baseline).
     InsnDurationStats insn_durations;
-    const char *dur_label = nullptr;   // label of the open window (null = none)
+    iss_decoder_insn_t *dur_desc = nullptr;   // instruction of the open window (null = none)
     int64_t dur_open_cycle = 0;        // cycle the fetch completed
     int64_t dur_open_stall = 0;        // stall_cycles snapshot at open (sync-fetch baseline)
 #endif
@@ -22,6 +22,15 @@
 
 #include <vp/vp.hpp>
 
+inline bool Events::needs_full_mode()
+{
+#ifdef CONFIG_GVSOC_STATS_ACTIVE
+    return this->stats_active;
+#else
+    return false;
+#endif
+}
+
 inline void Events::event_cycle_enable()
 {
     uint8_t one = 1;
@@ -70,7 +79,7 @@ inline void Events::event_instr_account()
     this->event_instr.dump(&one);
     this->event_instr.dump_next(&zero);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_instr++;
+    this->stat_instr++;
 #endif
 }
 
@@ -80,7 +89,7 @@ inline void Events::event_fetch_account()
     this->event_fetch.dump(&one);
     this->event_fetch.dump_next(&zero);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_fetch++;
+    this->stat_fetch++;
 #endif
 }
 
@@ -90,7 +99,7 @@ inline void Events::event_imiss_account(int incr)
     this->event_imiss.dump(&one);
     this->event_imiss.dump_next(&zero, incr);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_imiss += incr;
+    this->stat_imiss += incr;
 #endif
 }
 
@@ -112,7 +121,7 @@ inline void Events::event_load_account(int incr)
     this->event_ld.dump(&one);
     this->event_ld.dump_next(&zero, incr);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_ld += incr;
+    this->stat_ld += incr;
 #endif
 }
 
@@ -122,7 +131,7 @@ inline void Events::event_rvc_account(int incr)
     this->event_rvc.dump(&one);
     this->event_rvc.dump_next(&zero, incr);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_rvc += incr;
+    this->stat_rvc += incr;
 #endif
 }
 
@@ -132,7 +141,7 @@ inline void Events::event_store_account(int incr)
     this->event_st.dump(&one);
     this->event_st.dump_next(&zero, incr);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_st += incr;
+    this->stat_st += incr;
 #endif
 }
 
@@ -142,7 +151,7 @@ inline void Events::event_branch_account()
     this->event_branch.dump(&one);
     this->event_branch.dump_next(&zero);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_branch++;
+    this->stat_branch++;
 #endif
 }
 
@@ -152,7 +161,7 @@ inline void Events::event_taken_branch_account()
     this->event_taken_branch.dump(&one);
     this->event_taken_branch.dump_next(&zero);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_taken_branch++;
+    this->stat_taken_branch++;
 #endif
 #if defined(CONFIG_GVSOC_ISS_TAKEN_BRANCH_STALL_CYCLES)
     this->iss.exec.stall_cycles_inc(2);
@@ -166,7 +175,7 @@ inline void Events::event_jump_account()
     this->event_jump.dump(&one);
     this->event_jump.dump_next(&zero);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_jump++;
+    this->stat_jump++;
 #endif
 #if defined(CONFIG_GVSOC_ISS_JUMP_STALL_CYCLES)
     this->iss.exec.stall_cycles_inc(1);
@@ -179,7 +188,7 @@ inline void Events::event_misaligned_account(int incr)
     this->event_misaligned.dump(&one);
     this->event_misaligned.dump_next(&zero, incr);
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    if (this->stats_enabled) this->stat_misaligned += incr;
+    this->stat_misaligned += incr;
 #endif
 }
 
@@ -189,8 +198,8 @@ inline void Events::dur_window_open(iss_insn_t *insn, int64_t stall_now)
     if (!this->stats_enabled) return;
     // Open once: a stalled load / load-use hazard returns and re-enters fetch,
     // but must keep the original anchor so its wait stays inside the window.
-    if (this->dur_label != nullptr) return;
-    this->dur_label = insn->desc->label;
+    if (this->dur_desc != nullptr) return;
+    this->dur_desc = insn->desc;
     this->dur_open_cycle = this->iss.clock.get_cycles();
     // Baseline of any stall already queued by this instruction's fetch (a
     // synchronous icache-miss latency on ri5ky); subtracted at close so the
@@ -200,7 +209,7 @@ inline void Events::dur_window_open(iss_insn_t *insn, int64_t stall_now)
 
 inline void Events::dur_window_close(int64_t stall_now)
 {
-    if (!this->stats_enabled || this->dur_label == nullptr) return;
+    if (!this->stats_enabled || this->dur_desc == nullptr) return;
     int64_t now = this->iss.clock.get_cycles();
     // The instruction executes atomically, so fetch-done and commit land on the
     // same cycle; count its own issue slot as 1, then add the cycles waited
@@ -210,7 +219,7 @@ inline void Events::dur_window_close(int64_t stall_now)
     // fetch stall is cancelled by dur_open_stall.
     int64_t dur = 1 + (now - this->dur_open_cycle) + (stall_now - this->dur_open_stall);
     if (dur < 0) dur = 0;
-    this->insn_durations.account(this->dur_label, dur);
-    this->dur_label = nullptr;
+    this->insn_durations.account(this->dur_desc, dur);
+    this->dur_desc = nullptr;
 }
 #endif
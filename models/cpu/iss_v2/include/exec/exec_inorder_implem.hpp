@@ -131,6 +131,12 @@ inline bool ExecInOrder::can_switch_to_fast_mode()
         return false;
     }
 
+    // Counters are enabled by staying on the full handler, which does the accounting
+    if (this->iss.timing.needs_full_mode())
+    {
+        return false;
+    }
+
 #ifdef VP_TRACE_ACTIVE
     return false;
 #else
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#pragma once
+
+#include <vp/vp.hpp>
+#include <cpu/iss_v2/include/types.hpp>
+#include <cpu/iss/include/prefetch/prefetch_lines.hpp>
+
+/*
+ * Prefetcher with CONFIG_GVSOC_ISS_PREFETCH_NB_LINES lines of CONFIG_GVSOC_ISS_PREFETCH_SIZE
+ * bytes, with the same interface as PrefetchSingleLine.
+ *
+ * Lines are looked up by tag, so that loops fitting the buffer do not refetch their lines and
+ * instructions crossing 2 lines are rebuilt from the buffer. When the core enters a line, the
+ * next one is prefetched if CONFIG_GVSOC_ISS_PREFETCH_NEXT_LINE is set, so that sequential
+ * code only waits for the part of the fetch latency not covered by the current line.
+ */
+class PrefetchMultiLine
+{
+public:
+    PrefetchMultiLine(Iss &iss);
+
+    void start() {}
+    void stop() {}
+
+    // Reset the prefetcher, which will flush it to make it empty
+    void reset(bool active);
+
+    // Flush the prefetch buffer
+    void flush();
+
+    // Response callback for the refills
+    static void fetch_response(vp::Block *__this, vp::IoReq *req);
+
+#ifdef CONFIG_GVSOC_ISS_LSU_V2
+    // io_v2 retry callback (no-op: the fetch path never gets DENIED in this model).
+    static void fetch_retry(vp::Block *__this, vp::IoRetryChannel) {}
+
+    // Refill interface (io_v2 form: retry + resp set at construction).
+    vp::IoMaster fetch_itf{&PrefetchMultiLine::fetch_retry, &PrefetchMultiLine::fetch_response};
+#else
+    // Refill interface (io v1 form: methods set in constructor body).
+    vp::IoMaster fetch_itf;
+#endif
+
+    // Fetch the given instruction from prefetch buffer
+    bool fetch(iss_reg_t pc);
+
+private:
+    typedef PrefetchLines<vp::IoReq, CONFIG_GVSOC_ISS_PREFETCH_SIZE,
+        CONFIG_GVSOC_ISS_PREFETCH_NB_LINES, CONFIG_GVSOC_ISS_PREFETCH_BRANCH_TARGETS> Lines;
+
+    // Refill of the prefetch buffer
+    bool fetch_refill(iss_insn_t *insn, iss_addr_t addr, int index);
+
+    // Callback called when the fetch of the low part is received asynchronously.
+    static void fetch_resume_after_low_refill(PrefetchMultiLine *_this);
+
+    // Check if the current instruction fits entirely in the buffer and if not trigger another fetch
+    bool fetch_check_overflow(iss_insn_t *insn, int index);
+
+    // Callback called when the high part of the instruction is received asynchronously
+    static void fetch_resume_after_high_refill(PrefetchMultiLine *_this);
+
+    // Make the line containing the given address the current one, either from the buffer or
+    // with a refill. Returns 0 if the line is available, -1 if the core must wait for it and
+    // 1 in case of error.
+    int enter_line(iss_addr_t addr);
+
+    // Start prefetching the line following the current one
+    void prefetch_next_line();
+
+    // Account the fetch latency of a line
+    void account_latency(int64_t latency);
+
+    // Send the fetch request
+    int send_fetch_req(vp::IoReq *req, uint64_t addr, uint8_t *data, uint64_t size, bool is_write);
+
+    // Can be called to stall the core after a pending refill.
+    // The core will be unstalled automatically once the refill is done
+    void handle_stall(void (*callback)(PrefetchMultiLine *), iss_insn_t *current_insn);
+
+    // Top component used to access other blocks
+    Iss &iss;
+
+    // Prefetch lines
+    Lines lines;
+
+    // Data and start address of the current line, used by the fast path. The start address
+    // can be -1 to indicate there is no current line.
+    uint8_t *data;
+    iss_addr_t buffer_start_addr;
+
+    // Callback called when a pending fetch response is received
+    void (*fetch_stall_callback)(PrefetchMultiLine *_this);
+
+    // Instruction being fetched, used by callbacks
+    iss_insn_t *prefetch_insn;
+
+    // Pending opcode, used by callback when the instruction is split on 2 lines
+    iss_opcode_t fetch_stall_opcode;
+
+    // Prefetcher trace
+    vp::Trace trace;
+
+    iss_reg_t current_pc;
+
+};
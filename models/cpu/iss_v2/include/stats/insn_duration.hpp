@@ -26,16 +26,16 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <vp/stats/stats.hpp>
 #include <vp/stats/block_stat.hpp>
+#include <vp/stats/stats_engine.hpp>
+#include <cpu/iss_v2/include/types.hpp>
 
-// Per-label duration accumulator. One instance is registered with the stats
-// engine per distinct instruction label; it tracks the occurrence count, the
-// total, minimum and maximum duration in cycles, and reports the average at
-// dump time. Modeled on the derived stats in event/event.hpp (StatIpc, ...).
-class StatInsnDuration : public vp::StatCommon
+// Occurrence count, total, minimum and maximum duration in cycles of an
+// instruction.
+struct InsnDurationRecord
 {
-public:
     inline void account(int64_t cycles)
     {
         if (this->count == 0 || cycles < this->min) this->min = cycles;
@@ -44,9 +44,40 @@ public:
         this->count++;
     }
 
+    inline void merge(const InsnDurationRecord &other)
+    {
+        if (other.count == 0) return;
+        if (this->count == 0 || other.min < this->min) this->min = other.min;
+        if (this->count == 0 || other.max > this->max) this->max = other.max;
+        this->total += other.total;
+        this->count += other.count;
+    }
+
+    uint64_t count = 0;
+    uint64_t total = 0;
+    int64_t min = 0;
+    int64_t max = 0;
+};
+
+class InsnDurationStats;
+
+// Per-label duration accumulator. One instance is registered with the stats
+// engine per distinct instruction label, and reports the average at dump time.
+// Modeled on the derived stats in event/event.hpp (StatIpc, ...).
+class StatInsnDuration : public vp::StatCommon
+{
+public:
+    StatInsnDuration(InsnDurationStats *owner) : owner(owner) {}
+
+    inline void merge(const InsnDurationRecord &record)
+    {
+        this->record.merge(record);
+    }
+
     std::string format_value(bool raw) const override
     {
-        double avg = this->count ? (double)this->total / (double)this->count : 0.0;
+        const InsnDurationRecord &r = this->record;
+        double avg = r.count ? (double)r.total / (double)r.count : 0.0;
         char buf[96];
         if (raw)
         {
@@ -55,31 +86,47 @@ public:
         else
         {
             snprintf(buf, sizeof(buf), "%.2f cyc  (n=%llu, min=%lld, max=%lld)",
-                avg, (unsigned long long)this->count,
-                (long long)(this->count ? this->min : 0),
-                (long long)(this->count ? this->max : 0));
+                avg, (unsigned long long)r.count,
+                (long long)(r.count ? r.min : 0),
+                (long long)(r.count ? r.max : 0));
         }
         return buf;
     }
 
-    void reset() override { this->count = 0; this->total = 0; this->min = 0; this->max = 0; }
+    // Also drops the records accounted since the last dump, which would
+    // otherwise be folded into the stat at the next one.
+    inline void reset() override;
 
 private:
-    uint64_t count = 0;
-    uint64_t total = 0;
-    int64_t min = 0;
-    int64_t max = 0;
+    InsnDurationStats *owner;
+    InsnDurationRecord record;
 };
 
-// Collection of per-label duration stats. Labels are discovered at runtime, so
-// the matching StatInsnDuration is allocated and registered lazily the first
-// time a label is seen. The map is node-based, so the address handed to
-// register_stat() stays valid for the rest of the run. Registering mid-sim is
-// safe: register_stat() only appends to the engine's entry list, which is
-// iterated at dump time.
+// Collection of per-label duration stats.
+//
+// Each decoder instruction gets a dense slot the first time it is decoded (see
+// assign_slot), so accounting is an indexed update of a flat array of records,
+// with no lookup by label. The array is only folded into the per-label stats
+// when the engine is about to dump them, which is also when the stats of new
+// labels are registered. Several decoder instructions can share a label, they
+// are then merged into the same stat. The map is node-based, so the address
+// handed to register_stat() stays valid for the rest of the run. The "all"
+// stat, over every instruction, is registered at init so that a reset of the
+// stats before the first dump still drops the pending records.
 class InsnDurationStats
 {
 public:
+    // Give a slot to a decoder instruction, once. Slots are shared by all
+    // collections, since decoder instructions are shared by all cores.
+    static inline void assign_slot(iss_decoder_insn_t *desc)
+    {
+        if (desc->stat_slot < 0)
+        {
+            desc->stat_slot = slot_labels().size();
+            slot_labels().push_back(desc->label);
+        }
+    }
+
     // Cache the block stat helper and the group prefix (e.g. "insn_duration").
     // Each label becomes "<group>/<label>", which the grouped dumper collects
     // under "<core_path>/<group>".
@@ -87,30 +134,76 @@ public:
     {
         this->stats = stats;
         this->group = group;
+
+        vp::StatsEngine *engine = stats->get_engine();
+        if (engine != nullptr && engine->is_enabled())
+        {
+            this->stats->register_stat(&this->all, this->group + "/all",
+                "Average execution duration in cycles of all instructions");
+            engine->register_pre_dump([this]() { this->flush(); });
+        }
     }
 
-    inline void account(const char *label, int64_t cycles)
+    inline void account(iss_decoder_insn_t *desc, int64_t cycles)
     {
-        Entry &stat = this->map[label];
-        if (!stat.registered_in_engine)
+        size_t slot = desc->stat_slot;
+        if (unlikely(slot >= this->records.size()))
         {
-            stat.registered_in_engine = true;
-            this->stats->register_stat(&stat, this->group + "/" + label,
-                "Average execution duration in cycles");
+            this->records.resize(slot_labels().size());
+        }
+        this->records[slot].account(cycles);
+    }
+
+    // Drop the records accounted since the last dump. Called when the engine
+    // resets the stats, through the "all" stat or any per-label stat.
+    inline void clear_pending()
+    {
+        for (InsnDurationRecord &record : this->records)
+        {
+            record = InsnDurationRecord();
         }
-        stat.account(cycles);
     }
 
 private:
-    // Per-label stat plus a flag tracking whether it has been registered yet.
-    struct Entry : public StatInsnDuration
+    // Label of each slot, indexed by slot
+    static std::vector<const char *> &slot_labels()
+    {
+        static std::vector<const char *> labels;
+        return labels;
+    }
+
+    // Fold the records accounted since the last dump into the per-label stats
+    void flush()
     {
-        bool registered_in_engine = false;
-    };
+        for (size_t slot = 0; slot < this->records.size(); slot++)
+        {
+            InsnDurationRecord &record = this->records[slot];
+            if (record.count == 0) continue;
 
-    std::unordered_map<std::string, Entry> map;
+            const char *label = slot_labels()[slot];
+            auto [it, inserted] = this->map.try_emplace(label, this);
+            if (inserted)
+            {
+                this->stats->register_stat(&it->second, this->group + "/" + label,
+                    "Average execution duration in cycles");
+            }
+            it->second.merge(record);
+            this->all.merge(record);
+            record = InsnDurationRecord();
+        }
+    }
+
+    std::vector<InsnDurationRecord> records;
+    std::unordered_map<std::string, StatInsnDuration> map;
+    StatInsnDuration all{this};
     vp::BlockStat *stats = nullptr;
     std::string group;
 };
 
+inline void StatInsnDuration::reset()
+{
+    this->record = InsnDurationRecord();
+    this->owner->clear_pending();
+}
+
 #endif  // CONFIG_GVSOC_STATS_ACTIVE
@@ -246,6 +246,7 @@ typedef struct iss_decoder_range_set_s
 {
     int nb_ranges;
     iss_decoder_range_t ranges[ISS_MAX_DECODE_RANGES];
+    int bits;           // Width of the extracted value, used for sign extension
 } iss_decoder_range_set_t;
 
 typedef enum
@@ -356,6 +357,8 @@ typedef struct iss_decoder_insn_s
     float chaining_factor = 1.0f;
     float out_chaining_factor = 1.0f;
 #endif
+    // Dense index of the instruction in the duration statistics, -1 until it is first decoded
+    int stat_slot = -1;
 } iss_decoder_insn_t;
 
 typedef struct iss_decoder_item_s
@@ -377,6 +380,10 @@ typedef struct iss_decoder_item_s
             int width;
             int nb_groups;
             iss_decoder_item_t **groups;
+            // Sub-items directly indexed by the group opcode, with the "others" item in
+            // every slot not matching any sub-item. NULL for wide groups, which are
+            // decoded by scanning groups.
+            iss_decoder_item_t **table;
         } group;
     } u;
 
@@ -159,6 +159,33 @@ class PrefetchSingleLine(IssModule):
         iss.isa.add_include('<cpu/iss_v2/include/prefetch/prefetch_single_line.hpp>')
         iss.add_sources(['cpu/iss_v2/src/prefetch/prefetch_single_line.cpp'])
 
+class PrefetchMultiLine(IssModule):
+    """Multi-line instruction prefetch buffer.
+
+    Drop-in replacement for :class:`PrefetchSingleLine` holding ``nb_lines`` lines of
+    ``size`` bytes. Loops which fit the buffer are not refetched, and when the core enters
+    a line the next one is prefetched (``next_line``), so that sequential code only sees the
+    part of the fetch latency not covered by the execution of the current line. With
+    ``branch_targets``, lines refilled after a jump are replaced last.
+    Pass ``modules={'prefetch': PrefetchMultiLine()}`` to :class:`Riscv` to use it.
+    """
+    def __init__(self, size: int=16, nb_lines: int=4, next_line: bool=True,
+            branch_targets: bool=False):
+        self.size = size
+        self.nb_lines = nb_lines
+        self.next_line = next_line
+        self.branch_targets = branch_targets
+
+    @override
+    def gen(self, iss: RiscvCommon):
+        iss.isa.add_define('CONFIG_GVSOC_ISS_PREFETCH', 'PrefetchMultiLine')
+        iss.isa.add_define('CONFIG_GVSOC_ISS_PREFETCH_SIZE', self.size)
+        iss.isa.add_define('CONFIG_GVSOC_ISS_PREFETCH_NB_LINES', self.nb_lines)
+        iss.isa.add_define('CONFIG_GVSOC_ISS_PREFETCH_NEXT_LINE', int(self.next_line))
+        iss.isa.add_define('CONFIG_GVSOC_ISS_PREFETCH_BRANCH_TARGETS', int(self.branch_targets))
+        iss.isa.add_include('<cpu/iss_v2/include/prefetch/prefetch_multi_line.hpp>')
+        iss.add_sources(['cpu/iss_v2/src/prefetch/prefetch_multi_line.cpp'])
+
 class Lsu(IssModule):
     def __init__(self, nb_outstanding: int=1):
         self.nb_outstanding = nb_outstanding
@@ -259,6 +286,23 @@ class Event(IssModule):
         iss.add_sources(['cpu/iss_v2/src/event/event.cpp'])
         iss.isa.add_implem_include('<cpu/iss_v2/include/event/event_implem.hpp>')
 
+class EventEmpty(IssModule):
+    """Null event sink.
+
+    Drop-in replacement for :class:`Event` for cores which do not need performance counters,
+    ``pcer_*`` VCD events or core statistics. The accounting hooks called for every
+    instruction are empty and compile to nothing, while the state, PC and power events are
+    kept. Pass ``modules={'event': EventEmpty()}`` to :class:`Riscv` to use it.
+    """
+    @override
+    def gen(self, iss: RiscvCommon):
+        iss.isa.add_define('CONFIG_GVSOC_ISS_EVENT', 'EventsEmpty')
+        iss.isa.add_include('<cpu/iss_v2/include/event/event.hpp>')
+        iss.isa.add_include('<cpu/iss_v2/include/event/empty.hpp>')
+        iss.add_sources(['cpu/iss_v2/src/event/event.cpp'])
+        iss.isa.add_implem_include('<cpu/iss_v2/include/event/event_implem.hpp>')
+        iss.isa.add_implem_include('<cpu/iss_v2/include/event/empty_implem.hpp>')
+
 
 class Hwloop(IssModule):
     """Hardware-loop module (CoreV / PULP-style ``Xhwloop``).
@@ -373,7 +417,8 @@ class RiscvCommon(st.Component):
 
         self.add_c_flags([f'-DCONFIG_GVSOC_ISS_FLOAT_USE_{float_lib.upper()}=1'])
 
-        if float_lib == 'softfloat':
+        # The native library falls back to softfloat for the cases the host cannot handle
+        if float_lib in ['softfloat', 'native']:
             self.add_sources([
                 "cpu/iss/softfloat/softfloat_state.cpp",
                 "cpu/iss/softfloat/softfloat_raiseFlags.cpp",
@@ -415,6 +460,7 @@ class RiscvCommon(st.Component):
                 "cpu/iss/softfloat/s_mulAddF64.cpp",
                 "cpu/iss/softfloat/s_mulAddF16.cpp",
                 "cpu/iss/softfloat/f32_add.cpp",
+                "cpu/iss/softfloat/f32_sub.cpp",
                 "cpu/iss/softfloat/f64_mulAdd.cpp",
                 "cpu/iss/softfloat/f32_mulAdd.cpp",
                 "cpu/iss/softfloat/f16_mulAdd.cpp",
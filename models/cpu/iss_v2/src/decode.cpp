@@ -38,19 +38,14 @@ uint64_t Decode::decode_ranges(iss_opcode_t opcode, iss_decoder_range_set_t *ran
 {
     int nb_ranges = range_set->nb_ranges;
     iss_decoder_range_t *ranges = range_set->ranges;
-    ;
     uint64_t result = 0;
-    int bits = 0;
     for (int i = 0; i < nb_ranges; i++)
     {
         iss_decoder_range_t *range = &ranges[i];
         result |= iss_get_field(opcode, range->bit, range->width) << range->shift;
-        int last_bit = range->width + range->shift;
-        if (last_bit > bits)
-            bits = last_bit;
     }
     if (is_signed)
-        result = iss_get_signed_value(result, bits);
+        result = iss_get_signed_value(result, range_set->bits);
     return result;
 }
 
@@ -105,6 +100,9 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
         return -1;
 
     insn->desc = &item->u.insn;
+#ifdef CONFIG_GVSOC_STATS_ACTIVE
+    InsnDurationStats::assign_slot(insn->desc);
+#endif
     insn->resource_id = item->u.insn.resource_id;
     insn->resource_latency = item->u.insn.resource_latency;
     insn->resource_bandwidth = item->u.insn.resource_bandwidth;
@@ -247,6 +245,15 @@ int Decode::decode_insn(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss
 int Decode::decode_opcode_group(iss_insn_t *insn, iss_reg_t pc, iss_opcode_t opcode, iss_decoder_item_t *item)
 {
     iss_opcode_t group_opcode = (opcode >> item->u.group.bit) & ((1ULL << item->u.group.width) - 1);
+
+    if (item->u.group.table)
+    {
+        iss_decoder_item_t *group_item = item->u.group.table[group_opcode];
+        if (group_item == NULL)
+            return -1;
+        return this->decode_item(insn, pc, opcode, group_item);
+    }
+
     iss_decoder_item_t *group_item_other = NULL;
 
     for (int i = 0; i < item->u.group.nb_groups; i++)
@@ -22,7 +22,7 @@
 #include <vp/stats/stats_engine.hpp>
 #include <cpu/iss_v2/include/event/event.hpp>
 
-Events::Events(Iss &iss)
+Events::Events(Iss &iss, bool counters)
 : iss(iss),
 state_event(iss, "state", 8, gv::Vcd_event_type_logical, "Core state (active, idle, stall)"),
 pc_trace_event(iss, "pc", ISS_REG_WIDTH, gv::Vcd_event_type_logical, "Program counter value"),
@@ -65,7 +65,8 @@ active_pc_trace_event(iss, "active_pc", ISS_REG_WIDTH, gv::Vcd_event_type_logica
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
     // Cache whether stats are enabled at runtime (--stats). Skip all work otherwise.
     vp::StatsEngine *stats_engine = this->iss.stats.get_engine();
-    this->stats_enabled = stats_engine != nullptr && stats_engine->is_enabled();
+    this->stats_enabled = counters && stats_engine != nullptr && stats_engine->is_enabled();
+    this->stats_active = this->stats_enabled;
 
     if (this->stats_enabled)
     {
@@ -84,8 +85,8 @@ active_pc_trace_event(iss, "active_pc", ISS_REG_WIDTH, gv::Vcd_event_type_logica
         this->iss.stats.register_stat(&this->stat_ipc,          "ipc",          "Instructions per non-idle cycle");
         this->iss.stats.register_stat(&this->stat_active_pct,   "active_pct",   "Percentage of cycles the core was active");
 
-        // Per-label instruction durations are registered lazily, the first
-        // time each label is seen, under the "insn_duration" group.
+        // Per-label instruction durations are registered at dump time, the
+        // first time each label has been seen, under the "insn_duration" group.
         this->insn_durations.init(&this->iss.stats, "insn_duration");
 
         // Flush the in-progress window at dump time so the cycle counters
@@ -111,6 +112,27 @@ active_pc_trace_event(iss, "active_pc", ISS_REG_WIDTH, gv::Vcd_event_type_logica
 #endif
 }
 
+void Events::stats_start()
+{
+#ifdef CONFIG_GVSOC_STATS_ACTIVE
+    if (this->stats_enabled && !this->stats_active)
+    {
+        this->stats_active = true;
+        // Go back to the full handler so that instructions are counted again
+        this->iss.exec.switch_to_full_mode();
+    }
+#endif
+}
+
+void Events::stats_stop()
+{
+    // The full handler checks needs_full_mode() at the next instruction and switches back to
+    // the fast one.
+#ifdef CONFIG_GVSOC_STATS_ACTIVE
+    this->stats_active = false;
+#endif
+}
+
 void Events::reset(bool active)
 {
     if (active)
@@ -0,0 +1,387 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Authors: Germain Haugou, GreenWaves Technologies (germain.haugou@greenwaves-technologies.com)
+ */
+
+#include <vp/vp.hpp>
+
+PrefetchMultiLine::PrefetchMultiLine(Iss &iss)
+    : iss(iss)
+{
+    this->iss.traces.new_trace("prefetcher", &this->trace, vp::DEBUG);
+#ifndef CONFIG_GVSOC_ISS_LSU_V2
+    this->fetch_itf.set_resp_meth(&PrefetchMultiLine::fetch_response);
+#endif
+    this->iss.new_master_port("fetch", &fetch_itf, (vp::Block *)this);
+}
+
+void PrefetchMultiLine::reset(bool active)
+{
+    if (active)
+    {
+        this->lines.reset();
+        this->buffer_start_addr = -1;
+        this->prefetch_insn = NULL;
+    }
+}
+
+bool PrefetchMultiLine::fetch_refill(iss_insn_t *insn, iss_addr_t addr, int index)
+{
+    // We get here either if the instruction is entirely outside the current line or if it is
+    // only partially within.
+    if (this->prefetch_insn == insn)
+    {
+        return true;
+    }
+
+    this->prefetch_insn = NULL;
+
+    // If the instruction is entirely outside the current line, first get the line of the
+    // lower part
+    if (unlikely(index < 0 || index >= CONFIG_GVSOC_ISS_PREFETCH_SIZE))
+    {
+        if (int err = this->enter_line(addr))
+        {
+            if (err == -1)
+            {
+                // In case of a pending refill, we have to register a callback and leave,
+                // we'll get notified when the response is received
+                this->handle_stall(fetch_resume_after_low_refill, insn);
+            }
+            return false;
+        }
+        index = addr - this->buffer_start_addr;
+    }
+
+    // Now check if we can fully get the instruction from the current line, or it is only
+    // partially inside.
+    return this->fetch_check_overflow(insn, index);
+}
+
+void PrefetchMultiLine::fetch_resume_after_low_refill(PrefetchMultiLine *_this)
+{
+    iss_addr_t addr = _this->prefetch_insn->addr;
+    int index = addr - _this->buffer_start_addr;
+    _this->fetch_check_overflow(_this->prefetch_insn, index);
+}
+
+bool PrefetchMultiLine::fetch_check_overflow(iss_insn_t *insn, int index)
+{
+    iss_addr_t addr = insn->addr;
+
+    // Check if we overflow the current line. If not, the instruction fetch is over
+    if (likely(index + ISS_OPCODE_MAX_SIZE <= CONFIG_GVSOC_ISS_PREFETCH_SIZE))
+    {
+        insn->opcode = *(iss_opcode_t *)&this->data[index];
+    }
+    else
+    {
+        // Case where the opcode is between 2 lines. The first part is taken from the current
+        // line, and the second one from the next line once it becomes the current one.
+        iss_opcode_t opcode = 0;
+
+        // Compute address of next line
+        iss_addr_t next_addr = (this->current_pc + CONFIG_GVSOC_ISS_PREFETCH_SIZE - 1) & ~(CONFIG_GVSOC_ISS_PREFETCH_SIZE - 1);
+        iss_reg_t next_phys_addr;
+        // Number of bytes of the opcode which fits the first line
+        int nb_bytes = next_addr - addr;
+        iss_addr_t mask = ((1ULL << (nb_bytes*8)) - 1);
+        // Copy first part from first line
+        opcode = *(iss_opcode_t *)&this->data[index] & mask;
+#ifdef CONFIG_GVSOC_ISS_MMU
+        if (this->iss.mmu.insn_virt_to_phys(next_addr, next_phys_addr))
+        {
+            return false;
+        }
+#else
+        next_phys_addr = next_addr;
+#endif
+
+        // Get next line, usually already prefetched
+        if (int err = this->enter_line(next_phys_addr))
+        {
+            // Stall the core if the fetch is pending
+            // We need to remember the opcode since the first line may be replaced
+            if (err == -1)
+            {
+                this->fetch_stall_opcode = opcode;
+                this->handle_stall(fetch_resume_after_high_refill, insn);
+            }
+            return false;
+        }
+        // If the line is available now, append the second part from second line to the previous
+        // opcode and decode it
+        opcode = (opcode  & mask) | ((*(iss_opcode_t *)&this->data[0]) << (nb_bytes*8));
+
+        insn->opcode = opcode;
+    }
+
+    return true;
+}
+
+void PrefetchMultiLine::fetch_resume_after_high_refill(PrefetchMultiLine *_this)
+{
+    iss_addr_t addr = _this->prefetch_insn->addr;
+    iss_addr_t next_addr = (addr + CONFIG_GVSOC_ISS_PREFETCH_SIZE - 1) & ~(CONFIG_GVSOC_ISS_PREFETCH_SIZE - 1);
+    // Number of bytes of the opcode which fits the first line
+    int nb_bytes = next_addr - addr;
+
+    // And append the second part from second line
+    _this->prefetch_insn->opcode = _this->fetch_stall_opcode | ((*(iss_opcode_t *)&_this->data[0]) << (nb_bytes * 8));
+}
+
+int PrefetchMultiLine::enter_line(iss_addr_t addr)
+{
+    if (!this->lines.enter(addr))
+    {
+        Lines::Line *line = this->lines.current;
+        this->data = line->data;
+        this->buffer_start_addr = line->tag;
+
+        int err = this->send_fetch_req(&line->req, line->tag, line->data,
+            CONFIG_GVSOC_ISS_PREFETCH_SIZE, false);
+        if (err == 1)
+        {
+            this->lines.enter_failed();
+            this->buffer_start_addr = -1;
+            return err;
+        }
+        else if (err == -1)
+        {
+            this->lines.enter_pending();
+        }
+
+        this->prefetch_next_line();
+        return err;
+    }
+
+    Lines::Line *line = this->lines.current;
+
+    this->trace.msg(vp::Trace::LEVEL_TRACE, "Prefetch buffer hit (addr: 0x%lx)\n", line->tag);
+
+    this->data = line->data;
+    this->buffer_start_addr = line->tag;
+
+    if (line->pending)
+    {
+        // The prefetch of this line is still in flight, the core has to wait for it
+        this->lines.enter_pending();
+        this->iss.timing.event_imiss_start();
+        return -1;
+    }
+
+    this->account_latency(this->lines.enter_latency(this->iss.clock.get_cycles()));
+
+    this->prefetch_next_line();
+    return 0;
+}
+
+void PrefetchMultiLine::prefetch_next_line()
+{
+#if CONFIG_GVSOC_ISS_PREFETCH_NEXT_LINE
+#ifdef CONFIG_GVSOC_ISS_MMU
+    Lines::Line *line = this->lines.prefetch_alloc(1 << MMU_PGSHIFT);
+#else
+    Lines::Line *line = this->lines.prefetch_alloc(0);
+#endif
+    if (line == NULL)
+    {
+        return;
+    }
+
+    vp::IoReq *req = &line->req;
+
+    this->trace.msg(vp::Trace::LEVEL_TRACE, "Prefetch request (addr: 0x%lx, size: 0x%x)\n",
+        line->tag, CONFIG_GVSOC_ISS_PREFETCH_SIZE);
+
+#ifdef CONFIG_GVSOC_ISS_LSU_V2
+    req->prepare();
+#else
+    req->init();
+#endif
+    req->set_addr(line->tag);
+    req->set_size(CONFIG_GVSOC_ISS_PREFETCH_SIZE);
+    req->set_is_write(false);
+    req->set_data(line->data);
+
+    vp::IoReqStatus err = this->fetch_itf.req(req);
+#ifdef CONFIG_GVSOC_ISS_LSU_V2
+    bool pending = err != vp::IO_REQ_DONE;
+    bool invalid = !pending && req->get_resp_status() == vp::IO_RESP_INVALID;
+#else
+    bool pending = err != vp::IO_REQ_OK && err != vp::IO_REQ_INVALID;
+    bool invalid = err == vp::IO_REQ_INVALID;
+#endif
+    this->lines.prefetch_sent(line, pending, invalid,
+        this->iss.clock.get_cycles() + req->get_latency());
+#endif
+}
+
+int PrefetchMultiLine::send_fetch_req(vp::IoReq *req, uint64_t addr, uint8_t *data, uint64_t size, bool is_write)
+{
+    this->trace.msg(vp::Trace::LEVEL_TRACE, "Fetch request (addr: 0x%lx, size: 0x%lx)\n", addr, size);
+
+#ifdef CONFIG_GVSOC_ISS_LSU_V2
+    req->prepare();
+#else
+    req->init();
+#endif
+    req->set_addr(addr);
+    req->set_size(size);
+    req->set_is_write(is_write);
+    req->set_data(data);
+    vp::IoReqStatus err = this->fetch_itf.req(req);
+#ifdef CONFIG_GVSOC_ISS_LSU_V2
+    if (err == vp::IO_REQ_DONE)
+    {
+        if (req->get_resp_status() == vp::IO_RESP_INVALID)
+        {
+#ifndef CONFIG_GVSOC_ISS_RISCV_EXCEPTIONS
+            this->trace.force_warning("Invalid fetch request (addr: 0x%x, size: 0x%x)\n", addr, size);
+#endif
+            this->iss.exception.raise(this->iss.exec.current_insn, ISS_EXCEPT_INSN_FAULT);
+            return 1;
+        }
+    }
+    else
+    {
+        this->trace.msg(vp::Trace::LEVEL_TRACE, "Waiting for asynchronous response\n");
+        this->iss.timing.event_imiss_start();
+        return -1;
+    }
+#else
+    if (err != vp::IO_REQ_OK)
+    {
+        if (err == vp::IO_REQ_INVALID)
+        {
+#ifndef CONFIG_GVSOC_ISS_RISCV_EXCEPTIONS
+            this->trace.force_warning("Invalid fetch request (addr: 0x%x, size: 0x%x)\n", addr, size);
+#endif
+            this->iss.exception.raise(this->iss.exec.current_insn, ISS_EXCEPT_INSN_FAULT);
+            return 1;
+        }
+        else
+        {
+            this->trace.msg(vp::Trace::LEVEL_TRACE, "Waiting for asynchronous response\n");
+            this->iss.timing.event_imiss_start();
+            return -1;
+        }
+    }
+#endif
+
+    this->account_latency(req->get_latency());
+
+    return 0;
+}
+
+void PrefetchMultiLine::account_latency(int64_t latency)
+{
+    // Refills and lines entered before their prefetch is over are accounted the same way. As
+    // for the single-line prefetcher, a latency of 1 cycle is the one of a fetch which hits.
+    this->iss.timing.event_fetch_account();
+    if (latency > 1)
+    {
+        this->iss.timing.event_imiss_account(latency);
+    }
+}
+
+void PrefetchMultiLine::fetch_response(vp::Block *__this, vp::IoReq *req)
+{
+    PrefetchMultiLine *_this = (PrefetchMultiLine *)__this;
+
+    _this->trace.msg(vp::Trace::LEVEL_TRACE, "Received fetch response (addr: 0x%lx)\n", req->get_addr());
+
+    // If the prefetch is received before the core needs it, only the remaining latency will
+    // be seen
+    if (!_this->lines.response(req, _this->iss.clock.get_cycles() + req->get_latency()))
+    {
+        return;
+    }
+
+    _this->iss.timing.event_imiss_stop();
+
+    // Now unstall the core and call the fetch callback so that we can continue the refill
+    // operation
+    _this->iss.exec.retain_dec();
+    if (_this->fetch_stall_callback)
+    {
+        _this->fetch_stall_callback(_this);
+    }
+
+    // The core has entered the line, the next one can now be prefetched
+    _this->prefetch_next_line();
+}
+
+bool PrefetchMultiLine::fetch(iss_reg_t addr)
+{
+    // Since an instruction can be 2 or 4 bytes, we need to be careful that only part of it can
+    // fit the current line, so we have to check both the low part and the high part.
+
+    // Compute where the instructions address falls into the current line
+    iss_reg_t phys_addr;
+
+#ifdef CONFIG_GVSOC_ISS_MMU
+    if (this->iss.mmu.insn_virt_to_phys(addr, phys_addr))
+    {
+        return false;
+    }
+#else
+    phys_addr = addr;
+#endif
+
+    iss_insn_t *insn = this->iss.insn_cache.get_insn(addr);
+    if (insn == NULL)
+    {
+        return false;
+    }
+
+    unsigned int index = phys_addr - this->buffer_start_addr;
+
+    // If it is entirely within the current line, get the opcode and decode it.
+    if (likely(index <= CONFIG_GVSOC_ISS_PREFETCH_SIZE - sizeof(iss_opcode_t)))
+    {
+        insn->opcode = *(iss_opcode_t *)&this->data[index];
+        return true;
+    }
+
+    // Otherwise, look for the line in the buffer or refill it
+    this->current_pc = addr;
+    return this->fetch_refill(insn, phys_addr, index);
+}
+
+void PrefetchMultiLine::flush()
+{
+    this->lines.flush();
+    // Since the address is an unsigned int, the next index will be negative and will force the prefetcher
+    // to look for a new line
+    this->buffer_start_addr = -1;
+}
+
+void PrefetchMultiLine::handle_stall(void (*callback)(PrefetchMultiLine *), iss_insn_t *current_insn)
+{
+    Iss *iss = &this->iss;
+
+    // Function to be called when the refill is done
+    this->fetch_stall_callback = callback;
+    // Remember the current instruction since the core may switch to a new one while the prefetch buffer
+    // is being refilled
+    this->prefetch_insn = current_insn;
+    // Stall the core
+    iss->exec.retain_inc();
+}
@@ -757,6 +757,7 @@ void Syscalls::handle_riscv_ebreak()
         {
             engine->start(this->iss.time.get_time());
         }
+        this->iss.timing.stats_start();
         break;
     }
 
@@ -767,6 +768,7 @@ void Syscalls::handle_riscv_ebreak()
         {
             engine->stop(this->iss.time.get_time());
         }
+        this->iss.timing.stats_stop();
         break;
     }
 
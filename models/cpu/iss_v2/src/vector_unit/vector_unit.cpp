@@ -71,8 +71,8 @@ Vu::Vu(Iss &iss)
     }
 
 #ifdef CONFIG_GVSOC_STATS_ACTIVE
-    // Cache whether stats are enabled; per-label entries register lazily under
-    // the "vinsn_duration" group the first time each label completes.
+    // Cache whether stats are enabled; per-label entries are registered at dump
+    // time under the "vinsn_duration" group, once their label has completed.
     vp::StatsEngine *stats_engine = this->iss.stats.get_engine();
     this->stats_enabled = stats_engine != nullptr && stats_engine->is_enabled();
     this->insn_durations.init(&this->iss.stats, "vinsn_duration");
@@ -300,7 +300,7 @@ void Vu::insn_end(PendingInsn *pending_insn)
     // now. Common to all blocks (VLSU / VFPU / VSLIDE).
     if (this->stats_enabled && pending_insn->exec_start_cycle >= 0)
     {
-        this->insn_durations.account(insn->desc->label,
+        this->insn_durations.account(insn->desc,
             this->iss.clock.get_cycles() - pending_insn->exec_start_cycle);
     }
 #endif
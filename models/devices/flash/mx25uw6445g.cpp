@@ -35,6 +35,7 @@
 
 #include <vp/itf/hyper.hpp>
 #include <vp/itf/wire.hpp>
+#include <utils/burst.hpp>
 
 // Flash sector size
 #define MX25_SECTOR_SIZE (1 << 12)
@@ -54,7 +55,7 @@ typedef enum
  * This model derive from the time_scheduler so that it can push events based on time since
  * the flash is not cycle-based.
  */
-class Mx25 : public vp::Component
+class Mx25 : public vp::Component, public BurstIf
 {
 
 public:
@@ -68,6 +69,20 @@ public:
     // GVSOC reset function overloading
     void reset(bool active);
 
+    /**
+     * @brief Handle the whole data phase of a read or program command
+     *
+     * This can be called by the controller instead of sync_cycle, once the command header and
+     * address have been received, to transfer all the data bytes in one call.
+     *
+     * @param data     Buffer receiving the read data or containing the data to be programmed.
+     * @param size     Number of data bytes.
+     * @param is_write True if the command is a program.
+     * @return The number of octospi clock cycles of the data phase, including latency, or -1
+     *      if the burst can not be handled and the controller must go through sync_cycle.
+     */
+    int64_t burst_access(uint8_t *data, uint64_t size, bool is_write) override;
+
 private:
     /**
      * @brief Handle octospi clock edges
@@ -293,6 +308,8 @@ private:
     int program_size;
     // Time event used to make the flash available after a specific duration.
     vp::TimeEvent busy_event;
+    // False if bursts are refused, to only go through the edge interface.
+    bool burst;
 };
 
 
@@ -402,6 +419,51 @@ uint32_t Mx25::handle_array_access(int address, int is_write, uint8_t data)
 }
 
 
+int64_t Mx25::burst_access(uint8_t *data, uint64_t size, bool is_write)
+{
+    // Only array reads and programs are handled, and only at a byte boundary. Anything else,
+    // as well as accesses while busy or out of the array, is left to the edge interface which
+    // takes care of reporting them.
+    bool array_command = this->current_command == 0x12ed || this->current_command == 0x12 ||
+        this->current_command == 0xee11 || this->current_command == 0xc ||
+        this->current_command == 0xec13;
+
+    if (!this->burst || this->octospi_state != MX25_STATE_DATA || !array_command ||
+        is_write != this->is_write || this->busy || this->pending_bits != 8 ||
+        (uint64_t)this->current_address + size > (uint64_t)this->size)
+    {
+        return -1;
+    }
+
+    this->trace.msg(vp::Trace::LEVEL_TRACE,
+        "Handling burst (address: 0x%x, size: 0x%llx, is_write: %d)\n",
+        this->current_address, (unsigned long long)size, is_write);
+
+    // Number of useful edges of the data phase. In DTR mode, the latency has already been
+    // doubled since both edges are useful.
+    int64_t edges = this->latency_count + size * (this->ospi_mode ? 1 : 8);
+    this->latency_count = 0;
+
+    if (is_write)
+    {
+        // Programming must check each byte and accounts the program size, so it still goes
+        // through the array access, only the edge handling is skipped.
+        for (uint64_t i = 0; i < size; i++)
+        {
+            this->handle_array_access(this->current_address++, true, data[i]);
+        }
+    }
+    else
+    {
+        memcpy(data, &this->data[this->current_address], size);
+        this->current_address += size;
+    }
+
+    return this->dtr_mode ? (edges + 1) / 2 : edges;
+}
+
+
+
 void Mx25::parse_command(int &addr_bits)
 {
     this->trace.msg(vp::Trace::LEVEL_TRACE,
@@ -1028,6 +1090,9 @@ Mx25::Mx25(vp::ComponentConf &config)
     bool writeback = this->get_js_config()->get_child_bool("writeback");
     this->size = conf->get("size")->get_int();
 
+    js::Config *burst_conf = conf->get("burst");
+    this->burst = burst_conf != NULL && burst_conf->get_bool();
+
     this->trace.msg(vp::Trace::LEVEL_INFO, "Building flash (size: 0x%x)\n", this->size);
 
     // If there is no preload file or if the preload file is a classi input file,
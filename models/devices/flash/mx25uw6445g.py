@@ -34,10 +34,13 @@ class Mx25uw6445g(Flash):
     ----------
     size : int
         Size of the flash (default: 0x08000000).
+    burst : bool
+        True if the controller can transfer the data phase of a command in one call instead of
+        clocking it edge per edge, False to keep the edge-accurate path (default: False).
 
     """
 
-    def __init__(self, parent, name, size=None):
+    def __init__(self, parent, name, size=None, burst=False):
         super().__init__(parent, name)
 
         if size is None:
@@ -49,3 +52,4 @@ class Mx25uw6445g(Flash):
 
         self.add_property('writeback', True)
         self.add_property('size', size)
+        self.add_property('burst', burst)
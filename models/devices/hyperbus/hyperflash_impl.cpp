@@ -31,6 +31,7 @@
 
 #include <vp/itf/hyper.hpp>
 #include <vp/itf/wire.hpp>
+#include <utils/burst.hpp>
 
 #define REGS_AREA_SIZE 1024
 
@@ -65,7 +66,7 @@ typedef enum
 } hyperbus_state_e;
 
 
-class Hyperflash : public vp::Component
+class Hyperflash : public vp::Component, public BurstIf
 {
 
 public:
@@ -73,6 +74,7 @@ public:
   Hyperflash(vp::ComponentConf &conf);
 
   void handle_access(int reg_access, int address, int read, uint8_t data);
+  int64_t burst_access(uint8_t *data, uint64_t size, bool is_write) override;
   int preload_file(char *path);
   void erase_sector(unsigned int addr);
   void erase_chip();
@@ -117,6 +119,8 @@ protected:
   bool burst_write = false;
   int nb_word = -1;
   int sector;
+  // False if bursts are refused, to only go through the edge interface
+  bool burst;
 };
 
 
@@ -329,6 +333,39 @@ void Hyperflash::handle_access(int reg_access, int address, int read, uint8_t da
   }
 }
 
+int64_t Hyperflash::burst_access(uint8_t *data, uint64_t size, bool is_write)
+{
+  // Status register reads, out-of-bound accesses and bursts in the other direction than the
+  // command are left to the edge interface
+  if (!this->burst || this->hyper_state != HYPERBUS_STATE_DATA || is_write == (bool)this->ca.read ||
+    (!is_write && this->state == HYPERFLASH_STATE_GET_STATUS_REG) ||
+    (uint64_t)this->current_address + size > (uint64_t)this->size)
+  {
+    return -1;
+  }
+
+  this->trace.msg(vp::Trace::LEVEL_TRACE, "Handling burst (addr: 0x%x, size: 0x%llx, is_write: %d)\n",
+    this->current_address, (unsigned long long)size, is_write);
+
+  if (is_write)
+  {
+    // Writes are either command sequences or programming, which must check each byte, so they
+    // still go through the byte handler, only the edge handling is skipped
+    for (uint64_t i=0; i<size; i++)
+    {
+      this->handle_access(this->reg_access, this->current_address++, 0, data[i]);
+    }
+  }
+  else
+  {
+    memcpy(data, &this->data[this->current_address], size);
+    this->current_address += size;
+  }
+
+  // Hyperbus is transferring one byte on each clock edge
+  return (size + 1) / 2;
+}
+
 int Hyperflash::preload_file(char *path)
 {
   this->trace.msg(vp::Trace::LEVEL_INFO, "Preloading memory with stimuli file (path: %s)\n", path);
@@ -432,6 +469,9 @@ Hyperflash::Hyperflash(vp::ComponentConf &config)
   js::Config *conf = this->get_js_config();
 
   this->size = conf->get("size")->get_int();
+
+  js::Config *burst_conf = conf->get("burst");
+  this->burst = burst_conf != NULL && burst_conf->get_bool();
   this->trace.msg(vp::Trace::LEVEL_INFO, "Building flash (size: 0x%x)\n", this->size);
 
   this->data = new uint8_t[this->size];
@@ -27,13 +27,17 @@ class Hyperram(st.Component):
     ----------
     size : int
         Size of the RAM (default: 0x00800000).
+    burst : bool
+        True if the controller can transfer the data phase of a command in one call instead of
+        clocking it edge per edge, False to keep the edge-accurate path (default: False).
 
     """
 
-    def __init__(self, parent, name, size=0x00800000):
+    def __init__(self, parent, name, size=0x00800000, burst=False):
         super(Hyperram, self).__init__(parent, name)
 
         # Register all parameters as properties so that they can be overwritten from the command-line
         self.add_property('size', size)
+        self.add_property('burst', burst)
 
         self.set_component('devices.hyperbus.hyperram_impl')
@@ -31,6 +31,7 @@
 
 #include <vp/itf/hyper.hpp>
 #include <vp/itf/wire.hpp>
+#include <utils/burst.hpp>
 
 #define REGS_AREA_SIZE 1024
 
@@ -44,12 +45,13 @@ typedef enum
 
 
 
-class Hyperram : public vp::Component
+class Hyperram : public vp::Component, public BurstIf
 {
 public:
   Hyperram(vp::ComponentConf &conf);
 
   void handle_access(int reg_access, int address, int read, uint8_t data);
+  int64_t burst_access(uint8_t *data, uint64_t size, bool is_write) override;
 
   static void sync_cycle(vp::Block *_this, int data);
   static void cs_sync(vp::Block *__this, int cs, int value);
@@ -79,6 +81,8 @@ private:
   int ca_count;
   int current_address;
   int reg_access;
+  // False if bursts are refused, to only go through the edge interface
+  bool burst;
 
   Hyperbus_state_e state;
 };
@@ -112,6 +116,37 @@ void Hyperram::handle_access(int reg_access, int address, int read, uint8_t data
 
 
 
+int64_t Hyperram::burst_access(uint8_t *data, uint64_t size, bool is_write)
+{
+  // Register and out-of-bound accesses, and bursts in the other direction than the command, are
+  // left to the edge interface, which is handling them byte per byte
+  if (!this->burst || this->state != HYPERBUS_STATE_DATA || this->reg_access ||
+    is_write == (bool)this->ca.read ||
+    (uint64_t)this->current_address + size > (uint64_t)this->size)
+  {
+    return -1;
+  }
+
+  this->trace.msg(vp::Trace::LEVEL_TRACE, "Handling burst (addr: 0x%x, size: 0x%llx, is_write: %d)\n",
+    this->current_address, (unsigned long long)size, is_write);
+
+  if (is_write)
+  {
+    memcpy(&this->data[this->current_address], data, size);
+  }
+  else
+  {
+    memcpy(data, &this->data[this->current_address], size);
+  }
+
+  this->current_address += size;
+
+  // Hyperbus is transferring one byte on each clock edge
+  return (size + 1) / 2;
+}
+
+
+
 Hyperram::Hyperram(vp::ComponentConf &config)
 : vp::Component(config)
 {
@@ -125,6 +160,9 @@ Hyperram::Hyperram(vp::ComponentConf &config)
 
   this->size = conf->get("size")->get_int();
 
+  js::Config *burst_conf = conf->get("burst");
+  this->burst = burst_conf != NULL && burst_conf->get_bool();
+
   this->data = new uint8_t[this->size];
   memset(this->data, 0xff, this->size);
 
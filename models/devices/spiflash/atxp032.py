@@ -28,10 +28,13 @@ class Atxp032(st.Component):
     ----------
     size : int
         Size of the flash (default: 0x08000000).
+    burst : bool
+        True if the controller can transfer the data phase of a command in one call instead of
+        clocking it edge per edge, False to keep the edge-accurate path (default: False).
 
     """
 
-    def __init__(self, parent, name, size=0x08000000):
+    def __init__(self, parent, name, size=0x08000000, burst=False):
         super(Atxp032, self).__init__(parent, name)
 
         # Register all parameters as properties so that they can be overwritten from the command-line
@@ -50,6 +53,7 @@ class Atxp032(st.Component):
 
         self.add_property('writeback', True)
         self.add_property('size', size)
+        self.add_property('burst', burst)
 
         # TODO this is needed by GAPY but is not aligned with the size given to model
         # That should be resolved once the flash images are built by the system tree instead of gapy
@@ -21,7 +21,7 @@ from devices.flash.flash import Flash
 
 class Spiflash(Flash):
 
-    def __init__(self, parent, name, size=0x04000000):
+    def __init__(self, parent, name, size=0x04000000, burst=False):
         super(Spiflash, self).__init__(parent, name)
 
         # Register all parameters as properties so that they can be overwritten from the command-line
@@ -40,6 +40,7 @@ class Spiflash(Flash):
 
         self.add_property('writeback', True)
         self.add_property('size', size)
+        self.add_property('burst', burst)
 
         self.add_property('preload_file', self.get_image_path())
 
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <vp/itf/qspim.hpp>
+#include <utils/burst.hpp>
 
 #define CMD_READ_ID       0x9f
 #define CMD_RDCR          0x35
@@ -89,12 +90,14 @@ class spiflash;
 
 
 
-class spiflash : public vp::Component
+class spiflash : public vp::Component, public BurstIf
 {
 public:
 
   spiflash(vp::ComponentConf &conf);
 
+  int64_t burst_access(uint8_t *data, uint64_t size, bool is_write) override;
+
   static void sector_erase(vp::Block *__this, int data_0, int data_1, int data_2, int data_3);
   static void sector_erase_done(vp::Block *__this, vp::ClockEvent *event);
   static void quad_read(vp::Block *__this, int data_0, int data_1, int data_2, int data_3);
@@ -129,7 +132,7 @@ private:
   unsigned int pending_addr;
   int pending_bits;
   unsigned char pending_command_id;
-  command_t *pending_command;
+  command_t *pending_command = nullptr;
   int pending_post_addr_cmd;
   int pending_bytes;
 
@@ -138,12 +141,15 @@ private:
 
   bool quad;
   bool read;
-  bool waiting_command;
+  bool waiting_command = true;
 
   unsigned int current_addr;
 
   vp::ClockEvent *sector_erase_event;
 
+  // False if bursts are refused, to only go through the edge interface
+  bool burst;
+
 };
 
 
@@ -311,6 +317,76 @@ void spiflash::single_read(vp::Block *__this, int data_0, int data_1, int data_2
 
 }
 
+int64_t spiflash::burst_access(uint8_t *data, uint64_t size, bool is_write)
+{
+  if (!this->burst || this->waiting_command || this->pending_command == NULL || size == 0)
+  {
+    return -1;
+  }
+
+  if (is_write)
+  {
+    // Only page program is handled, once the address has been received and on a byte boundary
+    if (this->pending_command->handler != &spiflash::page_program || this->read ||
+      this->pending_bits < 24 || this->pending_bits % 8 != 0 ||
+      (uint64_t)this->current_addr + size > (uint64_t)this->size)
+    {
+      return -1;
+    }
+
+    this->trace.msg(vp::Trace::LEVEL_DEBUG, "Writing burst (address: 0x%x, size: 0x%llx)\n", this->current_addr, (unsigned long long)size);
+
+    memcpy(&this->mem_data[this->current_addr], data, size);
+    this->current_addr += size;
+    this->pending_word = data[size - 1];
+    this->pending_bits += size * 8;
+
+    // Page program is always in single mode
+    return size * 8;
+  }
+  else
+  {
+    // Only array reads are handled, once the address (and mode) has been received
+    int start_bits;
+    if (this->pending_command->handler == &spiflash::single_read)
+    {
+      start_bits = 24;
+    }
+    else if (this->pending_command->handler == &spiflash::quad_read)
+    {
+      start_bits = 40;
+    }
+    else
+    {
+      return -1;
+    }
+
+    if (!this->read || this->pending_bits < start_bits || this->pending_bits % 8 != 0)
+    {
+      return -1;
+    }
+
+    // The edge which has completed the address has already loaded the first byte and sent its
+    // first bits, so the burst starts from this byte. The next byte is loaded the same way at
+    // the end of the burst, which must then still be inside the array.
+    unsigned int addr = this->current_addr - 1;
+    if (this->current_addr == 0 || (uint64_t)addr + size >= (uint64_t)this->size)
+    {
+      return -1;
+    }
+
+    this->trace.msg(vp::Trace::LEVEL_DEBUG, "Reading burst (address: 0x%x, size: 0x%llx)\n", addr, (unsigned long long)size);
+
+    memcpy(data, &this->mem_data[addr], size);
+    this->current_addr = addr + size;
+    this->pending_bits += size * 8;
+    this->pending_word = this->mem_data[this->current_addr++];
+    this->pending_word <<= this->quad ? 4 : 1;
+
+    return size * (this->quad ? 2 : 8);
+  }
+}
+
 void spiflash::enqueue_bits(int data_0, int data_1, int data_2, int data_3)
 {
   if (!this->quad)
@@ -463,6 +539,9 @@ spiflash::spiflash(vp::ComponentConf &config)
 
   this->size = this->get_js_config()->get_child_int("size");
 
+  js::Config *burst_conf = this->get_js_config()->get("burst");
+  this->burst = burst_conf != NULL && burst_conf->get_bool();
+
   this->mem_data = new uint8_t[this->size];
 
   memset(this->mem_data, 0x57, this->size);
@@ -15,10 +15,12 @@
 //   1. Master M calls req() for bank B. We decode B from the address,
 //      set bit M in banks[B].pending_mask, schedule the FSM (0 delay),
 //      and return DENIED.
-//   2. The FSM iterates the banks. For each bank with pending bits it
-//      picks a single winner via round-robin (find-first-set on a
-//      rotated bitmask), clears the bit, and calls retry() on that
-//      master. The FSM raises an "in_election" flag for the whole
+//   2. The FSM iterates the banks with pending bits, found by scanning
+//      a bitmap of contended banks with count-trailing-zeros, so idle
+//      banks cost nothing. For each of them it picks a single winner
+//      via round-robin (find-first-set on the bits at or after the
+//      round-robin cursor, else on the whole mask), clears the bit, and
+//      calls retry() on that master. The FSM raises an "in_election" flag for the whole
 //      iteration: while it is set, any request landing on input_req is
 //      forwarded inline to its bank instead of being denied -- so the
 //      master's synchronous retry handler just re-issues and the
@@ -37,6 +39,10 @@
 //      for the next cycle so each bank serves at most one master per
 //      cycle.
 //
+// Statistics: each bank counts its accesses and its conflicts, i.e. the
+// number of master-cycles lost waiting for the bank while another master
+// was served, as output_<i>/accesses and output_<i>/conflicts.
+//
 // Output side (IoV2Sync): the bank must answer inline with
 // IO_REQ_DONE and never drives resp()/retry(). Bind only to a sync
 // slave such as memory.memory_v3.
@@ -49,6 +55,7 @@
 //     bank_offset = ((addr >> (slave_bits + interleaving_width)) << interleaving_width)
 //                   | (addr & ((1 << interleaving_width) - 1))
 
+#include <algorithm>
 #include <climits>
 #include <memory>
 #include <vector>
@@ -91,6 +98,10 @@ struct BankState
     int rr_next = 0;
     // GUI trace: the address of the access currently served by this bank.
     vp::Signal<uint64_t> gui_addr;
+    // Number of accesses granted to this bank
+    vp::StatScalar stat_accesses;
+    // Number of master-cycles lost waiting for this bank
+    vp::StatScalar stat_conflicts;
 };
 
 
@@ -124,13 +135,15 @@ private:
     uint64_t  decode_offset (uint64_t offset) const;
     // GUI: pulse the bank's address trace and the top-level activity strip.
     void      gui_log_bank  (int bank_id, uint64_t addr);
-    // Find the first set bit at or after `rr_next` in a `nb`-wide mask,
-    // wrapping. Returns the bit index in [0, nb); precondition: mask != 0.
-    int       pick_winner   (uint64_t mask, int rr_next, int nb) const;
+    // Find the first set bit at or after `rr_next` in the mask, wrapping.
+    // Returns the bit index; precondition: mask != 0.
+    int       pick_winner   (uint64_t mask, int rr_next) const;
 
     int slave_bits = 0;
     std::vector<std::unique_ptr<InputState>> inputs;
     std::vector<std::unique_ptr<BankState>>  banks;
+    // Bit b of word b / 64 is set when bank b has a non-empty pending_mask.
+    std::vector<uint64_t> active_banks;
     // True while the FSM is calling retry() on the elected winners.
     // Any incoming request seen during this window is forwarded inline.
     bool in_election = false;
@@ -200,8 +213,13 @@ LogIco::LogIco(vp::ComponentConf &config)
         std::string name = "output_" + std::to_string(i);
         auto b = std::make_unique<BankState>(this, i);
         this->new_master_port(name, &b->itf);
+        this->stats.register_stat(&b->stat_accesses, name + "/accesses",
+            "Number of accesses served by the bank");
+        this->stats.register_stat(&b->stat_conflicts, name + "/conflicts",
+            "Number of master-cycles lost waiting for the bank");
         this->banks.push_back(std::move(b));
     }
+    this->active_banks.resize((nb_slaves + 63) / 64);
 
     this->inputs.reserve(nb_masters);
     for (int i = 0; i < nb_masters; i++)
@@ -223,6 +241,7 @@ void LogIco::reset(bool active)
             b->pending_mask = 0;
             b->rr_next = 0;
         }
+        std::fill(this->active_banks.begin(), this->active_banks.end(), 0);
     }
 }
 
@@ -260,25 +279,14 @@ uint64_t LogIco::decode_offset(uint64_t offset) const
     return ((offset >> hi_shift) << iw) | (offset & iw_mask);
 }
 
-int LogIco::pick_winner(uint64_t mask, int rr_next, int nb) const
+int LogIco::pick_winner(uint64_t mask, int rr_next) const
 {
-    // Valid-bit mask so an over-wide rotation doesn't pull stale bits in.
-    uint64_t valid = (nb == 64) ? ~0ULL : ((1ULL << nb) - 1);
-    mask &= valid;
-
-    // Rotate the mask right by rr_next so the scan start lands at bit 0,
-    // then ctz gives the offset of the first set bit at-or-after rr_next.
-    uint64_t rotated;
-    if (rr_next == 0)
-    {
-        rotated = mask;
-    }
-    else
-    {
-        rotated = ((mask >> rr_next) | (mask << (nb - rr_next))) & valid;
-    }
-    int rel = __builtin_ctzll(rotated);
-    return (rr_next + rel) % nb;
+    // Keep the bits at or after the cursor, and fall back to the whole mask if
+    // there is none, which is the wrap-around. The selection is done with a mask
+    // rather than a branch, the outcome is data-dependent and poorly predicted.
+    uint64_t upper = mask & (~0ULL << rr_next);
+    uint64_t select = upper | (mask & (0ULL - (uint64_t)(upper == 0)));
+    return __builtin_ctzll(select);
 }
 
 
@@ -327,6 +335,7 @@ vp::IoReqStatus LogIco::input_req(vp::Block *__this, vp::IoReq *req, int id)
         bank_id);
 
     _this->banks[bank_id]->pending_mask |= (1ULL << id);
+    _this->active_banks[bank_id >> 6] |= 1ULL << (bank_id & 63);
     _this->fsm_event.enqueue(0);
     return vp::IO_REQ_DENIED;
 }
@@ -338,25 +347,42 @@ void LogIco::fsm_handler(vp::Block *__this, vp::ClockEvent *event)
     bool any_remaining = false;
 
     _this->in_election = true;
-    for (auto &bank : _this->banks)
+    for (size_t word_id = 0; word_id < _this->active_banks.size(); word_id++)
     {
-        if (bank->pending_mask == 0) continue;
-
-        int winner = _this->pick_winner(bank->pending_mask, bank->rr_next, nb);
-        bank->pending_mask &= ~(1ULL << winner);
-        bank->rr_next = (winner + 1) % nb;
-
-        _this->trace.msg(vp::Trace::LEVEL_DEBUG,
-            "Round-robin pick (bank: %d, winner: %d, remaining_mask: 0x%llx)\n",
-            bank->id, winner,
-            (unsigned long long)bank->pending_mask);
-
-        // Retry runs the master's retry handler synchronously: the
-        // master re-issues, input_req (with in_election=true) forwards
-        // inline to the bank and returns DONE.
-        _this->inputs[winner]->itf.retry();
-
-        if (bank->pending_mask != 0) any_remaining = true;
+        // Snapshot the word, requests forwarded during the election do not
+        // touch the bitmap, and banks are only cleared below.
+        uint64_t word = _this->active_banks[word_id];
+        while (word)
+        {
+            int bank_id = (int)(word_id * 64) + __builtin_ctzll(word);
+            word &= word - 1;
+            BankState *bank = _this->banks[bank_id].get();
+
+            int winner = _this->pick_winner(bank->pending_mask, bank->rr_next);
+            bank->pending_mask &= ~(1ULL << winner);
+            bank->rr_next = winner + 1 < nb ? winner + 1 : 0;
+            bank->stat_accesses++;
+            bank->stat_conflicts += __builtin_popcountll(bank->pending_mask);
+
+            _this->trace.msg(vp::Trace::LEVEL_DEBUG,
+                "Round-robin pick (bank: %d, winner: %d, remaining_mask: 0x%llx)\n",
+                bank->id, winner,
+                (unsigned long long)bank->pending_mask);
+
+            // Retry runs the master's retry handler synchronously: the
+            // master re-issues, input_req (with in_election=true) forwards
+            // inline to the bank and returns DONE.
+            _this->inputs[winner]->itf.retry();
+
+            if (bank->pending_mask != 0)
+            {
+                any_remaining = true;
+            }
+            else
+            {
+                _this->active_banks[word_id] &= ~(1ULL << (bank_id & 63));
+            }
+        }
     }
     _this->in_election = false;
 
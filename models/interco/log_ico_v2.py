@@ -140,9 +140,11 @@ class LogIco(Component):
       and return ``DENIED``. The crossbar never holds onto the request
       pointer — the master is expected to re-issue when retried.
     - **Arbiter tick** (``fsm_handler``): raise the ``in_election``
-      flag; for each bank with a non-empty mask, find the first set
-      bit at-or-after the bank's round-robin cursor (rotate +
-      ``ctz``), clear it, and call ``retry()`` on the winner. The
+      flag; for each bank with a non-empty mask, found through a
+      bitmap of contended banks so that idle banks are never visited,
+      find the first set bit at-or-after the bank's round-robin cursor
+      (masked select + ``ctz``), clear it, and call ``retry()`` on the
+      winner. The
       master's retry handler synchronously re-issues; the re-issue
       hits ``input_req`` with the flag still raised and is forwarded
       inline to the (IoV2Sync) bank for an inline ``IO_REQ_DONE``.
@@ -164,6 +166,22 @@ class LogIco(Component):
     latency, bandwidth) is modelled by the bank and surfaced via the
     inline ``req->latency`` annotation the master reads on response.
 
+    Statistics
+    ~~~~~~~~~~
+
+    Each bank registers two counters with the stats engine, dumped
+    with the other statistics of the run:
+
+    - ``output_<i>/accesses`` — number of accesses served by bank
+      ``i``.
+    - ``output_<i>/conflicts`` — number of master-cycles lost waiting
+      for bank ``i``: at each arbiter tick, the number of masters
+      still pending on the bank after the winner was picked.
+
+    A high conflicts-to-accesses ratio on a few banks points at a
+    too small ``nb_slaves`` or an ``interleaving_width`` not matching
+    the access stride.
+
     Ports
     ~~~~~
 
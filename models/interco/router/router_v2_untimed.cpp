@@ -11,8 +11,13 @@
  * DENIED) is propagated back to the master unchanged. `retry()` from any output is
  * broadcast to every input — masters that have nothing pending just ignore it.
  * `resp()` uses a minimal InFlight record to route back to the originating input;
- * this record is only allocated on the GRANTED path (the DONE and DENIED paths don't
- * touch initiator).
+ * this record is only installed on the GRANTED path (the DONE and DENIED paths don't
+ * touch it). Records live in a per-router open-addressed table keyed by the request
+ * pointer, so the steady state does no allocation at all.
+ *
+ * Each input remembers the last mapping it hit. A request fully inside that mapping
+ * skips the mapping tree lookup. Only mappings which do not overlap any other one
+ * are remembered, so the base/size check is enough to validate the hit.
  *
  * Scope: single-mapping only.
  *
@@ -21,6 +26,13 @@
  * debug-memory map (vp/debug_mem.hpp), lazily built by walking the mappings
  * down to the terminal memories, so it completes inline even while the
  * simulation is paused.
+ *
+ * Direct memory interface queries (utils/dmi.hpp) are forwarded to the
+ * target of the mapping and the returned range is clipped to the mapping.
+ * Only mappings which can be remembered by an input are forwarded, since a
+ * grant on a default or overlapping mapping could cover addresses routed to
+ * another target. Mappings are fixed once the router is built, so the router
+ * never has to invalidate a grant itself, the target does it.
  */
 
 #include <vp/vp.hpp>
@@ -29,7 +41,7 @@
 #include <vp/signal.hpp>
 #include <vp/proxy.hpp>
 #include <interco/router_v2/router_config.hpp>
-#include <unordered_map>
+#include <utils/dmi.hpp>
 #include <vector>
 
 #include "proxy_command.hpp"
@@ -63,17 +75,42 @@ public:
     RouterUntimed *top;
     int id;
     vp::IoSlave itf;
+    // Last mapping hit by this input, NULL if none. Only set for cacheable mappings.
+    vp::MappingTreeEntry *last_mapping = nullptr;
 };
 
 struct InFlight
 {
+    // NULL when the slot is free
+    vp::IoReq *req;
     InputPort *input;
-    // Free-list link used while parked in inflight_free; meaningless once
-    // alloc_inflight() hands the entry out.
-    InFlight *next_free;
 };
 
-class RouterUntimed : public vp::Component, public vp::DebugMemIf
+// Open-addressed table of in-flight requests, keyed by request pointer, with linear
+// probing. It only grows, so once it has reached the peak number of outstanding
+// requests, insertions and removals never allocate.
+class InFlightTable
+{
+public:
+    InFlightTable() { this->slots.resize(16, {nullptr, nullptr}); }
+    void insert(vp::IoReq *req, InputPort *input);
+    InFlight *find(vp::IoReq *req);
+    void erase(InFlight *ifl);
+
+private:
+    size_t index(vp::IoReq *req)
+    {
+        // Fibonacci hashing, the low bits of the pointer are always zero
+        return (((uintptr_t)req >> 4) * 0x9E3779B97F4A7C15ULL) >> this->shift;
+    }
+    void grow();
+
+    std::vector<InFlight> slots;
+    int shift = 64 - 4;
+    size_t count = 0;
+};
+
+class RouterUntimed : public vp::Component, public vp::DebugMemIf, public DmiIf
 {
     friend class InputPort;
     friend class OutputPort;
@@ -93,15 +130,17 @@ public:
         uint64_t local_base, uint64_t window_size, uint64_t entry_base,
         int depth) override;
 
+    bool dmi_get(uint64_t addr, DmiGrant &grant, DmiListener *listener) override;
+
 private:
     static vp::IoReqStatus req_muxed(vp::Block *__this, vp::IoReq *req, int port);
     static void resp_muxed(vp::Block *__this, vp::IoReq *req, int id);
     static void retry_muxed(vp::Block *__this, int id, vp::IoRetryChannel);
 
-    InFlight *alloc_inflight();
-    void free_inflight(InFlight *ifl);
-    InFlight *inflight_free = nullptr;
-    // Per-router in-flight map. A previous design stashed the InFlight* in
+    vp::MappingTreeEntry *get_mapping(InputPort *in, uint64_t addr, uint64_t size,
+        bool is_write);
+
+    // Per-router in-flight table. A previous design stashed the InFlight* in
     // req->initiator, but that breaks two ways: (a) the iDMA's idma_be_axi
     // back-end uses req->initiator to carry its own BurstInfo pointer; the
     // untimed router stomped on it and only restored on the first
@@ -110,7 +149,10 @@ private:
     // restored iDMA pointer as an InFlight* and crashed. (b) Even without
     // that consumer, two cascaded routers that both stashed into
     // req->initiator clobbered each other. Keying by req* sidesteps both.
-    std::unordered_map<vp::IoReq *, InFlight *> in_flight_map;
+    InFlightTable in_flight;
+
+    // True for each mapping which can be remembered as the last hit of an input
+    std::vector<bool> mapping_cacheable;
 
     // Flat backdoor map, built lazily on first debug access
     vp::DebugMemMap debug_map;
@@ -189,20 +231,121 @@ RouterUntimed::RouterUntimed(vp::ComponentConf &config)
         if (m.is_error) this->error_id = mapping_id;
     }
     this->mapping_tree.build();
+
+    // A mapping can be remembered by an input, or granted through DMI, only if no
+    // other mapping overlaps it, otherwise a hit inside its range could belong to the
+    // other one. Default mappings (size 0) only catch what no other mapping matches,
+    // so they don't count as overlapping, but they are never remembered, nor is the
+    // error one.
+    int nb_mappings = (int)this->cfg.mappings_count;
+    this->mapping_cacheable.resize(nb_mappings);
+    for (int i = 0; i < nb_mappings; i++)
+    {
+        const RouterMapping &m = this->cfg.mappings[i];
+        bool cacheable = m.size != 0 && i != this->error_id;
+        for (int j = 0; j < nb_mappings && cacheable; j++)
+        {
+            const RouterMapping &o = this->cfg.mappings[j];
+            if (j != i && o.size != 0 && o.base < m.base + m.size && m.base < o.base + o.size)
+            {
+                cacheable = false;
+            }
+        }
+        this->mapping_cacheable[i] = cacheable;
+    }
+}
+
+void InFlightTable::insert(vp::IoReq *req, InputPort *input)
+{
+    if ((this->count + 1) * 2 > this->slots.size())
+    {
+        this->grow();
+    }
+
+    size_t mask = this->slots.size() - 1;
+    size_t i = this->index(req);
+    while (this->slots[i].req != nullptr)
+    {
+        i = (i + 1) & mask;
+    }
+    this->slots[i] = {req, input};
+    this->count++;
 }
 
-InFlight *RouterUntimed::alloc_inflight()
+InFlight *InFlightTable::find(vp::IoReq *req)
 {
-    InFlight *ifl = this->inflight_free;
-    if (ifl) { this->inflight_free = ifl->next_free; }
-    else     { ifl = new InFlight(); }
-    return ifl;
+    size_t mask = this->slots.size() - 1;
+    size_t i = this->index(req);
+    while (this->slots[i].req != req)
+    {
+        if (this->slots[i].req == nullptr)
+        {
+            return nullptr;
+        }
+        i = (i + 1) & mask;
+    }
+    return &this->slots[i];
 }
 
-void RouterUntimed::free_inflight(InFlight *ifl)
+void InFlightTable::erase(InFlight *ifl)
 {
-    ifl->next_free = this->inflight_free;
-    this->inflight_free = ifl;
+    // Backward-shift deletion, so that lookups never need tombstones
+    size_t mask = this->slots.size() - 1;
+    size_t hole = ifl - this->slots.data();
+    size_t i = hole;
+    while (true)
+    {
+        i = (i + 1) & mask;
+        if (this->slots[i].req == nullptr)
+        {
+            break;
+        }
+        // The entry can move to the hole only if the hole is on its probe path,
+        // i.e. between its home slot and its current slot.
+        size_t home = this->index(this->slots[i].req);
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            this->slots[hole] = this->slots[i];
+            hole = i;
+        }
+    }
+    this->slots[hole] = {nullptr, nullptr};
+    this->count--;
+}
+
+void InFlightTable::grow()
+{
+    std::vector<InFlight> old = std::move(this->slots);
+    this->slots.assign(old.size() * 2, {nullptr, nullptr});
+    this->shift--;
+    this->count = 0;
+    for (InFlight &ifl : old)
+    {
+        if (ifl.req != nullptr)
+        {
+            this->insert(ifl.req, ifl.input);
+        }
+    }
+}
+
+vp::MappingTreeEntry *RouterUntimed::get_mapping(InputPort *in, uint64_t addr,
+    uint64_t size, bool is_write)
+{
+    // Masters tend to hit the same mapping over and over, check the last one first
+    vp::MappingTreeEntry *mapping = in->last_mapping;
+    if (mapping && addr >= mapping->base && addr + size <= mapping->base + mapping->size)
+    {
+        return mapping;
+    }
+
+    mapping = this->mapping_tree.get(addr, size, is_write);
+    if (mapping && this->mapping_cacheable[mapping->id] &&
+        addr + size <= mapping->base + mapping->size &&
+        this->entries[mapping->id]->itf.is_bound())
+    {
+        in->last_mapping = mapping;
+    }
+    return mapping;
 }
 
 vp::IoReqStatus RouterUntimed::req_muxed(vp::Block *__this, vp::IoReq *req, int port)
@@ -211,7 +354,7 @@ vp::IoReqStatus RouterUntimed::req_muxed(vp::Block *__this, vp::IoReq *req, int
     InputPort *in = _this->inputs[port];
     uint64_t size = req->get_size();
 
-    vp::MappingTreeEntry *mapping = _this->mapping_tree.get(
+    vp::MappingTreeEntry *mapping = _this->get_mapping(in,
         req->get_addr(), size, req->get_is_write());
     bool straddles = mapping && mapping->size != 0 &&
         req->get_addr() + size > mapping->base + mapping->size;
@@ -238,9 +381,7 @@ vp::IoReqStatus RouterUntimed::req_muxed(vp::Block *__this, vp::IoReq *req, int
     {
         // Install InFlight after the forward so resp_muxed can route back. Safe:
         // resp_muxed won't fire until we return.
-        InFlight *ifl = _this->alloc_inflight();
-        ifl->input = in;
-        _this->in_flight_map[req] = ifl;
+        _this->in_flight.insert(req, in);
         return vp::IO_REQ_GRANTED;
     }
     // DENIED: propagate to master unchanged. Master handles the protocol from here.
@@ -252,17 +393,15 @@ vp::IoReqStatus RouterUntimed::req_muxed(vp::Block *__this, vp::IoReq *req, int
 void RouterUntimed::resp_muxed(vp::Block *__this, vp::IoReq *req, int /*id*/)
 {
     RouterUntimed *_this = (RouterUntimed *)__this;
-    auto it = _this->in_flight_map.find(req);
-    vp_assert(it != _this->in_flight_map.end(), &_this->trace,
+    InFlight *ifl = _this->in_flight.find(req);
+    vp_assert(ifl != nullptr, &_this->trace,
         "resp_muxed: no in-flight entry for req=%p\n", req);
-    InFlight *ifl = it->second;
     InputPort *in = ifl->input;
     // For asymmetric reads (1 forward → N response beats) the same req object
     // visits us multiple times; only retire the slot on the last beat.
     if (req->is_last)
     {
-        _this->in_flight_map.erase(it);
-        _this->free_inflight(ifl);
+        _this->in_flight.erase(ifl);
     }
     in->itf.resp(req);
 }
@@ -295,6 +434,37 @@ void RouterUntimed::debug_mem_regions(std::vector<vp::DebugMemRegion> &regions,
         regions, local_base, window_size, entry_base, depth);
 }
 
+bool RouterUntimed::dmi_get(uint64_t addr, DmiGrant &grant, DmiListener *listener)
+{
+    vp::MappingTreeEntry *mapping = this->mapping_tree.get(addr, 1, false);
+    if (!mapping || !this->mapping_cacheable[mapping->id])
+    {
+        return false;
+    }
+
+    OutputPort *out = this->entries[mapping->id];
+    DmiIf *target = dmi_if_get(&out->itf);
+    if (target == nullptr)
+    {
+        return false;
+    }
+
+    uint64_t offset = out->add_offset - out->remove_offset;
+    if (!target->dmi_get(addr + offset, grant, listener))
+    {
+        return false;
+    }
+
+    // The grant is used for reads and writes, only let writes go through it if they are
+    // routed to the same mapping
+    if (this->mapping_tree.get(addr, 1, true) != mapping)
+    {
+        grant.writable = false;
+    }
+
+    return dmi_grant_clip(grant, offset, mapping->base, mapping->size);
+}
+
 std::string RouterUntimed::handle_command(gv::GvProxy *proxy, FILE *req_file,
     FILE *reply_file, std::vector<std::string> args, std::string cmd_req)
 {
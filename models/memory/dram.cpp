@@ -0,0 +1,641 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Authors: Germain Haugou (germain.haugou@gmail.com)
+//
+// Native DRAM timing model on io_v2.
+//
+// Cycle-approximate alternative to the DRAMSys wrappers (dramsys.cpp /
+// dramsys_v2.cpp) which needs neither SystemC nor libDRAMSys. The geometry
+// is the same GvsocMemspec the wrappers get back from DRAMSys, here built
+// from the compiled DramConfig, and the master-side protocol is the one of
+// dramsys_v2:
+//
+//   - Reads return IO_REQ_GRANTED and are answered with one beat per
+//     access_size burst, one beat per cycle at most, in request order.
+//   - Writes are posted: the data lands in the backing store and the
+//     request returns IO_REQ_DONE, while the bursts still occupy the DRAM
+//     timing (bank state, data bus) when the scheduler gets to them.
+//   - A request with more bursts for a channel than its queue has room for
+//     is denied, and retry() is signalled once a queue slot frees up.
+//
+// Each channel owns a request queue of access_size bursts and a set of
+// banks (ranks x bank groups x banks). A per-channel scheduler picks bursts
+// FR-FCFS (the burst whose column command is ready first, oldest among
+// equals) and computes the command timestamps analytically from the bank
+// state:
+//
+//   row hit      CAS at max(now, tCCD window)
+//   row closed   ACT, then CAS tRCD later
+//   row conflict PRE (after tRAS / write recovery), ACT tRP later, CAS tRCD
+//                later
+//
+// Data occupies the channel data bus for t_burst cycles starting tCL (reads)
+// or tCWL (writes) after the CAS. The scheduler does not run more than tCL
+// ahead of the data bus so that later arrivals still compete in FR-FCFS.
+// With open_page=false every access is followed by an auto-precharge.
+// Refreshes are applied lazily: every t_refi cycles of a channel, all its
+// banks are precharged and blocked for t_rfc.
+//
+// Not modelled: tRRD / tFAW activation windows, bank-group specific tCCD_L,
+// read-write bus turnaround, and the PIM side channels of dramsys.cpp.
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <vp/vp.hpp>
+#include <vp/stats/stats.hpp>
+#include <vp/itf/io_v2.hpp>
+#include <vp/itf/wire.hpp>
+#include <vp/debug_mem.hpp>
+#include <memory/include/memspec.hpp>
+#include <memory/dram/dram_config.hpp>
+
+
+class Dram;
+
+// Bank state. All timestamps are absolute cycles of the channel clock and
+// may lie in the future, since commands are scheduled ahead of time.
+struct DramBank
+{
+    int64_t open_row = -1;      // -1 when precharged
+    int64_t act_allowed = 0;    // Earliest ACT (tRP after the last PRE)
+    int64_t pre_allowed = 0;    // Earliest PRE (tRAS after ACT, tWR after write data)
+    int64_t cas_allowed = 0;    // Earliest column command (previous burst done)
+};
+
+struct DramRead;
+
+// One access_size burst waiting in a channel queue
+struct DramTxn
+{
+    int bank;
+    int64_t row;
+    bool is_write;
+    // Read this burst belongs to, and burst index inside it. NULL for writes.
+    DramRead *read;
+    int index;
+    uint64_t addr;
+};
+
+// Read request in flight, answered beat by beat in request order
+struct DramRead
+{
+    vp::IoReq *req;
+    uint64_t addr;
+    uint64_t size;
+    uint8_t *data;
+    int64_t burst_id;
+    uint64_t first_burst;
+    int nb_bursts;
+    int next_beat;
+    // Cycle at which the data of each burst is out of the DRAM, -1 if the burst is not
+    // scheduled yet.
+    std::vector<int64_t> ready;
+};
+
+struct DramChannel
+{
+    DramChannel(Dram *top, int id, int nb_banks);
+
+    Dram *top;
+    int id;
+    std::vector<DramBank> banks;
+    std::vector<DramTxn> queue;
+    // First cycle at which the data bus is free
+    int64_t bus_free = 0;
+    int64_t next_refresh = 0;
+    // Bursts of the request being checked by req_handler which go to this channel
+    int nb_new = 0;
+    vp::ClockEvent sched_event;
+};
+
+
+class Dram : public vp::Component, public vp::DebugMemIf
+{
+    friend struct DramChannel;
+
+public:
+    Dram(vp::ComponentConf &config);
+    ~Dram();
+
+    vp::DebugMemIf *debug_mem_if() override { return this; }
+    int debug_mem_access(uint64_t addr, uint8_t *data, uint64_t size,
+        bool is_write) override;
+
+    DramConfig cfg;
+
+private:
+    void reset(bool active) override;
+
+    static vp::IoReqStatus req_handler(vp::Block *__this, vp::IoReq *req);
+    static void sched_handler(vp::Block *__this, vp::ClockEvent *event);
+    static void beat_handler(vp::Block *__this, vp::ClockEvent *event);
+
+    int get_channel(uint64_t addr);
+    void push_burst(uint64_t addr, bool is_write, DramRead *read, int index);
+    void arm_sched(DramChannel *channel);
+    void refresh(DramChannel *channel, int64_t now);
+    int64_t get_cas(DramBank &bank, int64_t row, int64_t now, int64_t *act=NULL);
+    void issue(DramChannel *channel, DramTxn &txn, int64_t now);
+    void arm_beat();
+
+    vp::Trace trace;
+    vp::IoSlave in{&Dram::req_handler};
+    vp::WireMaster<GvsocMemspec> send_memspec_itf;
+
+    GvsocMemspec memspec;
+    uint8_t *mem_data;
+    int banks_per_channel;
+
+    std::vector<DramChannel *> channels;
+    // Reads waiting for their beats, in request order
+    std::deque<DramRead *> reads;
+    std::vector<DramRead *> free_reads;
+    vp::ClockEvent beat_event;
+    // Number of requests denied since the last retry
+    int denied_count = 0;
+
+    vp::StatScalar stat_reads;
+    vp::StatScalar stat_writes;
+    vp::StatScalar stat_row_hits;
+    vp::StatScalar stat_row_misses;
+    vp::StatScalar stat_row_conflicts;
+    vp::StatScalar stat_refreshes;
+};
+
+
+DramChannel::DramChannel(Dram *top, int id, int nb_banks)
+    : top(top), id(id), banks(nb_banks), sched_event(top, &Dram::sched_handler)
+{
+    this->sched_event.get_args()[0] = this;
+}
+
+
+Dram::Dram(vp::ComponentConf &config)
+    : vp::Component(config, this->cfg), beat_event(this, &Dram::beat_handler)
+{
+    this->traces.new_trace("trace", &this->trace, vp::DEBUG);
+    this->new_slave_port("input", &this->in);
+    this->new_master_port("send_memspec", &this->send_memspec_itf);
+
+    this->stats.register_stat(&this->stat_reads, "reads", "Number of read requests");
+    this->stats.register_stat(&this->stat_writes, "writes", "Number of write requests");
+    this->stats.register_stat(&this->stat_row_hits, "row_hits",
+        "Number of bursts hitting the open row");
+    this->stats.register_stat(&this->stat_row_misses, "row_misses",
+        "Number of bursts activating a precharged bank");
+    this->stats.register_stat(&this->stat_row_conflicts, "row_conflicts",
+        "Number of bursts closing another open row");
+    this->stats.register_stat(&this->stat_refreshes, "refreshes",
+        "Number of channel refreshes");
+
+    if (this->cfg.access_size == 0 || (this->cfg.access_size & (this->cfg.access_size - 1)))
+    {
+        this->trace.fatal("Access size must be a power of 2 (access_size: %d)\n",
+            (int)this->cfg.access_size);
+        return;
+    }
+
+    this->memspec.access_size = this->cfg.access_size;
+    this->memspec.nb_channels = this->cfg.nb_channels;
+    this->memspec.nb_pseudo_channels = this->cfg.nb_pseudo_channels;
+    this->memspec.nb_ranks = this->cfg.nb_ranks;
+    this->memspec.nb_bank_groups = this->cfg.nb_bank_groups;
+    this->memspec.nb_banks = this->cfg.nb_banks;
+    this->memspec.nb_rows = this->cfg.nb_rows;
+    this->memspec.nb_columns = this->cfg.nb_columns;
+    this->memspec.channel_stride = this->cfg.channel_stride;
+    this->memspec.rank_stride = this->cfg.rank_stride;
+    this->memspec.bankgroup_stride = this->cfg.bankgroup_stride;
+    this->memspec.bank_stride = this->cfg.bank_stride;
+    this->memspec.row_stride = this->cfg.row_stride;
+    this->memspec.column_stride = this->cfg.column_stride;
+
+    this->banks_per_channel = this->cfg.nb_ranks * this->cfg.nb_bank_groups * this->cfg.nb_banks;
+    for (int i = 0; i < this->cfg.nb_channels; i++)
+    {
+        this->channels.push_back(new DramChannel(this, i, this->banks_per_channel));
+    }
+
+    this->mem_data = (uint8_t *)calloc(this->cfg.size, 1);
+    if (this->mem_data == NULL) throw std::bad_alloc();
+
+    this->trace.msg("Native DRAM model (size: 0x%llx, access_size: %d, channels: %d, "
+        "banks per channel: %d, open_page: %d)\n", (unsigned long long)this->cfg.size,
+        (int)this->cfg.access_size, (int)this->cfg.nb_channels, this->banks_per_channel,
+        (int)this->cfg.open_page);
+}
+
+
+Dram::~Dram()
+{
+    for (DramChannel *channel : this->channels) delete channel;
+    for (DramRead *read : this->reads) delete read;
+    for (DramRead *read : this->free_reads) delete read;
+    free(this->mem_data);
+}
+
+
+void Dram::reset(bool active)
+{
+    if (active)
+    {
+        for (DramChannel *channel : this->channels)
+        {
+            if (channel->sched_event.is_enqueued()) channel->sched_event.cancel();
+            channel->queue.clear();
+            std::fill(channel->banks.begin(), channel->banks.end(), DramBank());
+            channel->bus_free = 0;
+            channel->next_refresh = this->cfg.t_refi;
+        }
+        for (DramRead *read : this->reads) this->free_reads.push_back(read);
+        this->reads.clear();
+        if (this->beat_event.is_enqueued()) this->beat_event.cancel();
+        this->denied_count = 0;
+    }
+    else
+    {
+        if (this->send_memspec_itf.is_bound())
+        {
+            this->send_memspec_itf.sync(this->memspec);
+        }
+    }
+}
+
+
+int Dram::debug_mem_access(uint64_t addr, uint8_t *data, uint64_t size, bool is_write)
+{
+    if (addr + size > this->cfg.size || addr + size < addr) return -1;
+
+    if (is_write)
+    {
+        memcpy(&this->mem_data[addr], data, size);
+    }
+    else
+    {
+        memcpy(data, &this->mem_data[addr], size);
+    }
+    return 0;
+}
+
+
+int Dram::get_channel(uint64_t addr)
+{
+    if (this->cfg.nb_channels == 1 || this->cfg.channel_stride == 0) return 0;
+    return (addr / this->cfg.channel_stride) % this->cfg.nb_channels;
+}
+
+
+static inline int64_t dram_field(uint64_t addr, int64_t stride, int64_t nb)
+{
+    return stride == 0 ? 0 : (addr / stride) % nb;
+}
+
+
+void Dram::push_burst(uint64_t addr, bool is_write, DramRead *read, int index)
+{
+    DramChannel *channel = this->channels[this->get_channel(addr)];
+    int64_t rank = dram_field(addr, this->cfg.rank_stride, this->cfg.nb_ranks);
+    int64_t bg = dram_field(addr, this->cfg.bankgroup_stride, this->cfg.nb_bank_groups);
+    int64_t bank = dram_field(addr, this->cfg.bank_stride, this->cfg.nb_banks);
+    int64_t row = dram_field(addr, this->cfg.row_stride, this->cfg.nb_rows);
+
+    if (is_write)
+    {
+        // A write to a burst which is still queued only refreshes data which already
+        // went to the backing store, so it is merged with the queued one.
+        for (DramTxn &txn : channel->queue)
+        {
+            if (txn.is_write && txn.addr == addr) return;
+        }
+    }
+
+    int bank_id = (rank * this->cfg.nb_bank_groups + bg) * this->cfg.nb_banks + bank;
+    channel->queue.push_back(DramTxn{ bank_id, row, is_write, read, index, addr });
+
+    this->arm_sched(channel);
+}
+
+
+vp::IoReqStatus Dram::req_handler(vp::Block *__this, vp::IoReq *req)
+{
+    Dram *_this = (Dram *)__this;
+    uint64_t addr = req->get_addr();
+    uint64_t size = req->get_size();
+    uint8_t *data = req->get_data();
+    bool is_write = req->get_is_write();
+
+    _this->trace.msg("Received request (addr: 0x%lx, size: 0x%lx, is_write: %d)\n",
+        addr, size, is_write);
+
+    if (size == 0 || addr + size > _this->cfg.size || addr + size < addr)
+    {
+        _this->trace.force_warning_no_error(
+            "Received out-of-bound request (reqAddr: 0x%llx, reqSize: 0x%llx, memSize: 0x%llx)\n",
+            (unsigned long long)addr, (unsigned long long)size,
+            (unsigned long long)_this->cfg.size);
+        req->set_resp_status(vp::IO_RESP_INVALID);
+        return vp::IO_REQ_DONE;
+    }
+
+    uint64_t access_size = _this->cfg.access_size;
+    uint64_t first_burst = addr & ~(access_size - 1);
+    int nb_bursts = ((addr + size - 1 - first_burst) / access_size) + 1;
+
+    // All the bursts of a request are queued at once, so it is accepted only if every
+    // channel it touches has room left for all its bursts. A request with more bursts than
+    // a queue can hold is accepted once the queue is empty, it would never fit otherwise.
+    for (int i = 0; i < nb_bursts; i++)
+    {
+        _this->channels[_this->get_channel(first_burst + i * access_size)]->nb_new++;
+    }
+
+    DramChannel *full = NULL;
+    for (int i = 0; i < nb_bursts; i++)
+    {
+        DramChannel *channel = _this->channels[_this->get_channel(first_burst + i * access_size)];
+        if (channel->nb_new != 0)
+        {
+            if (!channel->queue.empty() &&
+                (int)channel->queue.size() + channel->nb_new > _this->cfg.queue_size)
+            {
+                full = channel;
+            }
+            channel->nb_new = 0;
+        }
+    }
+
+    if (full != NULL)
+    {
+        _this->denied_count++;
+        _this->trace.msg("Denied request, channel %d queue full (pending retries: %d)\n",
+            full->id, _this->denied_count);
+        return vp::IO_REQ_DENIED;
+    }
+
+    if (is_write)
+    {
+        _this->stat_writes++;
+        memcpy(&_this->mem_data[addr], data, size);
+        for (int i = 0; i < nb_bursts; i++)
+        {
+            _this->push_burst(first_burst + i * access_size, true, NULL, i);
+        }
+        req->set_resp_status(vp::IO_RESP_OK);
+        return vp::IO_REQ_DONE;
+    }
+
+    _this->stat_reads++;
+    memcpy(data, &_this->mem_data[addr], size);
+
+    DramRead *read;
+    if (_this->free_reads.empty())
+    {
+        read = new DramRead;
+    }
+    else
+    {
+        read = _this->free_reads.back();
+        _this->free_reads.pop_back();
+    }
+    read->req = req;
+    read->addr = addr;
+    read->size = size;
+    read->data = data;
+    read->burst_id = req->burst_id;
+    read->first_burst = first_burst;
+    read->nb_bursts = nb_bursts;
+    read->next_beat = 0;
+    read->ready.assign(nb_bursts, -1);
+    _this->reads.push_back(read);
+
+    for (int i = 0; i < nb_bursts; i++)
+    {
+        _this->push_burst(first_burst + i * access_size, false, read, i);
+    }
+
+    return vp::IO_REQ_GRANTED;
+}
+
+
+void Dram::arm_sched(DramChannel *channel)
+{
+    if (channel->queue.empty() || channel->sched_event.is_enqueued()) return;
+
+    // Keep the scheduler at most tCL ahead of the data bus, so that the queue can still
+    // be reordered with requests arriving meanwhile.
+    int64_t delay = channel->bus_free - this->cfg.t_cl - this->clock.get_cycles();
+    channel->sched_event.enqueue(std::max(delay, (int64_t)1));
+}
+
+
+void Dram::refresh(DramChannel *channel, int64_t now)
+{
+    while (this->cfg.t_refi > 0 && channel->next_refresh <= now)
+    {
+        int64_t start = channel->next_refresh;
+        bool need_pre = false;
+        for (DramBank &bank : channel->banks)
+        {
+            if (bank.open_row != -1)
+            {
+                need_pre = true;
+                start = std::max(start, bank.pre_allowed);
+            }
+            start = std::max(start, bank.act_allowed);
+        }
+
+        int64_t end = start + (need_pre ? this->cfg.t_rp : 0) + this->cfg.t_rfc;
+        for (DramBank &bank : channel->banks)
+        {
+            bank.open_row = -1;
+            bank.act_allowed = end;
+        }
+        this->stat_refreshes++;
+        channel->next_refresh += this->cfg.t_refi;
+
+        // Refreshes missed while the channel was idle all find the banks precharged,
+        // only the last one can still delay the next activation.
+        if (channel->next_refresh + this->cfg.t_refi <= now)
+        {
+            int64_t skipped = (now - channel->next_refresh) / this->cfg.t_refi;
+            this->stat_refreshes += skipped;
+            channel->next_refresh += skipped * this->cfg.t_refi;
+        }
+    }
+}
+
+
+int64_t Dram::get_cas(DramBank &bank, int64_t row, int64_t now, int64_t *act)
+{
+    if (bank.open_row == row)
+    {
+        return std::max(now, bank.cas_allowed);
+    }
+
+    int64_t act_cycle;
+    if (bank.open_row == -1)
+    {
+        act_cycle = std::max(now, bank.act_allowed);
+    }
+    else
+    {
+        act_cycle = std::max(std::max(now, bank.pre_allowed) + this->cfg.t_rp,
+            bank.act_allowed);
+    }
+    if (act) *act = act_cycle;
+    return std::max(act_cycle + this->cfg.t_rcd, bank.cas_allowed);
+}
+
+
+void Dram::issue(DramChannel *channel, DramTxn &txn, int64_t now)
+{
+    DramBank &bank = channel->banks[txn.bank];
+    int64_t act;
+    int64_t cas = this->get_cas(bank, txn.row, now, &act);
+
+    if (bank.open_row == txn.row)
+    {
+        this->stat_row_hits++;
+    }
+    else
+    {
+        if (bank.open_row == -1)
+        {
+            this->stat_row_misses++;
+        }
+        else
+        {
+            this->stat_row_conflicts++;
+        }
+        bank.open_row = txn.row;
+        bank.pre_allowed = act + this->cfg.t_ras;
+    }
+
+    int64_t data_start = std::max(cas + (txn.is_write ? this->cfg.t_cwl : this->cfg.t_cl),
+        channel->bus_free);
+    int64_t data_end = data_start + this->cfg.t_burst;
+    channel->bus_free = data_end;
+    bank.cas_allowed = cas + this->cfg.t_burst;
+    if (txn.is_write)
+    {
+        bank.pre_allowed = std::max(bank.pre_allowed, data_end + this->cfg.t_wr);
+    }
+
+    if (!this->cfg.open_page)
+    {
+        bank.open_row = -1;
+        bank.act_allowed = bank.pre_allowed + this->cfg.t_rp;
+    }
+
+    this->trace.msg("Scheduled burst (channel: %d, bank: %d, row: %ld, addr: 0x%lx, "
+        "is_write: %d, cas: %ld, data: [%ld, %ld[)\n", channel->id, txn.bank, txn.row,
+        txn.addr, txn.is_write, cas, data_start, data_end);
+
+    if (txn.read)
+    {
+        txn.read->ready[txn.index] = data_end;
+        this->arm_beat();
+    }
+}
+
+
+void Dram::sched_handler(vp::Block *__this, vp::ClockEvent *event)
+{
+    Dram *_this = (Dram *)__this;
+    DramChannel *channel = (DramChannel *)event->get_args()[0];
+    int64_t now = _this->clock.get_cycles();
+
+    if (channel->queue.empty()) return;
+
+    _this->refresh(channel, now);
+
+    // FR-FCFS: the burst whose column command can go first, the oldest one among
+    // equals. Row hits naturally win over activations, and bursts to idle banks over
+    // bursts waiting for a busy one.
+    size_t pick = 0;
+    int64_t pick_cas = INT64_MAX;
+    for (size_t i = 0; i < channel->queue.size(); i++)
+    {
+        DramTxn &txn = channel->queue[i];
+        int64_t cas = _this->get_cas(channel->banks[txn.bank], txn.row, now);
+        if (cas < pick_cas)
+        {
+            pick = i;
+            pick_cas = cas;
+        }
+    }
+
+    _this->issue(channel, channel->queue[pick], now);
+    channel->queue.erase(channel->queue.begin() + pick);
+
+    // A queue slot is free again, let the denied masters retry. Retried requests may be
+    // denied again and bump the counter, so at most the current ones are retried.
+    int nb_retries = _this->denied_count;
+    while (nb_retries-- > 0 && _this->denied_count > 0
+        && (int)channel->queue.size() < _this->cfg.queue_size)
+    {
+        _this->denied_count--;
+        _this->in.retry();
+    }
+
+    _this->arm_sched(channel);
+}
+
+
+void Dram::arm_beat()
+{
+    if (this->reads.empty() || this->beat_event.is_enqueued()) return;
+
+    DramRead *read = this->reads.front();
+    int64_t ready = read->ready[read->next_beat];
+    if (ready == -1) return;
+
+    this->beat_event.enqueue(std::max(ready - this->clock.get_cycles(), (int64_t)1));
+}
+
+
+void Dram::beat_handler(vp::Block *__this, vp::ClockEvent *event)
+{
+    Dram *_this = (Dram *)__this;
+    DramRead *read = _this->reads.front();
+    int index = read->next_beat++;
+
+    uint64_t burst = read->first_burst + (uint64_t)index * _this->cfg.access_size;
+    uint64_t beat_start = std::max(burst, read->addr);
+    uint64_t beat_end = std::min(burst + _this->cfg.access_size, read->addr + read->size);
+    bool is_last = read->next_beat == read->nb_bursts;
+
+    vp::IoReq *req = read->req;
+    req->addr = beat_start;
+    req->data = read->data + (beat_start - read->addr);
+    req->size = beat_end - beat_start;
+    req->burst_id = read->burst_id;
+    req->is_first = index == 0;
+    req->is_last = is_last;
+    req->status = vp::IO_RESP_OK;
+
+    if (is_last)
+    {
+        _this->reads.pop_front();
+        _this->free_reads.push_back(read);
+    }
+
+    _this->trace.msg("Sending beat (addr: 0x%lx, size: 0x%lx, is_first: %d, is_last: %d)\n",
+        req->addr, req->size, req->is_first, req->is_last);
+
+    _this->in.resp(req);
+
+    _this->arm_beat();
+}
+
+
+extern "C" vp::Component *gv_new(vp::ComponentConf &config)
+{
+    return new Dram(config);
+}
@@ -0,0 +1,244 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+"""Native DRAM timing model on io_v2.
+
+This module provides the ``Dram`` generator (``dram.cpp``), a built-in
+bank / row-buffer DRAM model which can replace :class:`memory.dramsys.Dramsys`
+(``version=2``) when SystemC and DRAMSys are not available, or when their
+simulation cost is not wanted.
+"""
+
+from __future__ import annotations
+
+import gvsoc.systree
+from config_tree import Config, cfg_field, HasSize
+from gvsoc.signature import IoV2BigPacket
+
+
+class DramConfig(Config, HasSize):
+    """Configuration of the native DRAM model.
+
+    Snake-cased to ``memory/dram/dram_config.hpp`` at build time; only
+    ``dram.cpp`` includes it. The geometry fields mirror the
+    ``GvsocMemspec`` structure returned by DRAMSys, so that a memspec
+    extracted from a DRAMSys run can be copied over. Timings are in
+    cycles of the clock the model is attached to.
+
+    The defaults describe one DDR4-like channel with 16 banks in 4 bank
+    groups and 2 KiB rows, mapped so that consecutive 2 KiB blocks go to
+    different bank groups.
+    """
+
+    size: int = cfg_field(default=0x10000000, fmt="hex", dump=True, desc=(
+        "Memory size in bytes"
+    ))
+
+    access_size: int = cfg_field(default=32, dump=True, desc=(
+        "Size in bytes of a DRAM burst, also the width of the returned beats. "
+        "Must be a power of 2"
+    ))
+
+    nb_channels: int = cfg_field(default=1, dump=True, desc=(
+        "Number of independent channels, each with its own queue and data bus"
+    ))
+
+    nb_pseudo_channels: int = cfg_field(default=1, dump=True, desc=(
+        "Number of pseudo channels, only forwarded through the memspec"
+    ))
+
+    nb_ranks: int = cfg_field(default=1, dump=True, desc=(
+        "Number of ranks per channel"
+    ))
+
+    nb_bank_groups: int = cfg_field(default=4, dump=True, desc=(
+        "Number of bank groups per rank"
+    ))
+
+    nb_banks: int = cfg_field(default=4, dump=True, desc=(
+        "Number of banks per bank group"
+    ))
+
+    nb_rows: int = cfg_field(default=8192, dump=True, desc=(
+        "Number of rows per bank"
+    ))
+
+    nb_columns: int = cfg_field(default=64, dump=True, desc=(
+        "Number of bursts per row"
+    ))
+
+    channel_stride: int = cfg_field(default=0x8000, fmt="hex", dump=True, desc=(
+        "Address stride in bytes between 2 consecutive channels"
+    ))
+
+    rank_stride: int = cfg_field(default=0x8000, fmt="hex", dump=True, desc=(
+        "Address stride in bytes between 2 consecutive ranks"
+    ))
+
+    bankgroup_stride: int = cfg_field(default=0x800, fmt="hex", dump=True, desc=(
+        "Address stride in bytes between 2 consecutive bank groups"
+    ))
+
+    bank_stride: int = cfg_field(default=0x2000, fmt="hex", dump=True, desc=(
+        "Address stride in bytes between 2 consecutive banks of a bank group"
+    ))
+
+    row_stride: int = cfg_field(default=0x8000, fmt="hex", dump=True, desc=(
+        "Address stride in bytes between 2 consecutive rows"
+    ))
+
+    column_stride: int = cfg_field(default=32, fmt="hex", dump=True, desc=(
+        "Address stride in bytes between 2 consecutive columns"
+    ))
+
+    t_rcd: int = cfg_field(default=14, dump=True, desc=(
+        "ACT to column command delay (tRCD), in cycles"
+    ))
+
+    t_rp: int = cfg_field(default=14, dump=True, desc=(
+        "PRE to ACT delay (tRP), in cycles"
+    ))
+
+    t_cl: int = cfg_field(default=14, dump=True, desc=(
+        "Read column command to data delay (tCL), in cycles"
+    ))
+
+    t_cwl: int = cfg_field(default=4, dump=True, desc=(
+        "Write column command to data delay (tCWL), in cycles"
+    ))
+
+    t_ras: int = cfg_field(default=33, dump=True, desc=(
+        "ACT to PRE delay (tRAS), in cycles"
+    ))
+
+    t_wr: int = cfg_field(default=16, dump=True, desc=(
+        "End of write data to PRE delay (tWR), in cycles"
+    ))
+
+    t_burst: int = cfg_field(default=2, dump=True, desc=(
+        "Number of cycles a burst occupies the data bus"
+    ))
+
+    t_refi: int = cfg_field(default=3900, dump=True, desc=(
+        "Refresh interval (tREFI), in cycles. 0 disables refreshes"
+    ))
+
+    t_rfc: int = cfg_field(default=260, dump=True, desc=(
+        "Refresh duration (tRFC), in cycles"
+    ))
+
+    open_page: bool = cfg_field(default=True, dump=True, desc=(
+        "True to keep rows open after an access, False to precharge after each one"
+    ))
+
+    queue_size: int = cfg_field(default=32, dump=True, desc=(
+        "Number of bursts each channel queue can hold before requests are denied"
+    ))
+
+
+class Dram(gvsoc.systree.Component):
+    """DRAM timing model on the io_v2 protocol.
+
+    Overview
+    ~~~~~~~~
+
+    A backing store with a bank / row-buffer timing model, written
+    natively against the engine (no SystemC, no DRAMSys). It speaks the
+    same master-side protocol as ``Dramsys(version=2)`` and can be
+    swapped in for it.
+
+    Request flow
+    ~~~~~~~~~~~~
+
+    - Requests are split into ``access_size`` bursts, queued in the
+      channel selected by the address.
+    - **Write**: the data goes to the backing store and the request
+      returns ``IO_REQ_DONE``. The bursts stay queued and occupy the
+      banks and the data bus when they are scheduled (posted writes).
+      A write to a burst which is still queued is merged with it.
+    - **Read**: the data is captured and the request returns
+      ``IO_REQ_GRANTED``. One beat per burst is then sent back through
+      ``resp()``, each beat on its own cycle once the burst data is out
+      of the DRAM, with ``is_first`` / ``is_last`` set and ``addr`` /
+      ``data`` / ``size`` pointing at the beat. Reads complete in
+      request order.
+    - A request whose bursts for a channel do not fit in the
+      ``queue_size`` slots left in its queue returns ``IO_REQ_DENIED``;
+      ``retry()`` is signalled when the scheduler frees a slot. A
+      request with more bursts than a whole queue is accepted once the
+      queue is empty.
+    - Out-of-range requests return ``IO_REQ_DONE`` with
+      ``IO_RESP_INVALID``.
+
+    Timing model
+    ~~~~~~~~~~~~
+
+    Each channel schedules one burst per data-bus slot, FR-FCFS: the
+    burst whose column command can be issued first, the oldest one
+    among equals. Row hits only wait for the previous burst of the
+    bank; a precharged bank needs an ACT and tRCD; a row conflict adds
+    a PRE, which itself waits for tRAS after the ACT and for tWR after
+    write data. Read data comes tCL after the column command, write
+    data tCWL after it, and occupies the data bus for ``t_burst``.
+    With ``open_page=False`` rows are closed after every access.
+    Every ``t_refi`` cycles all banks of a channel are precharged and
+    refreshed for ``t_rfc`` cycles.
+
+    tRRD / tFAW, bank-group specific tCCD and bus turnaround are not
+    modelled, and the PIM ports of the DRAMSys wrapper are not
+    provided.
+
+    Statistics
+    ~~~~~~~~~~
+
+    ``reads`` / ``writes`` count requests; ``row_hits``,
+    ``row_misses`` (activation of a precharged bank) and
+    ``row_conflicts`` count bursts; ``refreshes`` counts channel
+    refreshes.
+
+    Ports
+    ~~~~~
+
+    - **INPUT** (slave, ``io_v2``) — request port.
+    - **send_memspec** (master, ``wire<GvsocMemspec>``) — sends the
+      geometry when reset is released, as the DRAMSys wrapper does.
+
+    Parameters
+    ----------
+    parent : gvsoc.systree.Component
+        Parent component.
+    name : str
+        Local name of the memory within ``parent``.
+    config : DramConfig
+        Geometry and timings.
+    """
+
+    __gvsoc_doc__ = {
+        'title': 'DRAM (native)',
+        'tests_dirs': [
+            {'dir':       'gvsoc/core/tests/memory/dramsys',
+             'component': 'memory.dram'},
+        ],
+    }
+
+    def __init__(self, parent: gvsoc.systree.Component, name: str,
+                 config: DramConfig):
+        super().__init__(parent, name, config=config)
+
+        self.add_sources(['memory/dram.cpp'])
+
+    def i_INPUT(self) -> gvsoc.systree.SlaveItf:
+        """Returns the io_v2 input port.
+
+        Reads are answered asynchronously as a stream of ``access_size``
+        beats and requests can be denied, so the signature is
+        :class:`IoV2BigPacket`, as for the DRAMSys v2 wrapper.
+        """
+        return gvsoc.systree.SlaveItf(self, 'input', signature=IoV2BigPacket())
+
+    def o_SENDMEMSPEC(self, itf: gvsoc.systree.SlaveItf):
+        """Binds the memspec output, sent when reset is released."""
+        self.itf_bind('send_memspec', itf, signature="wire<GvsocMemspec>")
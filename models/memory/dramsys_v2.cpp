@@ -43,27 +43,11 @@
 #include <vp/itf/io_v2.hpp>
 #include <systemc.h>
 
-// GvsocMemspec: ABI-compatible duplicate of the struct in
-// gvsoc/core/models/memory/include/pim.hpp. We can't include pim.hpp
-// here because it transitively pulls in vp/itf/io.hpp (v1), whose
-// vp::IoReq / vp::IoSlave / vp::IoMaster definitions conflict with
-// the v2 versions from vp/itf/io_v2.hpp.
-struct GvsocMemspec {
-    uint access_size;
-    uint nb_channels;
-    uint nb_pseudo_channels;
-    uint nb_ranks;
-    uint nb_bank_groups;
-    uint nb_banks;
-    uint nb_rows;
-    uint nb_columns;
-    uint channel_stride;
-    uint rank_stride;
-    uint bankgroup_stride;
-    uint bank_stride;
-    uint row_stride;
-    uint column_stride;
-};
+// GvsocMemspec comes from memspec.hpp rather than pim.hpp, which
+// transitively pulls in vp/itf/io.hpp (v1), whose vp::IoReq /
+// vp::IoSlave / vp::IoMaster definitions conflict with the v2 versions
+// from vp/itf/io_v2.hpp.
+#include <memory/include/memspec.hpp>
 
 #include <stdio.h>
 #include <string.h>
@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+// Set of valid buffers of a memory checked for buffer overflows (memcheck), shared by the
+// memory and memory_v2 models.
+//
+// Buffers are kept in an ordered map of disjoint [base, end) intervals, so that checking an
+// access or finding the buffer closest to a faulty one is logarithmic in the number of
+// buffers instead of linear in the memory size. Adjacent or overlapping buffers are merged,
+// which gives the same result as the former one-bit-per-byte map.
+//
+// An optional bitmap with one bit per 8-byte word caches the words which are fully inside
+// a buffer, so that most accesses are checked without looking into the map. A bit is only
+// set when the word is known to be valid, a cleared bit just means the map must be
+// consulted.
+
+#include <stdint.h>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <vector>
+
+class MemcheckBuffers
+{
+public:
+    MemcheckBuffers(uint64_t size, bool cache)
+    {
+        if (cache)
+        {
+            this->cache.resize(((size + 7) / 8 + 63) / 64, 0);
+        }
+    }
+
+    void add(uint64_t base, uint64_t size)
+    {
+        if (size == 0) return;
+
+        uint64_t end = base + size;
+
+        // Absorb any buffer which overlaps or touches the new one
+        auto it = this->buffers.upper_bound(base);
+        if (it != this->buffers.begin())
+        {
+            auto prev = std::prev(it);
+            if (prev->second >= base)
+            {
+                it = prev;
+            }
+        }
+        while (it != this->buffers.end() && it->first <= end)
+        {
+            base = std::min(base, it->first);
+            end = std::max(end, it->second);
+            it = this->buffers.erase(it);
+        }
+        this->buffers.emplace(base, end);
+
+        this->cache_update(base, end, true);
+    }
+
+    void remove(uint64_t base, uint64_t size)
+    {
+        if (size == 0) return;
+
+        uint64_t end = base + size;
+
+        auto it = this->buffers.upper_bound(base);
+        if (it != this->buffers.begin())
+        {
+            it = std::prev(it);
+        }
+        while (it != this->buffers.end() && it->first < end)
+        {
+            uint64_t buffer_base = it->first;
+            uint64_t buffer_end = it->second;
+            if (buffer_end <= base)
+            {
+                it++;
+                continue;
+            }
+
+            it = this->buffers.erase(it);
+            // Keep what is left on both sides of the removed range
+            if (buffer_base < base)
+            {
+                this->buffers.emplace(buffer_base, base);
+            }
+            if (buffer_end > end)
+            {
+                this->buffers.emplace(end, buffer_end);
+            }
+        }
+
+        this->cache_update(base, end, false);
+    }
+
+    // Return true if all bytes of [offset, offset + size) are inside a buffer. If not,
+    // invalid_offset is set to the first invalid byte.
+    bool check(uint64_t offset, uint64_t size, uint64_t &invalid_offset)
+    {
+        if (this->cache_check(offset, size)) return true;
+
+        auto it = this->buffers.upper_bound(offset);
+        if (it == this->buffers.begin() || std::prev(it)->second <= offset)
+        {
+            invalid_offset = offset;
+            return false;
+        }
+
+        uint64_t end = std::prev(it)->second;
+        if (end < offset + size)
+        {
+            invalid_offset = end;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Find the buffer closest to an invalid offset, looking both before and after it.
+    // Distance is 0 if there is no buffer at all. In case of equality, the buffer before
+    // the offset is returned.
+    void find_closest(uint64_t offset, uint64_t &distance, uint64_t &buffer_offset,
+        uint64_t &buffer_size)
+    {
+        auto after = this->buffers.upper_bound(offset);
+        uint64_t distance_before = 0;
+        uint64_t distance_after = 0;
+
+        if (after != this->buffers.begin())
+        {
+            // Distance to the last valid byte of the buffer
+            uint64_t last = std::min(std::prev(after)->second, offset) - 1;
+            distance_before = offset - last;
+        }
+
+        if (after != this->buffers.end())
+        {
+            distance_after = after->first - offset;
+        }
+
+        if (distance_before == 0 && distance_after == 0)
+        {
+            distance = 0;
+            return;
+        }
+
+        if (distance_before == 0 || (distance_after != 0 && distance_after < distance_before))
+        {
+            distance = distance_after;
+            buffer_offset = after->first;
+            buffer_size = after->second - after->first;
+        }
+        else
+        {
+            auto before = std::prev(after);
+            distance = distance_before;
+            buffer_offset = before->first;
+            buffer_size = before->second - before->first;
+        }
+    }
+
+private:
+    void cache_update(uint64_t base, uint64_t end, bool valid)
+    {
+        if (this->cache.size() == 0) return;
+
+        // When adding, only words fully inside the buffer can be marked valid. When removing,
+        // every word touched by the range must be invalidated.
+        uint64_t first = valid ? (base + 7) / 8 : base / 8;
+        uint64_t last = valid ? end / 8 : (end + 7) / 8;
+        uint64_t nb_words = this->cache.size() * 64;
+        last = std::min(last, nb_words);
+
+        for (uint64_t word = first; word < last;)
+        {
+            uint64_t index = word / 64;
+            uint64_t bit = word % 64;
+            uint64_t count = std::min<uint64_t>(64 - bit, last - word);
+            uint64_t mask = count == 64 ? ~(uint64_t)0 : (((uint64_t)1 << count) - 1) << bit;
+
+            if (valid)
+            {
+                this->cache[index] |= mask;
+            }
+            else
+            {
+                this->cache[index] &= ~mask;
+            }
+
+            word += count;
+        }
+    }
+
+    bool cache_check(uint64_t offset, uint64_t size)
+    {
+        if (this->cache.size() == 0 || size == 0) return false;
+
+        uint64_t first = offset / 8;
+        uint64_t last = (offset + size - 1) / 8;
+
+        if (last >= this->cache.size() * 64) return false;
+
+        for (uint64_t word = first; word <= last; word++)
+        {
+            if (((this->cache[word / 64] >> (word % 64)) & 1) == 0) return false;
+        }
+
+        return true;
+    }
+
+    // Valid buffers, indexed by base, each entry giving the end of the buffer
+    std::map<uint64_t, uint64_t> buffers;
+    // One bit per 8-byte word, set if the word is fully inside a buffer
+    std::vector<uint64_t> cache;
+};
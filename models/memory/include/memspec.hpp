@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+// DRAM geometry and address mapping, as exchanged between the DRAM models and
+// the PIM component. Kept apart from pim.hpp so that io_v2 models can include
+// it without pulling vp/itf/io.hpp (v1).
+
+#include <sys/types.h>
+
+struct GvsocMemspec {
+    uint access_size;
+    uint nb_channels;
+    uint nb_pseudo_channels;
+    uint nb_ranks;
+    uint nb_bank_groups;
+    uint nb_banks;
+    uint nb_rows;
+    uint nb_columns;
+    uint channel_stride;
+    uint rank_stride;
+    uint bankgroup_stride;
+    uint bank_stride;
+    uint row_stride;
+    uint column_stride;
+};
@@ -6,22 +6,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 
-struct GvsocMemspec {
-    uint access_size;
-    uint nb_channels;
-    uint nb_pseudo_channels;
-    uint nb_ranks;
-    uint nb_bank_groups;
-    uint nb_banks;
-    uint nb_rows;
-    uint nb_columns;
-    uint channel_stride;
-    uint rank_stride;
-    uint bankgroup_stride;
-    uint bank_stride;
-    uint row_stride;
-    uint column_stride;
-};
+#include <memory/include/memspec.hpp>
 
 struct PimInfo {
     uint is_write;
@@ -29,6 +29,7 @@
 #include <vp/itf/wire.hpp>
 #include <vp/debug_mem.hpp>
 #include <memory/memory_config/memory_config.hpp>
+#include <memory/include/memcheck_buffers.hpp>
 
 class Memory : public vp::Component, public vp::DebugMemIf
 {
@@ -63,10 +64,6 @@ private:
     vp::IoReqStatus handle_read(uint64_t addr, uint64_t size, uint8_t *data, uint8_t *memcheck_data);
     vp::IoReqStatus handle_atomic(uint64_t addr, uint64_t size, uint8_t *in_data, uint8_t *out_data,
         vp::IoReqOpcode opcode, int initiator, uint8_t *in_memcheck_data, uint8_t *out_memcheck_data);
-    // Check if an access to the specified offset falls into a valid buffer
-    bool memcheck_is_valid_address(uint64_t offset);
-    // In case of a faulting access, find the closest valid buffer to the offset
-    void memcheck_find_closest_buffer(uint64_t offset, uint64_t &distance, uint64_t &buffer_offset, uint64_t &buffer_size);
     void memcheck_buffer_setup(uint64_t base, uint64_t size, bool enable);
     bool check_buffer_access(uint64_t offset, uint64_t size, bool is_write);
     void log_access(uint64_t addr, uint64_t size, bool is_write);
@@ -86,7 +83,8 @@ private:
     uint8_t *mem_data;
     uint8_t *memcheck_data = NULL;
     uint8_t *check_mem;
-    uint8_t *memcheck_valid_flags = NULL;
+    // Valid buffers, only allocated if buffer overflows are tracked in this memory
+    MemcheckBuffers *memcheck_buffers = NULL;
 
     int64_t next_packet_start;
 
@@ -232,9 +230,9 @@ log_is_write(*this, "req_is_write", 1, vp::SignalCommon::ResetKind::HighZ)
         if (memcheck_id != -1)
         {
             this->memcheck_expansion_factor = this->get_js_config()->get_child_int("memcheck_expansion_factor");
-            int memcheck_size = this->cfg.size * this->memcheck_expansion_factor;
-            this->memcheck_valid_flags = (uint8_t *)calloc((memcheck_size + 7) / 8, 1);
-            if (this->memcheck_valid_flags == NULL) throw std::bad_alloc();
+            uint64_t memcheck_size = this->cfg.size * this->memcheck_expansion_factor;
+            this->memcheck_buffers = new MemcheckBuffers(memcheck_size,
+                this->get_js_config()->get_child_bool("memcheck_cache"));
 
             this->memcheck_base = this->get_js_config()->get_child_int("memcheck_base");
             this->memcheck_virtual_base = this->get_js_config()->get_child_int("memcheck_virtual_base");
@@ -496,148 +494,41 @@ vp::IoReqStatus Memory::handle_write(uint64_t offset, uint64_t size, uint8_t *da
 }
 
 
-bool Memory::memcheck_is_valid_address(uint64_t offset)
-{
-    // Valid bytes are monitored through an array, one bit per byte
-    size_t valid_byte = offset >> 3;
-    int valid_bit = offset & 0x7;
-    return (this->memcheck_valid_flags[valid_byte] >> valid_bit) & 1;
-}
-
-void Memory::memcheck_find_closest_buffer(uint64_t offset, uint64_t &distance,
-    uint64_t &buffer_offset, uint64_t &buffer_size)
+bool Memory::check_buffer_access(uint64_t offset, uint64_t size, bool is_write)
 {
-    // First go through the memory in descending order from the current offset to see if we find a
-    // valid buffer before the offset
-    uint64_t valid_before_offset;
-    uint64_t valid_before_offset_last;
-    uint64_t distance_before = 0;
-
-    if (offset > 0)
+    if (this->memcheck_buffers != NULL)
     {
-        uint64_t current_offset = offset;
+        // Check that the whole access falls into a valid buffer
+        uint64_t current_offset;
+        bool is_valid = this->memcheck_buffers->check(offset, size, current_offset);
 
-        // First look for the first valid bit to get end of buffer
-        do
+        if (!is_valid)
         {
-            current_offset--;
+            // If not, get the closest valid buffer and throw a warning to help the user
+            // understand better the overflow
+            uint64_t buffer_offset, buffer_size, distance;
+            this->memcheck_buffers->find_closest(current_offset, distance, buffer_offset, buffer_size);
 
-            if (this->memcheck_is_valid_address(current_offset))
-            {
-                valid_before_offset_last = current_offset;
-                valid_before_offset = current_offset;
-                distance_before = offset - current_offset;
-                break;
-            }
-        } while (current_offset != 0);
+            this->trace.force_warning_no_error("%s access outside buffer "
+                "(virtual addr: 0x%x)\n", is_write ? "Write" : "Read",
+                current_offset + this->memcheck_virtual_base);
 
-        // And then for the first invalid bit to get start of buffer
-        if (current_offset > 0)
-        {
-            do
+            if (distance == 0)
             {
-                current_offset--;
-                if (this->memcheck_is_valid_address(current_offset))
-                {
-                    valid_before_offset = current_offset;
-                }
-                else
-                {
-                    break;
-                }
-            } while (current_offset != 0);
-        }
-    }
-
-    // First go through the memory in ascending order from the current offset to see if we find a
-    // valid buffer after the offset
-    uint64_t valid_after_offset;
-    uint64_t valid_after_offset_last;
-    uint64_t distance_after = 0;
-    // First look for the first valid bit to get start of buffer
-    for (uint64_t current_offset = offset; current_offset<this->cfg.size; current_offset++)
-    {
-        if (this->memcheck_is_valid_address(current_offset))
-        {
-            valid_after_offset = current_offset;
-            valid_after_offset_last = current_offset;
-            distance_after = current_offset - offset;
-            break;
-        }
-    }
-
-    // And then for the first invalid bit to get end of buffer
-    for (uint64_t current_offset = valid_after_offset; current_offset<this->cfg.size; current_offset++)
-    {
-        if (this->memcheck_is_valid_address(current_offset))
-        {
-            valid_after_offset_last = current_offset;
-        }
-        else
-        {
-            break;
-        }
-    }
-
-    if (distance_before == 0 && distance_after == 0)
-    {
-        distance = 0;
-        return;
-    }
-
-    // Finally return the one which is closer
-    if (distance_before == 0 || (distance_after != 0 && distance_after < distance_before))
-    {
-        distance = distance_after;
-        buffer_offset = valid_after_offset;
-        buffer_size = valid_after_offset_last - valid_after_offset + 1;
-    }
-    else
-    {
-        distance = distance_before;
-        buffer_offset = valid_before_offset;
-        buffer_size = valid_before_offset_last - valid_before_offset + 1;
-    }
-}
-
-bool Memory::check_buffer_access(uint64_t offset, uint64_t size, bool is_write)
-{
-    if (this->memcheck_valid_flags != NULL)
-    {
-        // Go through all bytes of the access to see if one is not valid
-        for (int i=0; i<size; i++)
-        {
-            uint64_t current_offset = offset + i;
-            bool is_valid = this->memcheck_is_valid_address(current_offset);
-
-            if (!is_valid)
+                this->trace.force_warning_no_error("%s access with no buffer\n", is_write ? "Write" : "Read");
+                return true;
+            }
+            else
             {
-                // If not, get the closest valid buffer and throw a warning to help the user
-                // understand better the overflow
-                uint64_t buffer_offset, buffer_size, distance;
-                this->memcheck_find_closest_buffer(current_offset, distance, buffer_offset, buffer_size);
-
-                this->trace.force_warning_no_error("%s access outside buffer "
-                    "(virtual addr: 0x%x)\n", is_write ? "Write" : "Read",
-                    current_offset + this->memcheck_virtual_base);
-
-                if (distance == 0)
-                {
-                    this->trace.force_warning_no_error("%s access with no buffer\n", is_write ? "Write" : "Read");
-                    return true;
-                }
-                else
-                {
-                    bool is_before = buffer_offset > current_offset;
-                    uint64_t buffer_real_addr = (buffer_offset - buffer_size * (this->memcheck_expansion_factor  / 2)) /
-                        this->memcheck_expansion_factor + this->memcheck_base;
+                bool is_before = buffer_offset > current_offset;
+                uint64_t buffer_real_addr = (buffer_offset - buffer_size * (this->memcheck_expansion_factor  / 2)) /
+                    this->memcheck_expansion_factor + this->memcheck_base;
 
-                    this->trace.force_warning_no_error("%s access is %ld byte(s) %s buffer (buffer_addr: 0x%llx, buffer_virtual_addr: %llx, buffer_size: 0x%llx)\n",
-                        is_write ? "Write" : "Read", distance, is_before ? "before" : "after",
-                        buffer_real_addr, buffer_offset + this->memcheck_virtual_base, buffer_size);
+                this->trace.force_warning_no_error("%s access is %ld byte(s) %s buffer (buffer_addr: 0x%llx, buffer_virtual_addr: %llx, buffer_size: 0x%llx)\n",
+                    is_write ? "Write" : "Read", distance, is_before ? "before" : "after",
+                    buffer_real_addr, buffer_offset + this->memcheck_virtual_base, buffer_size);
 
-                    return true;
-                }
+                return true;
             }
         }
     }
@@ -784,6 +675,8 @@ void Memory::stop()
     {
         delete[] this->check_mem;
     }
+    delete this->memcheck_buffers;
+    this->memcheck_buffers = NULL;
 }
 
 void Memory::reset(bool active)
@@ -849,7 +742,7 @@ void Memory::memcheck_buffer_setup(uint64_t base, uint64_t size, bool enable)
     }
 
 
-    if (this->memcheck_valid_flags != NULL)
+    if (this->memcheck_buffers != NULL)
     {
         this->trace.msg(vp::Trace::LEVEL_INFO, "%s valid buffer (offset: 0x%lx, size: 0x%lx)\n",
             enable ? "Adding" : "Removing", base, size);
@@ -861,19 +754,13 @@ void Memory::memcheck_buffer_setup(uint64_t base, uint64_t size, bool enable)
             return;
         }
 
-        for (int i=0; i<size; i++)
+        if (enable)
         {
-            uint64_t offset = base + i;
-            int valid_byte = offset >> 3;
-            int valid_bit = offset & 0x7;
-            if (enable)
-            {
-                this->memcheck_valid_flags[valid_byte] |= 1 << valid_bit;
-            }
-            else
-            {
-                this->memcheck_valid_flags[valid_byte] &= ~(1 << valid_bit);
-            }
+            this->memcheck_buffers->add(base, size);
+        }
+        else
+        {
+            this->memcheck_buffers->remove(base, size);
         }
     }
 
@@ -883,7 +770,7 @@ void Memory::memcheck_buffer_setup(uint64_t base, uint64_t size, bool enable)
 uint64_t Memory::memcheck_alloc(uint64_t ptr, uint64_t size)
 {
 #ifdef VP_MEMCHECK_ACTIVE
-    if (this->memcheck_valid_flags != NULL)
+    if (this->memcheck_buffers != NULL)
     {
         uint64_t virtual_offset = (ptr - this->memcheck_base) * this->memcheck_expansion_factor +
             size * (this->memcheck_expansion_factor  / 2) ;
@@ -901,7 +788,7 @@ uint64_t Memory::memcheck_alloc(uint64_t ptr, uint64_t size)
 uint64_t Memory::memcheck_free(uint64_t virtual_ptr, uint64_t size)
 {
 #ifdef VP_MEMCHECK_ACTIVE
-    if (this->memcheck_valid_flags != NULL)
+    if (this->memcheck_buffers != NULL)
     {
         uint64_t virtual_offset = virtual_ptr - this->memcheck_virtual_base;
         uint64_t offset = (virtual_offset - size * (this->memcheck_expansion_factor  / 2)) / this->memcheck_expansion_factor + this->memcheck_base;
@@ -60,6 +60,9 @@ class Memory(gvsoc.systree.Component):
         Absolute virtual base of allocated buffers.
     memcheck_expansion_factor: int
         Extra size used to track buffer overflow.
+    memcheck_cache: bool
+        True to keep a bitmap with one bit per 8-byte word of the tracked area, on top of the
+        buffer index, so that most accesses are checked without looking up the index.
     truncate_size: int
         If non-zero, incoming request addresses are masked with (truncate_size - 1)
         before accessing the backing array. Lets the caller wrap or fold the incoming
@@ -69,7 +72,8 @@ class Memory(gvsoc.systree.Component):
     def __init__(self, parent: gvsoc.systree.Component, name: str, size: int=0, width_log2: int=-1,
             stim_file: str=None, power_trigger: bool=False,
             align: int=0, atomics: bool=False, latency=0, memcheck_id: int=-1, memcheck_base: int=0,
-            memcheck_virtual_base: int=0, memcheck_expansion_factor: int=5, init=True,
+            memcheck_virtual_base: int=0, memcheck_expansion_factor: int=5, memcheck_cache: bool=True,
+            init=True,
             truncate_size: int=0,
             attributes: MemoryConfig | None=None, config: MemoryConfig | None=None):
 
@@ -102,6 +106,7 @@ class Memory(gvsoc.systree.Component):
             'memcheck_base': memcheck_base,
             'memcheck_virtual_base': memcheck_virtual_base,
             'memcheck_expansion_factor': memcheck_expansion_factor,
+            'memcheck_cache': memcheck_cache,
             'truncate_size': truncate_size,
         })
 
@@ -45,6 +45,11 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
 #include <map>
 #include <vp/vp.hpp>
 #include <vp/signal.hpp>
@@ -52,9 +57,10 @@
 #include <vp/itf/io_v2.hpp>
 #include <vp/itf/wire.hpp>
 #include <vp/debug_mem.hpp>
+#include <utils/dmi.hpp>
 #include <memory/memory_v3/memory_v3_config.hpp>
 
-class Memory : public vp::Component, public vp::DebugMemIf
+class Memory : public vp::Component, public vp::DebugMemIf, public DmiIf
 {
 
 public:
@@ -66,6 +72,9 @@ public:
     int debug_mem_access(uint64_t addr, uint8_t *data, uint64_t size,
         bool is_write) override;
 
+    // Direct host access to the whole memory, used by untimed masters
+    bool dmi_get(uint64_t addr, DmiGrant &grant, DmiListener *listener) override;
+
     MemoryV3Config cfg;
 
 private:
@@ -81,6 +90,7 @@ private:
     vp::IoReqStatus handle_atomic(uint64_t addr, uint64_t size, uint8_t *in_data,
         uint8_t *out_data, vp::IoReqOpcode opcode, void *initiator);
     void log_access(uint64_t addr, uint64_t size, bool is_write);
+    void map_stim_file();
 
     vp::Trace trace;
     // io_v2 slave port — request callback is attached via the in-class
@@ -97,10 +107,17 @@ private:
 
     bool powered_up;
 
+    // Masters which got a direct access to the memory, to be notified when the memory is
+    // powered down or its storage changes
+    DmiListeners dmi_listeners;
+
     // LR/SC reservation table. Keyed on ``req->initiator`` (void* in v2).
     std::map<void *, uint64_t> res_table;
 
     bool free_mem = false;
+    // Lazily-allocated store reserved with mmap, if any. Kept apart from mem_data which
+    // meminfo can redirect to another buffer.
+    uint8_t *mapped_mem = NULL;
     vp::Signal<uint64_t> log_addr;
     vp::Signal<uint64_t> log_size;
     vp::Signal<bool> log_is_write;
@@ -149,16 +166,34 @@ log_is_write(*this, "req_is_write", 1, vp::SignalCommon::ResetKind::HighZ)
     trace.msg("Building Memory (size: 0x%llx, check: %d)\n",
               (unsigned long long)this->cfg.size, this->cfg.check);
 
-    if (this->cfg.align)
+    // A lazy store only costs the host pages which are actually written, which matters for
+    // multi-GiB memories of which the software touches a few MB. mmap only guarantees page
+    // alignment, so bigger alignments still go through aligned_alloc. mmap also refuses
+    // empty mappings, which are allocated like non-lazy stores.
+    if (this->cfg.lazy && this->cfg.size != 0 && this->cfg.align <= sysconf(_SC_PAGESIZE))
     {
-        mem_data = (uint8_t *)aligned_alloc(this->cfg.align, this->cfg.size);
+        this->mem_data = (uint8_t *)mmap(NULL, this->cfg.size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (this->mem_data == MAP_FAILED) throw std::bad_alloc();
+        if (this->cfg.huge_pages)
+        {
+            madvise(this->mem_data, this->cfg.size, MADV_HUGEPAGE);
+        }
+        this->mapped_mem = this->mem_data;
     }
     else
     {
-        mem_data = (uint8_t *)calloc(this->cfg.size, 1);
-        if (mem_data == NULL) throw std::bad_alloc();
+        if (this->cfg.align)
+        {
+            mem_data = (uint8_t *)aligned_alloc(this->cfg.align, this->cfg.size);
+        }
+        else
+        {
+            mem_data = (uint8_t *)calloc(this->cfg.size, 1);
+            if (mem_data == NULL) throw std::bad_alloc();
+        }
+        this->free_mem = true;
     }
-    this->free_mem = true;
 
     if (this->cfg.check)
     {
@@ -178,6 +213,12 @@ log_is_write(*this, "req_is_write", 1, vp::SignalCommon::ResetKind::HighZ)
     {
         trace.msg("Preloading Memory with stimuli file (path: %s)\n", this->cfg.stim_file);
 
+        if (this->mapped_mem)
+        {
+            this->map_stim_file();
+            return;
+        }
+
         FILE *file = fopen(this->cfg.stim_file, "rb");
         if (file == NULL)
         {
@@ -189,12 +230,70 @@ log_is_write(*this, "req_is_write", 1, vp::SignalCommon::ResetKind::HighZ)
         {
             this->trace.fatal("Failed to read stim file: %s, %s\n",
                                this->cfg.stim_file, strerror(errno));
+            fclose(file);
             return;
         }
+        fclose(file);
     }
 }
 
 
+void Memory::map_stim_file()
+{
+    int fd = open(this->cfg.stim_file, O_RDONLY);
+    if (fd == -1)
+    {
+        this->trace.fatal("Unable to open stim file: %s, %s\n",
+                           this->cfg.stim_file, strerror(errno));
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size == 0)
+    {
+        this->trace.fatal("Failed to read stim file: %s, %s\n",
+                           this->cfg.stim_file, strerror(errno));
+        close(fd);
+        return;
+    }
+
+    uint64_t size = std::min((uint64_t)st.st_size, (uint64_t)this->cfg.size);
+
+    // Whole pages are mapped copy-on-write over the store, so that only the pages the
+    // simulation writes get duplicated and the file is never modified. The partial last
+    // page is read, to keep the rest of that page as it was (poisoned or zero).
+    // The pages not written yet keep reading the file, so it must not be truncated while
+    // the simulation runs, accessing them would then raise SIGBUS.
+    uint64_t mapped_size = size & ~(uint64_t)(sysconf(_SC_PAGESIZE) - 1);
+    if (mapped_size)
+    {
+        if (mmap(this->mem_data, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+            fd, 0) == MAP_FAILED)
+        {
+            this->trace.fatal("Failed to map stim file: %s, %s\n",
+                               this->cfg.stim_file, strerror(errno));
+            close(fd);
+            return;
+        }
+    }
+
+    uint64_t offset = mapped_size;
+    while (offset < size)
+    {
+        ssize_t len = pread(fd, &this->mem_data[offset], size - offset, offset);
+        if (len <= 0)
+        {
+            this->trace.fatal("Failed to read stim file: %s, %s\n",
+                               this->cfg.stim_file, strerror(errno));
+            break;
+        }
+        offset += len;
+    }
+
+    close(fd);
+}
+
+
 void Memory::log_access(uint64_t addr, uint64_t size, bool is_write)
 {
     int64_t cycles = this->clock.get_cycles();
@@ -326,6 +425,34 @@ int Memory::debug_mem_access(uint64_t addr, uint8_t *data, uint64_t size, bool i
 }
 
 
+bool Memory::dmi_get(uint64_t addr, DmiGrant &grant, DmiListener *listener)
+{
+    // Register the listener even if the access is refused, so that the master queries again
+    // once the memory is powered up
+    this->dmi_listeners.add(listener);
+
+    // The power trigger needs to see every access
+    if (!this->powered_up || this->cfg.power_trigger)
+    {
+        return false;
+    }
+
+    uint64_t offset = addr & this->truncate_mask;
+    if (offset >= (uint64_t)this->cfg.size)
+    {
+        return false;
+    }
+
+    grant.base = addr - offset;
+    grant.size = this->cfg.size;
+    grant.host = this->mem_data;
+    grant.latency = this->cfg.latency;
+    grant.writable = true;
+
+    return true;
+}
+
+
 vp::IoReqStatus Memory::handle_write(uint64_t offset, uint64_t size, uint8_t *data)
 {
     if (!this->powered_up)
@@ -440,6 +567,11 @@ vp::IoReqStatus Memory::handle_atomic(uint64_t addr, uint64_t size, uint8_t *in_
 
 void Memory::stop()
 {
+    if (this->mapped_mem)
+    {
+        munmap(this->mapped_mem, this->cfg.size);
+        this->mapped_mem = NULL;
+    }
     if (this->free_mem)
     {
         free(this->mem_data);
@@ -456,6 +588,7 @@ void Memory::reset(bool active)
     if (active)
     {
         this->powered_up = true;
+        this->dmi_listeners.invalidate();
     }
 }
 
@@ -464,7 +597,11 @@ void Memory::reset(bool active)
 void Memory::power_ctrl_sync(vp::Block *__this, bool value)
 {
     Memory *_this = (Memory *)__this;
-    _this->powered_up = value;
+    if (_this->powered_up != value)
+    {
+        _this->powered_up = value;
+        _this->dmi_listeners.invalidate();
+    }
 }
 
 
@@ -482,6 +619,7 @@ void Memory::meminfo_sync(vp::Block *__this, void *value)
     Memory *_this = (Memory *)__this;
     _this->mem_data = (uint8_t *)value;
     _this->free_mem = false;
+    _this->dmi_listeners.invalidate();
 }
 
 
@@ -61,6 +61,13 @@ class MemoryV3Config(Config, HasSize):
         True to enable the power-capture trigger (magic writes of
         ``0xabbaabba`` / ``0xdeadcaca`` at offset 0 start/stop
         capture).
+    lazy: bool
+        True to reserve the backing buffer with an anonymous mapping
+        whose host pages are only allocated on first write. Default
+        ``True``.
+    huge_pages: bool
+        True to ask for transparent 2 MiB host pages on the lazy
+        backing buffer.
     """
 
     size: int = cfg_field(default=0, fmt="hex", dump=True, desc=(
@@ -104,6 +111,15 @@ class MemoryV3Config(Config, HasSize):
         "Enable power-capture start/stop triggers on magic writes to offset 0"
     ))
 
+    lazy: bool = cfg_field(default=True, dump=True, desc=(
+        "Reserve the backing buffer with an anonymous mapping, so that host pages "
+        "are only allocated when first written and stim files are mapped copy-on-write"
+    ))
+
+    huge_pages: bool = cfg_field(default=False, dump=True, desc=(
+        "Advise transparent huge pages on the lazy backing buffer"
+    ))
+
 
 class Memory(gvsoc.systree.Component):
     """SRAM backing store on the io_v2 protocol.
@@ -222,7 +238,8 @@ class Memory(gvsoc.systree.Component):
       expected when ``cfg.size`` is a power of two. Non-power-of-two
       sizes with ``truncate=True`` alias into unexpected regions.
     - **``init=True`` fills the buffer with 0x57.** Memories larger
-      than 32 MiB skip the poison fill to keep startup fast. If you
+      than 32 MiB skip the poison fill to keep startup fast (and, with
+      ``lazy=True``, to keep the buffer unallocated). If you
       care about fresh zeros for large regions, load a stim file or
       clear the buffer explicitly.
 
@@ -244,8 +261,9 @@ class Memory(gvsoc.systree.Component):
         When ``False``, addresses above ``cfg.size`` fail the bounds
         check. Default ``True``.
     ``align``
-        Alignment (bytes) passed to ``aligned_alloc`` for the
-        backing buffer. ``0`` falls back to ``calloc``.
+        Alignment (bytes) of the backing buffer. Alignments above
+        the host page size are served by ``aligned_alloc`` instead of
+        the lazy mapping.
     ``check``
         Allocate a side-band bitmap for tracking uninitialised
         accesses.
@@ -253,12 +271,31 @@ class Memory(gvsoc.systree.Component):
         ``True`` to poison the backing buffer with ``0x57`` at
         construction (skipped for memories ≥ 32 MiB).
     ``stim_file``
-        Path to a raw-binary file loaded via ``fread`` into the
-        backing store at startup. Empty string means "no preload".
+        Path to a raw-binary file preloaded into the backing store at
+        startup. With ``lazy=True`` its whole pages are mapped
+        copy-on-write (``MAP_PRIVATE``) rather than read, so the file
+        is neither read up front nor modified. The pages the simulation
+        has not written yet are still backed by the file, which must
+        therefore not change while the simulation runs: truncating it
+        makes the accesses to those pages fail with ``SIGBUS``. Use
+        ``lazy=False`` for a stim file which may be rewritten meanwhile.
+        Empty string means "no preload".
     ``power_trigger``
         When ``True``, a write of ``0xabbaabba`` to offset 0 starts
         power capture; ``0xdeadcaca`` stops it and prints a measure
         line.
+    ``lazy``
+        When ``True`` (default), the backing buffer is an anonymous
+        ``MAP_NORESERVE`` mapping: host pages are allocated on the
+        first write, untouched ranges read as zero without being
+        allocated, and the buffer stays contiguous for ``meminfo``,
+        DMI and debug accesses. Multi-GiB memories then only cost
+        what the software touches. ``False`` uses ``calloc`` /
+        ``aligned_alloc``.
+    ``huge_pages``
+        When ``True``, the lazy buffer is advised for transparent
+        2 MiB host pages, trading memory footprint for fewer page
+        faults and TLB misses on densely-used memories.
 
     Example
     ~~~~~~~
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Authors: Germain Haugou (germain.haugou@gmail.com)
+
+/*
+ * Burst interface of external memory devices (HyperRAM, HyperFlash, SPI and octo-SPI flashes).
+ *
+ * These devices are normally driven by their controller one useful clock edge at a time, which
+ * costs several calls per transferred byte. A controller can resolve the burst interface of the
+ * device behind its port with burst_if_get() and, once it has sent the command and address
+ * phases on the edge interface, hand the whole data phase of a read or program to the device in
+ * a single call. The device copies the data from or to its array and returns the number of bus
+ * clock cycles the data phase would have taken on the edge interface, so that the controller can
+ * account it in one go. Chip select is still driven through the edge interface, so that the
+ * device state machine (end of program, busy time, etc) is unchanged.
+ *
+ * The device refuses a burst whenever it can not guarantee the same result as the edge
+ * interface (register access, out-of-bound access, device busy, etc), and the controller must
+ * then fall back to clocking it edge per edge. Devices only accept bursts when their burst
+ * property is set, otherwise they keep the edge-accurate path, which is the default.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <vp/vp.hpp>
+
+class BurstIf
+{
+public:
+    // Transfer the size bytes of the data phase of the current command, starting at the first
+    // data byte. Data is read into data for a read command, or taken from it for a program.
+    // Returns the number of bus clock cycles of the data phase, including the remaining latency
+    // cycles of the command, or -1 if the burst can not be handled, in which case nothing
+    // was done.
+    virtual int64_t burst_access(uint8_t *data, uint64_t size, bool is_write) = 0;
+};
+
+// Returns the burst interface of the device bound behind a master port, or NULL if the port
+// is not bound or the device does not support bursts
+inline BurstIf *burst_if_get(vp::MasterPort *port)
+{
+    std::vector<vp::SlavePort *> finals = port->get_final_ports();
+    if (finals.empty() || finals[0]->get_owner() == nullptr)
+    {
+        return nullptr;
+    }
+    return dynamic_cast<BurstIf *>(finals[0]->get_owner());
+}
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Authors: Germain Haugou (germain.haugou@gmail.com)
+
+/*
+ * Direct memory interface (DMI).
+ *
+ * Lets a master get a raw host pointer on a range of a memory, so that it can
+ * do plain host loads and stores instead of sending an IoReq for each access.
+ * A master resolves the component behind one of its ports with dmi_if_get()
+ * and asks it for a grant covering an address. Components in between (routers)
+ * forward the query with their address translation applied and clip the
+ * returned range to the mapping, so the grant is always expressed in the
+ * master address space.
+ *
+ * The master passes a listener with its query. It is called whenever the
+ * grants it got may no longer be valid (memory powered down, storage changed,
+ * reset, etc), after which the master must drop all its grants and query again.
+ *
+ * DMI is a functional shortcut: it bypasses the timing, statistics and traces
+ * of the components on the path, and is meant for untimed simulations.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <vp/vp.hpp>
+
+// Range of a memory which can be directly accessed from the host
+struct DmiGrant
+{
+    // First address of the range, in the address space of the requester
+    uint64_t base = 0;
+    uint64_t size = 0;
+    // Host pointer corresponding to base
+    uint8_t *host = nullptr;
+    // Fixed latency of each access done through this range
+    int64_t latency = 0;
+    bool writable = true;
+};
+
+class DmiListener
+{
+public:
+    // Called when all grants given to this listener must be dropped
+    virtual void dmi_invalidate() = 0;
+};
+
+class DmiIf
+{
+public:
+    // Fill grant with a range containing addr, addr being local to this component.
+    // Returns false if addr can not be directly accessed.
+    virtual bool dmi_get(uint64_t addr, DmiGrant &grant, DmiListener *listener) = 0;
+};
+
+// Set of listeners which got a grant from a component
+class DmiListeners
+{
+public:
+    void add(DmiListener *listener)
+    {
+        if (listener && std::find(this->listeners.begin(), this->listeners.end(), listener) ==
+            this->listeners.end())
+        {
+            this->listeners.push_back(listener);
+        }
+    }
+
+    // Tell every listener to drop its grants. They register again with their next query.
+    void invalidate()
+    {
+        std::vector<DmiListener *> listeners;
+        listeners.swap(this->listeners);
+        for (DmiListener *listener : listeners)
+        {
+            listener->dmi_invalidate();
+        }
+    }
+
+private:
+    std::vector<DmiListener *> listeners;
+};
+
+// Returns the DMI interface of the component bound behind a master port, or NULL if the
+// port is not bound or the component does not support DMI
+inline DmiIf *dmi_if_get(vp::MasterPort *port)
+{
+    std::vector<vp::SlavePort *> finals = port->get_final_ports();
+    if (finals.empty() || finals[0]->get_owner() == nullptr)
+    {
+        return nullptr;
+    }
+    return dynamic_cast<DmiIf *>(finals[0]->get_owner());
+}
+
+// Clip a grant returned by a child to the window [base, base + size) of the parent address
+// space, child addresses being parent ones plus offset. size 0 means the whole address space.
+inline bool dmi_grant_clip(DmiGrant &grant, uint64_t offset, uint64_t base, uint64_t size)
+{
+    uint64_t grant_base = grant.base - offset;
+    uint64_t grant_end = grant_base + grant.size;
+    uint64_t win_end = size == 0 ? UINT64_MAX : base + size;
+    uint64_t new_base = std::max(grant_base, size == 0 ? 0 : base);
+    uint64_t new_end = std::min(grant_end, win_end);
+
+    if (new_base >= new_end)
+    {
+        return false;
+    }
+
+    grant.host += new_base - grant_base;
+    grant.base = new_base;
+    grant.size = new_end - new_base;
+    return true;
+}
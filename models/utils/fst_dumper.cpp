@@ -24,6 +24,10 @@
  * reader API delivers a single, globally time-sorted value-change stream via
  * fstReaderIterBlocks2, so the per-signal traversal handles + heap that
  * FSDB needs collapse into one flat sorted vector here.
+ *
+ * The stream is read by consecutive time windows rather than all at once, so
+ * that multi-GB FSTs can be replayed with bounded memory: while the events of
+ * one window are injected, a background thread loads the next one.
  */
 
 #include <vp/vp.hpp>
@@ -31,8 +35,12 @@
 
 #include "fstapi.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -93,12 +101,46 @@ private:
     // vcd_user to the trace engine; the allocation happens in reset(false).
     void walk_hierarchy();
 
-    // Pre-load every value change in time order via fstReaderIterBlocks2.
-    // The reader streams VCs through value_change_cb (and the varlen variant
-    // for strings, which we ignore); each callback push_back's into all_vcs.
-    // This is the heaviest step (O(file size) I/O), so it runs in the
-    // constructor and overlaps with GUI startup.
-    void load_value_changes();
+    // One window of value changes, in monotonically increasing time order
+    // (fstReaderIterBlocks2 guarantees this). Values are not stored per
+    // entry but packed one after the other into a byte pool shared by the
+    // whole window, entries only keep their offset, which avoids one heap
+    // allocation per wide value change. Vectors are cleared but not freed
+    // when the window is reloaded, so after the first windows the replay
+    // runs without any allocation.
+    struct VcEntry
+    {
+        uint64_t time_ps;
+        fstHandle handle;
+        // Offset in the pool of the bit_size value bytes
+        uint32_t offset;
+    };
+
+    struct VcWindow
+    {
+        std::vector<VcEntry> vcs;
+        std::vector<unsigned char> pool;
+        // Range of FST ticks covered by the window, both included
+        uint64_t start = 0;
+        uint64_t end = 0;
+        bool last = true;
+    };
+
+    // Load the value changes of the window starting at load_start via
+    // fstReaderIterBlocks2 restricted to the window time range. The reader
+    // streams VCs through value_change_cb (and the varlen variant for
+    // strings, which we ignore). The window span is then adapted so that
+    // next windows hold about window_vcs value changes whatever the density
+    // of the trace.
+    void load_window(VcWindow *window);
+
+    // Body of the background thread, which loads the next window while the
+    // current one is drained by the event handler.
+    void loader_routine();
+
+    // Make the prefetched window the current one and ask the loader for the
+    // following one. Returns false once the last window has been drained.
+    bool switch_window();
 
     static void value_change_cb(void *ud, uint64_t time, fstHandle h,
         const unsigned char *value);
@@ -114,7 +156,7 @@ private:
     // time_delay is added to the current simulated time so one handler call
     // can emit VCs that belong to multiple future timestamps; this keeps the
     // number of TimeEvent schedulings bounded even for densely-sampled FSTs.
-    void inject_value(FstSignal *sig, const std::string &raw, int64_t time_delay);
+    void inject_value(FstSignal *sig, const unsigned char *raw, int64_t time_delay);
     void enqueue_next();
 
     // Decode an FST per-bit value buffer into one or more 64-bit (value,
@@ -142,22 +184,42 @@ private:
     // FST file declared them, matching what GUI consumers (signal browser,
     // gtkwave) expect.
     std::vector<fstHandle> signals_order;
+    // Same signals indexed by handle, FST handles being dense, to avoid a
+    // hash lookup per value change. NULL for skipped variables.
+    std::vector<FstSignal *> signals_by_handle;
     std::unordered_map<std::string, int> element_size_map;
 
-    // One entry per value change in the file, in monotonically increasing
-    // time order (fstReaderIterBlocks2 guarantees this). Pre-allocated in
-    // the constructor so the event-driven drain in reset(false) just walks
-    // the index. Storing the raw bytes rather than the decoded chunks keeps
-    // memory usage in line with the on-disk format and lets decode happen
-    // lazily at injection time when the dedup cache also lives.
-    struct VcEntry
-    {
-        uint64_t time_ps;
-        fstHandle handle;
-        std::string value;
-    };
-    std::vector<VcEntry> all_vcs;
+    // Storing the raw bytes rather than the decoded chunks keeps memory
+    // usage in line with the on-disk format and lets decode happen lazily at
+    // injection time when the dedup cache also lives.
+    VcWindow windows[2];
+    // Window drained by the event handler and window owned by the loader
+    VcWindow *current = &this->windows[0];
+    VcWindow *next = &this->windows[1];
+    // Window being filled by the value change callbacks
+    VcWindow *loading = nullptr;
     size_t vc_index = 0;
+    // First tick of the next window to load, last tick of the file, and
+    // current window span in ticks. Only accessed by the loader once the
+    // first window has been loaded.
+    uint64_t load_start = 0;
+    uint64_t end_time = 0;
+    uint64_t window_span = 1;
+    // Target number of value changes per window
+    size_t window_vcs = 1000000;
+
+    std::thread *loader_thread = nullptr;
+    std::mutex loader_mutex;
+    std::condition_variable loader_cond;
+    // Set by the event handler to ask for the next window, and by the
+    // loader once it is loaded
+    bool loader_request = false;
+    bool next_ready = false;
+    bool loader_quit = false;
+
+    // Scratch buffers of decode_logic_value, kept to avoid allocations
+    std::vector<uint64_t> decode_values;
+    std::vector<uint64_t> decode_flags;
 
     int64_t ps_per_tick = 1;
     bool signals_materialized = false;
@@ -189,6 +251,12 @@ FstDumper::FstDumper(vp::ComponentConf &config)
         }
     }
 
+    js::Config *window_cfg = this->get_js_config()->get("window_vcs");
+    if (window_cfg != NULL && window_cfg->get_int() > 0)
+    {
+        this->window_vcs = window_cfg->get_int();
+    }
+
     std::string fst_path = this->get_js_config()->get_child_str("fst_file");
     if (fst_path == "")
     {
@@ -211,15 +279,53 @@ FstDumper::FstDumper(vp::ComponentConf &config)
 
     this->walk_hierarchy();
 
-    // Mark every variable as wanted, then iterate. This is the heavy step;
-    // it overlaps with GUI startup so reset(false) only does cheap signal
-    // allocation + register.
+    fstHandle max_handle = fstReaderGetMaxHandle(this->fst_ctx);
+    this->signals_by_handle.assign((size_t)max_handle + 1, nullptr);
+    for (auto &kv : this->signals)
+    {
+        if (kv.first <= max_handle)
+        {
+            this->signals_by_handle[kv.first] = kv.second;
+        }
+    }
+
+    // Mark every variable as wanted. Windows start with a span of a few FST
+    // blocks and adapt from there.
     fstReaderSetFacProcessMaskAll(this->fst_ctx);
-    this->load_value_changes();
+    this->load_start = fstReaderGetStartTime(this->fst_ctx);
+    this->end_time = std::max(fstReaderGetEndTime(this->fst_ctx), this->load_start);
+    uint64_t nb_blocks = std::max(fstReaderGetValueChangeSectionCount(this->fst_ctx), (uint64_t)1);
+    this->window_span = std::max((this->end_time - this->load_start) / nb_blocks * 4, (uint64_t)1);
+
+    // The first window is loaded here so that it overlaps with GUI startup
+    // and reset(false) only does cheap signal allocation + register. The
+    // next one is prefetched right away.
+    this->load_window(this->current);
+    this->trace.msg(vp::Trace::LEVEL_INFO,
+        "FST loaded %lu value changes across %lu signals in first window [%lu, %lu]\n",
+        (unsigned long)this->current->vcs.size(),
+        (unsigned long)this->signals.size(),
+        (unsigned long)this->current->start, (unsigned long)this->current->end);
+
+    if (!this->current->last)
+    {
+        this->loader_request = true;
+        this->loader_thread = new std::thread(&FstDumper::loader_routine, this);
+    }
 }
 
 FstDumper::~FstDumper()
 {
+    if (this->loader_thread)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->loader_mutex);
+            this->loader_quit = true;
+            this->loader_cond.notify_all();
+        }
+        this->loader_thread->join();
+        delete this->loader_thread;
+    }
     for (auto &kv : this->signals)
     {
         delete kv.second;
@@ -418,37 +524,110 @@ void FstDumper::walk_hierarchy()
     }
 }
 
-void FstDumper::load_value_changes()
+void FstDumper::load_window(VcWindow *window)
 {
+    window->vcs.clear();
+    window->pool.clear();
+    window->start = this->load_start;
+    window->end = this->end_time - this->load_start < this->window_span ?
+        this->end_time : this->load_start + this->window_span - 1;
+    window->last = window->end == this->end_time;
+
+    this->loading = window;
+    fstReaderSetLimitTimeRange(this->fst_ctx, window->start, window->end);
     fstReaderIterBlocks2(this->fst_ctx,
         &FstDumper::value_change_cb,
         &FstDumper::value_change_cb_varlen,
         this,
         nullptr);
-    this->trace.msg(vp::Trace::LEVEL_INFO,
-        "FST loaded %lu value changes across %lu signals\n",
-        (unsigned long)this->all_vcs.size(),
-        (unsigned long)this->signals.size());
+    this->loading = nullptr;
+
+    this->load_start = window->end + 1;
+
+    size_t nb_vcs = window->vcs.size();
+    if (nb_vcs > this->window_vcs && this->window_span > 1)
+    {
+        this->window_span /= 2;
+    }
+    else if (nb_vcs < this->window_vcs / 2 && this->window_span < (UINT64_MAX >> 2))
+    {
+        this->window_span *= 2;
+    }
+}
+
+void FstDumper::loader_routine()
+{
+    std::unique_lock<std::mutex> lock(this->loader_mutex);
+    while (1)
+    {
+        this->loader_cond.wait(lock, [this] { return this->loader_request || this->loader_quit; });
+        if (this->loader_quit)
+        {
+            break;
+        }
+        this->loader_request = false;
+        VcWindow *window = this->next;
+
+        // The event handler never touches the next window or the FST reader
+        // until next_ready is set, so the load can run unlocked.
+        lock.unlock();
+        this->load_window(window);
+        lock.lock();
+
+        this->next_ready = true;
+        this->loader_cond.notify_all();
+    }
+}
+
+bool FstDumper::switch_window()
+{
+    if (this->current->last)
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(this->loader_mutex);
+    this->loader_cond.wait(lock, [this] { return this->next_ready; });
+    std::swap(this->current, this->next);
+    this->next_ready = false;
+    this->vc_index = 0;
+    if (!this->current->last)
+    {
+        this->loader_request = true;
+        this->loader_cond.notify_all();
+    }
+    return true;
 }
 
 void FstDumper::value_change_cb(void *ud, uint64_t time, fstHandle h,
     const unsigned char *value)
 {
     FstDumper *_this = (FstDumper *)ud;
-    auto it = _this->signals.find(h);
-    if (it == _this->signals.end())
+    VcWindow *window = _this->loading;
+
+    // The reader processes whole blocks, so it also reports the VCs of the
+    // blocks overlapping the window boundaries. The ones before the window
+    // were already loaded with the previous window.
+    if (time < window->start || time > window->end)
+    {
+        return;
+    }
+
+    FstSignal *sig = h < _this->signals_by_handle.size() ? _this->signals_by_handle[h] : nullptr;
+    if (sig == nullptr)
     {
         // Unknown handle (skipped at hierarchy walk, e.g. real type) -- drop.
         return;
     }
-    int bit_size = it->second->bit_size;
+
     // The reader owns `value` only for the duration of this callback, so we
-    // must copy. std::string is a convenient byte container with SSO for
-    // narrow signals (the typical case).
-    _this->all_vcs.push_back({
+    // must copy.
+    size_t offset = window->pool.size();
+    window->pool.insert(window->pool.end(), value, value + sig->bit_size);
+    window->vcs.push_back({
         (uint64_t)time * (uint64_t)_this->ps_per_tick,
         h,
-        std::string((const char *)value, (size_t)bit_size)
+        (uint32_t)offset
     });
 }
 
@@ -472,7 +651,7 @@ void FstDumper::materialize_signals()
     // synchronously with the GUI's Db; doing this in the constructor (or
     // from start(), which runs inside gvsoc->open() before Db::bind) would
     // take the vcd_user == NULL branch and the events would never appear.
-    // The FST value-change load already ran in the constructor, so this
+    // The first FST window was already loaded in the constructor, so this
     // pass is only the cheap allocation + register step and runs fast.
     for (fstHandle handle : this->signals_order)
     {
@@ -542,19 +721,16 @@ void FstDumper::event_handler(vp::Block *__this, vp::TimeEvent *event)
     // scheduling round-trips from millions down to a handful per second.
     constexpr int BATCH_LIMIT = 16384;
     int processed = 0;
-    while (_this->vc_index < _this->all_vcs.size() && processed < BATCH_LIMIT)
+    VcWindow *window = _this->current;
+    while (_this->vc_index < window->vcs.size() && processed < BATCH_LIMIT)
     {
-        VcEntry &e = _this->all_vcs[_this->vc_index];
+        VcEntry &e = window->vcs[_this->vc_index];
         int64_t delay = (int64_t)e.time_ps - now;
         if (delay < 0)
         {
             delay = 0;
         }
-        auto it = _this->signals.find(e.handle);
-        if (it != _this->signals.end())
-        {
-            _this->inject_value(it->second, e.value, delay);
-        }
+        _this->inject_value(_this->signals_by_handle[e.handle], &window->pool[e.offset], delay);
         _this->vc_index++;
         processed++;
     }
@@ -564,12 +740,17 @@ void FstDumper::event_handler(vp::Block *__this, vp::TimeEvent *event)
 
 void FstDumper::enqueue_next()
 {
-    if (this->vc_index >= this->all_vcs.size())
+    // Move to the next window once the current one is drained. Windows can
+    // be empty if nothing changed during their time range.
+    while (this->vc_index >= this->current->vcs.size())
     {
-        this->time.get_engine()->quit(0);
-        return;
+        if (!this->switch_window())
+        {
+            this->time.get_engine()->quit(0);
+            return;
+        }
     }
-    int64_t next = (int64_t)this->all_vcs[this->vc_index].time_ps;
+    int64_t next = (int64_t)this->current->vcs[this->vc_index].time_ps;
     int64_t now = this->time.get_time();
     int64_t delta = next - now;
     if (delta < 0)
@@ -579,23 +760,13 @@ void FstDumper::enqueue_next()
     this->event.enqueue(delta);
 }
 
-void FstDumper::inject_value(FstSignal *sig, const std::string &raw, int64_t time_delay)
+void FstDumper::inject_value(FstSignal *sig, const unsigned char *raw, int64_t time_delay)
 {
-    if ((int)raw.size() != sig->bit_size)
-    {
-        // Defensive: load_value_changes captured `bit_size` bytes per VC
-        // because that's what FST advertises for the var. Anything else is
-        // a reader-side bug we'd rather not silently propagate.
-        this->trace.msg(vp::Trace::LEVEL_DEBUG,
-            "VC for %s has %zu bytes but bit_size=%d; skipping\n",
-            sig->full_name.c_str(), raw.size(), sig->bit_size);
-        return;
-    }
-
-    std::vector<uint64_t> values;
-    std::vector<uint64_t> flags;
-    this->decode_logic_value((const unsigned char *)raw.data(), sig->bit_size,
-        values, flags);
+    // raw holds exactly bit_size bytes, value_change_cb copied that many
+    // because that's what FST advertises for the var.
+    std::vector<uint64_t> &values = this->decode_values;
+    std::vector<uint64_t> &flags = this->decode_flags;
+    this->decode_logic_value(raw, sig->bit_size, values, flags);
 
     if (sig->signal_array.size() > 0)
     {
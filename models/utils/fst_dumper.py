@@ -44,9 +44,19 @@ class FstDumper(st.Component):
             cast=str
         ).get_value()
 
+        self.window_vcs = TargetParameter(
+            self, name='window_vcs', value=1000000,
+            description='Approximate number of value changes loaded at once from the FST file. '
+                        'The file is replayed by time windows holding about this number of '
+                        'value changes, the next one being loaded in background, so that '
+                        'memory usage does not depend on the trace length.',
+            cast=int
+        ).get_value()
+
         if self.fst_file is not None:
             self.add_properties({
-                'fst_file': self.fst_file
+                'fst_file': self.fst_file,
+                'window_vcs': self.window_vcs
             })
 
         # Pre-load the layout so any element_size overrides it carries can be
@@ -42,6 +42,14 @@
 // fires (async path). Between one chunk's completion and the next
 // one's issue, a single idle cycle is added so the simulator has a
 // chance to advance other components.
+//
+// Backdoor mode: when the ``backdoor`` property is set, the first
+// event writes every section in zero time through the debug-memory
+// backdoor (vp/debug_mem.hpp) of the component behind ``out``, which
+// for a router resolves the destination through its flat map of
+// debug_mem_regions down to the memories' backing stores. Only the
+// sections which are not fully covered by a backdoor are then
+// streamed through ``out`` as usual.
 
 #include <cstring>
 #include <fcntl.h>
@@ -54,6 +62,7 @@
 #include <vector>
 #include <vp/vp.hpp>
 #include <vp/itf/io_v2.hpp>
+#include <vp/debug_mem.hpp>
 
 #include "elf.h"
 
@@ -87,6 +96,11 @@ private:
     void section_copy(uint64_t paddr, uint8_t *data, size_t size);
     void section_clear(uint64_t paddr, size_t size);
 
+    // Write all queued sections through the debug-memory backdoor and drop
+    // the ones which landed. The others stay queued for the chunked path.
+    void backdoor_load();
+    bool backdoor_write(vp::DebugMemIf *debug_mem, Section *section);
+
     // Emit the current chunk on the output. Called from event_handler
     // (initial attempt) and from output_retry (after a DENY).
     void send_chunk();
@@ -123,6 +137,10 @@ private:
     bool      is_32 = true;
     uint64_t  fetchen_value = 0;
 
+    // Set if sections should first be loaded through the backdoor, cleared
+    // once done
+    bool      backdoor = false;
+
     static constexpr size_t MAX_CHUNK = 1 << 16;   // 64 KiB
 };
 
@@ -139,6 +157,8 @@ Loader::Loader(vp::ComponentConf &config)
     this->event = this->event_new(&Loader::event_handler);
 
     this->zero_buffer.assign(MAX_CHUNK, 0);
+
+    this->backdoor = this->get_js_config()->get_child_bool("backdoor");
 }
 
 
@@ -197,6 +217,68 @@ void Loader::section_clear(uint64_t paddr, size_t size)
 }
 
 
+void Loader::backdoor_load()
+{
+    this->backdoor = false;
+
+    std::vector<vp::SlavePort *> finals = this->out_itf.get_final_ports();
+    if (finals.empty() || finals[0]->get_owner() == nullptr)
+    {
+        return;
+    }
+    vp::DebugMemIf *debug_mem = finals[0]->get_owner()->debug_mem_if();
+    if (debug_mem == nullptr)
+    {
+        this->trace.msg(vp::Trace::LEVEL_INFO,
+            "No debug-memory backdoor on output, using regular load\n");
+        return;
+    }
+
+    for (auto it = this->sections.begin(); it != this->sections.end();)
+    {
+        Section *section = it->get();
+        if (this->backdoor_write(debug_mem, section))
+        {
+            it = this->sections.erase(it);
+        }
+        else
+        {
+            this->trace.msg(vp::Trace::LEVEL_DEBUG,
+                "Section not covered by backdoor, using regular load (addr: 0x%llx, size: 0x%llx)\n",
+                (unsigned long long)section->paddr, (unsigned long long)section->size);
+            it++;
+        }
+    }
+}
+
+
+bool Loader::backdoor_write(vp::DebugMemIf *debug_mem, Section *section)
+{
+    this->trace.msg(vp::Trace::LEVEL_DEBUG,
+        "Backdoor load of section (addr: 0x%llx, data: %p, size: 0x%llx)\n",
+        (unsigned long long)section->paddr, section->data,
+        (unsigned long long)section->size);
+
+    if (section->data != nullptr)
+    {
+        return debug_mem->debug_mem_access(section->paddr, section->data,
+            section->size, true) == 0;
+    }
+
+    // bss: the zero buffer only covers one chunk
+    for (size_t offset = 0; offset < section->size; offset += MAX_CHUNK)
+    {
+        size_t size = std::min(section->size - offset, MAX_CHUNK);
+        if (debug_mem->debug_mem_access(section->paddr + offset,
+            this->zero_buffer.data(), size, true))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
 void Loader::send_chunk()
 {
     this->req.prepare();
@@ -269,6 +351,13 @@ void Loader::event_handler(vp::Block *__this, vp::ClockEvent *event)
 {
     Loader *_this = (Loader *)__this;
 
+    // Done on the first event rather than at reset, so that the memories have
+    // completed their own reset.
+    if (_this->backdoor)
+    {
+        _this->backdoor_load();
+    }
+
     // Pick up the next section if there is none in progress.
     if (_this->current_section == nullptr && !_this->sections.empty())
     {
@@ -92,6 +92,25 @@ class ElfLoader(gvsoc.systree.Component):
     chunk and the issue of the next one, so other components get a
     chance to advance.
 
+    Backdoor load
+    ~~~~~~~~~~~~~
+
+    With ``backdoor=True``, the first streaming event writes every
+    section in zero time through the debug-memory backdoor of the
+    component bound to ``OUT`` (``vp::DebugMemIf``). Routers resolve
+    each write through their flat map of backdoor regions down to the
+    backing store of the destination memory, and ``bss`` is
+    zero-filled the same way. No request goes through ``OUT`` for
+    these sections, so large images (kernel plus initramfs) are in
+    place before the first instruction runs, at the cost of skipping
+    the interconnect timing and traces.
+
+    A section which is not fully covered by a backdoor (for example
+    one targeting a peripheral or a memory model without backdoor
+    support) falls back to the regular chunked path described above.
+    The ``ENTRY`` and ``START`` wires still fire once every section
+    has landed.
+
     Timing model
     ~~~~~~~~~~~~
 
@@ -131,8 +150,9 @@ class ElfLoader(gvsoc.systree.Component):
       address as-is, and an ``addr+size`` range that falls outside
       any bound memory simply triggers ``IO_RESP_INVALID`` from the
       interconnect (logged, not fatal).
-    - **One chunk in flight at a time.** The loader waits for each
-      chunk to be acknowledged before issuing the next. Throughput
+    - **One chunk in flight at a time.** Outside of the backdoor
+      load, the loader waits for each chunk to be acknowledged
+      before issuing the next. Throughput
       is therefore governed by the slowest downstream on the path,
       and a stalled interconnect will hold the loader hostage until
       it clears.
@@ -188,6 +208,12 @@ class ElfLoader(gvsoc.systree.Component):
         ``fetchen_addr`` in memory. Useful for lock-step start
         schemes where a "go" flag in memory releases the core.
 
+    ``backdoor``
+        If ``True``, load the sections in zero time through the
+        debug-memory backdoor, and only stream through ``OUT`` the
+        ones which are not covered by a backdoor. Default:
+        ``False``.
+
     Example
     ~~~~~~~
 
@@ -227,6 +253,8 @@ class ElfLoader(gvsoc.systree.Component):
         this address.
     fetchen_value : int, optional
         Value to write at ``fetchen_addr``.
+    backdoor : bool, optional
+        Load the sections through the debug-memory backdoor.
     """
 
     # Developer-manual doc registration. Discovered by AST scan at doc
@@ -242,7 +270,8 @@ class ElfLoader(gvsoc.systree.Component):
     def __init__(self, parent: gvsoc.systree.Component, name: str,
                  binary: str = None, binaries: list = None,
                  entry: int = None, entry_addr: int = None,
-                 fetchen_addr: int = None, fetchen_value=None):
+                 fetchen_addr: int = None, fetchen_value=None,
+                 backdoor: bool = False):
         super().__init__(parent, name)
 
         whole_binaries = []
@@ -264,6 +293,8 @@ class ElfLoader(gvsoc.systree.Component):
                 'fetchen_addr': fetchen_addr,
                 'fetchen_value': fetchen_value,
             })
+        if backdoor:
+            self.add_properties({'backdoor': True})
 
     def set_binary(self, binary: str):
         """Replace the list of binaries with a single one.
@@ -35,7 +35,7 @@ def build_case(case_name: str) -> dict:
     # replacement behaviour is fully deterministic.
     default_cache = dict(size=128, line_size=16, ways=1,
                          refill_shift=0, refill_offset=0, refill_latency=0,
-                         enabled=True)
+                         enabled=True, mshrs=1)
 
     def cache_cfg(**overrides):
         d = dict(default_cache)
@@ -101,6 +101,73 @@ def build_case(case_name: str) -> dict:
             'rules': rules,
         }
 
+    if case_name in ['hit_under_miss', 'hit_blocked']:
+        # Line B (0x40) is primed first. A miss on line A then starts a long async
+        # refill, and a read to line B arriving during that refill must hit and
+        # complete inline, without waiting for A's refill. With a single MSHR
+        # (hit_blocked), the cache is blocking and the hit must wait instead.
+        rules = [dict(addr_min=0, addr_max=0xFFFF_FFFF, behavior='granted',
+                      resp_delay=30, retry_delay=0)]
+        return {
+            'cache_config': cache_cfg(mshrs=2 if case_name == 'hit_under_miss' else 1),
+            'schedule': [
+                dict(cycle=10, addr=0x40, size=4, is_write=False, name='prime'),
+                dict(cycle=50, addr=0x00, size=4, is_write=False, name='miss'),
+                dict(cycle=55, addr=0x44, size=4, is_write=False, name='hit'),
+            ],
+            'rules': rules,
+        }
+
+    if case_name == 'miss_merge':
+        # Two misses on the same line during the same refill. The second one must
+        # be merged into the MSHR of the first: a single refill REQ reaches the
+        # target and both requests get their RESP when it lands. 2 MSHRs so that
+        # the second miss is not simply queued behind the refill.
+        rules = [dict(addr_min=0, addr_max=0xFFFF_FFFF, behavior='granted',
+                      resp_delay=30, retry_delay=0)]
+        return {
+            'cache_config': cache_cfg(mshrs=2),
+            'schedule': [
+                dict(cycle=10, addr=0x00, size=4, is_write=False, name='rA'),
+                dict(cycle=12, addr=0x04, size=4, is_write=False, name='rB'),
+            ],
+            'rules': rules,
+        }
+
+    if case_name == 'miss_under_miss':
+        # Same traffic as queue_during_refill but with 2 MSHRs: the second miss
+        # starts its own refill right away instead of waiting for the first one.
+        rules = [dict(addr_min=0, addr_max=0xFFFF_FFFF, behavior='granted',
+                      resp_delay=30, retry_delay=0)]
+        return {
+            'cache_config': cache_cfg(mshrs=2),
+            'schedule': [
+                dict(cycle=10, addr=0x00, size=4, is_write=False, name='rA'),
+                dict(cycle=12, addr=0x40, size=4, is_write=False, name='rB'),
+            ],
+            'rules': rules,
+        }
+
+    if case_name == 'victim_after_stall':
+        # Single set of 4 ways and 2 MSHRs. The third miss stalls since both MSHRs
+        # are busy, and must not step the LFSR, which picks ways 0, 1, 3, 2, 1 for
+        # the refills actually issued. The third line then goes to way 3 and the
+        # fourth one to the empty way 2, so that line B is still there at the end.
+        # Had the stalled miss stepped the LFSR, the fourth line would evict B.
+        rules = [dict(addr_min=0, addr_max=0xFFFF_FFFF, behavior='granted',
+                      resp_delay=30, retry_delay=0)]
+        return {
+            'cache_config': cache_cfg(size=64, ways=4, mshrs=2),
+            'schedule': [
+                dict(cycle=10, addr=0x00, size=4, is_write=False, name='rA'),
+                dict(cycle=12, addr=0x10, size=4, is_write=False, name='rB'),
+                dict(cycle=14, addr=0x20, size=4, is_write=False, name='rC'),
+                dict(cycle=100, addr=0x30, size=4, is_write=False, name='rD'),
+                dict(cycle=150, addr=0x14, size=4, is_write=False, name='rB2'),
+            ],
+            'rules': rules,
+        }
+
     if case_name == 'bypass_done':
         # Cache disabled at reset, target returns DONE inline. The cache should
         # forward the request addr (after refill_shift/refill_offset transform) and
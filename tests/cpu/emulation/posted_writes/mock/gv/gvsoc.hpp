@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * External IO binding between the emulated code and the emulation core.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace gv {
+
+enum Io_request_type
+{
+    Io_request_read,
+    Io_request_write
+};
+
+enum Io_request_status
+{
+    Io_request_ok,
+    Io_request_ko
+};
+
+class Io_request
+{
+public:
+    uint64_t addr = 0;
+    uint8_t *data = nullptr;
+    uint64_t size = 0;
+    int type = Io_request_read;
+    Io_request_status retval = Io_request_ko;
+};
+
+class Io_user
+{
+public:
+    virtual void reply(Io_request *req) = 0;
+};
+
+class Io_binding
+{
+public:
+    virtual void grant(Io_request *req) = 0;
+    virtual void reply(Io_request *req) = 0;
+    virtual void access(Io_request *req) = 0;
+};
+
+}
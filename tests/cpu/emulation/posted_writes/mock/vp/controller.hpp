@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Engine controller. The engine lock is not a real lock since the test is single-threaded,
+ * it only records how the emulation core takes it. Running the engine executes the
+ * callback installed by the test, which usually answers the stalled accesses.
+ */
+
+#pragma once
+
+#include <functional>
+
+namespace gv {
+
+class Client
+{
+public:
+    void run() { this->on_run(); }
+    void stop() {}
+
+    std::function<void()> on_run = []() {};
+};
+
+class Controller
+{
+public:
+    static Controller &get()
+    {
+        static Controller controller;
+        return controller;
+    }
+
+    void engine_lock()
+    {
+        if (this->locked)
+        {
+            printf("Engine locked twice\n");
+            this->nb_errors++;
+        }
+        this->locked = true;
+        this->nb_locks++;
+    }
+
+    void engine_unlock()
+    {
+        if (!this->locked)
+        {
+            printf("Engine unlocked while not locked\n");
+            this->nb_errors++;
+        }
+        this->locked = false;
+    }
+
+    Client *default_client_get() { return &this->client; }
+
+    Client client;
+    bool locked = false;
+    int nb_locks = 0;
+    int nb_errors = 0;
+};
+
+}
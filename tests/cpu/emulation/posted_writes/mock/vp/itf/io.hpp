@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * IO request and master port of the engine. The master port forwards each request to the
+ * handler installed by the test, which plays the role of the rest of the platform.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vp/vp.hpp>
+
+namespace vp {
+
+enum IoReqStatus
+{
+    IO_REQ_OK,
+    IO_REQ_INVALID,
+    IO_REQ_DENIED,
+    IO_REQ_PENDING
+};
+
+class IoReq
+{
+public:
+    void init() { *this = IoReq(); }
+    void set_addr(uint64_t addr) { this->addr = addr; }
+    void set_size(uint64_t size) { this->size = size; }
+    void set_is_write(bool is_write) { this->is_write = is_write; }
+    void set_data(uint8_t *data) { this->data = data; }
+
+    uint64_t addr = 0;
+    uint64_t size = 0;
+    bool is_write = false;
+    uint8_t *data = nullptr;
+};
+
+class IoMaster;
+
+// Called for each request sent by a master port, must return its status
+extern std::function<int(IoMaster *, IoReq *)> io_handler;
+
+class IoMaster : public Port
+{
+public:
+    void set_resp_meth(void (*meth)(Block *, IoReq *)) { this->resp_meth = meth; }
+    void set_grant_meth(void (*meth)(Block *, IoReq *)) {}
+
+    int req(IoReq *req) { return io_handler(this, req); }
+
+    // To be called by the handler to answer a request it returned IO_REQ_PENDING for
+    void resp(IoReq *req) { this->resp_meth(this->owner, req); }
+
+private:
+    void (*resp_meth)(Block *, IoReq *) = nullptr;
+};
+
+class IoSlave : public Port
+{
+};
+
+}
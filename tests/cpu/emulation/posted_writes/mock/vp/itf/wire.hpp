@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace vp {
+
+template<class T>
+class WireMaster : public Port
+{
+public:
+    void sync(T value) {}
+    void sync_back(T *value) {}
+};
+
+template<class T>
+class WireSlave : public Port
+{
+public:
+    void set_sync_meth(void (*meth)(Block *, T)) {}
+};
+
+}
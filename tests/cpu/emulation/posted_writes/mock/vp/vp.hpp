@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Subset of the engine used by the emulation core, so that it can be built on the host
+ * without the GVSoC engine.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+using std::logic_error;
+
+namespace js {
+
+class Config
+{
+public:
+    Config(int64_t value=0) : value(value) {}
+
+    Config *get(std::string name) { return &this->childs[name]; }
+    int get_child_int(std::string name) { return this->childs[name].value; }
+    bool get_bool() { return this->value != 0; }
+    void set(std::string name, int64_t value) { this->childs[name] = Config(value); }
+
+private:
+    int64_t value;
+    std::map<std::string, Config> childs;
+};
+
+}
+
+namespace vp {
+
+class Block;
+
+enum TraceLevel
+{
+    DEBUG
+};
+
+class Trace
+{
+public:
+    enum
+    {
+        LEVEL_DEBUG
+    };
+
+    void msg(int level, const char *fmt, ...) {}
+
+    void force_warning(const char *fmt, ...)
+    {
+        va_list ap;
+        va_start(ap, fmt);
+        printf("WARNING: ");
+        vprintf(fmt, ap);
+        va_end(ap);
+        nb_warnings++;
+    }
+
+    static inline int nb_warnings = 0;
+};
+
+class Traces
+{
+public:
+    void new_trace(std::string name, Trace *trace, TraceLevel level) {}
+};
+
+class Port
+{
+public:
+    Block *owner = nullptr;
+};
+
+class ComponentConf
+{
+public:
+    js::Config config;
+};
+
+class Block
+{
+public:
+    virtual ~Block() {}
+};
+
+class Component : public Block
+{
+public:
+    Component(ComponentConf &conf) : config(&conf.config) {}
+
+    virtual void reset(bool active) {}
+
+    js::Config *get_js_config() { return this->config; }
+    std::string get_path() { return "/emulation"; }
+
+    void new_slave_port(std::string name, Port *port) { port->owner = this; }
+    void new_master_port(std::string name, Port *port) { port->owner = this; }
+
+    Traces traces;
+
+private:
+    js::Config *config;
+};
+
+}
+
+#include <vp/itf/wire.hpp>
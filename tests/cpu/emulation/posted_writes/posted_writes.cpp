@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host test of the posted writes of the emulation core.
+ *
+ * The emulation core is built against a mock engine whose data port goes to a small
+ * memory. Accesses above STALL_BASE are answered asynchronously when the engine is run,
+ * and accesses above INVALID_BASE are invalid. This checks that posted writes are replied
+ * immediately, are sent in order under a single engine lock before the next access which
+ * needs an answer or when the batch is full, and that invalid and stalled accesses are
+ * handled as without batching.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "cpu/emulation/emulation.cpp"
+
+#define MEM_SIZE     0x2000
+#define STALL_BASE   0x1000
+#define INVALID_BASE 0x2000
+
+std::function<int(vp::IoMaster *, vp::IoReq *)> vp::io_handler;
+
+static int nb_errors = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); nb_errors++; } } while (0)
+
+struct Access
+{
+    uint64_t addr;
+    uint64_t size;
+    bool is_write;
+};
+
+class Bench : public gv::Io_user
+{
+public:
+    Bench(int batch_size)
+    {
+        this->conf.config.set("fetch_enable", 1);
+        this->conf.config.set("core_id", 0);
+        this->conf.config.set("cluster_id", 0);
+        this->conf.config.set("batch_size", batch_size);
+        this->core = (emulation *)gv_new(this->conf);
+        this->binding = (gv::Io_binding *)this->core->external_bind("/emulation", "", this);
+
+        memset(this->mem, 0, sizeof(this->mem));
+
+        vp::io_handler = [this](vp::IoMaster *port, vp::IoReq *req) {
+            this->accesses.push_back({ req->addr, req->size, req->is_write });
+            if (req->addr >= INVALID_BASE)
+            {
+                return (int)vp::IO_REQ_INVALID;
+            }
+            if (req->addr >= STALL_BASE)
+            {
+                this->stalled_port = port;
+                this->stalled_req = req;
+                return (int)vp::IO_REQ_PENDING;
+            }
+            this->mem_access(req);
+            return (int)vp::IO_REQ_OK;
+        };
+
+        // Running the engine is where the stalled access gets its response
+        gv::Controller::get().client.on_run = [this]() {
+            if (this->stalled_req)
+            {
+                vp::IoReq *req = this->stalled_req;
+                this->stalled_req = nullptr;
+                this->mem_access(req);
+                this->stalled_port->resp(req);
+            }
+        };
+
+        this->core->reset(true);
+        this->core->reset(false);
+    }
+
+    ~Bench()
+    {
+        delete this->core;
+        // Each core counts itself as running from its construction, only one core must be
+        // seen by the next bench so that stalling it runs the engine
+        nb_running--;
+    }
+
+    void reply(gv::Io_request *req) override
+    {
+        this->replies.push_back(req);
+    }
+
+    gv::Io_request_status access(uint64_t addr, uint64_t size, bool is_write, uint8_t *data)
+    {
+        gv::Io_request req;
+        req.addr = addr;
+        req.size = size;
+        req.type = is_write ? gv::Io_request_write : gv::Io_request_read;
+        req.data = data;
+        size_t nb_replies = this->replies.size();
+        this->binding->access(&req);
+        this->replied = this->replies.size() != nb_replies;
+        return req.retval;
+    }
+
+    gv::Io_request_status write32(uint64_t addr, uint32_t value)
+    {
+        return this->access(addr, 4, true, (uint8_t *)&value);
+    }
+
+    uint32_t read32(uint64_t addr, gv::Io_request_status *status=nullptr)
+    {
+        uint32_t value = 0;
+        gv::Io_request_status retval = this->access(addr, 4, false, (uint8_t *)&value);
+        if (status) *status = retval;
+        return value;
+    }
+
+    uint32_t mem32(uint64_t addr)
+    {
+        uint32_t value;
+        memcpy(&value, &this->mem[addr], 4);
+        return value;
+    }
+
+    // Sends a request which is neither a read nor a write, here a state synchronization
+    void sync()
+    {
+        gv::Io_request req;
+        req.type = 2;
+        this->binding->access(&req);
+    }
+
+    int nb_locks()
+    {
+        return gv::Controller::get().nb_locks;
+    }
+
+    std::vector<Access> accesses;
+    std::vector<gv::Io_request *> replies;
+    bool replied;
+    uint8_t mem[MEM_SIZE];
+
+private:
+    void mem_access(vp::IoReq *req)
+    {
+        if (req->is_write)
+        {
+            memcpy(&this->mem[req->addr], req->data, req->size);
+        }
+        else
+        {
+            memcpy(req->data, &this->mem[req->addr], req->size);
+        }
+    }
+
+    vp::ComponentConf conf;
+    emulation *core;
+    gv::Io_binding *binding;
+    vp::IoMaster *stalled_port = nullptr;
+    vp::IoReq *stalled_req = nullptr;
+};
+
+// Without batching, each write goes to the simulator before being replied
+static void test_unbatched()
+{
+    Bench bench(1);
+    int nb_locks = bench.nb_locks();
+
+    CHECK(bench.write32(0x10, 0x11111111) == gv::Io_request_ok);
+    CHECK(bench.replied);
+    CHECK(bench.accesses.size() == 1);
+    CHECK(bench.mem32(0x10) == 0x11111111);
+    CHECK(bench.nb_locks() == nb_locks + 1);
+}
+
+// Writes are replied immediately and sent in order when the batch is full
+static void test_batch_full()
+{
+    Bench bench(4);
+    int nb_locks = bench.nb_locks();
+
+    for (int i = 0; i < 3; i++)
+    {
+        // The data must be copied since the emulated code can reuse its buffer after the reply
+        uint32_t value = 0x100 + i;
+        CHECK(bench.access(0x20 + i * 4, 4, true, (uint8_t *)&value) == gv::Io_request_ok);
+        value = 0xdeadbeef;
+        CHECK(bench.replied);
+    }
+    CHECK(bench.accesses.size() == 0);
+    CHECK(bench.nb_locks() == nb_locks);
+
+    CHECK(bench.write32(0x2c, 0x103) == gv::Io_request_ok);
+    CHECK(bench.accesses.size() == 4);
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK(bench.accesses[i].addr == (uint64_t)(0x20 + i * 4));
+        CHECK(bench.accesses[i].is_write);
+        CHECK(bench.mem32(0x20 + i * 4) == (uint32_t)(0x100 + i));
+    }
+    CHECK(bench.nb_locks() == nb_locks + 1);
+}
+
+// A read first sends the posted writes, under the same engine lock, and sees their data
+static void test_read_flushes()
+{
+    Bench bench(8);
+    int nb_locks = bench.nb_locks();
+
+    bench.write32(0x40, 1);
+    bench.write32(0x40, 2);
+    gv::Io_request_status status;
+    CHECK(bench.read32(0x40, &status) == 2);
+    CHECK(status == gv::Io_request_ok);
+    CHECK(bench.replied);
+    CHECK(bench.accesses.size() == 3);
+    CHECK(!bench.accesses[2].is_write);
+    CHECK(bench.nb_locks() == nb_locks + 1);
+}
+
+// Writes too big to be posted are sent right away, after the posted ones
+static void test_big_write()
+{
+    Bench bench(8);
+
+    bench.write32(0x80, 0x55);
+    uint8_t data[MAX_POSTED_SIZE + 4];
+    memset(data, 0xaa, sizeof(data));
+    CHECK(bench.access(0x100, sizeof(data), true, data) == gv::Io_request_ok);
+    CHECK(bench.accesses.size() == 2);
+    CHECK(bench.accesses[0].addr == 0x80);
+    CHECK(bench.accesses[1].size == sizeof(data));
+    CHECK(bench.mem[0x100 + MAX_POSTED_SIZE] == 0xaa);
+}
+
+// Any other request, which may wait for another core to see the writes, sends them first
+static void test_other_request_flushes()
+{
+    Bench bench(8);
+
+    bench.write32(0x60, 0x66);
+    bench.sync();
+    CHECK(bench.accesses.size() == 1);
+    CHECK(bench.mem32(0x60) == 0x66);
+}
+
+// An invalid posted write can only be reported as a warning, an invalid read is still
+// replied with an error
+static void test_invalid()
+{
+    Bench bench(8);
+    int nb_warnings = vp::Trace::nb_warnings;
+
+    CHECK(bench.write32(INVALID_BASE, 1) == gv::Io_request_ok);
+    bench.write32(0x70, 0x77);
+    gv::Io_request_status status;
+    bench.read32(INVALID_BASE + 4, &status);
+    CHECK(status == gv::Io_request_ko);
+    CHECK(bench.replied);
+    CHECK(bench.mem32(0x70) == 0x77);
+    CHECK(vp::Trace::nb_warnings == nb_warnings + 1);
+}
+
+// A stalled posted write is completed before the next access. A stalled access which
+// needs an answer is not replied, as without batching, but its data is there on return.
+static void test_stalled()
+{
+    Bench bench(8);
+
+    bench.write32(STALL_BASE, 0x12345678);
+    bench.write32(0x90, 0x99);
+    CHECK(bench.read32(STALL_BASE) == 0x12345678);
+    CHECK(!bench.replied);
+    CHECK(bench.accesses.size() == 3);
+    CHECK(bench.mem32(0x90) == 0x99);
+    CHECK(gv::Controller::get().locked == false);
+}
+
+int main()
+{
+    test_unbatched();
+    test_batch_full();
+    test_read_flushes();
+    test_big_write();
+    test_other_request_flushes();
+    test_invalid();
+    test_stalled();
+
+    nb_errors += gv::Controller::get().nb_errors;
+
+    if (nb_errors)
+    {
+        printf("FAILED (%d errors)\n", nb_errors);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2020 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Stress test of the emulation core handoff primitives.
+ *
+ * Each emulated core is modelled by a pair of threads: the core thread sends requests and
+ * the simulator thread answers them. Every pair runs the same request/response sequence
+ * three times:
+ *   - mutex + condition variable handoff, as the emulation core used to do,
+ *   - SPSC rings with spin-then-park waiting, one request answered at a time,
+ *   - SPSC rings with batches of posted requests, only the last one being waited for.
+ * Each answer must carry the request sequence number plus one, and the final checksums
+ * must match. The rate of each mode is printed, but it only measures the primitives on a
+ * synthetic exchange, not the emulation core going through the engine, so it says nothing
+ * about the speed of an emulated platform.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "cpu/emulation/spsc_ring.hpp"
+
+#define BATCH 16
+
+static int nb_errors = 0;
+
+// Baseline: one request at a time through a mutex and a condition variable
+struct LockedChannel
+{
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool has_req = false;
+    bool has_resp = false;
+    uint64_t value;
+};
+
+static uint64_t run_locked(int iterations)
+{
+    LockedChannel chan;
+    uint64_t checksum = 0;
+
+    std::thread simulator([&]() {
+        for (int i = 0; i < iterations; i++)
+        {
+            std::unique_lock<std::mutex> lock(chan.mutex);
+            chan.cond.wait(lock, [&]() { return chan.has_req; });
+            chan.has_req = false;
+            chan.value++;
+            chan.has_resp = true;
+            chan.cond.notify_all();
+        }
+    });
+
+    for (int i = 0; i < iterations; i++)
+    {
+        std::unique_lock<std::mutex> lock(chan.mutex);
+        chan.value = i;
+        chan.has_req = true;
+        chan.cond.notify_all();
+        chan.cond.wait(lock, [&]() { return chan.has_resp; });
+        chan.has_resp = false;
+        if (chan.value != (uint64_t)i + 1) nb_errors++;
+        checksum += chan.value;
+    }
+
+    simulator.join();
+    return checksum;
+}
+
+struct RingChannel
+{
+    emu::SpscRing<uint64_t, 64> requests;
+    emu::SpscRing<uint64_t, 64> responses;
+    emu::Parker req_parker;
+    emu::Parker resp_parker;
+};
+
+static void ring_simulator(RingChannel &chan, int iterations)
+{
+    for (int i = 0; i < iterations; i++)
+    {
+        uint64_t value;
+        chan.req_parker.wait([&]() { return chan.requests.pop(value); });
+        while (!chan.responses.push(value + 1))
+        {
+            emu::cpu_relax();
+        }
+        chan.resp_parker.wake();
+    }
+}
+
+// One request at a time through the rings
+static uint64_t run_ring(int iterations)
+{
+    RingChannel chan;
+    uint64_t checksum = 0;
+
+    std::thread simulator(ring_simulator, std::ref(chan), iterations);
+
+    for (int i = 0; i < iterations; i++)
+    {
+        chan.requests.push(i);
+        chan.req_parker.wake();
+        uint64_t value;
+        chan.resp_parker.wait([&]() { return chan.responses.pop(value); });
+        if (value != (uint64_t)i + 1) nb_errors++;
+        checksum += value;
+    }
+
+    simulator.join();
+    return checksum;
+}
+
+// Requests are posted by batches and only the responses of a full batch are waited for
+static uint64_t run_ring_batched(int iterations)
+{
+    RingChannel chan;
+    uint64_t checksum = 0;
+
+    std::thread simulator(ring_simulator, std::ref(chan), iterations);
+
+    for (int i = 0; i < iterations; i += BATCH)
+    {
+        int count = std::min(BATCH, iterations - i);
+        for (int j = 0; j < count; j++)
+        {
+            chan.requests.push(i + j);
+        }
+        chan.req_parker.wake();
+
+        for (int j = 0; j < count; j++)
+        {
+            uint64_t value;
+            chan.resp_parker.wait([&]() { return chan.responses.pop(value); });
+            if (value != (uint64_t)(i + j) + 1) nb_errors++;
+            checksum += value;
+        }
+    }
+
+    simulator.join();
+    return checksum;
+}
+
+static void run_mode(const char *name, uint64_t (*mode)(int), int nb_cores, int iterations)
+{
+    std::vector<std::thread> cores;
+    std::vector<uint64_t> checksums(nb_cores);
+    uint64_t expected = (uint64_t)iterations * (iterations + 1) / 2;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nb_cores; i++)
+    {
+        cores.emplace_back([&, i]() { checksums[i] = mode(iterations); });
+    }
+    for (auto &core : cores)
+    {
+        core.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (int i = 0; i < nb_cores; i++)
+    {
+        if (checksums[i] != expected)
+        {
+            printf("%s: core %d checksum mismatch (got %lu, expected %lu)\n", name, i,
+                checksums[i], expected);
+            nb_errors++;
+        }
+    }
+
+    printf("%-12s %10.0f requests/s (%d cores, %.3f s)\n", name,
+        (double)nb_cores * iterations / elapsed, nb_cores, elapsed);
+}
+
+int main(int argc, char **argv)
+{
+    int nb_threads = argc > 1 ? atoi(argv[1]) : 16;
+    int iterations = argc > 2 ? atoi(argv[2]) : 200000;
+    int nb_cores = std::max(nb_threads / 2, 1);
+
+    run_mode("locked", run_locked, nb_cores, iterations);
+    run_mode("ring", run_ring, nb_cores, iterations);
+    run_mode("ring_batch", run_ring_batched, nb_cores, iterations);
+
+    if (nb_errors)
+    {
+        printf("FAILED (%d errors)\n", nb_errors);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Micro-benchmark of the ISS decoding tree walk.
+ *
+ * The tree dumped by gen_tree.py is walked once by scanning the sub-items of each group,
+ * as Decode::decode_opcode_group did, and once through the dispatch tables generated by
+ * isa_gen. Both walks must select the same instruction for every opcode.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+typedef struct bench_item_s bench_item_t;
+
+struct bench_item_s
+{
+    bool is_insn;
+    bool is_active;
+    bool opcode_others;
+    uint64_t opcode;
+    int bit;
+    int width;
+    int nb_groups;
+    bench_item_t **groups;
+    bench_item_t **table;
+    int insn_id;
+};
+
+typedef struct
+{
+    uint64_t mask;
+    uint64_t value;
+    int len;
+    int insn_id;
+} bench_encoding_t;
+
+#include "decode_tree.h"
+
+
+static int decode_scan(bench_item_t *item, uint64_t opcode)
+{
+    while (!item->is_insn)
+    {
+        uint64_t group_opcode = (opcode >> item->bit) & ((1ULL << item->width) - 1);
+        bench_item_t *group_item_other = NULL;
+        bench_item_t *next = NULL;
+
+        for (int i = 0; i < item->nb_groups; i++)
+        {
+            bench_item_t *group_item = item->groups[i];
+            if (group_opcode == group_item->opcode && !group_item->opcode_others)
+            {
+                next = group_item;
+                break;
+            }
+            if (group_item->opcode_others)
+                group_item_other = group_item;
+        }
+
+        if (next == NULL)
+            next = group_item_other;
+        if (next == NULL)
+            return -1;
+        item = next;
+    }
+
+    return item->is_active ? item->insn_id : -1;
+}
+
+static int decode_table(bench_item_t *item, uint64_t opcode)
+{
+    while (!item->is_insn)
+    {
+        uint64_t group_opcode = (opcode >> item->bit) & ((1ULL << item->width) - 1);
+
+        if (item->table)
+        {
+            item = item->table[group_opcode];
+            if (item == NULL)
+                return -1;
+        }
+        else
+        {
+            bench_item_t *group_item_other = NULL;
+            bench_item_t *next = NULL;
+
+            for (int i = 0; i < item->nb_groups; i++)
+            {
+                bench_item_t *group_item = item->groups[i];
+                if (group_opcode == group_item->opcode && !group_item->opcode_others)
+                {
+                    next = group_item;
+                    break;
+                }
+                if (group_item->opcode_others)
+                    group_item_other = group_item;
+            }
+
+            if (next == NULL)
+                next = group_item_other;
+            if (next == NULL)
+                return -1;
+            item = next;
+        }
+    }
+
+    return item->is_active ? item->insn_id : -1;
+}
+
+static uint64_t rand_state = 0x2545f4914f6cdd1dULL;
+
+static uint64_t rand64()
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+    return rand_state;
+}
+
+template<typename F>
+static double bench(const std::vector<uint64_t> &opcodes, int iterations, F decode, int64_t *checksum)
+{
+    auto start = std::chrono::steady_clock::now();
+    int64_t sum = 0;
+    for (int it = 0; it < iterations; it++)
+    {
+        for (uint64_t opcode : opcodes)
+        {
+            sum += decode(bench_tree, opcode);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    *checksum = sum;
+    return std::chrono::duration<double, std::nano>(end - start).count() / (opcodes.size() * (double)iterations);
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 20;
+    int nb_encodings = sizeof(bench_encodings) / sizeof(bench_encodings[0]);
+    std::vector<uint64_t> opcodes;
+    int nb_errors = 0;
+
+    // Random valid instructions, plus fully random words to exercise illegal opcodes
+    for (int i = 0; i < 100000; i++)
+    {
+        uint64_t opcode;
+        if (i % 8 == 0)
+        {
+            opcode = rand64() & 0xffffffff;
+        }
+        else
+        {
+            bench_encoding_t *encoding = &bench_encodings[rand64() % nb_encodings];
+            uint64_t len_mask = encoding->len == 64 ? ~0ULL : (1ULL << encoding->len) - 1;
+            opcode = ((rand64() & ~encoding->mask) | encoding->value) & len_mask;
+        }
+        opcodes.push_back(opcode);
+
+        int scan = decode_scan(bench_tree, opcode);
+        int table = decode_table(bench_tree, opcode);
+        if (scan != table)
+        {
+            if (nb_errors < 10)
+                printf("Mismatch for opcode 0x%llx: scan %d, table %d\n", (unsigned long long)opcode, scan, table);
+            nb_errors++;
+        }
+    }
+
+    int64_t scan_checksum, table_checksum;
+    double scan_time = bench(opcodes, iterations, decode_scan, &scan_checksum);
+    double table_time = bench(opcodes, iterations, decode_table, &table_checksum);
+
+    printf("scan:  %.2f ns/opcode\n", scan_time);
+    printf("table: %.2f ns/opcode\n", table_time);
+    printf("speedup: %.2fx\n", scan_time / table_time);
+    printf("decode: %d opcodes, %d mismatches\n", (int)opcodes.size(), nb_errors + (scan_checksum != table_checksum));
+
+    return nb_errors != 0 || scan_checksum != table_checksum;
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+# Dumps the decoding tree built by isa_gen for an ISA as a standalone header, with the
+# same groups and dispatch tables as the generated decoder but without the instruction
+# descriptions, so that the tree walk can be benchmarked on the host.
+
+import argparse
+import os
+import sys
+
+parser = argparse.ArgumentParser(description='Dump an ISS decoding tree for the decoder benchmark')
+parser.add_argument("--isa", dest="isa", default="rv64imafdcv", help="ISA string")
+parser.add_argument("--output", dest="output", required=True, help="Output header")
+parser.add_argument("--models", dest="models", required=True, help="Path to the models directory")
+args = parser.parse_args()
+
+sys.path.insert(0, args.models)
+
+from cpu.iss.isa_gen.isa_riscv_gen import RiscvIsa
+from cpu.iss.isa_gen.isa_gen import DecodeTree, DecodeLeaf
+
+
+isa = RiscvIsa('bench', args.isa)
+insns = isa.get_insns()
+insn_ids = {insn.get_full_name(): index for index, insn in enumerate(insns)}
+
+
+def gen(out, node):
+    if isinstance(node, DecodeLeaf):
+        name = node.get_name()
+        out.write(f'static bench_item_t {name} = {{ true, {1 if node.instr.active else 0}, '
+            f'{1 if node.others else 0}, 0b{node.opcode}, 0, 0, 0, NULL, NULL, {insn_ids[name]} }};\n')
+        return
+
+    if not node.needTree:
+        gen(out, list(node.subtrees.values())[0])
+        return
+
+    for subtree in node.subtrees.values():
+        gen(out, subtree)
+
+    name = node.get_name()
+    out.write(f'static bench_item_t *{name}_groups[] = {{')
+    for subtree in node.subtrees.values():
+        out.write(f' &{subtree.get_name()},')
+    out.write(' };\n')
+
+    table = node.get_table()
+    if table is not None:
+        out.write(f'static bench_item_t *{name}_table[] = {{')
+        for subtree in table:
+            out.write(' NULL,' if subtree is None else f' &{subtree.get_name()},')
+        out.write(' };\n')
+
+    out.write(f'static bench_item_t {name} = {{ false, false, false, 0b{node.opcode}, '
+        f'{node.firstBit}, {node.opcode_width}, {len(node.subtrees)}, {name}_groups, '
+        f'{"NULL" if table is None else name + "_table"}, -1 }};\n')
+
+
+with open(args.output, 'w') as out:
+    tree = DecodeTree(isa, insns)
+
+    out.write('#pragma once\n\n')
+    gen(out, tree)
+    out.write(f'\nstatic bench_item_t *bench_tree = &{tree.get_name()};\n\n')
+
+    # Fixed bits of each active instruction, used to draw random valid opcodes
+    out.write('static bench_encoding_t bench_encodings[] = {\n')
+    for insn in insns:
+        if not insn.active:
+            continue
+        mask = 0
+        value = 0
+        for bit in range(0, insn.len):
+            if insn.encoding[bit] in ['0', '1']:
+                mask |= 1 << bit
+                if insn.encoding[bit] == '1':
+                    value |= 1 << bit
+        out.write(f'    {{ 0x{mask:x}ULL, 0x{value:x}ULL, {insn.len}, {insn_ids[insn.get_full_name()]} }},\n')
+    out.write('};\n')
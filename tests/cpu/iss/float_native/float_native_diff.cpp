@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2020 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Differential fuzzer of the native float library against the softfloat one.
+ *
+ * Every operation of the native library is executed with random operands and rounding
+ * modes, once with each library, and the results and the accumulated fflags must be bit
+ * exact. Operands are biased towards the cases where the host FPU and RISC-V can differ:
+ * zeros, infinities, quiet and signaling NaNs, subnormals, values around the overflow and
+ * underflow thresholds, and products cancelling the addend. The throughput of both
+ * libraries on normal operands is reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+
+#include "float_ops.hpp"
+
+// fflags bit of inexact
+static const uint32_t FFLAG_INEXACT = 0x1;
+
+static int nb_errors = 0;
+
+static uint64_t rand_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t rand64()
+{
+    // xorshift64*
+    rand_state ^= rand_state >> 12;
+    rand_state ^= rand_state << 25;
+    rand_state ^= rand_state >> 27;
+    return rand_state * 0x2545F4914F6CDD1DULL;
+}
+
+template<int EXP_BITS, int FRAC_BITS>
+static uint64_t rand_operand()
+{
+    const uint64_t exp_max = (1ULL << EXP_BITS) - 1;
+    const uint64_t bias = exp_max >> 1;
+    const uint64_t frac_mask = (1ULL << FRAC_BITS) - 1;
+    uint64_t sign = (rand64() & 1) << (EXP_BITS + FRAC_BITS);
+    uint64_t frac = rand64() & frac_mask;
+    uint64_t exp;
+
+    switch (rand64() % 12)
+    {
+        case 0: exp = 0; frac = 0; break;                                       // zero
+        case 1: exp = 0; break;                                                 // subnormal
+        case 2: exp = exp_max; frac = 0; break;                                 // infinity
+        case 3: exp = exp_max; frac |= 1ULL << (FRAC_BITS - 1); break;          // qNaN
+        case 4: exp = exp_max; frac = (frac >> 1) | 1; break;                   // sNaN
+        case 5: exp = 1 + rand64() % 4; break;                                  // smallest normals
+        case 6: exp = exp_max - 1 - rand64() % 4; break;                        // largest normals
+        case 7: exp = bias / 2 + rand64() % 4; break;                           // products underflow
+        case 8: exp = bias + bias / 2 - rand64() % 4; break;                    // products overflow
+        case 9: exp = bias + rand64() % 3 - 1; frac &= ~(frac_mask >> 4); break; // few mantissa bits
+        default: exp = rand64() % exp_max; break;                               // any finite value
+    }
+
+    return sign | (exp << FRAC_BITS) | frac;
+}
+
+static uint32_t rand_mode(Iss *iss)
+{
+    // Static modes including RMM, and the dynamic one with a random frm
+    static const uint32_t modes[] = { 0, 1, 2, 3, 4, 7 };
+    iss->csr.fcsr.frm = rand64() % 5;
+    return modes[rand64() % 6];
+}
+
+template<typename T, typename F>
+static void check(const char *name, F ref_op, F native_op, T a, T b, T c, uint32_t mode,
+    Iss &ref_iss, Iss &native_iss, int width, uint32_t fflags)
+{
+    ref_iss.csr.fcsr.fflags = fflags;
+    native_iss.csr.fcsr.fflags = fflags;
+    native_iss.csr.fcsr.frm = ref_iss.csr.fcsr.frm;
+
+    T ref = ref_op(&ref_iss, a, b, c, mode);
+    T native = native_op(&native_iss, a, b, c, mode);
+
+    if (ref != native || ref_iss.csr.fcsr.fflags != native_iss.csr.fcsr.fflags)
+    {
+        if (nb_errors++ < 20)
+        {
+            printf("%s mismatch (a: 0x%0*llx, b: 0x%0*llx, c: 0x%0*llx, mode: %d, frm: %d)\n"
+                "  softfloat: 0x%0*llx fflags 0x%x\n  native:    0x%0*llx fflags 0x%x\n",
+                name, width, (unsigned long long)a, width, (unsigned long long)b,
+                width, (unsigned long long)c, mode, ref_iss.csr.fcsr.frm,
+                width, (unsigned long long)ref, ref_iss.csr.fcsr.fflags,
+                width, (unsigned long long)native, native_iss.csr.fcsr.fflags);
+        }
+    }
+}
+
+// Directed operands, run with every rounding mode and with inexact already set so that the
+// fast path of the native library is taken
+struct Directed32
+{
+    uint32_t a, b, c;
+};
+
+struct Directed64
+{
+    uint64_t a, b, c;
+};
+
+static const Directed32 directed_32[] = {
+    // -1.5*2^-75 * 2^-76 + 2^-126: the exact result is just below the minimum normal and
+    // rounds up to it in round to nearest, which must still raise underflow
+    { 0x9a400000, 0x19800000, 0x00800000 },
+};
+
+static const Directed64 directed_64[] = {
+    // -1.5*2^-538 * 2^-538 + 2^-1022, same as above in binary64
+    { 0x9e58000000000000ULL, 0x1e50000000000000ULL, 0x0010000000000000ULL },
+};
+
+struct Op32
+{
+    const char *name;
+    float_op_32_t ref;
+    float_op_32_t native;
+};
+
+static const Op32 ops_32[] = {
+    { "fadd.s",   ref_add_32,   native_add_32 },
+    { "fsub.s",   ref_sub_32,   native_sub_32 },
+    { "fmadd.s",  ref_madd_32,  native_madd_32 },
+    { "fmsub.s",  ref_msub_32,  native_msub_32 },
+    { "fnmadd.s", ref_nmadd_32, native_nmadd_32 },
+    { "fnmsub.s", ref_nmsub_32, native_nmsub_32 },
+};
+
+template<typename T, typename F>
+static double bench(F op, const T *operands, int count)
+{
+    Iss iss = {};
+    T sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        sum += op(&iss, operands[3*i], operands[3*i+1], operands[3*i+2], 0);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // Keep the results alive
+    if (sum == 1) printf(" ");
+    return count / elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 1000000;
+    Iss ref_iss = {}, native_iss = {};
+
+    for (uint32_t mode = 0; mode < 5; mode++)
+    {
+        ref_iss.csr.fcsr.frm = mode;
+        for (const Directed32 &op : directed_32)
+        {
+            for (const Op32 &op32 : ops_32)
+            {
+                check<uint32_t>(op32.name, op32.ref, op32.native, op.a, op.b, op.c, 7, ref_iss,
+                    native_iss, 8, FFLAG_INEXACT);
+            }
+        }
+        for (const Directed64 &op : directed_64)
+        {
+            check<uint64_t>("fmadd.d", ref_madd_64, native_madd_64, op.a, op.b, op.c, 7,
+                ref_iss, native_iss, 16, FFLAG_INEXACT);
+        }
+    }
+
+    for (int i = 0; i < iterations; i++)
+    {
+        for (const Op32 &op : ops_32)
+        {
+            uint32_t mode = rand_mode(&ref_iss);
+            uint32_t a = rand_operand<8, 23>();
+            uint32_t b = rand_operand<8, 23>();
+            uint32_t c = rand_operand<8, 23>();
+            // Make the addend cancel the product from time to time
+            if (rand64() % 8 == 0)
+            {
+                c = native_madd_32(&native_iss, a, b, 0, 0) ^ (rand64() % 3 == 0 ? 0x80000000 : 0);
+            }
+            // Start from random flags, inexact being already set enables the fast path of
+            // the native library
+            check<uint32_t>(op.name, op.ref, op.native, a, b, c, mode, ref_iss, native_iss, 8,
+                rand64() & 0x1F);
+        }
+
+        uint32_t mode = rand_mode(&ref_iss);
+        uint64_t a = rand_operand<11, 52>();
+        uint64_t b = rand_operand<11, 52>();
+        uint64_t c = rand_operand<11, 52>();
+        if (rand64() % 8 == 0)
+        {
+            c = native_madd_64(&native_iss, a, b, 0, 0) ^ (rand64() % 3 == 0 ? 1ULL << 63 : 0);
+        }
+        check<uint64_t>("fmadd.d", ref_madd_64, native_madd_64, a, b, c, mode, ref_iss,
+            native_iss, 16, rand64() & 0x1F);
+    }
+
+    // Throughput on normal operands with the default rounding mode, the usual case
+    const int bench_count = 1000000;
+    uint32_t *operands_32 = new uint32_t[3 * bench_count];
+    uint64_t *operands_64 = new uint64_t[3 * bench_count];
+    for (int i = 0; i < 3 * bench_count; i++)
+    {
+        operands_32[i] = (rand64() & 0x807FFFFF) | ((uint32_t)(100 + rand64() % 56) << 23);
+        operands_64[i] = (rand64() & 0x800FFFFFFFFFFFFFULL) | ((uint64_t)(1000 + rand64() % 48) << 52);
+    }
+    double ref_32 = bench<uint32_t>(ref_madd_32, operands_32, bench_count);
+    double native_32 = bench<uint32_t>(native_madd_32, operands_32, bench_count);
+    double ref_64 = bench<uint64_t>(ref_madd_64, operands_64, bench_count);
+    double native_64 = bench<uint64_t>(native_madd_64, operands_64, bench_count);
+    printf("fmadd.s: softfloat %.1f Mops/s, native %.1f Mops/s (%.2fx)\n", ref_32 / 1e6,
+        native_32 / 1e6, native_32 / ref_32);
+    printf("fmadd.d: softfloat %.1f Mops/s, native %.1f Mops/s (%.2fx)\n", ref_64 / 1e6,
+        native_64 / 1e6, native_64 / ref_64);
+    delete[] operands_32;
+    delete[] operands_64;
+
+    if (nb_errors)
+    {
+        printf("FAILED (%d errors)\n", nb_errors);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
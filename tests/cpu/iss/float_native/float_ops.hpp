@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2020 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "cpu/iss/include/iss_core.hpp"
+
+typedef uint32_t (*float_op_32_t)(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode);
+typedef uint64_t (*float_op_64_t)(Iss *iss, uint64_t a, uint64_t b, uint64_t c, uint32_t mode);
+
+#define FLOAT_OPS_DECLARE(lib) \
+    uint32_t lib##_add_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode); \
+    uint32_t lib##_sub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode); \
+    uint32_t lib##_madd_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode); \
+    uint32_t lib##_msub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode); \
+    uint32_t lib##_nmadd_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode); \
+    uint32_t lib##_nmsub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode); \
+    uint64_t lib##_madd_64(Iss *iss, uint64_t a, uint64_t b, uint64_t c, uint32_t mode);
+
+FLOAT_OPS_DECLARE(ref)
+FLOAT_OPS_DECLARE(native)
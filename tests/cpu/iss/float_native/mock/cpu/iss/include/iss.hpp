@@ -0,0 +1,3 @@
+#pragma once
+
+#include "cpu/iss/include/iss_core.hpp"
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2020 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Subset of the ISS state accessed by the float libraries and softfloat, so that they can
+ * be built on the host without the GVSoC engine.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifndef likely
+#define likely(x) __builtin_expect((x), 1)
+#define unlikely(x) __builtin_expect((x), 0)
+#endif
+
+class Iss
+{
+public:
+    struct
+    {
+        struct
+        {
+            unsigned int fflags : 5;
+            unsigned int frm : 3;
+        } fcsr;
+    } csr;
+
+    struct
+    {
+        int float_mode;
+    } core;
+};
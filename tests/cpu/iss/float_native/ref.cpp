@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2020 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Operations of the softfloat float library, built in their own unit since both libraries
+ * define the same functions.
+ */
+
+#include "cpu/iss/include/isa_lib/float_softfloat.h"
+#include "float_ops.hpp"
+
+uint32_t ref_add_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    return float_add_32(iss, a, b, mode);
+}
+
+uint32_t ref_sub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    return float_sub_32(iss, a, b, mode);
+}
+
+uint32_t ref_madd_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    return float_madd_32(iss, a, b, c, mode);
+}
+
+uint32_t ref_msub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    return float_msub_32(iss, a, b, c, mode);
+}
+
+uint32_t ref_nmadd_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    return float_nmadd_32(iss, a, b, c, mode);
+}
+
+uint32_t ref_nmsub_32(Iss *iss, uint32_t a, uint32_t b, uint32_t c, uint32_t mode)
+{
+    return float_nmsub_32(iss, a, b, c, mode);
+}
+
+uint64_t ref_madd_64(Iss *iss, uint64_t a, uint64_t b, uint64_t c, uint32_t mode)
+{
+    return float_madd_64(iss, a, b, c, mode);
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Micro-benchmark of the ISS instruction page switch.
+ *
+ * A jumpy sequence of instruction pages (main code, library calls, interrupt handlers and
+ * periodic cache flushes like fence.i) is resolved once with the hash map and per-page
+ * allocation which InsnCache::page_get used, and once with InsnPageTable. Both must return
+ * pages initialized for the same addresses.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include "cpu/iss/include/insn_page_table.hpp"
+
+#define INSN_PAGE_BITS 9
+#define INSN_PAGE_SIZE (1 << (INSN_PAGE_BITS - 1))
+
+// Number of page switches between two instruction cache flushes
+#define FLUSH_PERIOD 200000
+
+// Stands for iss_insn_t, only the fields written when the page is initialized are
+// meaningful, the rest gives the page a realistic size
+struct bench_insn_t
+{
+    void *handler;
+    void *fast_handler;
+    uint64_t addr;
+    uint8_t others[488];
+};
+
+struct BenchPage
+{
+    bench_insn_t insns[INSN_PAGE_SIZE];
+    BenchPage *next;
+};
+
+static uint64_t rand_state = 0x123456789abcdefULL;
+
+static uint64_t rand64()
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+    return rand_state;
+}
+
+static void page_init(BenchPage *page, uint64_t index)
+{
+    uint64_t addr = index << INSN_PAGE_BITS;
+    for (int i=0; i<INSN_PAGE_SIZE; i++)
+    {
+        page->insns[i].handler = NULL;
+        page->insns[i].fast_handler = NULL;
+        page->insns[i].addr = addr;
+        addr += 2;
+    }
+}
+
+// Previous InsnCache::page_get implementation
+template<typename Addr>
+class MapPages
+{
+public:
+    BenchPage *get(Addr index)
+    {
+        BenchPage *page = this->pages[index];
+        if (page != NULL)
+        {
+            return page;
+        }
+        page = new BenchPage;
+        this->pages[index] = page;
+        page_init(page, index);
+        return page;
+    }
+
+    void flush()
+    {
+        for (auto page: this->pages)
+        {
+            delete page.second;
+        }
+        this->pages.clear();
+    }
+
+private:
+    std::unordered_map<Addr, BenchPage *> pages;
+};
+
+template<typename Addr>
+class TablePages
+{
+public:
+    TablePages() : pages(sizeof(Addr) * 8 - INSN_PAGE_BITS) {}
+
+    BenchPage *get(Addr index)
+    {
+        BenchPage *page = this->pages.get(index);
+        if (page != NULL)
+        {
+            return page;
+        }
+        page = this->pages.alloc(index);
+        page_init(page, index);
+        return page;
+    }
+
+    void flush()
+    {
+        this->pages.flush();
+    }
+
+private:
+    InsnPageTable<BenchPage, Addr> pages;
+};
+
+// Build the sequence of page indexes visited by a program which mostly runs a few hot pages,
+// regularly calls library code and is sometimes interrupted
+template<typename Addr>
+static std::vector<Addr> gen_trace(int nb_switches, Addr main_base, Addr lib_base, Addr irq_base)
+{
+    std::vector<Addr> trace;
+    for (int i=0; i<nb_switches; i++)
+    {
+        int kind = rand64() % 100;
+        Addr addr;
+        if (kind < 70)
+        {
+            addr = main_base + (rand64() % 12) * (1 << INSN_PAGE_BITS);
+        }
+        else if (kind < 95)
+        {
+            addr = lib_base + (rand64() % 48) * (1 << INSN_PAGE_BITS);
+        }
+        else
+        {
+            addr = irq_base + (rand64() % 4) * (1 << INSN_PAGE_BITS);
+        }
+        trace.push_back(addr >> INSN_PAGE_BITS);
+    }
+    return trace;
+}
+
+// Check that every page returned for the trace was initialized for the right address
+template<typename Addr, typename Pages>
+static int check(const std::vector<Addr> &trace)
+{
+    Pages pages;
+    int nb_errors = 0;
+    int count = 0;
+    for (Addr index : trace)
+    {
+        BenchPage *page = pages.get(index);
+        if (page->insns[0].addr != (uint64_t)index << INSN_PAGE_BITS ||
+            page->insns[INSN_PAGE_SIZE - 1].addr != ((uint64_t)index << INSN_PAGE_BITS) + (INSN_PAGE_SIZE - 1) * 2)
+        {
+            nb_errors++;
+        }
+        if (++count == FLUSH_PERIOD)
+        {
+            pages.flush();
+            count = 0;
+        }
+    }
+    pages.flush();
+    return nb_errors;
+}
+
+// Only the lookup is timed, the page content is not accessed since this costs the same
+// for both implementations
+template<typename Addr, typename Pages>
+static double bench(const std::vector<Addr> &trace, int iterations)
+{
+    Pages pages;
+    uintptr_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++)
+    {
+        int count = 0;
+        for (Addr index : trace)
+        {
+            sum ^= (uintptr_t)pages.get(index);
+            if (++count == FLUSH_PERIOD)
+            {
+                pages.flush();
+                count = 0;
+            }
+        }
+        pages.flush();
+    }
+    auto end = std::chrono::steady_clock::now();
+    // Keep the lookups alive
+    if (sum == 1)
+    {
+        printf("\n");
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / (trace.size() * (double)iterations);
+}
+
+template<typename Addr>
+static int bench_width(const char *name, int iterations, Addr main_base, Addr lib_base, Addr irq_base)
+{
+    std::vector<Addr> trace = gen_trace<Addr>(1000000, main_base, lib_base, irq_base);
+
+    int nb_errors = check<Addr, MapPages<Addr>>(trace) + check<Addr, TablePages<Addr>>(trace);
+
+    double map_time = bench<Addr, MapPages<Addr>>(trace, iterations);
+    double table_time = bench<Addr, TablePages<Addr>>(trace, iterations);
+
+    printf("%s map:   %.2f ns/switch\n", name, map_time);
+    printf("%s table: %.2f ns/switch\n", name, table_time);
+    printf("%s speedup: %.2fx\n", name, map_time / table_time);
+    printf("%s: %d switches, %d errors\n", name, (int)trace.size(), nb_errors);
+
+    return nb_errors;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 5;
+    int errors = 0;
+
+    errors += bench_width<uint32_t>("rv32", iterations, 0x1c008000, 0x1c100000, 0x1a000000);
+    errors += bench_width<uint64_t>("rv64", iterations, 0x80000000, 0x3fc0000000ULL, 0xffffffc000001000ULL);
+
+    return errors != 0;
+}
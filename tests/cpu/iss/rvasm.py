@@ -0,0 +1,486 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+"""Minimal RISC-V assembler for the ISS testbenches.
+
+The ISS tests must not depend on a cross toolchain, so their programs are
+assembled in Python with this module and written as an ELF image which the
+regular loader copies into the simulated memory.
+
+Only what the tests need is supported: RV32/RV64 I, M, F and D, a few
+compressed instructions, CSR accesses, labels with branch/jump/la fixups and
+raw data. Instructions are emitted by calling the method of the same name
+(``p.addi('a0', 'a0', 1)``), with ``_`` instead of ``.`` in the mnemonic
+(``p.fadd_s(...)``).
+"""
+
+from __future__ import annotations
+
+import struct
+
+
+def _reg_table() -> dict:
+    regs = {f'x{i}': i for i in range(32)}
+    abi = ['zero', 'ra', 'sp', 'gp', 'tp', 't0', 't1', 't2', 's0', 's1'] + \
+        [f'a{i}' for i in range(8)] + [f's{i}' for i in range(2, 12)] + \
+        [f't{i}' for i in range(3, 7)]
+    regs.update({name: i for i, name in enumerate(abi)})
+    regs['fp'] = 8
+    return regs
+
+
+def _freg_table() -> dict:
+    regs = {f'f{i}': i for i in range(32)}
+    abi = [f'ft{i}' for i in range(8)] + ['fs0', 'fs1'] + [f'fa{i}' for i in range(8)] + \
+        [f'fs{i}' for i in range(2, 12)] + [f'ft{i}' for i in range(8, 12)]
+    regs.update({name: i for i, name in enumerate(abi)})
+    return regs
+
+
+REGS = _reg_table()
+FREGS = _freg_table()
+
+CSRS = {
+    'fflags': 0x001, 'frm': 0x002, 'fcsr': 0x003,
+    'mstatus': 0x300, 'mcycle': 0xb00, 'minstret': 0xb02, 'mhartid': 0xf14,
+}
+
+# Semi-hosting operations handled by the ISS (see Syscalls::handle_riscv_ebreak)
+SEMIHOSTING_WRITE0 = 0x4
+SEMIHOSTING_EXIT = 0x18
+SEMIHOSTING_EXIT_SUCCESS = 0x20026
+
+_OP_LOAD, _OP_LOAD_FP, _OP_IMM, _OP_AUIPC, _OP_IMM_32 = 0x03, 0x07, 0x13, 0x17, 0x1b
+_OP_STORE, _OP_STORE_FP, _OP, _OP_LUI, _OP_32 = 0x23, 0x27, 0x33, 0x37, 0x3b
+_OP_MADD, _OP_FP, _OP_BRANCH, _OP_JALR, _OP_JAL = 0x43, 0x53, 0x63, 0x67, 0x6f
+_OP_SYSTEM = 0x73
+
+# name: (opcode, funct3, funct7)
+_R_OPS = {
+    'add': (_OP, 0, 0x00), 'sub': (_OP, 0, 0x20), 'sll': (_OP, 1, 0x00),
+    'slt': (_OP, 2, 0x00), 'sltu': (_OP, 3, 0x00), 'xor': (_OP, 4, 0x00),
+    'srl': (_OP, 5, 0x00), 'sra': (_OP, 5, 0x20), 'or_': (_OP, 6, 0x00),
+    'and_': (_OP, 7, 0x00),
+    'mul': (_OP, 0, 0x01), 'mulh': (_OP, 1, 0x01), 'mulhsu': (_OP, 2, 0x01),
+    'mulhu': (_OP, 3, 0x01), 'div': (_OP, 4, 0x01), 'divu': (_OP, 5, 0x01),
+    'rem': (_OP, 6, 0x01), 'remu': (_OP, 7, 0x01),
+    'addw': (_OP_32, 0, 0x00), 'subw': (_OP_32, 0, 0x20), 'sllw': (_OP_32, 1, 0x00),
+    'srlw': (_OP_32, 5, 0x00), 'sraw': (_OP_32, 5, 0x20), 'mulw': (_OP_32, 0, 0x01),
+    'divw': (_OP_32, 4, 0x01), 'divuw': (_OP_32, 5, 0x01), 'remw': (_OP_32, 6, 0x01),
+    'remuw': (_OP_32, 7, 0x01),
+}
+
+_I_OPS = {
+    'addi': (_OP_IMM, 0), 'slti': (_OP_IMM, 2), 'sltiu': (_OP_IMM, 3),
+    'xori': (_OP_IMM, 4), 'ori': (_OP_IMM, 6), 'andi': (_OP_IMM, 7),
+    'addiw': (_OP_IMM_32, 0),
+}
+
+_SHIFT_OPS = {
+    'slli': (_OP_IMM, 1, 0x000), 'srli': (_OP_IMM, 5, 0x000), 'srai': (_OP_IMM, 5, 0x400),
+    'slliw': (_OP_IMM_32, 1, 0x000), 'srliw': (_OP_IMM_32, 5, 0x000),
+    'sraiw': (_OP_IMM_32, 5, 0x400),
+}
+
+_LOAD_OPS = {'lb': 0, 'lh': 1, 'lw': 2, 'ld': 3, 'lbu': 4, 'lhu': 5, 'lwu': 6}
+_STORE_OPS = {'sb': 0, 'sh': 1, 'sw': 2, 'sd': 3}
+_BRANCH_OPS = {'beq': 0, 'bne': 1, 'blt': 4, 'bge': 5, 'bltu': 6, 'bgeu': 7}
+
+# Floating-point operations on 2 sources: name: (funct5, funct3 or None for rm)
+_FP_R_OPS = {
+    'fadd': (0x00, None), 'fsub': (0x01, None), 'fmul': (0x02, None), 'fdiv': (0x03, None),
+    'fsgnj': (0x04, 0), 'fsgnjn': (0x04, 1), 'fsgnjx': (0x04, 2),
+    'fmin': (0x05, 0), 'fmax': (0x05, 1),
+}
+# Comparisons, writing an integer register
+_FP_CMP_OPS = {'feq': 2, 'flt': 1, 'fle': 0}
+
+_FMT = {'s': 0, 'd': 1}
+_RM_DYN = 7
+
+
+def _check_imm(value: int, bits: int, what: str):
+    if value < -(1 << (bits - 1)) or value >= (1 << (bits - 1)):
+        raise ValueError(f'{what} out of range: {value}')
+
+
+class Program:
+    """RISC-V program being assembled.
+
+    Code and data are emitted in order into one image which is loaded at
+    ``base``. Labels can be used before being defined, they are resolved by
+    :meth:`image`.
+    """
+
+    def __init__(self, base: int, xlen: int = 32):
+        self.base = base
+        self.xlen = xlen
+        self.data = bytearray()
+        self.labels = {}
+        self.fixups = []
+
+    # -- Helpers -----------------------------------------------------------------------------
+
+    def pc(self) -> int:
+        return self.base + len(self.data)
+
+    def label(self, name: str):
+        if name in self.labels:
+            raise ValueError(f'Label defined twice: {name}')
+        self.labels[name] = self.pc()
+
+    def addr(self, name: str) -> int:
+        return self.labels[name]
+
+    def align(self, alignment: int):
+        while len(self.data) % alignment:
+            # c.nop if the image is only 2-byte aligned, zeros otherwise
+            if len(self.data) % 4 == 2 and alignment >= 4:
+                self.half(0x0001)
+            else:
+                self.data.append(0)
+
+    def org(self, address: int):
+        """Move forward to address, filling with zeros."""
+        if address < self.pc():
+            raise ValueError(f'Can not move backward to 0x{address:x}')
+        self.data += bytes(address - self.pc())
+
+    def byte(self, value: int):
+        self.data += struct.pack('<B', value & 0xff)
+
+    def half(self, value: int):
+        self.data += struct.pack('<H', value & 0xffff)
+
+    def word(self, value: int):
+        self.data += struct.pack('<I', value & 0xffffffff)
+
+    def dword(self, value: int):
+        self.data += struct.pack('<Q', value & 0xffffffffffffffff)
+
+    def space(self, size: int):
+        self.data += bytes(size)
+
+    def string(self, value: str):
+        self.data += value.encode() + b'\0'
+
+    def image(self) -> bytes:
+        for fixup in self.fixups:
+            fixup()
+        self.fixups = []
+        return bytes(self.data)
+
+    def _patch(self, offset: int, value: int):
+        struct.pack_into('<I', self.data, offset, value & 0xffffffff)
+
+    def _reg(self, name) -> int:
+        return REGS[name] if isinstance(name, str) else name
+
+    def _freg(self, name) -> int:
+        return FREGS[name] if isinstance(name, str) else name
+
+    # -- Encodings ---------------------------------------------------------------------------
+
+    def _r(self, opcode, funct3, funct7, rd, rs1, rs2):
+        self.word((funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode)
+
+    def _i(self, opcode, funct3, rd, rs1, imm):
+        _check_imm(imm, 12, 'I immediate')
+        self.word(((imm & 0xfff) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode)
+
+    def _s(self, opcode, funct3, rs1, rs2, imm):
+        _check_imm(imm, 12, 'S immediate')
+        self.word((((imm >> 5) & 0x7f) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) |
+            ((imm & 0x1f) << 7) | opcode)
+
+    @staticmethod
+    def _b_enc(funct3, rs1, rs2, offset):
+        _check_imm(offset, 13, 'branch offset')
+        return (((offset >> 12) & 1) << 31) | (((offset >> 5) & 0x3f) << 25) | (rs2 << 20) | \
+            (rs1 << 15) | (funct3 << 12) | (((offset >> 1) & 0xf) << 8) | \
+            (((offset >> 11) & 1) << 7) | _OP_BRANCH
+
+    @staticmethod
+    def _j_enc(rd, offset):
+        _check_imm(offset, 21, 'jump offset')
+        return (((offset >> 20) & 1) << 31) | (((offset >> 1) & 0x3ff) << 21) | \
+            (((offset >> 11) & 1) << 20) | (((offset >> 12) & 0xff) << 12) | (rd << 7) | _OP_JAL
+
+    def __getattr__(self, name):
+        # Dispatches the table-driven mnemonics. Trailing "_" avoids python keywords (or_, and_)
+        # and "_" stands for "." in floating-point mnemonics (fadd_s).
+        if name in _R_OPS:
+            opcode, funct3, funct7 = _R_OPS[name]
+            return lambda rd, rs1, rs2: self._r(opcode, funct3, funct7, self._reg(rd),
+                self._reg(rs1), self._reg(rs2))
+
+        if name in _I_OPS:
+            opcode, funct3 = _I_OPS[name]
+            return lambda rd, rs1, imm: self._i(opcode, funct3, self._reg(rd), self._reg(rs1), imm)
+
+        if name in _SHIFT_OPS:
+            opcode, funct3, high = _SHIFT_OPS[name]
+            return lambda rd, rs1, shamt: self._i(opcode, funct3, self._reg(rd), self._reg(rs1),
+                high | shamt)
+
+        if name in _LOAD_OPS:
+            funct3 = _LOAD_OPS[name]
+            return lambda rd, offset, rs1: self._i(_OP_LOAD, funct3, self._reg(rd),
+                self._reg(rs1), offset)
+
+        if name in _STORE_OPS:
+            funct3 = _STORE_OPS[name]
+            return lambda rs2, offset, rs1: self._s(_OP_STORE, funct3, self._reg(rs1),
+                self._reg(rs2), offset)
+
+        if name in _BRANCH_OPS:
+            funct3 = _BRANCH_OPS[name]
+            return lambda rs1, rs2, target: self._branch(funct3, self._reg(rs1),
+                self._reg(rs2), target)
+
+        parts = name.split('_')
+        if len(parts) == 2 and parts[1] in _FMT:
+            op, fmt = parts[0], _FMT[parts[1]]
+            if op in _FP_R_OPS:
+                funct5, funct3 = _FP_R_OPS[op]
+                return lambda rd, rs1, rs2: self._r(_OP_FP, _RM_DYN if funct3 is None else funct3,
+                    (funct5 << 2) | fmt, self._freg(rd), self._freg(rs1), self._freg(rs2))
+            if op in _FP_CMP_OPS:
+                funct3 = _FP_CMP_OPS[op]
+                return lambda rd, rs1, rs2: self._r(_OP_FP, funct3, (0x14 << 2) | fmt,
+                    self._reg(rd), self._freg(rs1), self._freg(rs2))
+            if op == 'fsqrt':
+                return lambda rd, rs1: self._r(_OP_FP, _RM_DYN, (0x0b << 2) | fmt,
+                    self._freg(rd), self._freg(rs1), 0)
+            if op in ['fmadd', 'fmsub', 'fnmsub', 'fnmadd']:
+                opcode = _OP_MADD + 4 * ['fmadd', 'fmsub', 'fnmsub', 'fnmadd'].index(op)
+                return lambda rd, rs1, rs2, rs3: self.word((self._freg(rs3) << 27) |
+                    (fmt << 25) | (self._freg(rs2) << 20) | (self._freg(rs1) << 15) |
+                    (_RM_DYN << 12) | (self._freg(rd) << 7) | opcode)
+            if op == 'fclass':
+                return lambda rd, rs1: self._r(_OP_FP, 1, (0x1c << 2) | fmt, self._reg(rd),
+                    self._freg(rs1), 0)
+
+        raise AttributeError(name)
+
+    def _branch(self, funct3, rs1, rs2, target):
+        offset = len(self.data)
+        pc = self.pc()
+        self.word(0)
+        def fixup():
+            self._patch(offset, self._b_enc(funct3, rs1, rs2, self.labels[target] - pc))
+        self.fixups.append(fixup)
+
+    # -- Instructions not covered by the tables ----------------------------------------------
+
+    def lui(self, rd, imm20: int):
+        self.word(((imm20 & 0xfffff) << 12) | (self._reg(rd) << 7) | _OP_LUI)
+
+    def auipc(self, rd, imm20: int):
+        self.word(((imm20 & 0xfffff) << 12) | (self._reg(rd) << 7) | _OP_AUIPC)
+
+    def jal(self, rd, target: str):
+        offset = len(self.data)
+        pc = self.pc()
+        rd = self._reg(rd)
+        self.word(0)
+        self.fixups.append(lambda: self._patch(offset, self._j_enc(rd, self.labels[target] - pc)))
+
+    def jalr(self, rd, rs1, imm: int = 0):
+        self._i(_OP_JALR, 0, self._reg(rd), self._reg(rs1), imm)
+
+    def flw(self, rd, offset, rs1):
+        self._i(_OP_LOAD_FP, 2, self._freg(rd), self._reg(rs1), offset)
+
+    def fld(self, rd, offset, rs1):
+        self._i(_OP_LOAD_FP, 3, self._freg(rd), self._reg(rs1), offset)
+
+    def fsw(self, rs2, offset, rs1):
+        self._s(_OP_STORE_FP, 2, self._reg(rs1), self._freg(rs2), offset)
+
+    def fsd(self, rs2, offset, rs1):
+        self._s(_OP_STORE_FP, 3, self._reg(rs1), self._freg(rs2), offset)
+
+    def fcvt_w_s(self, rd, rs1, unsigned=False):
+        self._r(_OP_FP, _RM_DYN, 0x60, self._reg(rd), self._freg(rs1), int(unsigned))
+
+    def fcvt_w_d(self, rd, rs1, unsigned=False):
+        self._r(_OP_FP, _RM_DYN, 0x61, self._reg(rd), self._freg(rs1), int(unsigned))
+
+    def fcvt_s_w(self, rd, rs1, unsigned=False):
+        self._r(_OP_FP, _RM_DYN, 0x68, self._freg(rd), self._reg(rs1), int(unsigned))
+
+    # Conversions which are always exact take rm=0
+    def fcvt_d_w(self, rd, rs1, unsigned=False):
+        self._r(_OP_FP, 0, 0x69, self._freg(rd), self._reg(rs1), int(unsigned))
+
+    def fcvt_s_d(self, rd, rs1):
+        self._r(_OP_FP, _RM_DYN, 0x20, self._freg(rd), self._freg(rs1), 1)
+
+    def fcvt_d_s(self, rd, rs1):
+        self._r(_OP_FP, 0, 0x21, self._freg(rd), self._freg(rs1), 0)
+
+    def fmv_x_w(self, rd, rs1):
+        self._r(_OP_FP, 0, 0x70, self._reg(rd), self._freg(rs1), 0)
+
+    def fmv_w_x(self, rd, rs1):
+        self._r(_OP_FP, 0, 0x78, self._freg(rd), self._reg(rs1), 0)
+
+    def csrrw(self, rd, csr, rs1):
+        self._csr(1, rd, csr, rs1)
+
+    def csrrs(self, rd, csr, rs1):
+        self._csr(2, rd, csr, rs1)
+
+    def _csr(self, funct3, rd, csr, rs1):
+        csr = CSRS[csr] if isinstance(csr, str) else csr
+        self.word((csr << 20) | (self._reg(rs1) << 15) | (funct3 << 12) | (self._reg(rd) << 7) |
+            _OP_SYSTEM)
+
+    def ebreak(self):
+        self.word(0x00100073)
+
+    def wfi(self):
+        self.word(0x10500073)
+
+    def fence(self):
+        self.word(0x0ff0000f)
+
+    def fence_i(self):
+        self.word(0x0000100f)
+
+    # Compressed instructions, only emitted explicitly
+    def c_addi(self, rd, imm):
+        _check_imm(imm, 6, 'c.addi immediate')
+        self.half((((imm >> 5) & 1) << 12) | (self._reg(rd) << 7) | ((imm & 0x1f) << 2) | 0x1)
+
+    def c_li(self, rd, imm):
+        _check_imm(imm, 6, 'c.li immediate')
+        self.half((2 << 13) | (((imm >> 5) & 1) << 12) | (self._reg(rd) << 7) |
+            ((imm & 0x1f) << 2) | 0x1)
+
+    def c_slli(self, rd, shamt):
+        self.half((((shamt >> 5) & 1) << 12) | (self._reg(rd) << 7) | ((shamt & 0x1f) << 2) | 0x2)
+
+    def c_mv(self, rd, rs2):
+        self.half((4 << 13) | (self._reg(rd) << 7) | (self._reg(rs2) << 2) | 0x2)
+
+    def c_add(self, rd, rs2):
+        self.half((4 << 13) | (1 << 12) | (self._reg(rd) << 7) | (self._reg(rs2) << 2) | 0x2)
+
+    # -- Pseudo-instructions -----------------------------------------------------------------
+
+    def nop(self):
+        self.addi('zero', 'zero', 0)
+
+    def mv(self, rd, rs):
+        self.addi(rd, rs, 0)
+
+    def j(self, target: str):
+        self.jal('zero', target)
+
+    def call(self, target: str):
+        self.jal('ra', target)
+
+    def ret(self):
+        self.jalr('zero', 'ra', 0)
+
+    def beqz(self, rs, target):
+        self.beq(rs, 'zero', target)
+
+    def bnez(self, rs, target):
+        self.bne(rs, 'zero', target)
+
+    def csrr(self, rd, csr):
+        self.csrrs(rd, csr, 'zero')
+
+    def csrw(self, csr, rs):
+        self.csrrw('zero', csr, rs)
+
+    def li(self, rd, value: int):
+        mask = (1 << self.xlen) - 1
+        value &= mask
+        if value >> (self.xlen - 1):
+            value -= 1 << self.xlen
+
+        if -2048 <= value < 2048:
+            self.addi(rd, 'zero', value)
+        elif -(1 << 31) <= value < (1 << 31):
+            hi = (value + 0x800) >> 12
+            lo = value - (hi << 12)
+            self.lui(rd, hi)
+            if lo != 0:
+                if self.xlen == 64:
+                    self.addiw(rd, rd, lo)
+                else:
+                    self.addi(rd, rd, lo)
+        else:
+            lo = ((value & 0xfff) ^ 0x800) - 0x800
+            self.li(rd, (value - lo) >> 12)
+            self.slli(rd, rd, 12)
+            if lo != 0:
+                self.addi(rd, rd, lo)
+
+    def la(self, rd, target: str):
+        offset = len(self.data)
+        pc = self.pc()
+        rd = self._reg(rd)
+        self.word(0)
+        self.word(0)
+        def fixup():
+            delta = self.labels[target] - pc
+            hi = (delta + 0x800) >> 12
+            lo = delta - (hi << 12)
+            self._patch(offset, ((hi & 0xfffff) << 12) | (rd << 7) | _OP_AUIPC)
+            self._patch(offset + 4, ((lo & 0xfff) << 20) | (rd << 15) | (rd << 7) | _OP_IMM)
+        self.fixups.append(fixup)
+
+    def semihosting(self, op: int, arg):
+        """Semi-hosting call with a0=op and a1=arg (a register, or an immediate)."""
+        self.li('a0', op)
+        if isinstance(arg, int):
+            self.li('a1', arg)
+        else:
+            self.mv('a1', arg)
+        # The ISS only recognizes the sequence on 4-byte aligned uncompressed instructions
+        self.align(4)
+        self.slli('zero', 'zero', 0x1f)
+        self.ebreak()
+        self.srai('zero', 'zero', 7)
+
+
+def write_elf(path: str, program: Program, entry: int | None = None):
+    """Write the program as an ELF executable with one loadable segment."""
+    data = program.image()
+    is_64 = program.xlen == 64
+    entry = program.base if entry is None else entry
+
+    if is_64:
+        ehdr_size, phdr_size = 64, 56
+    else:
+        ehdr_size, phdr_size = 52, 32
+
+    e_ident = b'\x7fELF' + bytes([
+        2 if is_64 else 1,    # EI_CLASS
+        1,                    # EI_DATA = ELFDATA2LSB
+        1,                    # EI_VERSION = EV_CURRENT
+    ]) + bytes(9)
+
+    # e_type=ET_EXEC, e_machine=EM_RISCV, e_version, entry, e_phoff, e_shoff, e_flags,
+    # e_ehsize, e_phentsize, e_phnum, e_shentsize, e_shnum, e_shstrndx
+    fields = (2, 0xf3, 1, entry, ehdr_size, 0, 0, ehdr_size, phdr_size, 1, 0, 0, 0)
+    if is_64:
+        ehdr = e_ident + struct.pack('<HHIQQQIHHHHHH', *fields)
+        # p_type=PT_LOAD, p_flags=RWX, p_offset, p_vaddr, p_paddr, p_filesz, p_memsz, p_align
+        phdr = struct.pack('<IIQQQQQQ', 1, 7, ehdr_size + phdr_size, program.base,
+            program.base, len(data), len(data), 4)
+    else:
+        ehdr = e_ident + struct.pack('<HHIIIIIHHHHHH', *fields)
+        phdr = struct.pack('<IIIIIIII', 1, ehdr_size + phdr_size, program.base,
+            program.base, len(data), len(data), 7, 4)
+
+    with open(path, 'wb') as file:
+        file.write(ehdr + phdr + data)
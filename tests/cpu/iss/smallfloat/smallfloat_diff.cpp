@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2020 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Differential test of the small-float engine against flexfloat.
+ *
+ * The flexfloat functions of int.h, which now go through the engine, are compared with the
+ * generic ones, which only use flexfloat, on results and fflags. 8-bit formats are checked
+ * exhaustively for the table-driven operations, the other operations and formats with
+ * random operands biased towards zeros, infinities, NaNs, subnormals and values around the
+ * overflow and underflow thresholds. The throughput of both paths is reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+
+#define likely(x) __builtin_expect((x), 1)
+#define unlikely(x) __builtin_expect((x), 0)
+
+#define ISS_REG_WIDTH 32
+
+typedef uint32_t iss_opcode_t;
+typedef uint64_t iss_reg_t;
+typedef uint64_t iss_uim_t;
+typedef int64_t iss_sim_t;
+typedef uint64_t iss_freg_t;
+
+// Subset of the ISS state accessed by the float library
+struct Iss
+{
+    struct
+    {
+        struct
+        {
+            unsigned int fflags : 5;
+            unsigned int frm : 3;
+        } fcsr;
+    } csr;
+};
+
+static inline int64_t getSignedField(int64_t value, int shift, int width)
+{
+    return ((int64_t)value << (64 - shift - width)) >> (64 - width);
+}
+
+static inline int64_t iss_get_signed_value(int64_t value, int width)
+{
+    return getSignedField(value, 0, width);
+}
+
+#include "cpu/iss/include/isa_lib/int.h"
+
+struct Format
+{
+    const char *name;
+    uint8_t e;
+    uint8_t m;
+};
+
+static const Format formats[] = {
+    { "fp16",     5, 10 },
+    { "bf16",     8, 7  },
+    { "fp8",      5, 2  },
+    { "fp8alt",   4, 3  },
+};
+
+struct Op2
+{
+    const char *name;
+    smallfloat_generic2_t engine;
+    smallfloat_generic2_t generic;
+};
+
+static const Op2 ops_2[] = {
+    { "add", lib_flexfloat_add_round, lib_flexfloat_add_round_generic },
+    { "sub", lib_flexfloat_sub_round, lib_flexfloat_sub_round_generic },
+    { "mul", lib_flexfloat_mul_round, lib_flexfloat_mul_round_generic },
+    { "div", lib_flexfloat_div_round, lib_flexfloat_div_round_generic },
+};
+
+struct Op3
+{
+    const char *name;
+    smallfloat_generic3_t engine;
+    smallfloat_generic3_t generic;
+};
+
+static const Op3 ops_3[] = {
+    { "madd",  lib_flexfloat_madd_round,  lib_flexfloat_madd_round_generic },
+    { "msub",  lib_flexfloat_msub_round,  lib_flexfloat_msub_round_generic },
+    { "nmadd", lib_flexfloat_nmadd_round, lib_flexfloat_nmadd_round_generic },
+    { "nmsub", lib_flexfloat_nmsub_round, lib_flexfloat_nmsub_round_generic },
+};
+
+static int nb_errors = 0;
+
+static uint64_t rand_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t rand64()
+{
+    // xorshift64*
+    rand_state ^= rand_state >> 12;
+    rand_state ^= rand_state << 25;
+    rand_state ^= rand_state >> 27;
+    return rand_state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint64_t rand_operand(const Format &format)
+{
+    uint64_t exp_max = (1ULL << format.e) - 1;
+    uint64_t bias = exp_max >> 1;
+    uint64_t sign = (rand64() & 1) << (format.e + format.m);
+    uint64_t frac = rand64() & ((1ULL << format.m) - 1);
+    uint64_t exp;
+
+    switch (rand64() % 10)
+    {
+        case 0: exp = 0; frac = 0; break;                              // zero
+        case 1: exp = 0; break;                                        // subnormal
+        case 2: exp = exp_max; frac = rand64() % 2 ? 0 : frac; break;  // infinity or NaN
+        case 3: exp = 1 + rand64() % 3; break;                         // smallest normals
+        case 4: exp = exp_max - 1 - rand64() % 3; break;               // largest normals
+        case 5: exp = bias / 2 + rand64() % 3; break;                  // products underflow
+        case 6: exp = bias + bias / 2 - rand64() % 3; break;           // products overflow
+        default: exp = bias - 3 + rand64() % 7; break;                 // usual values
+    }
+
+    // Also leave garbage in the upper bits, as the packed instructions do
+    return (rand64() << (format.e + format.m + 1)) | sign | (exp << format.m) | frac;
+}
+
+// Static rounding modes, and the dynamic one with a valid frm
+static unsigned long int rand_round(Iss &iss)
+{
+    static const unsigned long int rounds[] = { 0, 1, 2, 3, 7 };
+    iss.csr.fcsr.frm = rand64() % 4;
+    return rounds[rand64() % 5];
+}
+
+static void report(const char *op, const Format &format, unsigned long int round, Iss &iss,
+    uint64_t a, uint64_t b, uint64_t c, unsigned long int engine, unsigned int engine_flags,
+    unsigned long int generic, unsigned int generic_flags)
+{
+    if (engine == generic && engine_flags == generic_flags) return;
+
+    if (nb_errors++ < 20)
+    {
+        printf("%s.%s mismatch (a: 0x%llx, b: 0x%llx, c: 0x%llx, round: %ld, frm: %d)\n"
+            "  flexfloat: 0x%lx fflags 0x%x\n  engine:    0x%lx fflags 0x%x\n",
+            op, format.name, (unsigned long long)a, (unsigned long long)b,
+            (unsigned long long)c, round, iss.csr.fcsr.frm, generic, generic_flags, engine,
+            engine_flags);
+    }
+}
+
+static void check2(const Op2 &op, const Format &format, uint64_t a, uint64_t b,
+    unsigned long int round, Iss &iss)
+{
+    // Start from random flags, they are sticky
+    unsigned int fflags = rand64() & 0x1f;
+    iss.csr.fcsr.fflags = fflags;
+    unsigned long int generic = op.generic(&iss, a, b, format.e, format.m, round);
+    unsigned int generic_flags = iss.csr.fcsr.fflags;
+    iss.csr.fcsr.fflags = fflags;
+    unsigned long int engine = op.engine(&iss, a, b, format.e, format.m, round);
+    report(op.name, format, round, iss, a, b, 0, engine, iss.csr.fcsr.fflags, generic,
+        generic_flags);
+}
+
+static void check3(const Op3 &op, const Format &format, uint64_t a, uint64_t b, uint64_t c,
+    unsigned long int round, Iss &iss)
+{
+    unsigned int fflags = rand64() & 0x1f;
+    iss.csr.fcsr.fflags = fflags;
+    unsigned long int generic = op.generic(&iss, a, b, c, format.e, format.m, round);
+    unsigned int generic_flags = iss.csr.fcsr.fflags;
+    iss.csr.fcsr.fflags = fflags;
+    unsigned long int engine = op.engine(&iss, a, b, c, format.e, format.m, round);
+    report(op.name, format, round, iss, a, b, c, engine, iss.csr.fcsr.fflags, generic,
+        generic_flags);
+}
+
+static double bench(smallfloat_generic3_t op, const uint64_t *operands, int count)
+{
+    Iss iss = {};
+    uint64_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        sum += op(&iss, operands[3*i], operands[3*i+1], operands[3*i+2], 5, 10, 7);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // Keep the results alive
+    if (sum == 1) printf(" ");
+    return count / elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 1000000;
+    Iss iss = {};
+
+    // Exhaustive check of the table-driven operations of the 8-bit formats
+    for (const Format &format : formats)
+    {
+        if (format.e + format.m != 7) continue;
+
+        for (const Op2 &op : ops_2)
+        {
+            for (unsigned long int round = 0; round < 4; round++)
+            {
+                for (uint64_t a = 0; a < 256; a++)
+                {
+                    for (uint64_t b = 0; b < 256; b++)
+                    {
+                        check2(op, format, a, b, round, iss);
+                    }
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < iterations; i++)
+    {
+        for (const Format &format : formats)
+        {
+            for (const Op2 &op : ops_2)
+            {
+                unsigned long int round = rand_round(iss);
+                check2(op, format, rand_operand(format), rand_operand(format), round, iss);
+            }
+            for (const Op3 &op : ops_3)
+            {
+                unsigned long int round = rand_round(iss);
+                check3(op, format, rand_operand(format), rand_operand(format),
+                    rand_operand(format), round, iss);
+            }
+        }
+    }
+
+    // Throughput of fp16 vfmac-like operations on usual values, with the dynamic rounding mode
+    const int bench_count = 1000000;
+    uint64_t *operands = new uint64_t[3 * bench_count];
+    for (int i = 0; i < 3 * bench_count; i++)
+    {
+        operands[i] = (rand64() & 0x83ff) | ((12 + rand64() % 6) << 10);
+    }
+    double generic = bench(lib_flexfloat_madd_round_generic, operands, bench_count);
+    double engine = bench(lib_flexfloat_madd_round, operands, bench_count);
+    printf("fp16 madd: flexfloat %.1f Mops/s, engine %.1f Mops/s (%.2fx)\n", generic / 1e6,
+        engine / 1e6, engine / generic);
+    delete[] operands;
+
+    if (nb_errors)
+    {
+        printf("FAILED (%d errors)\n", nb_errors);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
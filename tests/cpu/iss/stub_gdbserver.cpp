@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Authors: Germain Haugou (germain.haugou@gmail.com)
+//
+// Gdbserver stub replaying a fixed debug session on every core registered to it, instead of
+// serving a remote gdb. Each core is released from reset with a breakpoint set on the
+// breakpoint address, and then goes through:
+//   - first breakpoint hit: the breakpoint is removed and the core steps over it
+//   - end of step: the breakpoint is set again and the core continues
+//   - second breakpoint hit: the breakpoint is removed, a write watchpoint is set on
+//     [watchpoint, watchpoint + watchpoint_size) and the core continues
+//   - watchpoint hit: the watchpoint is removed and the core continues
+// Any other stop leaves the core halted. Cores signal stops from inside their instruction
+// handlers, so the stops are handled in the next cycle, once the pc is up to date. Each stop
+// is printed as
+//   <core>: stop<n> signal=<signal> reason=<reason> info=0x<info> pc=0x<pc>
+// and is checked against the signal and reason of its step, against the watchpoint address
+// for the watchpoint hit, and against the pc given for it in the pcs property.
+
+#include <vp/vp.hpp>
+#include <vp/gdbserver/gdbserver_engine.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+class StubGdbserver : public vp::Component, vp::Gdbserver_engine
+{
+public:
+    StubGdbserver(vp::ComponentConf &conf);
+    void reset(bool active) override;
+
+    int register_core(vp::Gdbserver_core *core) override;
+    void signal(vp::Gdbserver_core *core, int signal, std::string reason="", int info=0) override;
+    void exit(int status) override;
+
+private:
+    struct Stop {
+        vp::Gdbserver_core *core;
+        int signal;
+        std::string reason;
+        int info;
+    };
+
+    static void handler(vp::Block *__this, vp::ClockEvent *event);
+    void handle_stop(Stop &stop);
+
+    vp::Trace                 trace;
+    vp::ClockEvent            event;
+    uint64_t                  breakpoint;
+    uint64_t                  watchpoint;
+    int                       watchpoint_size;
+    std::vector<std::string>  pcs;
+    bool                      released = false;
+    std::vector<vp::Gdbserver_core *> cores;
+    // Number of stops already handled for each core, which gives its step in the session
+    std::map<vp::Gdbserver_core *, int> nb_stops;
+    std::vector<Stop>         pending_stops;
+};
+
+
+StubGdbserver::StubGdbserver(vp::ComponentConf &config)
+    : vp::Component(config),
+      event(this, &StubGdbserver::handler)
+{
+    this->traces.new_trace("trace", &this->trace, vp::DEBUG);
+
+    this->breakpoint = (uint64_t)this->get_js_config()->get_child_int("breakpoint");
+    this->watchpoint = (uint64_t)this->get_js_config()->get_child_int("watchpoint");
+    this->watchpoint_size = this->get_js_config()->get_child_int("watchpoint_size");
+
+    for (auto x : this->get_js_config()->get("pcs")->get_elems())
+    {
+        this->pcs.push_back(x->get_str());
+    }
+
+    this->new_service("gdbserver", static_cast<vp::Gdbserver_engine *>(this));
+}
+
+
+void StubGdbserver::reset(bool active)
+{
+    if (!active)
+    {
+        // Cores are halted by their reset when a gdbserver is there, release them once
+        // everything is out of reset
+        this->event.enqueue(1);
+    }
+}
+
+
+int StubGdbserver::register_core(vp::Gdbserver_core *core)
+{
+    core->gdbserver_set_id(this->cores.size());
+    this->cores.push_back(core);
+    this->nb_stops[core] = 0;
+    return 0;
+}
+
+
+void StubGdbserver::signal(vp::Gdbserver_core *core, int signal, std::string reason, int info)
+{
+    this->trace.msg(vp::Trace::LEVEL_DEBUG, "Received signal (core: %s, signal: %d)\n",
+        core->gdbserver_get_name().c_str(), signal);
+
+    this->pending_stops.push_back({core, signal, reason, info});
+    if (!this->event.is_enqueued())
+    {
+        this->event.enqueue(1);
+    }
+}
+
+
+void StubGdbserver::exit(int status)
+{
+}
+
+
+void StubGdbserver::handle_stop(Stop &stop)
+{
+    // Signal and reason of each step of the session, step 1 being the end of the stepi
+    static const struct {
+        int signal;
+        const char *reason;
+    } session[] = {
+        { vp::Gdbserver_engine::SIGNAL_TRAP, "hwbreak" },
+        { vp::Gdbserver_engine::SIGNAL_TRAP, "" },
+        { vp::Gdbserver_engine::SIGNAL_TRAP, "hwbreak" },
+        { vp::Gdbserver_engine::SIGNAL_TRAP, "watch" },
+    };
+    int nb_steps = sizeof(session) / sizeof(session[0]);
+
+    vp::Gdbserver_core *core = stop.core;
+    int step = this->nb_stops[core]++;
+
+    int nb_regs, reg_size;
+    core->gdbserver_regs_get(&nb_regs, &reg_size, NULL);
+    std::vector<uint8_t> regs(nb_regs * reg_size);
+    core->gdbserver_regs_get(NULL, NULL, regs.data());
+    uint64_t pc = 0;
+    memcpy(&pc, &regs[32 * reg_size], reg_size);
+
+    printf("%s: stop%d signal=%d reason=%s info=0x%x pc=0x%lx",
+        core->gdbserver_get_name().c_str(), step, stop.signal,
+        stop.reason.empty() ? "-" : stop.reason.c_str(), stop.info, pc);
+    if (step >= nb_steps)
+    {
+        printf(" FAILED (unexpected stop)");
+    }
+    else if (stop.signal != session[step].signal || stop.reason != session[step].reason ||
+        (step == 3 && (uint64_t)stop.info != this->watchpoint) ||
+        (step < (int)this->pcs.size() && pc != strtoull(this->pcs[step].c_str(), NULL, 0)))
+    {
+        printf(" FAILED (expected signal=%d reason=%s pc=%s)", session[step].signal,
+            session[step].reason[0] ? session[step].reason : "-",
+            step < (int)this->pcs.size() ? this->pcs[step].c_str() : "-");
+    }
+    printf("\n");
+    fflush(stdout);
+
+    switch (step)
+    {
+        case 0:
+            core->gdbserver_breakpoint_remove(this->breakpoint);
+            core->gdbserver_stepi();
+            break;
+
+        case 1:
+            core->gdbserver_breakpoint_insert(this->breakpoint);
+            core->gdbserver_cont();
+            break;
+
+        case 2:
+            core->gdbserver_breakpoint_remove(this->breakpoint);
+            core->gdbserver_watchpoint_insert(true, this->watchpoint, this->watchpoint_size);
+            core->gdbserver_cont();
+            break;
+
+        case 3:
+            core->gdbserver_watchpoint_remove(true, this->watchpoint, this->watchpoint_size);
+            core->gdbserver_cont();
+            break;
+    }
+}
+
+
+void StubGdbserver::handler(vp::Block *__this, vp::ClockEvent *event)
+{
+    StubGdbserver *_this = (StubGdbserver *)__this;
+
+    if (!_this->released)
+    {
+        _this->released = true;
+        for (vp::Gdbserver_core *core : _this->cores)
+        {
+            core->gdbserver_breakpoint_insert(_this->breakpoint);
+            core->gdbserver_cont();
+        }
+        return;
+    }
+
+    std::vector<Stop> stops;
+    stops.swap(_this->pending_stops);
+    for (Stop &stop : stops)
+    {
+        _this->handle_stop(stop);
+    }
+}
+
+
+extern "C" vp::Component *gv_new(vp::ComponentConf &config)
+{
+    return new StubGdbserver(config);
+}
@@ -0,0 +1,23 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+import gvsoc.systree
+
+
+class StubGdbserver(gvsoc.systree.Component):
+    """Gdbserver replaying a fixed session of breakpoints, steps and watchpoints on every core.
+
+    ``pcs`` gives, for each stop of the session, the pc the core must be stopped at, as an
+    hexadecimal string.
+    """
+    def __init__(self, parent: gvsoc.systree.Component, name: str, breakpoint: int,
+                 watchpoint: int, watchpoint_size: int, pcs: list):
+        super().__init__(parent, name)
+        self.add_sources(['stub_gdbserver.cpp'])
+        self.add_property('breakpoint', breakpoint)
+        self.add_property('watchpoint', watchpoint)
+        self.add_property('watchpoint_size', watchpoint_size)
+        self.add_property('pcs', pcs)
@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Authors: Germain Haugou (germain.haugou@gmail.com)
+//
+// Memory of the ISS testbenches whose data port is bound directly to it, so
+// that the syscalls of the core see it as the final port of the data path.
+// Requests inside [base, base + size) are served from its storage, the others
+// are forwarded unchanged to its output, which goes to the router of the core.
+// With dmi set, it gives direct access to its storage, through grants of at
+// most grant_size bytes, so that big buffers need many host chunks. It has no
+// debug-memory backdoor, so without dmi, the syscalls of the core have to go
+// through byte-wise debug requests.
+
+#include <vp/vp.hpp>
+#include <vp/itf/io.hpp>
+#include <utils/dmi.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+class StubMem : public vp::Component, public DmiIf
+{
+public:
+    StubMem(vp::ComponentConf &conf);
+
+    bool dmi_get(uint64_t addr, DmiGrant &grant, DmiListener *listener) override;
+
+private:
+    static vp::IoReqStatus req(vp::Block *__this, vp::IoReq *req);
+
+    vp::Trace             trace;
+    vp::IoSlave           input;
+    vp::IoMaster          out;
+    uint64_t              base;
+    uint64_t              grant_size;
+    bool                  dmi;
+    std::vector<uint8_t>  storage;
+};
+
+
+StubMem::StubMem(vp::ComponentConf &config)
+    : vp::Component(config)
+{
+    this->traces.new_trace("trace", &this->trace, vp::DEBUG);
+
+    this->base = (uint64_t)this->get_js_config()->get_child_int("base");
+    this->storage.resize((uint64_t)this->get_js_config()->get_child_int("size"));
+    this->grant_size = (uint64_t)this->get_js_config()->get_child_int("grant_size");
+    this->dmi = this->get_js_config()->get_child_bool("dmi");
+
+    this->input.set_req_meth(&StubMem::req);
+    this->new_slave_port("input", &this->input);
+    this->new_master_port("out", &this->out);
+}
+
+
+bool StubMem::dmi_get(uint64_t addr, DmiGrant &grant, DmiListener *listener)
+{
+    if (!this->dmi || addr < this->base || addr - this->base >= this->storage.size())
+    {
+        return false;
+    }
+
+    // Grants are aligned on grant_size, the whole storage if 0
+    uint64_t offset = addr - this->base;
+    uint64_t start = this->grant_size ? offset & ~(this->grant_size - 1) : 0;
+    uint64_t size = this->grant_size ? std::min(this->grant_size,
+        this->storage.size() - start) : this->storage.size();
+
+    grant.base = this->base + start;
+    grant.size = size;
+    grant.host = &this->storage[start];
+    grant.latency = 0;
+    grant.writable = true;
+    return true;
+}
+
+
+vp::IoReqStatus StubMem::req(vp::Block *__this, vp::IoReq *req)
+{
+    StubMem *_this = (StubMem *)__this;
+    uint64_t addr = req->get_addr();
+    uint64_t size = req->get_size();
+
+    if (addr < _this->base || addr - _this->base + size > _this->storage.size())
+    {
+        return _this->out.req_forward(req);
+    }
+
+    uint8_t *host = &_this->storage[addr - _this->base];
+    if (req->get_is_write())
+    {
+        memcpy(host, req->get_data(), size);
+    }
+    else
+    {
+        memcpy(req->get_data(), host, size);
+    }
+
+    return vp::IO_REQ_OK;
+}
+
+
+extern "C" vp::Component *gv_new(vp::ComponentConf &config)
+{
+    return new StubMem(config);
+}
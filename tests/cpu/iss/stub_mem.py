@@ -0,0 +1,30 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+import gvsoc.systree
+
+
+class StubMem(gvsoc.systree.Component):
+    """Memory bound directly to the data port of a core, without debug-memory backdoor.
+
+    Requests outside ``[base, base + size)`` are forwarded to ``o_OUT``. With ``dmi``, it
+    gives direct access to its storage through grants of ``grant_size`` bytes (0 for the
+    whole storage).
+    """
+    def __init__(self, parent: gvsoc.systree.Component, name: str, base: int, size: int,
+                 dmi: bool = False, grant_size: int = 0):
+        super().__init__(parent, name)
+        self.add_sources(['stub_mem.cpp'])
+        self.add_property('base', base)
+        self.add_property('size', size)
+        self.add_property('dmi', dmi)
+        self.add_property('grant_size', grant_size)
+
+    def i_INPUT(self) -> gvsoc.systree.SlaveItf:
+        return gvsoc.systree.SlaveItf(self, 'input', signature='io')
+
+    def o_OUT(self, itf: gvsoc.systree.SlaveItf):
+        self.itf_bind('out', itf, signature='io')
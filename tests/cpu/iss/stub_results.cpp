@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Authors: Germain Haugou (germain.haugou@gmail.com)
+//
+// Result sink of the ISS testbenches. Every core of the testbench sees it
+// through its own router, which maps it so that core N accesses the window
+// at offset N * 0x1000. In its window, a core writes result slots (8 bytes
+// each, up to offset 0x800), which are printed as "<core>: slot<i>=0x<value>"
+// for the checker, and are checked against the expected values given by the
+// testbench, then writes the exit register at offset 0x800. The
+// simulation is stopped once every core has exited, so that the cores of a
+// testbench run the same program side by side and their results and cycle
+// counts can be compared.
+
+#include <vp/vp.hpp>
+#include <vp/itf/io.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define STUB_RESULTS_WINDOW    0x1000
+#define STUB_RESULTS_EXIT      0x800
+
+class StubResults : public vp::Component
+{
+public:
+    StubResults(vp::ComponentConf &conf);
+
+private:
+    static vp::IoReqStatus req(vp::Block *__this, vp::IoReq *req);
+
+    vp::Trace                 trace;
+    vp::IoSlave               input;
+    std::vector<std::string>  cores;
+    std::vector<std::string>  expected;
+    int                       nb_exited = 0;
+};
+
+
+StubResults::StubResults(vp::ComponentConf &config)
+    : vp::Component(config)
+{
+    this->traces.new_trace("trace", &this->trace, vp::DEBUG);
+
+    for (auto x : this->get_js_config()->get("cores")->get_elems())
+    {
+        this->cores.push_back(x->get_str());
+    }
+
+    js::Config *expected_conf = this->get_js_config()->get("expected");
+    if (expected_conf != NULL)
+    {
+        for (auto x : expected_conf->get_elems())
+        {
+            this->expected.push_back(x->get_str());
+        }
+    }
+
+    this->input.set_req_meth(&StubResults::req);
+    this->new_slave_port("input", &this->input);
+}
+
+
+vp::IoReqStatus StubResults::req(vp::Block *__this, vp::IoReq *req)
+{
+    StubResults *_this = (StubResults *)__this;
+    uint64_t addr = req->get_addr();
+    uint64_t size = req->get_size();
+    unsigned int core = addr / STUB_RESULTS_WINDOW;
+    uint64_t offset = addr % STUB_RESULTS_WINDOW;
+
+    if (!req->get_is_write() || core >= _this->cores.size() || size > 8 ||
+        offset + size > STUB_RESULTS_WINDOW)
+    {
+        _this->trace.force_warning("Invalid access (addr: 0x%lx, size: 0x%lx, is_write: %d)\n",
+            addr, size, req->get_is_write());
+        return vp::IO_REQ_INVALID;
+    }
+
+    uint64_t value = 0;
+    memcpy(&value, req->get_data(), size);
+
+    if (offset < STUB_RESULTS_EXIT)
+    {
+        uint64_t slot = offset / 8;
+        printf("%s: slot%ld=0x%lx", _this->cores[core].c_str(), slot, value);
+        if (slot < _this->expected.size() && !_this->expected[slot].empty())
+        {
+            uint64_t expected = strtoull(_this->expected[slot].c_str(), NULL, 0);
+            if (value != expected)
+            {
+                printf(" FAILED (expected 0x%lx)", expected);
+            }
+        }
+        printf("\n");
+    }
+    else
+    {
+        printf("%s: exit cycles=%ld\n", _this->cores[core].c_str(), _this->clock.get_cycles());
+        if (++_this->nb_exited == (int)_this->cores.size())
+        {
+            _this->time.get_engine()->quit(0);
+        }
+    }
+    fflush(stdout);
+
+    return vp::IO_REQ_OK;
+}
+
+
+extern "C" vp::Component *gv_new(vp::ComponentConf &config)
+{
+    return new StubResults(config);
+}
@@ -0,0 +1,24 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+import gvsoc.systree
+
+
+class StubResults(gvsoc.systree.Component):
+    """Result sink of the ISS testbenches, with one 4KB window per core.
+
+    ``expected`` gives, for each slot, the value every core must write, as an
+    hexadecimal string, or an empty string if the slot is not checked.
+    """
+    def __init__(self, parent: gvsoc.systree.Component, name: str, cores: list,
+                 expected: list | None = None):
+        super().__init__(parent, name)
+        self.add_sources(['stub_results.cpp'])
+        self.add_property('cores', cores)
+        self.add_property('expected', expected or [])
+
+    def i_INPUT(self) -> gvsoc.systree.SlaveItf:
+        return gvsoc.systree.SlaveItf(self, 'input', signature='io')
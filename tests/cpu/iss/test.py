@@ -0,0 +1,1025 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+"""ISS testbench.
+
+Each case assembles a small program with ``rvasm`` and runs it on one or
+several riscv cores (iss v1) which only differ by their generator options.
+Every core has its own memory, router and loader, and they share the
+``stub_results`` sink, which prints the result slots written by each core,
+checks them against the values computed here, and stops the simulation once
+all cores have exited. Slot 0 holds the number of cycles the core took to run
+the measured part of the program, so the checker can compare the cores.
+A case can instead bind the data port of a core directly to a ``stub_mem``
+memory, to control how the syscalls of the core reach its buffers, or drive
+all the cores through a ``stub_gdbserver`` debug session.
+"""
+
+from __future__ import annotations
+
+import os
+
+import gvsoc.systree
+import gvsoc.runner
+import vp.clock_domain
+from cpu.iss.riscv import RiscvCommon
+from cpu.iss.isa_gen.isa_riscv_gen import RiscvIsa
+from interco.router import Router
+from memory.memory import Memory
+from utils.loader.loader import ElfLoader
+from gvrun.parameter import TargetParameter
+
+from rvasm import Program, write_elf
+from stub_gdbserver import StubGdbserver
+from stub_mem import StubMem
+from stub_results import StubResults
+
+
+RAM_BASE = 0x1000_0000
+RAM_SIZE = 0x10_0000
+RESULTS_BASE = 0x2000_0000
+RESULTS_WINDOW = 0x1000
+RESULTS_EXIT = 0x800
+# Prefix of the binary instruction traces of the trace case
+TRACE_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), 'build', 'traces'))
+
+
+class BenchProgram(Program):
+    """Program with the result and exit conventions of the testbench.
+
+    t5, t6 and s10 are reserved for the testbench code.
+    """
+
+    def __init__(self, xlen: int):
+        super().__init__(RAM_BASE, xlen)
+        # Slot 0 is the cycle count, which is compared between cores but has no expected value
+        self.expected = [None]
+        self.csrr('s10', 'mcycle')
+
+    def result(self, reg: str, expected: int | None = None):
+        slot = len(self.expected)
+        if (slot + 1) * 8 > RESULTS_EXIT:
+            raise ValueError('Too many result slots')
+        if expected is not None:
+            expected &= (1 << self.xlen) - 1
+        self.expected.append(expected)
+        self.li('t6', RESULTS_BASE + slot * 8)
+        if self.xlen == 64:
+            self.sd(reg, 0, 't6')
+        else:
+            self.sw(reg, 0, 't6')
+
+    def exit(self):
+        self.csrr('t5', 'mcycle')
+        self.sub('t5', 't5', 's10')
+        self.li('t6', RESULTS_BASE)
+        self.sw('t5', 0, 't6')
+        self.li('t6', RESULTS_BASE + RESULTS_EXIT)
+        self.sw('zero', 0, 't6')
+        self.label('__exit_loop')
+        self.wfi()
+        self.j('__exit_loop')
+
+
+class BenchCore(RiscvCommon):
+    """Riscv core whose generator options are given by the test case."""
+
+    def __init__(self, parent, name, isa, **kwargs):
+        super().__init__(parent, name, isa=isa, misa=isa.misa, riscv_exceptions=True,
+            fetch_enable=False, boot_addr=RAM_BASE, **kwargs)
+
+        self.add_c_flags([
+            "-DCONFIG_ISS_CORE=riscv",
+        ])
+
+
+# One ISA instance per ISA string, shared by all the cores using it
+_isas = {}
+
+def _get_isa(isa: str) -> RiscvIsa:
+    if _isas.get(isa) is None:
+        _isas[isa] = RiscvIsa(f'iss_bench_{isa}', isa, inc_supervisor=False)
+    return _isas[isa]
+
+
+# -----------------------------------------------------------------------------
+# Reference semantics used to compute the expected results
+# -----------------------------------------------------------------------------
+
+def _sx(value: int, bits: int) -> int:
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >> (bits - 1) else value
+
+
+def _ux(value: int, bits: int) -> int:
+    return value & ((1 << bits) - 1)
+
+
+def _div(a: int, b: int, bits: int, signed: bool, rem: bool) -> int:
+    a, b = (_sx(a, bits), _sx(b, bits)) if signed else (_ux(a, bits), _ux(b, bits))
+    if b == 0:
+        return a if rem else -1
+    if signed and a == -(1 << (bits - 1)) and b == -1:
+        return 0 if rem else a
+    q = abs(a) // abs(b)
+    if (a < 0) != (b < 0):
+        q = -q
+    return a - b * q if rem else q
+
+
+def _alu_ops(xlen: int) -> dict:
+    x = xlen
+    ops = {
+        'add': lambda a, b: a + b,
+        'sub': lambda a, b: a - b,
+        'sll': lambda a, b: a << (b & (x - 1)),
+        'slt': lambda a, b: int(_sx(a, x) < _sx(b, x)),
+        'sltu': lambda a, b: int(_ux(a, x) < _ux(b, x)),
+        'xor': lambda a, b: a ^ b,
+        'srl': lambda a, b: _ux(a, x) >> (b & (x - 1)),
+        'sra': lambda a, b: _sx(a, x) >> (b & (x - 1)),
+        'or_': lambda a, b: a | b,
+        'and_': lambda a, b: a & b,
+        'mul': lambda a, b: a * b,
+        'mulh': lambda a, b: (_sx(a, x) * _sx(b, x)) >> x,
+        'mulhsu': lambda a, b: (_sx(a, x) * _ux(b, x)) >> x,
+        'mulhu': lambda a, b: (_ux(a, x) * _ux(b, x)) >> x,
+        'div': lambda a, b: _div(a, b, x, True, False),
+        'divu': lambda a, b: _div(a, b, x, False, False),
+        'rem': lambda a, b: _div(a, b, x, True, True),
+        'remu': lambda a, b: _div(a, b, x, False, True),
+    }
+    if xlen == 64:
+        ops.update({
+            'addw': lambda a, b: _sx(a + b, 32),
+            'subw': lambda a, b: _sx(a - b, 32),
+            'sllw': lambda a, b: _sx(a << (b & 31), 32),
+            'srlw': lambda a, b: _sx(_ux(a, 32) >> (b & 31), 32),
+            'sraw': lambda a, b: _sx(_sx(a, 32) >> (b & 31), 32),
+            'mulw': lambda a, b: _sx(a * b, 32),
+            'divw': lambda a, b: _sx(_div(a, b, 32, True, False), 32),
+            'divuw': lambda a, b: _sx(_div(a, b, 32, False, False), 32),
+            'remw': lambda a, b: _sx(_div(a, b, 32, True, True), 32),
+            'remuw': lambda a, b: _sx(_div(a, b, 32, False, True), 32),
+        })
+    return ops
+
+
+# -----------------------------------------------------------------------------
+# Cases
+# -----------------------------------------------------------------------------
+
+def _program_decode(xlen: int) -> BenchProgram:
+    # Goes through every kind of base, M and compressed instruction with operands hitting
+    # sign, overflow and division corner cases, so that each of them has to be decoded to the
+    # right handler with the right operands.
+    p = BenchProgram(xlen)
+    x = xlen
+
+    pairs = [(0x12345678, 0x9abcdef1), (-7, 3), (-(1 << (x - 1)), -1), (5, 0)]
+    if xlen == 64:
+        pairs.append((0x123456789abcdef0, 0xfedcba9876543210))
+
+    for name, op in _alu_ops(xlen).items():
+        for a, b in pairs:
+            p.li('a1', a)
+            p.li('t1', b)
+            getattr(p, name)('a0', 'a1', 't1')
+            p.result('a0', op(a, b))
+
+    imm_ops = {
+        'addi': lambda a, i: a + i,
+        'slti': lambda a, i: int(_sx(a, x) < i),
+        'sltiu': lambda a, i: int(_ux(a, x) < _ux(i, x)),
+        'xori': lambda a, i: a ^ i,
+        'ori': lambda a, i: a | i,
+        'andi': lambda a, i: a & i,
+    }
+    for name, op in imm_ops.items():
+        for a, imm in [(0x12345678, -2048), (-7, 2047)]:
+            p.li('a1', a)
+            getattr(p, name)('a0', 'a1', imm)
+            p.result('a0', op(a, imm))
+
+    shift_ops = {
+        'slli': lambda a, s: a << s,
+        'srli': lambda a, s: _ux(a, x) >> s,
+        'srai': lambda a, s: _sx(a, x) >> s,
+    }
+    if xlen == 64:
+        shift_ops.update({
+            'slliw': lambda a, s: _sx(a << s, 32),
+            'srliw': lambda a, s: _sx(_ux(a, 32) >> s, 32),
+            'sraiw': lambda a, s: _sx(_sx(a, 32) >> s, 32),
+            'addiw': lambda a, s: _sx(a + s, 32),
+        })
+    for name, op in shift_ops.items():
+        for shamt in [1, 31]:
+            a = -0x12345678
+            p.li('a1', a)
+            getattr(p, name)('a0', 'a1', shamt)
+            p.result('a0', op(a, shamt))
+
+    # Loads of every width and sign from a known pattern
+    pattern = 0x8182838485868788
+    p.la('a2', 'scratch')
+    p.li('a1', pattern & ((1 << x) - 1))
+    p.sw('a1', 0, 'a2')
+    if xlen == 64:
+        p.sd('a1', 8, 'a2')
+    else:
+        p.li('a1', pattern >> 32)
+        p.sw('a1', 4, 'a2')
+        p.li('a1', pattern & 0xffffffff)
+        p.sw('a1', 8, 'a2')
+        p.li('a1', pattern >> 32)
+        p.sw('a1', 12, 'a2')
+    p.sh('a1', 16, 'a2')
+    p.sb('a1', 19, 'a2')
+    loads = {'lb': (1, True), 'lh': (2, True), 'lw': (4, True), 'lbu': (1, False),
+        'lhu': (2, False)}
+    if xlen == 64:
+        loads.update({'ld': (8, True), 'lwu': (4, False)})
+    for name, (size, signed) in loads.items():
+        getattr(p, name)('a0', 8, 'a2')
+        value = pattern & ((1 << (size * 8)) - 1)
+        p.result('a0', _sx(value, size * 8) if signed else value)
+    # Halfword and byte stores only modify their bytes
+    p.lw('a0', 16, 'a2')
+    stored = pattern >> 32 if xlen == 32 else pattern
+    p.result('a0', _sx(_ux(stored, 16) | (_ux(stored, 8) << 24), 32))
+
+    # Branches, taken and not taken
+    branches = {
+        'beq': lambda a, b: a == b, 'bne': lambda a, b: a != b,
+        'blt': lambda a, b: _sx(a, x) < _sx(b, x), 'bge': lambda a, b: _sx(a, x) >= _sx(b, x),
+        'bltu': lambda a, b: _ux(a, x) < _ux(b, x), 'bgeu': lambda a, b: _ux(a, x) >= _ux(b, x),
+    }
+    for name, cond in branches.items():
+        for index, (a, b) in enumerate([(-1, 1), (3, 3)]):
+            label = f'{name}_{index}'
+            p.li('a1', a)
+            p.li('t1', b)
+            p.li('a0', 1)
+            getattr(p, name)('a1', 't1', label)
+            p.li('a0', 0)
+            p.label(label)
+            p.result('a0', int(cond(a, b)))
+
+    # Compressed instructions, starting on a 2-byte boundary so that the following
+    # 4-byte instructions are misaligned too
+    p.li('a0', 100)
+    p.li('a1', -3)
+    p.c_addi('a0', -32)
+    p.c_add('a0', 'a1')
+    p.c_slli('a0', 3)
+    p.c_mv('a3', 'a0')
+    p.c_li('a4', 31)
+    p.add('a0', 'a3', 'a4')
+    p.result('a0', ((100 - 32 - 3) << 3) + 31)
+
+    p.exit()
+
+    p.align(8)
+    p.label('scratch')
+    p.space(32)
+
+    return p
+
+
+def _program_blocks(xlen: int) -> BenchProgram:
+    # Straight-line code, loops, calls and returns across pages, and code patched at runtime
+    # followed by fence.i, so that block execution has to follow and drop its successor links
+    # exactly like single-instruction execution does.
+    p = BenchProgram(xlen)
+
+    # Loop calling a function which sits on another page
+    p.li('s0', 0)
+    p.li('s1', 0)
+    p.li('s2', 100)
+    p.label('loop')
+    p.mv('a0', 's1')
+    p.call('far_func')
+    p.add('s0', 's0', 'a0')
+    p.addi('s1', 's1', 1)
+    p.blt('s1', 's2', 'loop')
+    p.result('s0', sum(i * 3 + 7 for i in range(100)))
+
+    # Nested loops with a data-dependent branch
+    p.li('s0', 0)
+    p.li('s1', 0)
+    p.label('outer')
+    p.li('s3', 0)
+    p.label('inner')
+    p.andi('t0', 's3', 1)
+    p.beqz('t0', 'even')
+    p.add('s0', 's0', 's3')
+    p.j('next')
+    p.label('even')
+    p.sub('s0', 's0', 's1')
+    p.label('next')
+    p.addi('s3', 's3', 1)
+    p.li('t0', 13)
+    p.blt('s3', 't0', 'inner')
+    p.addi('s1', 's1', 1)
+    p.li('t0', 9)
+    p.blt('s1', 't0', 'outer')
+    expected = 0
+    for i in range(9):
+        for j in range(13):
+            expected += j if j & 1 else -i
+    p.result('s0', expected)
+
+    # Self-modifying code: the immediate of the first instruction of patched_func is rewritten
+    # before each call
+    p.li('s0', 0)
+    p.li('s1', 0)
+    p.la('s4', 'patched_func')
+    p.label('patch_loop')
+    p.lw('t0', 0, 's4')
+    p.li('t1', 0x000fffff)
+    p.and_('t0', 't0', 't1')
+    p.slli('t1', 's1', 20)
+    p.or_('t0', 't0', 't1')
+    p.sw('t0', 0, 's4')
+    p.fence_i()
+    p.li('a0', 1000)
+    p.call('patched_func')
+    p.add('s0', 's0', 'a0')
+    p.addi('s1', 's1', 1)
+    p.li('t0', 5)
+    p.blt('s1', 't0', 'patch_loop')
+    p.result('s0', sum(1000 + i for i in range(5)))
+
+    p.exit()
+
+    p.align(4)
+    p.label('patched_func')
+    p.addi('a0', 'a0', 0)
+    p.ret()
+
+    p.org((p.pc() + 0x1000) & ~0xfff)
+    p.label('far_func')
+    p.slli('t0', 'a0', 1)
+    p.add('a0', 'a0', 't0')
+    p.addi('a0', 'a0', 7)
+    p.ret()
+
+    return p
+
+
+def _program_pages(xlen: int) -> BenchProgram:
+    # Walks a chain of functions spread over many instruction pages several times, with an
+    # instruction cache flush in the middle and an instruction crossing a page boundary, so
+    # that pages are looked up both through the page cache and through the page table.
+    p = BenchProgram(xlen)
+    nb_pages = 48
+    nb_rounds = 4
+
+    p.li('s0', 0)
+    p.li('s1', 0)
+    p.label('round')
+    p.li('a0', 0)
+    p.call('page_0')
+    p.add('s0', 's0', 'a0')
+    p.li('t0', nb_rounds // 2 - 1)
+    p.bne('s1', 't0', 'no_flush')
+    p.fence_i()
+    p.label('no_flush')
+    p.addi('s1', 's1', 1)
+    p.li('t0', nb_rounds)
+    p.blt('s1', 't0', 'round')
+    p.result('s0', nb_rounds * (sum(range(1, nb_pages + 1)) + 1))
+
+    p.exit()
+
+    # One function per page, each one jumping to the next, the last one going through an
+    # instruction which starts 2 bytes before the end of its page
+    page = (p.pc() + 0xfff) & ~0xfff
+    for index in range(nb_pages):
+        p.org(page + index * 0x1000 + 0x40 * (index % 7))
+        p.label(f'page_{index}')
+        p.addi('a0', 'a0', index + 1)
+        p.j(f'page_{index + 1}' if index != nb_pages - 1 else 'straddle')
+
+    p.org(page + nb_pages * 0x1000 - 2)
+    p.label('straddle')
+    p.addi('a0', 'a0', 1)
+    p.ret()
+
+    return p
+
+
+def _program_prefetch(xlen: int) -> BenchProgram:
+    # Loop whose body spans several prefetch lines and calls a function on another page, then
+    # a long straight-line sequence, so that a multi-line prefetch buffer keeps the loop lines
+    # and prefetches the next line of sequential code.
+    p = BenchProgram(xlen)
+    mask = (1 << xlen) - 1
+
+    p.li('s0', 0)
+    p.li('s1', 0)
+    p.li('s2', 50)
+    p.label('loop')
+    p.slli('t0', 's1', 3)
+    p.xor('t0', 't0', 's1')
+    p.add('s0', 's0', 't0')
+    p.addi('t1', 's1', 5)
+    p.mul('t1', 't1', 's1')
+    p.sub('s0', 's0', 't1')
+    p.srli('t0', 's0', 2)
+    p.add('s0', 's0', 't0')
+    p.mv('a0', 's1')
+    p.call('prefetch_func')
+    p.add('s0', 's0', 'a0')
+    p.addi('s1', 's1', 1)
+    p.blt('s1', 's2', 'loop')
+    expected = 0
+    for i in range(50):
+        expected = (expected + ((i << 3) ^ i)) & mask
+        expected = (expected - (i + 5) * i) & mask
+        expected = (expected + (expected >> 2)) & mask
+        expected = (expected + 2 * i + 1) & mask
+    p.result('s0', expected)
+
+    p.li('a0', 0)
+    for i in range(64):
+        p.addi('a0', 'a0', i + 1)
+    p.result('a0', sum(range(1, 65)))
+
+    p.exit()
+
+    p.org((p.pc() + 0x1000) & ~0xfff)
+    p.label('prefetch_func')
+    p.slli('a0', 'a0', 1)
+    p.addi('a0', 'a0', 1)
+    p.ret()
+
+    return p
+
+
+# Special binary32 and binary64 values mixed with the random operands of the float case:
+# zeros, ones, thirds (inexact), the largest normals (overflow), the smallest normals and
+# subnormals (underflow), infinities and NaNs (softfloat fallback of the native library)
+_F32_SPECIALS = [0x00000000, 0x80000000, 0x3f800000, 0xbf800000, 0x3eaaaaab, 0x7f7fffff,
+    0xff7fffff, 0x00800000, 0x80800000, 0x00000001, 0x007fffff, 0x7f800000, 0xff800000,
+    0x7fc00000, 0x7f800001]
+_F64_SPECIALS = [0x0000000000000000, 0x8000000000000000, 0x3ff0000000000000,
+    0xbff0000000000000, 0x3fd5555555555555, 0x7fefffffffffffff, 0xffefffffffffffff,
+    0x0010000000000000, 0x0000000000000001, 0x000fffffffffffff, 0x7ff0000000000000,
+    0x7ff8000000000000]
+
+
+def _float_operands(specials: list, exp_bits: int, frac_bits: int, count: int, seed: int) -> list:
+    # Deterministic operands, one special value out of 4, the others with an exponent close
+    # to the bias so that the operations mostly give normal, inexact results
+    bias = (1 << (exp_bits - 1)) - 1
+    values = []
+    state = seed
+    for index in range(count):
+        state = (state * 6364136223846793005 + 1442695040888963407) & ((1 << 64) - 1)
+        if index % 4 == 3:
+            values.append(specials[(state >> 33) % len(specials)])
+            continue
+        sign = (state >> 63) & 1
+        exp = bias - 8 + ((state >> 40) & 15)
+        frac = (state >> 3) & ((1 << frac_bits) - 1)
+        values.append((sign << (exp_bits + frac_bits)) | (exp << frac_bits) | frac)
+    return values
+
+
+def _fold(p: BenchProgram, acc: str, reg: str):
+    # acc = rotl(acc, 5) ^ reg, so that the order of the folded values matters
+    p.slli('t1', acc, 5)
+    p.srli('t2', acc, p.xlen - 5)
+    p.or_(acc, 't1', 't2')
+    p.xor(acc, acc, reg)
+
+
+def _program_float(xlen: int) -> BenchProgram:
+    # binary32 adds and fused ops and binary64 fused ops, on random and special operands,
+    # in every rounding mode. Each result and the fflags seen after each operation are folded
+    # into checksums. fflags are only cleared after each set of operands, so that operations
+    # run both with and without inexact already raised.
+    p = BenchProgram(xlen)
+    nb_f32 = 96
+    nb_f64 = 48
+
+    p.li('t0', 0x6000)
+    p.csrrs('zero', 'mstatus', 't0')
+    p.li('s3', 0)
+    p.li('s4', 0)
+    p.li('s5', 0)
+    p.li('s6', 0)
+    p.li('s9', 5)
+
+    # Fused ops whose exact result is just below the minimum normal and rounds up to it, with
+    # inexact already set: underflow must still be raised, since tininess is detected after
+    # rounding
+    p.csrw('frm', 'zero')
+    p.la('s7', 'float_directed')
+    p.li('t0', 1)
+    p.csrw('fflags', 't0')
+    p.flw('fa0', 0, 's7')
+    p.flw('fa1', 4, 's7')
+    p.flw('fa2', 8, 's7')
+    p.fmadd_s('fa3', 'fa0', 'fa1', 'fa2')
+    p.fmv_x_w('t0', 'fa3')
+    p.result('t0', 0x00800000)
+    p.csrrw('t0', 'fflags', 'zero')
+    p.result('t0', 0x3)
+    p.li('t0', 1)
+    p.csrw('fflags', 't0')
+    p.fld('fa0', 16, 's7')
+    p.fld('fa1', 24, 's7')
+    p.fld('fa2', 32, 's7')
+    p.fmadd_d('fa3', 'fa0', 'fa1', 'fa2')
+    p.fsd('fa3', 40, 's7')
+    p.lw('t0', 40, 's7')
+    p.result('t0', 0)
+    p.lw('t0', 44, 's7')
+    p.result('t0', 0x00100000)
+    p.csrrw('t0', 'fflags', 'zero')
+    p.result('t0', 0x3)
+
+    p.label('float_rm_loop')
+    p.csrw('frm', 's6')
+
+    p.la('s7', 'float_f32')
+    p.li('s8', nb_f32)
+    p.label('float_f32_loop')
+    p.flw('fa0', 0, 's7')
+    p.flw('fa1', 4, 's7')
+    p.flw('fa2', 8, 's7')
+    for op in ['fadd_s', 'fmadd_s', 'fmsub_s', 'fnmsub_s', 'fnmadd_s']:
+        if op == 'fadd_s':
+            getattr(p, op)('fa3', 'fa0', 'fa1')
+        else:
+            getattr(p, op)('fa3', 'fa0', 'fa1', 'fa2')
+        p.fmv_x_w('t0', 'fa3')
+        _fold(p, 's3', 't0')
+        p.csrr('t0', 'fflags')
+        _fold(p, 's4', 't0')
+    p.csrw('fflags', 'zero')
+    p.addi('s7', 's7', 12)
+    p.addi('s8', 's8', -1)
+    p.bnez('s8', 'float_f32_loop')
+
+    p.la('s7', 'float_f64')
+    p.li('s8', nb_f64)
+    p.label('float_f64_loop')
+    p.fld('fa0', 0, 's7')
+    p.fld('fa1', 8, 's7')
+    p.fld('fa2', 16, 's7')
+    p.fmadd_d('fa3', 'fa0', 'fa1', 'fa2')
+    p.fsd('fa3', 24, 's7')
+    p.lw('t0', 24, 's7')
+    _fold(p, 's5', 't0')
+    p.lw('t0', 28, 's7')
+    _fold(p, 's5', 't0')
+    p.csrr('t0', 'fflags')
+    _fold(p, 's4', 't0')
+    p.csrw('fflags', 'zero')
+    p.addi('s7', 's7', 32)
+    p.addi('s8', 's8', -1)
+    p.bnez('s8', 'float_f64_loop')
+
+    p.addi('s6', 's6', 1)
+    p.blt('s6', 's9', 'float_rm_loop')
+
+    # The reference is the softfloat core, so the checksums have no expected value
+    p.result('s3')
+    p.result('s5')
+    p.result('s4')
+    p.result('s6', 5)
+
+    p.exit()
+
+    p.align(8)
+    p.label('float_directed')
+    # -1.5*2^-75 * 2^-76 + 2^-126, then the same in binary64 with 2^-538 and 2^-1022
+    for value in [0x9a400000, 0x19800000, 0x00800000, 0]:
+        p.word(value)
+    for value in [0x9e58000000000000, 0x1e50000000000000, 0x0010000000000000, 0]:
+        p.dword(value)
+
+    p.label('float_f32')
+    for value in _float_operands(_F32_SPECIALS, 8, 23, nb_f32 * 3, 1):
+        p.word(value)
+    p.align(8)
+    # Each set of operands is followed by a slot receiving the result
+    p.label('float_f64')
+    operands = _float_operands(_F64_SPECIALS, 11, 52, nb_f64 * 3, 2)
+    for index in range(nb_f64):
+        for value in operands[index * 3:index * 3 + 3]:
+            p.dword(value)
+        p.dword(0)
+
+    return p
+
+
+
+# Semi-hosting operations and HTIF syscall numbers used by the syscalls case
+_SH_OPEN, _SH_CLOSE, _SH_WRITE, _SH_READ, _SH_SEEK = 0x1, 0x2, 0x5, 0x6, 0xa
+_SH_MODE_RW_TRUNC = 6
+_HTIF_UNLINKAT, _HTIF_OPENAT, _HTIF_CLOSE, _HTIF_LSEEK = 35, 56, 57, 62
+_HTIF_READ, _HTIF_WRITE, _HTIF_PREAD, _HTIF_PWRITE = 63, 64, 67, 68
+_AT_FDCWD = -100
+_O_RDWR_CREAT_TRUNC = 0x242
+
+
+def _program_syscalls(xlen: int) -> BenchProgram:
+    # Writes a pattern to a file and reads it back, through semi-hosting and through HTIF,
+    # with buffers big enough to need more host chunks than IOV_MAX, short reads and reads
+    # at the end of the file. The read buffers are filled with a sentinel, so that their
+    # checksums also catch bytes written past what was read. Each core works on its own
+    # files, named after its hart id.
+    p = BenchProgram(xlen)
+    wsize = xlen // 8
+    store = p.sw if xlen == 32 else p.sd
+    load = p.lw if xlen == 32 else p.ld
+    pattern = bytes((i * 7 + i // 251 + 3) & 0xff for i in range(20000))
+    sentinel = 0x5a
+    nb_loops = [0]
+
+    def set_args(label, args):
+        # Arguments are immediates, registers, or (label, offset) addresses
+        p.la('t3', label)
+        for index, arg in enumerate(args):
+            if isinstance(arg, tuple):
+                p.la('t4', arg[0])
+                if arg[1] != 0:
+                    p.li('t2', arg[1])
+                    p.add('t4', 't4', 't2')
+                reg = 't4'
+            elif isinstance(arg, str):
+                reg = arg
+            else:
+                p.li('t4', arg)
+                reg = 't4'
+            store(reg, index * wsize, 't3')
+
+    def semihosting(op, args):
+        set_args('sh_args', args)
+        p.la('t3', 'sh_args')
+        p.semihosting(op, 't3')
+
+    def htif(number, args):
+        # The ISS polls tohost, runs the syscall described by the magic area, writes the
+        # result in its first slot and sets fromhost
+        set_args('htif_magic', [number] + args)
+        p.la('t3', 'htif_magic')
+        p.la('t4', 'tohost')
+        store('t3', 0, 't4')
+        loop = f'htif_wait_{nb_loops[0]}'
+        nb_loops[0] += 1
+        p.la('t4', 'fromhost')
+        p.label(loop)
+        load('t2', 0, 't4')
+        p.beqz('t2', loop)
+        store('zero', 0, 't4')
+        p.la('t3', 'htif_magic')
+        load('a0', 0, 't3')
+
+    def checksum(label, size, expected):
+        loop = f'checksum_{nb_loops[0]}'
+        nb_loops[0] += 1
+        p.la('t3', label)
+        p.li('t4', size)
+        p.li('s1', 0)
+        p.label(loop)
+        p.lbu('t0', 0, 't3')
+        _fold(p, 's1', 't0')
+        p.addi('t3', 't3', 1)
+        p.addi('t4', 't4', -1)
+        p.bnez('t4', loop)
+        mask = (1 << xlen) - 1
+        value = 0
+        for byte in expected:
+            value = (((value << 5) | (value >> (xlen - 5))) & mask) ^ byte
+        p.result('s1', value)
+
+    # Name the files after the hart id
+    p.csrr('t0', 'mhartid')
+    p.addi('t0', 't0', ord('0'))
+    for label in ['sh_name', 'htif_name']:
+        p.la('t1', label)
+        p.sb('t0', 7, 't1')
+
+    # Semi-hosting. The second write and the second read do not fit in IOV_MAX chunks of
+    # the memory of the dmi core, and have to go through the copy loop.
+    semihosting(_SH_OPEN, [('sh_name', 0), _SH_MODE_RW_TRUNC, 12])
+    p.mv('s0', 'a0')
+    p.slti('t0', 's0', 0)
+    p.result('t0', 0)
+    semihosting(_SH_WRITE, ['s0', ('buf_w', 0), 1000])
+    p.result('a0', 0)
+    semihosting(_SH_WRITE, ['s0', ('buf_w', 1000), 19000])
+    p.result('a0', 0)
+    semihosting(_SH_SEEK, ['s0', 0])
+    p.result('a0', 0)
+    semihosting(_SH_READ, ['s0', ('buf_r', 0), 1000])
+    p.result('a0', 0)
+    # Short read: 19000 bytes left in the file
+    semihosting(_SH_READ, ['s0', ('buf_r', 1000), 20000])
+    p.result('a0', 1000)
+    # Short read through host chunks, then a read at the end of the file
+    semihosting(_SH_SEEK, ['s0', 19500])
+    p.result('a0', 0)
+    semihosting(_SH_READ, ['s0', ('buf_r2', 0), 800])
+    p.result('a0', 300)
+    semihosting(_SH_READ, ['s0', ('buf_r2', 500), 100])
+    p.result('a0', 100)
+    p.semihosting(_SH_CLOSE, 's0')
+    p.result('a0', 0)
+    checksum('buf_r', 21000, pattern + bytes([sentinel] * 1000))
+    checksum('buf_r2', 800, pattern[19500:] + bytes([sentinel] * 300))
+
+    # HTIF, whose path lengths include the terminating zero
+    htif(_HTIF_OPENAT, [_AT_FDCWD, ('htif_name', 0), 13, _O_RDWR_CREAT_TRUNC, 0o644])
+    p.mv('s0', 'a0')
+    p.slti('t0', 's0', 0)
+    p.result('t0', 0)
+    htif(_HTIF_WRITE, ['s0', ('buf_w', 0), 3000])
+    p.result('a0', 3000)
+    htif(_HTIF_PWRITE, ['s0', ('buf_w', 5000), 1000, 3000])
+    p.result('a0', 1000)
+    # Short positioned read: the file has 4000 bytes
+    htif(_HTIF_PREAD, ['s0', ('buf_h', 0), 2000, 3000])
+    p.result('a0', 1000)
+    htif(_HTIF_LSEEK, ['s0', 0, 0])
+    p.result('a0', 0)
+    htif(_HTIF_READ, ['s0', ('buf_h', 2000), 5000])
+    p.result('a0', 4000)
+    htif(_HTIF_READ, ['s0', ('buf_h', 7000), 100])
+    p.result('a0', 0)
+    htif(_HTIF_CLOSE, ['s0'])
+    p.result('a0', 0)
+    checksum('buf_h', 7100, pattern[5000:6000] + bytes([sentinel] * 1000) +
+        pattern[:3000] + pattern[5000:6000] + bytes([sentinel] * 1100))
+
+    # Remove both files
+    for label in ['sh_name', 'htif_name']:
+        htif(_HTIF_UNLINKAT, [_AT_FDCWD, (label, 0), 13, 0])
+        p.result('a0', 0)
+
+    p.exit()
+
+    p.label('sh_name')
+    p.string('iss_sh_0.bin')
+    p.label('htif_name')
+    p.string('iss_ht_0.bin')
+    p.align(8)
+    p.label('tohost')
+    p.dword(0)
+    p.label('fromhost')
+    p.dword(0)
+    p.label('sh_args')
+    p.space(4 * 8)
+    p.label('htif_magic')
+    p.space(8 * 8)
+    p.label('buf_w')
+    for value in pattern:
+        p.byte(value)
+    for label, size in [('buf_r', 21000), ('buf_r2', 800), ('buf_h', 7100)]:
+        p.label(label)
+        for index in range(size):
+            p.byte(sentinel)
+
+    return p
+
+
+def _program_gdb(xlen: int) -> BenchProgram:
+    # Loop with a breakpoint in the middle of its body, hit twice, once resumed with a step
+    # and once with a continue, then many iterations without breakpoints, and stores to the
+    # page of a write watchpoint before the store to the watched word itself. The results
+    # check that no instruction was skipped or executed twice around the stops.
+    p = BenchProgram(xlen)
+
+    p.li('s0', 0)
+    p.li('s1', 0)
+    p.li('s2', 200)
+    p.label('gdb_loop')
+    p.add('s0', 's0', 's1')
+    p.slli('t0', 's1', 1)
+    p.label('gdb_breakpoint')
+    p.add('s0', 's0', 't0')
+    p.addi('s1', 's1', 1)
+    p.blt('s1', 's2', 'gdb_loop')
+    p.result('s0', sum(i * 3 for i in range(200)))
+
+    # Words next to the watched one, which are on the same page but must not stop the core
+    p.la('s4', 'gdb_buffer')
+    p.li('s0', 0)
+    p.li('s1', 0)
+    p.label('gdb_fill')
+    p.slli('t0', 's1', 2)
+    p.add('t0', 't0', 's4')
+    p.sw('s1', 0, 't0')
+    p.lw('t1', 0, 't0')
+    p.add('s0', 's0', 't1')
+    p.addi('s1', 's1', 1)
+    p.li('t0', 16)
+    p.blt('s1', 't0', 'gdb_fill')
+    p.result('s0', sum(range(16)))
+
+    # The store is not done when the watchpoint stops the core, and is done once it continues
+    p.la('s5', 'gdb_watched')
+    p.li('t0', 0x1234)
+    p.label('gdb_watch_store')
+    p.sw('t0', 0, 's5')
+    p.lw('t1', 0, 's5')
+    p.result('t1', 0x1234)
+
+    p.exit()
+
+    p.align(128)
+    p.label('gdb_buffer')
+    p.space(16 * 4)
+    p.label('gdb_watched')
+    p.word(0)
+
+    return p
+
+
+def build_case(case_name: str) -> dict:
+    if case_name in ['decode_rv32', 'decode_rv64']:
+        xlen = 32 if case_name == 'decode_rv32' else 64
+        return {
+            'isa': f'rv{xlen}imc',
+            'program': _program_decode(xlen),
+            'cores': {'core': dict(timed=False)},
+        }
+
+    if case_name == 'blocks':
+        # Same untimed core, executing one instruction or blocks of instructions per clock event
+        return {
+            'isa': 'rv32imc',
+            'program': _program_blocks(32),
+            'cores': {
+                'single': dict(timed=False),
+                'blocks': dict(timed=False, insn_block_size=16),
+            },
+        }
+
+    if case_name == 'pages':
+        return {
+            'isa': 'rv32imc',
+            'program': _program_pages(32),
+            'cores': {'core': dict(timed=False)},
+        }
+
+    if case_name == 'trace':
+        # Same core, dumping its instruction trace as text or in binary format. The checker
+        # decodes the binary one and compares it to the text one.
+        return {
+            'isa': 'rv32imc',
+            'program': _program_decode(32),
+            'cores': {
+                'text': dict(timed=False),
+                'binary': dict(timed=False, insn_trace_binary=TRACE_DIR + '/'),
+            },
+        }
+
+    if case_name == 'prefetch':
+        # Same timed core with the single-line prefetcher or a 4-line prefetch buffer, fetching
+        # from a memory with some latency so that refills are visible in the cycle count
+        return {
+            'isa': 'rv32imc',
+            'program': _program_prefetch(32),
+            'mem_latency': 4,
+            'cores': {
+                'single_line': dict(timed=True),
+                'multi_line': dict(timed=True, prefetcher_nb_lines=4),
+            },
+        }
+
+    if case_name == 'float':
+        # Same core with the softfloat or the native float library. The native one must give
+        # bit-exact results and flags, and cannot change the timing.
+        return {
+            'isa': 'rv32imafdc',
+            'program': _program_float(32),
+            'cores': {
+                'softfloat': dict(timed=False, float_lib='softfloat'),
+                'native': dict(timed=False, float_lib='native'),
+            },
+        }
+
+    if case_name == 'syscalls':
+        # Same core going through semi-hosting and HTIF with its buffers in a memory giving
+        # direct access in 16-byte host chunks, in a memory with a debug-memory backdoor,
+        # syncing its semi-hosting writes, and in a memory with neither, reached byte per
+        # byte. The data port of the dmi and io cores is bound directly to their memory.
+        return {
+            'isa': 'rv32imc',
+            'program': _program_syscalls(32),
+            'stub_mems': {
+                'dmi': dict(dmi=True, grant_size=16),
+                'io': dict(),
+            },
+            'cores': {
+                'dmi': dict(timed=False, htif=True),
+                'backdoor': dict(timed=False, htif=True, syscalls_fsync=True),
+                'io': dict(timed=False, htif=True),
+            },
+        }
+
+    if case_name == 'gdb':
+        # Same untimed core, executing one instruction or blocks of instructions per clock
+        # event, driven by a gdbserver stub which stops them on breakpoints, steps and
+        # watchpoints. Both stay in fast mode outside of the step.
+        program = _program_gdb(32)
+        breakpoint = program.addr('gdb_breakpoint')
+        return {
+            'isa': 'rv32imc',
+            'program': program,
+            'gdbserver': dict(breakpoint=breakpoint, watchpoint=program.addr('gdb_watched'),
+                watchpoint_size=4, pcs=[f'0x{pc:x}' for pc in [breakpoint, breakpoint + 4,
+                breakpoint, program.addr('gdb_watch_store')]]),
+            'cores': {
+                'single': dict(timed=False),
+                'blocks': dict(timed=False, insn_block_size=16),
+            },
+        }
+
+    raise ValueError(f'Unknown case: {case_name}')
+
+
+class Chip(gvsoc.systree.Component):
+    def __init__(self, parent, name=None):
+        super().__init__(parent, name)
+        case = TargetParameter(
+            self, name='case', value='decode_rv32',
+            description='Which ISS test case to run', cast=str,
+        ).get_value()
+
+        spec = build_case(case)
+
+        if case == 'trace':
+            # The ISS does not create the directory of its binary traces
+            os.makedirs(TRACE_DIR, exist_ok=True)
+
+        work_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), 'build', 'elfs'))
+        os.makedirs(work_dir, exist_ok=True)
+        binary = os.path.join(work_dir, f'{case}.elf')
+        program = spec['program']
+        write_elf(binary, program)
+
+        isa = _get_isa(spec['isa'])
+        clock = vp.clock_domain.Clock_domain(self, 'clock', frequency=100_000_000)
+
+        core_names = list(spec['cores'].keys())
+        results = StubResults(self, 'results', cores=core_names,
+            expected=['' if value is None else f'0x{value:x}' for value in program.expected])
+        clock.o_CLOCK(results.i_CLOCK())
+
+        if spec.get('gdbserver') is not None:
+            # Registered as the gdbserver service, which all the cores connect to
+            gdbserver = StubGdbserver(self, 'gdbserver', **spec['gdbserver'])
+            clock.o_CLOCK(gdbserver.i_CLOCK())
+
+        stub_mems = spec.get('stub_mems', {})
+        for index, (core_name, core_kwargs) in enumerate(spec['cores'].items()):
+            core = BenchCore(self, core_name, isa=isa, core_id=index, **core_kwargs)
+            ico = Router(self, f'{core_name}_ico')
+            loader = ElfLoader(self, f'{core_name}_loader', binary=binary)
+
+            if core_name in stub_mems:
+                mem = StubMem(self, f'{core_name}_mem', base=RAM_BASE, size=RAM_SIZE,
+                    **stub_mems[core_name])
+                ico.o_MAP(mem.i_INPUT(), base=RAM_BASE, size=RAM_SIZE, rm_base=False)
+                # The memory forwards the other data accesses to the router
+                mem.o_OUT(ico.i_INPUT(1))
+                core.o_DATA(mem.i_INPUT())
+            else:
+                mem = Memory(self, f'{core_name}_mem', size=RAM_SIZE,
+                    latency=spec.get('mem_latency', 0))
+                ico.o_MAP(mem.i_INPUT(), base=RAM_BASE, size=RAM_SIZE)
+                core.o_DATA(ico.i_INPUT(1))
+
+            for component in [core, mem, ico, loader]:
+                clock.o_CLOCK(component.i_CLOCK())
+
+            if core_kwargs.get('htif', False):
+                # The program is not an ELF with symbols, so give the HTIF mailboxes directly
+                core.add_property('htif_tohost', f'0x{program.addr("tohost"):x}')
+                core.add_property('htif_fromhost', f'0x{program.addr("fromhost"):x}')
+
+            # Each core sees its own window of the result sink at the same address
+            ico.o_MAP(results.i_INPUT(), name='results', base=RESULTS_BASE, size=RESULTS_WINDOW,
+                remove_offset=RESULTS_BASE - index * RESULTS_WINDOW)
+
+            core.o_FETCH(ico.i_INPUT(0))
+            loader.o_OUT(ico.i_INPUT(2))
+            loader.o_START(core.i_FETCHEN())
+            loader.o_ENTRY(core.i_ENTRY())
+
+
+class Target(gvsoc.runner.Target):
+    gapy_description = 'ISS testbench'
+    model = Chip
+    name = 'test'
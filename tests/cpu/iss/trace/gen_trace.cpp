@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Writes binary instruction traces covering the various kinds of arguments, the same way
+ * src/trace.cpp does, so that the decoder goes through the formatting of arguments (vector,
+ * floating-point, memcheck) which the ISS testbench does not produce.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "cpu/iss/include/trace_binary.hpp"
+
+struct GenArg
+{
+    uint8_t type;
+    uint32_t flags;
+    bool dump_name;
+    int64_t a;
+    int64_t b;
+    uint64_t values[2];
+    uint64_t checks[2];
+    const char *name;
+};
+
+class Gen
+{
+public:
+    Gen(const char *path, int reg_width, int fp_width, uint32_t flags, uint32_t vlen)
+        : vlen(vlen)
+    {
+        if (!this->writer.open(path))
+        {
+            fprintf(stderr, "Unable to open %s\n", path);
+            return;
+        }
+        this->writer.reserve(1024);
+        this->writer.put<uint32_t>(ISS_TRACE_BIN_MAGIC);
+        this->writer.put<uint16_t>(ISS_TRACE_BIN_VERSION);
+        this->writer.put<uint8_t>(reg_width);
+        this->writer.put<uint8_t>(fp_width);
+        this->writer.put<uint32_t>(flags);
+        this->writer.put<uint32_t>(vlen);
+        this->writer.put_str("/soc/cluster/pe0");
+    }
+
+    int def(const char *label, uint64_t opcode, std::vector<GenArg> args)
+    {
+        int id = this->nb_defs++;
+        this->writer.reserve(4096);
+        this->writer.put<uint8_t>(ISS_TRACE_BIN_TAG_DEF);
+        this->writer.put<uint32_t>(id);
+        this->writer.put<uint64_t>(opcode);
+        this->writer.put_str(label);
+        this->writer.put<uint8_t>(args.size());
+        for (size_t i = 0; i < args.size(); i++)
+        {
+            this->writer.put<uint8_t>(i);
+        }
+        for (GenArg &arg : args)
+        {
+            this->writer.put<uint8_t>(arg.type);
+            this->writer.put<uint32_t>(arg.flags);
+            this->writer.put<uint8_t>(arg.dump_name);
+            this->writer.put<uint32_t>(arg.name ? ISS_TRACE_BIN_ARG_FLAG_DUMP_NAME : 0);
+            this->writer.put_str(arg.name ? arg.name : "");
+            this->writer.put<int64_t>(arg.a);
+            this->writer.put<int64_t>(arg.b);
+        }
+        return id;
+    }
+
+    void exec(int id, uint64_t pc, uint64_t cycles, std::vector<GenArg> args, const char *str_dump = NULL,
+        uint8_t sewb = 0, uint8_t lmul = 0, std::vector<std::vector<uint8_t>> vregs = {})
+    {
+        uint8_t flags = str_dump ? ISS_TRACE_BIN_EXEC_STR_DUMP : 0;
+        if (sewb)
+            flags |= ISS_TRACE_BIN_EXEC_VECTOR;
+
+        this->writer.reserve(4096);
+        this->writer.put<uint8_t>(ISS_TRACE_BIN_TAG_EXEC);
+        this->writer.put<uint32_t>(id);
+        this->writer.put<uint8_t>(flags);
+        this->writer.put<uint8_t>(3);
+        this->writer.put<uint64_t>(cycles * 1000);
+        this->writer.put<uint64_t>(cycles);
+        this->writer.put<uint64_t>(pc);
+        if (str_dump)
+            this->writer.put_str(str_dump);
+        if (sewb)
+        {
+            this->writer.put<uint8_t>(sewb);
+            this->writer.put<uint8_t>(lmul);
+            this->writer.put<uint8_t>(8);
+            this->writer.put<uint8_t>(23);
+        }
+        int vreg = 0;
+        for (GenArg &arg : args)
+        {
+            if (arg.flags & ISS_TRACE_BIN_ARG_FLAG_VREG)
+            {
+                this->writer.put_data(vregs[vreg++].data(), this->vlen / 8 * lmul);
+                continue;
+            }
+            int nb_values = iss_trace_bin_exec_arg_nb_values(arg.type, arg.flags);
+            for (int i = 0; i < nb_values; i++)
+            {
+                this->writer.put<uint64_t>(arg.values[i]);
+                this->writer.put<uint64_t>(arg.checks[i]);
+            }
+        }
+    }
+
+    IssTraceBinWriter writer;
+
+private:
+    uint32_t vlen;
+    int nb_defs = 0;
+};
+
+static GenArg out_reg(int index, uint64_t value, uint32_t flags = 0, uint64_t check = ~0ULL)
+{
+    return { ISS_TRACE_BIN_ARG_OUT_REG, flags, true, index, 0, { value, 0 }, { check, 0 }, NULL };
+}
+
+static GenArg in_reg(int index, uint64_t value, uint32_t flags = 0, uint64_t check = ~0ULL)
+{
+    return { ISS_TRACE_BIN_ARG_IN_REG, flags, true, index, 0, { value, 0 }, { check, 0 }, NULL };
+}
+
+static GenArg simm(int64_t value)
+{
+    return { ISS_TRACE_BIN_ARG_SIMM, 0, false, value, 0, { 0, 0 }, { 0, 0 }, NULL };
+}
+
+static GenArg uimm(int64_t value, const char *name = NULL)
+{
+    return { ISS_TRACE_BIN_ARG_UIMM, 0, false, value, 0, { 0, 0 }, { 0, 0 }, name };
+}
+
+static GenArg indirect_imm(int index, int64_t imm, uint64_t value, uint32_t flags = 0)
+{
+    return { ISS_TRACE_BIN_ARG_INDIRECT_IMM, flags, false, index, imm, { value, 0 }, { ~0ULL, 0 }, NULL };
+}
+
+static GenArg indirect_reg(int base, int offset, uint64_t base_value, uint64_t offset_value, uint32_t flags = 0)
+{
+    return { ISS_TRACE_BIN_ARG_INDIRECT_REG, flags, false, base, offset, { base_value, offset_value },
+        { ~0ULL, ~0ULL }, NULL };
+}
+
+// 32 bits core, long format, with floats and vectors
+static void gen_rv32(const char *path)
+{
+    Gen gen(path, 32, 32, ISS_TRACE_BIN_FLAG_LONG, 128);
+
+    int addi = gen.def("addi", 0x00150513, { out_reg(10, 0), in_reg(10, 0), simm(-1) });
+    int lw = gen.def("lw", 0x0045a603, { out_reg(12, 0), indirect_imm(11, 4, 0) });
+    int sw_post = gen.def("p.sw", 0x00c5a22b, { in_reg(12, 0), indirect_imm(11, 4, 0, ISS_TRACE_BIN_ARG_FLAG_POSTINC) });
+    int lw_rr = gen.def("p.lw", 0x00c5f603, { out_reg(12, 0), indirect_reg(11, 13, 0, 0) });
+    int csrr = gen.def("csrr", 0xf1402573, { out_reg(10, 0), uimm(0xf14, "mhartid"), in_reg(0, 0) });
+    int fadd = gen.def("fadd.s", 0x00b574d3, {
+        out_reg(9, 0, ISS_TRACE_BIN_ARG_FLAG_FREG | ISS_TRACE_BIN_ARG_FLAG_ELEM_32),
+        in_reg(10, 0, ISS_TRACE_BIN_ARG_FLAG_FREG | ISS_TRACE_BIN_ARG_FLAG_ELEM_32),
+        in_reg(11, 0, ISS_TRACE_BIN_ARG_FLAG_FREG | ISS_TRACE_BIN_ARG_FLAG_ELEM_32) });
+    int vfadd = gen.def("vfadd.vv", 0x02209057, {
+        out_reg(0, 0, ISS_TRACE_BIN_ARG_FLAG_VREG | ISS_TRACE_BIN_ARG_FLAG_FREG),
+        in_reg(2, 0, ISS_TRACE_BIN_ARG_FLAG_VREG),
+        in_reg(1, 0, ISS_TRACE_BIN_ARG_FLAG_VREG) });
+    int a_long_instruction = gen.def("pv.shuffle2.b.very.long", 0x12345678, {
+        out_reg(5, 0), in_reg(6, 0), in_reg(7, 0) });
+
+    gen.exec(addi, 0x1c008080, 10, { out_reg(10, 0), in_reg(10, 1) });
+    gen.exec(lw, 0x1c008084, 11, { out_reg(12, 0xdeadbeef), indirect_imm(11, 4, 0x10000000) });
+    gen.exec(sw_post, 0x1c008088, 12, { in_reg(12, 0xdeadbeef), indirect_imm(11, 4, 0x10000004) });
+    gen.exec(lw_rr, 0x1c00808c, 13, { out_reg(12, 0x12), indirect_reg(11, 13, 0x10000000, 0x20) });
+    gen.exec(csrr, 0x1c008090, 14, { out_reg(10, 3), uimm(0), in_reg(0, 0) }, "0x42");
+    gen.exec(fadd, 0x1c008094, 15, {
+        out_reg(9, 0x40400000), in_reg(10, 0x3f800000), in_reg(11, 0x40000000) });
+    std::vector<uint8_t> v0(16), v1(16), v2(16);
+    uint32_t f[4] = { 0x3f800000, 0x40000000, 0xbf000000, 0x7f800000 };
+    memcpy(v0.data(), f, 16);
+    for (int i = 0; i < 16; i++)
+    {
+        v1[i] = i;
+        v2[i] = 0xf0 + i;
+    }
+    gen.exec(vfadd, 0x1c008098, 16, { out_reg(0, 0, ISS_TRACE_BIN_ARG_FLAG_VREG | ISS_TRACE_BIN_ARG_FLAG_FREG),
+        in_reg(2, 0, ISS_TRACE_BIN_ARG_FLAG_VREG), in_reg(1, 0, ISS_TRACE_BIN_ARG_FLAG_VREG) },
+        NULL, 4, 1, { v0, v1, v2 });
+    // Widens the label column for next instructions
+    gen.exec(a_long_instruction, 0x1c00809c, 17, { out_reg(5, 1), in_reg(6, 2), in_reg(7, 3) });
+    gen.exec(addi, 0x1c008080, 18, { out_reg(10, 0xffffffff), in_reg(10, 0) });
+}
+
+// 64 bits core, short format, with memcheck
+static void gen_rv64(const char *path)
+{
+    Gen gen(path, 64, 64, ISS_TRACE_BIN_FLAG_MEMCHECK | ISS_TRACE_BIN_FLAG_HAS_DOUBLE, 0);
+
+    int addi = gen.def("addi", 0xfff50513, { out_reg(10, 0), in_reg(10, 0), simm(-1) });
+    int ld = gen.def("ld", 0xff85b603, { out_reg(12, 0), indirect_imm(11, -8, 0) });
+    int fmv = gen.def("fmv.d", 0x22a50553, {
+        out_reg(10, 0, ISS_TRACE_BIN_ARG_FLAG_FREG), in_reg(10, 0, ISS_TRACE_BIN_ARG_FLAG_FREG) });
+    int fcvt = gen.def("fcvt.d.s", 0x42050553, {
+        out_reg(10, 0, ISS_TRACE_BIN_ARG_FLAG_FREG | ISS_TRACE_BIN_ARG_FLAG_ELEM_64),
+        in_reg(10, 0, ISS_TRACE_BIN_ARG_FLAG_FREG | ISS_TRACE_BIN_ARG_FLAG_ELEM_32) });
+
+    gen.exec(addi, 0x80000000, 1, { out_reg(10, 0x00000000ffff1234, 0, 0x00000000ffff0fff), in_reg(10, 0x1235) });
+    gen.exec(ld, 0x80000004, 2, { out_reg(12, 0x0123456789abcdef), indirect_imm(11, -8, 0x80001008) });
+    gen.exec(fmv, 0x80000008, 3, { out_reg(10, 0x400921fb54442d18), in_reg(10, 0x400921fb54442d18) });
+    gen.exec(fcvt, 0x8000000c, 4, { out_reg(10, 0x3ff8000000000000), in_reg(10, 0xffffffff3fc00000) });
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <rv32 trace> <rv64 trace>\n", argv[0]);
+        return 1;
+    }
+
+    gen_rv32(argv[1]);
+    gen_rv64(argv[2]);
+
+    return 0;
+}
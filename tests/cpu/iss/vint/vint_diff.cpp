@@ -0,0 +1,361 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Differential test of the RVV integer engine against the former bit-serial library.
+ *
+ * Every instruction is executed with random register contents, scalars, masks and vector
+ * lengths for all SEW, LMUL and vm combinations, once with the golden model and once with
+ * the engine, and the whole register file is compared afterwards.
+ *
+ * The golden model traps on division by zero, on INT64_MIN / -1 and miscomputes unsigned
+ * 64-bit quotients above INT64_MAX, so divisors are kept away from these values. It also
+ * indexes the mask of vslide1up with the wrong byte, so this instruction is only checked
+ * with masks made of identical bytes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "cpu/iss/include/isa_lib/vint_engine.hpp"
+
+#define NB_VREGS 32
+#define NB_VEL   256
+
+typedef uint64_t iss_reg_t;
+typedef uint8_t iss_Vel_t;
+
+// Subset of the ISS state accessed by the golden model
+struct Iss
+{
+    struct
+    {
+        int SEW_t;
+        float LMUL_t;
+        struct
+        {
+            uint8_t vregs[NB_VREGS][NB_VEL];
+        } vregfile;
+    } spatz;
+
+    struct
+    {
+        struct
+        {
+            iss_reg_t value;
+        } vl, vstart;
+    } csr;
+};
+
+#define SEW iss->spatz.SEW_t
+#define LMUL iss->spatz.LMUL_t
+#define VL iss->csr.vl.value
+#define VSTART iss->csr.vstart.value
+#define VLMAX (int)((2048*LMUL)/SEW)
+#define MAX(a, b) ((a) >= (b) ? (a) : (b))
+#define mask(vm,bin) (!(vm) && !bin[i%8])
+
+#include "vint_ref.hpp"
+
+
+#define VS1 8
+#define VS2 16
+#define VD  24
+
+enum {
+    OP_VV,
+    OP_VX,
+    OP_VI,
+    OP_XS,
+};
+
+enum {
+    FLAG_WIDEN    = 1 << 0,
+    FLAG_DIV      = 1 << 1,
+    FLAG_UNSIGNED = 1 << 2,
+    FLAG_SLIDE1UP = 1 << 3,
+};
+
+typedef void (*ref_vv_t)(Iss *iss, int vs1, int vs2, int vd, bool vm);
+typedef void (*ref_vx_t)(Iss *iss, int vs2, int64_t rs1, int vd, bool vm);
+typedef iss_reg_t (*ref_xs_t)(Iss *iss, int vs2, bool vm);
+typedef void (*eng_vv_t)(const VintState &s, int vs1, int vs2, int vd, bool vm);
+typedef void (*eng_vx_t)(const VintState &s, int vs2, int64_t rs1, int vd, bool vm);
+typedef int64_t (*eng_xs_t)(const VintState &s, int vs2, bool vm);
+
+struct Op
+{
+    const char *name;
+    int kind;
+    int flags;
+    void *ref;
+    void *eng;
+};
+
+#define VV(name, flags)      { #name, OP_VV, flags, (void *)ref_lib_##name, (void *)vint_##name }
+#define VX(name, flags)      { #name, OP_VX, flags, (void *)ref_lib_##name, (void *)vint_##name }
+#define VI(name, eng, flags) { #name, OP_VI, flags, (void *)ref_lib_##name, (void *)vint_##eng }
+
+static const Op ops[] = {
+    VV(ADDVV, 0), VX(ADDVX, 0), VI(ADDVI, ADDVX, 0),
+    VV(SUBVV, 0), VX(SUBVX, 0),
+    VX(RSUBVX, 0), VI(RSUBVI, RSUBVX, 0),
+    VV(ANDVV, 0), VX(ANDVX, 0), VI(ANDVI, ANDVX, 0),
+    VV(ORVV, 0), VX(ORVX, 0), VI(ORVI, ORVX, 0),
+    VV(XORVV, 0), VX(XORVX, 0), VI(XORVI, XORVX, 0),
+    VV(MINVV, 0), VX(MINVX, 0), VV(MINUVV, 0), VX(MINUVX, 0),
+    VV(MAXVV, 0), VX(MAXVX, 0), VV(MAXUVV, 0), VX(MAXUVX, 0),
+    VV(MULVV, 0), VX(MULVX, 0),
+    VV(MULHVV, 0), VX(MULHVX, 0),
+    VV(MULHUVV, 0), VX(MULHUVX, 0),
+    VV(MULHSUVV, 0), VX(MULHSUVX, 0),
+    VV(MVVV, 0), VX(MVVX, 0), VI(MVVI, MVVX, 0),
+    VX(MVSX, 0),
+    { "MVXS", OP_XS, 0, (void *)ref_lib_MVXS, (void *)vint_MVXS },
+    VV(WMULVV, FLAG_WIDEN), VX(WMULVX, FLAG_WIDEN),
+    VV(WMULUVV, FLAG_WIDEN), VX(WMULUVX, FLAG_WIDEN),
+    VV(WMULSUVV, FLAG_WIDEN), VX(WMULSUVX, FLAG_WIDEN),
+    VV(MACCVV, 0), VX(MACCVX, 0),
+    VV(MADDVV, 0), VX(MADDVX, 0),
+    VV(NMSACVV, 0), VX(NMSACVX, 0),
+    VV(NMSUBVV, 0), VX(NMSUBVX, 0),
+    VV(WMACCVV, FLAG_WIDEN), VX(WMACCVX, FLAG_WIDEN),
+    VV(WMACCUVV, FLAG_WIDEN), VX(WMACCUVX, FLAG_WIDEN),
+    VX(WMACCUSVX, FLAG_WIDEN),
+    VV(WMACCSUVV, FLAG_WIDEN), VX(WMACCSUVX, FLAG_WIDEN),
+    VV(REDSUMVS, 0), VV(REDANDVS, 0), VV(REDORVS, 0), VV(REDXORVS, 0),
+    VV(REDMINVS, 0), VV(REDMINUVS, 0), VV(REDMAXVS, 0), VV(REDMAXUVS, 0),
+    VX(SLIDEUPVX, 0), VI(SLIDEUPVI, SLIDEUPVX, 0),
+    VX(SLIDEDWVX, 0), VI(SLIDEDWVI, SLIDEDWVX, 0),
+    VX(SLIDE1UVX, FLAG_SLIDE1UP), VX(SLIDE1DVX, 0),
+    VV(DIVVV, FLAG_DIV), VX(DIVVX, FLAG_DIV),
+    VV(DIVUVV, FLAG_DIV | FLAG_UNSIGNED), VX(DIVUVX, FLAG_DIV | FLAG_UNSIGNED),
+    VV(REMVV, FLAG_DIV), VX(REMVX, FLAG_DIV),
+    VV(REMUVV, FLAG_DIV | FLAG_UNSIGNED), VX(REMUVX, FLAG_DIV | FLAG_UNSIGNED),
+};
+
+
+static uint64_t rand_state = 0x9e3779b97f4a7c15ULL;
+
+static uint64_t rand64()
+{
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 7;
+    rand_state ^= rand_state << 17;
+    return rand_state;
+}
+
+// Random value biased towards the corner cases of the element width
+static int64_t rand_value(int sew)
+{
+    int64_t min = sew == 64 ? INT64_MIN : -(1LL << (sew - 1));
+    int64_t max = sew == 64 ? INT64_MAX : (1LL << (sew - 1)) - 1;
+
+    switch (rand64() % 12)
+    {
+        case 0: return 0;
+        case 1: return -1;
+        case 2: return 1;
+        case 3: return min;
+        case 4: return max;
+        case 5: return (int64_t)(rand64() % 64) - 32;
+        default: return rand64();
+    }
+}
+
+static void set_elem(uint8_t *reg, int sew, int index, int64_t value)
+{
+    memcpy(reg + index * (sew / 8), &value, sew / 8);
+}
+
+static int64_t get_elem(uint8_t *reg, int sew, int index)
+{
+    int64_t value = 0;
+    memcpy(&value, reg + index * (sew / 8), sew / 8);
+    if (sew < 64)
+    {
+        value = (value << (64 - sew)) >> (64 - sew);
+    }
+    return value;
+}
+
+// Replaces divisors the golden model can not handle
+static int64_t fix_divisor(int64_t value, int sew)
+{
+    if (value == 0 || (sew == 64 && (value == -1 || value == 1)))
+    {
+        return 3;
+    }
+    return value;
+}
+
+static VintState engine_state(Iss *iss)
+{
+    VintState state;
+    state.vregs = &iss->spatz.vregfile.vregs[0][0];
+    state.vreg_size = NB_VEL;
+    state.sew = SEW;
+    state.vstart = VSTART;
+    state.vl = VL;
+    state.vlmax = VLMAX;
+    return state;
+}
+
+static int run_case(const Op *op, int sew, int lmul, bool vm, Iss *ref, Iss *eng)
+{
+    Iss *iss = ref;
+    uint8_t *vregs = &ref->spatz.vregfile.vregs[0][0];
+
+    ref->spatz.SEW_t = sew;
+    ref->spatz.LMUL_t = lmul;
+
+    int vlmax = VLMAX;
+    int nb_elems = NB_VREGS * NB_VEL / (sew / 8);
+
+    for (int i = 0; i < nb_elems; i++)
+    {
+        set_elem(vregs, sew, i, rand_value(sew));
+    }
+
+    if (op->flags & FLAG_SLIDE1UP)
+    {
+        memset(ref->spatz.vregfile.vregs[0], rand64(), NB_VEL);
+    }
+    else
+    {
+        for (int i = 0; i < NB_VEL; i++)
+        {
+            ref->spatz.vregfile.vregs[0][i] = rand64();
+        }
+    }
+
+    int64_t rs1;
+    switch (rand64() % 4)
+    {
+        case 0: rs1 = (int64_t)(rand64() % (vlmax + 4)); break;
+        case 1: rs1 = rand_value(sew); break;
+        default: rs1 = rand_value(64); break;
+    }
+
+    if (op->kind == OP_VI)
+    {
+        rs1 = (int64_t)(rand64() % 32) - 16;
+        if (strstr(op->name, "SLIDE"))
+        {
+            rs1 &= 0x1f;
+        }
+    }
+    else if (strstr(op->name, "SLIDE") && !(op->flags & FLAG_SLIDE1UP) && strcmp(op->name, "SLIDE1DVX"))
+    {
+        rs1 = (int64_t)(rand64() % (vlmax + 4));
+    }
+
+    if (op->flags & FLAG_DIV)
+    {
+        rs1 = fix_divisor(rs1, sew);
+        for (int i = 0; i < NB_VEL * 8 / (sew / 8); i++)
+        {
+            uint8_t *reg = ref->spatz.vregfile.vregs[VS1];
+            set_elem(reg, sew, i, fix_divisor(get_elem(reg, sew, i), sew));
+        }
+    }
+
+    ref->csr.vstart.value = 0;
+    ref->csr.vl.value = rand64() % 4 == 0 ? vlmax : rand64() % (vlmax + 1);
+
+    memcpy(eng, ref, sizeof(Iss));
+
+    iss_reg_t ref_result = 0, eng_result = 0;
+
+    switch (op->kind)
+    {
+        case OP_VV:
+            ((ref_vv_t)op->ref)(ref, VS1, VS2, VD, vm);
+            ((eng_vv_t)op->eng)(engine_state(eng), VS1, VS2, VD, vm);
+            break;
+        case OP_VX:
+        case OP_VI:
+            ((ref_vx_t)op->ref)(ref, VS2, rs1, VD, vm);
+            ((eng_vx_t)op->eng)(engine_state(eng), VS2, rs1, VD, vm);
+            break;
+        case OP_XS:
+            ref_result = ((ref_xs_t)op->ref)(ref, VS2, vm);
+            eng_result = ((eng_xs_t)op->eng)(engine_state(eng), VS2, vm);
+            break;
+    }
+
+    if (ref_result != eng_result)
+    {
+        printf("%s sew=%d lmul=%d vm=%d: result mismatch (ref 0x%llx, engine 0x%llx)\n",
+            op->name, sew, lmul, vm, (unsigned long long)ref_result, (unsigned long long)eng_result);
+        return 1;
+    }
+
+    for (int reg = 0; reg < NB_VREGS; reg++)
+    {
+        for (int i = 0; i < NB_VEL; i++)
+        {
+            if (ref->spatz.vregfile.vregs[reg][i] != eng->spatz.vregfile.vregs[reg][i])
+            {
+                printf("%s sew=%d lmul=%d vm=%d vl=%d rs1=0x%llx: mismatch at v%d byte %d (ref 0x%02x, engine 0x%02x)\n",
+                    op->name, sew, lmul, vm, (int)ref->csr.vl.value, (unsigned long long)rs1, reg, i,
+                    ref->spatz.vregfile.vregs[reg][i], eng->spatz.vregfile.vregs[reg][i]);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 20;
+    static Iss ref, eng;
+    int nb_cases = 0, nb_errors = 0;
+
+    for (unsigned int op = 0; op < sizeof(ops) / sizeof(ops[0]); op++)
+    {
+        for (int sew = 8; sew <= 64; sew *= 2)
+        {
+            for (int lmul = 1; lmul <= 8; lmul *= 2)
+            {
+                // The destination group of widening instructions would exceed 8 registers
+                if ((ops[op].flags & FLAG_WIDEN) && lmul == 8)
+                {
+                    continue;
+                }
+
+                for (int vm = 0; vm < 2; vm++)
+                {
+                    for (int it = 0; it < iterations; it++)
+                    {
+                        nb_cases++;
+                        nb_errors += run_case(&ops[op], sew, lmul, vm, &ref, &eng);
+                    }
+                }
+            }
+        }
+    }
+
+    printf("vint: %d cases, %d mismatches\n", nb_cases, nb_errors);
+
+    return nb_errors != 0;
+}
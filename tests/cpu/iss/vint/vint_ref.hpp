@@ -0,0 +1,3147 @@
+/*
+ * Copyright (C) 2020 GreenWaves Technologies, SAS, ETH Zurich and
+ *                    University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Golden model for the vint differential test.
+ *
+ * This is the bit-serial implementation of the RVV integer instructions which was used
+ * by isa_lib/vint.h before the word-level engine (isa_lib/vint_engine.hpp). It is kept
+ * verbatim, only the entry points are renamed from lib_* to ref_lib_*. It expects the
+ * includer to provide Iss, iss_reg_t and the SEW/LMUL/VL/VSTART/VLMAX/MAX/mask macros.
+ */
+
+#ifndef VINT_REF_HPP
+#define VINT_REF_HPP
+
+static inline void printBin(int size, bool *a,const char name[]){
+    printf("%s = ",name);
+    for(int i = size-1; i >= 0  ; i--){
+        printf("%d",a[i]);
+    }
+    printf("\n");
+}
+
+static inline void printHex(int size, bool *a,const char name[]){
+    printf("%s = ",name);
+    int hexVal = 0;
+    for(int i = size-1; i >= 3  ; i-=4){
+        hexVal = a[i]*8 + a[i-1]*4 + a[i-2]*2 + a[i-3];
+        printf("%x",hexVal);
+    }
+    printf("\n");
+}
+
+static inline int  bin8ToChar(bool *bin,int s, int e){
+    int c = 0;
+    for(int i = s; i < e;i++){
+        c += bin[i]*pow(2,i-s);
+    }
+    return c;
+}
+
+static inline int  sewCase(int sew){ //sew/8
+    int iteration = 0;
+    switch (sew){
+    case(8 ) :iteration = 1 ;break;
+    case(16) :iteration = 2 ;break;
+    case(32) :iteration = 4 ;break;
+    case(64) :iteration = 8 ;break;
+    case(128):iteration = 16;break;
+    default:printf("This SEW(%d) is not supported\n",sew);return -1;
+        break;
+    }
+    return iteration;
+}
+
+static inline void EMCase(int sew, uint8_t *m, uint8_t *e){
+    switch (sew){
+    case 8:{
+        printf("8 bit is not supported for FLOAT\n");
+        return;
+        break;
+    }
+    case 16:{
+        *e = 5;
+        *m = 10;
+        break;
+    }
+    case 32:{
+        *e = 8;
+        *m = 23;
+        break;
+    }
+    case 64:{
+        *e = 11;
+        *m = 52;
+        break;
+    }                
+    default:
+        break;
+    }
+}
+
+static inline void reverseBin(int size, bool* dataIn, bool* res){
+    for (int i = 0; i < size; i++)
+    {
+        res[size-1-i] = dataIn[i];
+    } 
+}
+
+static inline void twosComplement(int size, bool* res){
+    for (int j = 0; j < size; j++) {
+        res[j] = !(res[j]);
+    }
+    for (int j = 0; j < size; j++) {
+        if(res[j] == 1){
+            res[j] = 0;
+        }else{
+            res[j] = 1;
+            break;
+        }
+    }
+}
+
+static inline void intToBin(int size, int64_t dataIn, bool* res){
+    int64_t temp = dataIn;
+    for (int j = 0; j < size; j++) {
+        if (!(temp%2)) {
+            res[j] = 0;
+        } else {
+            res[j] = 1;
+        }
+        temp = temp/2;
+    }
+}
+
+static inline void intToBinU(int size, uint64_t dataIn, bool* res){
+    uint64_t temp = dataIn;
+    for (int j = 0; j < size; j++) {
+        if (!(temp%2)) {
+            res[j] = 0;
+        } else {
+            res[j] = 1;
+        }
+        temp = temp/2;
+    }
+}
+
+static inline void doubleToBin(int size, double dataIn, bool* res, int *point){
+    bool temp[size];
+    int dec = floor(abs(dataIn));
+    double frac = abs(dataIn) - dec;
+    int i = 1;
+    int dec_size = (dec == 0)?1:int(ceil(log(dec))+1);
+
+    temp[0] = 0;
+    while(dec > 0){
+        if(!(dec%2)) {
+            temp[i] = 0;
+        } else {
+            temp[i] = 1;
+        }
+        dec /= 2;
+        i++;
+    }
+    while(i < size){
+        frac *= 2;
+        if(frac < 1) {
+            temp[i] = 0;
+        } else {
+            frac -= 1;
+            temp[i] = 1;
+        }
+        i++;
+    }
+    reverseBin(size, temp, res);
+    if(dataIn < 0){
+        twosComplement(size,res);
+    }
+    *point = dec_size;
+}
+
+static inline void binToDouble(int size, bool* a, int point, double *res){
+    *res = 0;
+    bool flag = 0;
+    if(a[size-1]){
+        twosComplement(size,a);
+        flag = 1;
+    }
+    int i = 0;
+    while(i < point){
+        *res += a[size-point+i] * pow(2,i);
+        i++;
+    }
+    while(i < size){
+        *res += a[size-1-i] * pow(2,(point-i-1));
+        i++;
+    }
+    if(flag){
+        *res = -(*res);
+    }    
+}
+
+static inline void buildDataInt(Iss *iss, int vs, int i, int64_t* data){
+    iss_Vel_t temp[8];
+    int iteration = SEW/8;
+    for(int j = 0;j < iteration;j++){
+        temp[j] = iss->spatz.vregfile.vregs[vs][i*iteration+j];
+    }
+    *data = 0;
+    for(int j = 0;j < iteration;j++){
+        *data += temp[j]*pow(2,8*j);
+    }
+}
+
+static inline void buildDataBin(Iss *iss, int size, int vs, int i, bool* dataBin){
+    int iteration = size/8;
+    for(int j = 0;j < iteration;j++){
+        intToBinU(8,(uint64_t)abs(iss->spatz.vregfile.vregs[vs][i*iteration+j]), &dataBin[j*8]);
+    }
+}
+
+static inline void myAbs(Iss *iss, int size, int vs, int i, int64_t* data){
+    iss_Vel_t temp[8];
+    int cin = 0;
+    int iteration = size/8;
+
+    if(iss->spatz.vregfile.vregs[vs][i*iteration+iteration-1] > 127){
+        cin = 1;
+        for(int j = 0;j < iteration;j++){
+            temp[j] = 255 - iss->spatz.vregfile.vregs[vs][i*iteration+j];
+        }
+    }else{
+        cin = 0;
+        for(int j = 0;j < iteration;j++){
+            temp[j] = iss->spatz.vregfile.vregs[vs][i*iteration+j];
+        }
+    }
+
+    *data = 0;
+    for(int j = 0;j < iteration;j++){
+        *data += temp[j]*(int64_t)pow(2,8*j);
+    }
+    *data += cin;
+    *data = cin?(-*data):*data;
+}
+
+static inline void myAbsU(Iss *iss,int size, int vs, int i, uint64_t* data){
+    iss_Vel_t temp[8];
+    int iteration = size/8;
+
+    for(int j = 0;j < iteration;j++){
+        temp[j] = iss->spatz.vregfile.vregs[vs][i*iteration+j];
+    }
+
+    *data = 0;
+    for(int j = 0;j < iteration;j++){
+        *data += temp[j]*(uint64_t)pow(2,8*j);
+    }
+}
+
+static inline void writeToVReg(Iss *iss, int size, int vd, int i, bool *bin){
+    int iteration = size/8;
+    for(int j = 0; j < iteration; j++){
+        iss->spatz.vregfile.vregs[vd][i*iteration+j] = bin8ToChar(bin,8*j,8*(j+1));        
+    }
+}
+
+static inline void binToInt(int size, bool* dataIn, int64_t *res){
+    *res = 0;
+    for (int j = 0; j < size; j++) {
+        *res += dataIn[j]*(int64_t)pow(2,j);
+    }
+}
+
+static inline void extend2x(int size, bool *a, bool* res, bool isSgined){
+    for(int i = 0; i < size ;i++){
+        res[i] = a[i];
+    }
+    if(isSgined){
+        for(int i = size; i < size*2 ;i++){
+            res[i] = a[size-1];
+        }
+    }else{
+        for(int i = size; i < size*2 ;i++){
+            res[i] = 0;
+        }
+    }
+}
+
+static inline void binShift(int size, int shamt, bool *a, bool *res, bool shr, bool isSigned){
+    if(shr){
+        if(isSigned){
+            for(int i = 0; i < shamt; i++){
+                res[size-1-i] = a[size-1];
+            }
+        }else{
+            for(int i = 0; i < shamt; i++){
+                res[size-1-i] = 0;
+            }
+        }
+        for(int i = shamt; i < size; i++){
+            res[i-shamt] = a[i];
+        }
+    }else{
+        for(int i = 0; i < shamt; i++){
+            res[i] = 0;
+        }
+        for(int i = shamt; i < size; i++){
+            res[i] = a[i-shamt];
+        }
+    }
+}
+
+static inline void binSub2(int size, bool *data1, bool *data2, bool *res){
+    bool bin = 0;
+    for(int i = 0; i < size; i++){
+        res[i] = data1[i] ^ data2[i] ^ bin;
+        bin = (!data1[i] & data2[i]) | ((!data1[i] | data2[i]) & bin);
+    }
+}
+
+static inline void binSum2(int size, bool *data1, bool *data2, bool *res){
+    bool cin = 0;
+    for(int i = 0; i < size; i++){
+        res[i] = data1[i] ^ data2[i] ^ cin;
+        cin = (data1[i] & data2[i]) | (cin & data2[i]) | (data1[i] & cin);
+    }
+}
+
+static inline void binSum4(int size, bool *data1, bool *data2, bool *data3, bool *data4, bool *res){
+    bool temp0[128];
+    bool temp1[128];
+    binSum2(size,data1,data2,temp0);
+    binSum2(size,data3,data4,temp1);
+    binSum2(size,temp0,temp1,res);
+}
+
+static inline void binMul(int size, bool *a, bool *b, bool *res){
+    int64_t aDec,bDec;
+    uint64_t temp;
+    binToInt(size, a, &aDec);
+    binToInt(size, b, &bDec);
+    temp = aDec * bDec;
+    intToBinU(size*2, temp, res);
+
+}
+
+static inline void binMulSumUp(int size, bool *M0Bin, bool *M1Bin,bool *M2Bin, bool *M3Bin, bool *res, bool isSigned){
+    bool M02x[128];
+    bool M12x[128];
+    bool M22x[128];
+    bool M32x[128];
+    
+    bool temp0[128];
+    bool temp1[128];
+    bool temp2[128];
+    bool temp3[128];
+
+    extend2x(size, M0Bin, M02x, isSigned);
+    extend2x(size, M1Bin, M12x, isSigned);
+    extend2x(size, M2Bin, M22x, isSigned);
+    extend2x(size, M3Bin, M32x, isSigned);
+
+    binShift(size*2, 0     , M02x, temp0, false, isSigned);
+    binShift(size*2, size/2, M12x, temp1, false, isSigned);
+    binShift(size*2, size/2, M22x, temp2, false, isSigned);
+    binShift(size*2, size  , M32x, temp3, false, isSigned);
+
+    binSum4(size*2, temp0, temp1, temp2, temp3, res);
+}
+
+static inline void ref_lib_ADDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+        res = data1+data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_ADDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1+data2;
+
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_ADDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1+data2;
+
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_SUBVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data2 - data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_SUBVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data2 - data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_RSUBVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ 
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 - data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_RSUBVI   (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 - data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_ANDVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 & data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_ANDVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){ 
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 & data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_ANDVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){  
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 & data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_ORVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 | data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_ORVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 | data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_ORVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 | data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_XORVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data1 ^ data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_XORVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 ^ data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_XORVI    (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = sim;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data1 ^ data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MINVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = (data1 > data2)?data2:data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MINVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = (data1 > data2)?data2:data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MINUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbsU(iss, SEW, vs1, i, &data1);
+        myAbsU(iss, SEW, vs2, i, &data2);
+
+        res = (data1 > data2)?data2:data1;
+
+        intToBinU(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MINUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs2, i, &data2);
+        
+        res = (data1 > data2)?data2:data1;
+        
+        intToBinU(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MAXVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = (data1 > data2)?data1:data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MAXVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = (data1 > data2)?data1:data2;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MAXUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbsU(iss, SEW, vs1, i, &data1);
+        myAbsU(iss, SEW, vs2, i, &data2);
+
+        res = (data1 > data2)?data1:data2;
+
+        intToBinU(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MAXUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs2, i, &data2);
+        
+        res = (data1 > data2)?data1:data2;
+        
+        intToBinU(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MULVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MULVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MULHVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void ref_lib_MULHVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void ref_lib_MULHUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void ref_lib_MULHUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+
+    intToBin(64, rs1, data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void ref_lib_MULHSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void ref_lib_MULHSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, rs1, data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn == 1){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, &resBin[SEW]);
+        }
+    }
+}
+
+static inline void ref_lib_MVVV     (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, res;
+    bool bin[8];
+    bool resBin[64];
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        myAbs(iss, SEW, vs1, i, &data1);
+        
+        res = data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MVVX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t res;
+    bool bin[8];
+    bool resBin[64];
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        res = rs1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MVVI     (Iss *iss, int vs2, int64_t sim, int vd, bool vm){
+    int64_t res;
+    bool bin[8];
+    bool resBin[64];
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        
+        res = sim;
+        intToBin(SEW, abs(res), resBin);
+        if(sim < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MVSX     (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t res;
+    bool resBin[64];
+    res = rs1;
+    if(VSTART < VL){
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(vm){
+            writeToVReg(iss, SEW, vd, 0, resBin);
+        }else{
+            printf("MVSX VM=0 is RESERVED\n");
+        }
+    }
+}
+
+static inline iss_reg_t ref_lib_MVXS     (Iss *iss, int vs2, bool vm){
+
+    int64_t data1;
+
+    myAbs(iss, SEW, vs2, 0, &data1);
+
+    return iss_reg_t(data1);
+}
+
+static inline void ref_lib_WMULVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMULVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMULUVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMULUVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+
+    intToBin(64, rs1, data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMULSUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn){
+            twosComplement(SEW*2,resBin);
+            sgn = 0;
+        }
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMULSUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128];
+    bool sgn = 0;
+
+    intToBin(64, rs1, data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, resBin, false);
+
+        if(sgn == 1){
+            twosComplement(SEW*2,resBin);
+        }
+        sgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MACCVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW, vd , i, data3);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(sgn){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MACCVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW, vd , i, data3);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;
+        }
+
+        extend2x(SEW, data3, data3Ext, true);
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MADDVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vd , i, data2);
+        buildDataBin(iss, SEW, vs2, i, data3);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(sgn){
+            twosComplement(SEW*2,mulOutBin);
+            sgn = 0;
+        }
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_MADDVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vd , i, data2);
+        buildDataBin(iss, SEW, vs2 , i, data3);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+
+        extend2x(SEW, data3, data3Ext, true);
+
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_NMSACVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW, vd , i, data3);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(!sgn){//compare with VMACC
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_NMSACVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW, vd , i, data3);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(!((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1))){//compare with VMACC
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_NMSUBVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs1, i, data1);
+        buildDataBin(iss, SEW, vd , i, data2);
+        buildDataBin(iss, SEW, vs2, i, data3);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(!sgn){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_NMSUBVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64], data3[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vd , i, data2);
+        buildDataBin(iss, SEW, vs2 , i, data3);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3[SEW-1]){
+            twosComplement(SEW,data3);
+            vdSgn = !vdSgn;            
+        }
+
+        extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if(!((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1))){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMACCVV  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW  , vs1, i, data1);
+        buildDataBin(iss, SEW  , vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;            
+        }
+        // extend2x(SEW, data3, data3Ext, true);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(sgn){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMACCVX  (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;
+        }
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMACCUVV (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        buildDataBin(iss, SEW  , vs1, i, data1);
+        buildDataBin(iss, SEW  , vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMACCUVX (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMACCUSVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        if(data2[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data2);
+        }
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;
+        }
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if(sgn == 1){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMACCSUVV(Iss *iss, int vs1, int vs2    , int vd, bool vm){
+/*
+        1H 1L
+        2H 2L
+    -------------
+    0   0   M0H M0L
+    0   M1H M1L 0   
+    0   M2H M2L 0   
+    M3H M3L 0   0
+*/
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW  , vs1, i, data1);
+        buildDataBin(iss, SEW  , vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+
+        if(data1[SEW-1]){
+            sgn = !sgn;
+            twosComplement(SEW,data1);
+        }
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;            
+        }
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+        if(sgn){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_WMACCSUVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    bool data1[64], data2[64];
+    bool data1H[32], data1L[32], data2H[32], data2L[32];
+    bool M0[64], M1[64], M2[64], M3[64];
+    bool bin[8];
+    bool resBin[128], mulOutBin[128], data3Ext[128];
+    bool sgn = 0;
+    bool vdSgn = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        buildDataBin(iss, SEW, vs2, i, data2);
+        buildDataBin(iss, SEW*2, vd , i, data3Ext);
+        if(data3Ext[SEW*2-1]){
+            twosComplement(SEW*2,data3Ext);
+            vdSgn = !vdSgn;
+        }
+        for(int j = 0;j < SEW/2;j++){
+            data1L[j] = data1[j];
+            data2L[j] = data2[j];
+            data1H[j] = data1[j+SEW/2];
+            data2H[j] = data2[j+SEW/2];
+        }
+
+        binMul(SEW/2,data1L,data2L,M0);
+        binMul(SEW/2,data1L,data2H,M1);
+        binMul(SEW/2,data1H,data2L,M2);
+        binMul(SEW/2,data1H,data2H,M3);
+        binMulSumUp(SEW, M0, M1, M2, M3, mulOutBin, false);
+
+        if((rs1 < 0 && sgn == 0) || (rs1 > 0 && sgn == 1)){
+            twosComplement(SEW*2,mulOutBin);
+        }
+        sgn = 0;
+        if(!vdSgn){
+            binSum2(SEW*2, mulOutBin, data3Ext, resBin);
+        }else{
+            binSub2(SEW*2, mulOutBin, data3Ext, resBin);
+        }
+        vdSgn = 0;
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW*2, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_REDSUMVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res += data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void ref_lib_REDANDVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res &= data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void ref_lib_REDORVS  (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res |= data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void ref_lib_REDXORVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;    
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res ^= data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void ref_lib_REDMINVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res = (res < data2)?res:data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void ref_lib_REDMINUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbsU(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbsU(iss, SEW, vs2, i, &data2);
+            res = (res < data2)?res:data2;
+        }
+    }
+    intToBinU(SEW, res, resBin);
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void ref_lib_REDMAXVS (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbs(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbs(iss, SEW, vs2, i, &data2);
+            res = (res > data2)?res:data2;
+        }
+    }
+    intToBin(SEW, abs(res), resBin);
+    if(res < 0){
+        twosComplement(SEW, resBin);
+    }
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void ref_lib_REDMAXUVS(Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    myAbsU(iss, SEW, vs1, 0, &data1);
+    res = data1;
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            myAbsU(iss, SEW, vs2, i, &data2);
+            res = (res > data2)?res:data2;
+        }
+    }
+    intToBinU(SEW, res, resBin);
+    writeToVReg(iss, SEW, vd, 0, resBin);    
+}
+
+static inline void ref_lib_SLIDEUPVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    int64_t OFFSET;
+    bool bin[8];
+   
+    OFFSET = rs1;
+    int s = MAX(VSTART,OFFSET); 
+
+    for (int i = s; i < VL; i++){
+        intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+
+        if(!mask(vm,bin)){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-OFFSET)*t+j];
+            }
+        }
+    }
+}
+
+static inline void ref_lib_SLIDEUPVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    int64_t OFFSET;
+    bool bin[8];
+    OFFSET = sim;
+    int s = MAX(VSTART,OFFSET); 
+
+    for (int i = s; i < VL; i++){
+        intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        if(!mask(vm,bin)){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-OFFSET)*t+j];
+            }
+        }
+    }
+}
+
+static inline void ref_lib_SLIDEDWVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    int64_t OFFSET;
+    bool bin[8];
+    OFFSET = rs1;
+    int s = MAX(VSTART,OFFSET); 
+
+    for (int i = VSTART; i < VL; i++){
+        if(i+OFFSET >= VLMAX){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = 0;
+            }            
+        }else{
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+
+            if(!mask(vm,bin)){
+                for(int j = 0; j <  t ; j++){
+                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+OFFSET)*t+j];
+                }
+            }
+        }
+    }
+}
+
+static inline void ref_lib_SLIDEDWVI(Iss *iss, int vs2, int64_t sim, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    int64_t OFFSET;
+    bool bin[8];
+    OFFSET = sim;
+
+    int s = MAX(VSTART,OFFSET); 
+
+    for (int i = VSTART; i < VL; i++){
+        if(i+OFFSET >= VLMAX){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = 0;
+            }            
+        }else{
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+            
+            if(!mask(vm,bin)){
+                for(int j = 0; j <  t ; j++){
+                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+OFFSET)*t+j];
+                }
+            }
+        }
+    }
+}
+
+static inline void ref_lib_SLIDE1UVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    bool bin[8];
+    bool data1[64];
+   
+    int s = MAX(VSTART,1); 
+    intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][0],bin);
+
+    int i = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+    if(rs1 < 0){
+        twosComplement(64,data1);
+    }
+    if(VSTART == 0){
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, 0, data1);
+        }
+    }
+    for (int i = s; i < VL; i++){
+        if(!((i-s)%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][(i-s)/8],bin);
+        }
+        
+        if(!mask(vm,bin)){
+            for(int j = 0; j <  t ; j++){
+                iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i-1)*t+j];
+            }
+        }
+    }
+}
+
+static inline void ref_lib_SLIDE1DVX(Iss *iss, int vs2, int64_t rs1, int vd, bool vm){//VMA and VTA should be checked
+    int t = SEW/8;
+    bool bin[8];
+    bool data1[64];
+    
+    intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][0],bin);
+
+    int i = 0;
+    intToBin(64, abs((int64_t)rs1), data1);
+    if(rs1 < 0){
+        twosComplement(64,data1);
+    }
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        if(!mask(vm,bin)){
+            if(i == VL-1){
+                writeToVReg(iss, SEW, vd, VL-1, data1);   
+            }else{
+                for(int j = 0; j <  t ; j++){
+                    iss->spatz.vregfile.vregs[vd][i*t+j] = iss->spatz.vregfile.vregs[vs2][(i+1)*t+j];
+                }
+            }
+        }
+    }
+}
+
+static inline void ref_lib_DIVVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data2/data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_DIVVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data2/data1;
+
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_DIVUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs1, i, &data1);
+        myAbsU(iss, SEW, vs2, i, &data2);
+
+        res = data2/data1;
+
+        intToBin(SEW, res, resBin);
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_DIVUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    uint64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs2, i, &data2);
+        
+        res = data2/data1;
+
+
+        intToBin(SEW, res, resBin);
+
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_REMVV    (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs1, i, &data1);
+        myAbs(iss, SEW, vs2, i, &data2);
+
+        res = data2%data1;
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_REMVX    (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    int64_t data1, data2, res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbs(iss, SEW, vs2, i, &data2);
+        
+        res = data2%data1;
+
+
+        intToBin(SEW, abs(res), resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_REMUVV   (Iss *iss, int vs1, int vs2    , int vd, bool vm){
+    uint64_t data1, data2;
+    int64_t res;
+    bool bin[8];
+    bool resBin[64];
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs1, i, &data1);
+        myAbsU(iss, SEW, vs2, i, &data2);
+
+        res = data2%data1;
+        intToBin(SEW, res, resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+static inline void ref_lib_REMUVX   (Iss *iss, int vs2, int64_t rs1, int vd, bool vm){
+    uint64_t data1, data2;
+    int64_t res;
+    bool bin[8];
+    bool resBin[64];
+    
+    data1 = rs1;
+
+    for (int i = VSTART; i < VL; i++){
+        if(!(i%8)){
+            intToBin(8,(int64_t) iss->spatz.vregfile.vregs[0][i/8],bin);
+        }
+
+        myAbsU(iss, SEW, vs2, i, &data2);
+        
+        res = data2%data1;
+
+
+        intToBin(SEW, res, resBin);
+        if(res < 0){
+            twosComplement(SEW, resBin);
+        }
+        if(!mask(vm,bin)){
+            writeToVReg(iss, SEW, vd, i, resBin);
+        }
+    }
+}
+
+#endif
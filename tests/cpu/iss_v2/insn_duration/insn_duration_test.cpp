@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host test of the per-label instruction duration stats of iss_v2.
+ *
+ * Durations are accounted into pending records which are only folded into the registered
+ * stats at dump time. This checks that a stats reset drops the pending records, including
+ * before the first dump when no per-label stat is registered yet, which is the usual reset
+ * at the start of the region of interest.
+ */
+
+#include <stdio.h>
+#include <string>
+#include <cpu/iss_v2/include/stats/insn_duration.hpp>
+
+static int nb_errors = 0;
+
+static void check(vp::BlockStat &stats, const std::string &name, const char *expected)
+{
+    auto it = stats.stats.find(name);
+    std::string value = it == stats.stats.end() ? "not registered" : it->second->format_value(false);
+    if (value != expected)
+    {
+        printf("%s: got \"%s\", expected \"%s\"\n", name.c_str(), value.c_str(), expected);
+        nb_errors++;
+    }
+}
+
+int main()
+{
+    vp::BlockStat stats;
+    InsnDurationStats durations;
+    durations.init(&stats, "insn_duration");
+
+    iss_decoder_insn_t add = { "add" };
+    iss_decoder_insn_t mul = { "mul" };
+    InsnDurationStats::assign_slot(&add);
+    InsnDurationStats::assign_slot(&mul);
+
+    // Reset before the first dump: the durations accounted before must not be dumped
+    durations.account(&add, 3);
+    durations.account(&mul, 7);
+    stats.engine.reset();
+    durations.account(&add, 5);
+    stats.engine.dump();
+    check(stats, "insn_duration/add", "5.00 cyc  (n=1, min=5, max=5)");
+    check(stats, "insn_duration/mul", "not registered");
+    check(stats, "insn_duration/all", "5.00 cyc  (n=1, min=5, max=5)");
+
+    // Reset between two dumps drops both the dumped and the pending durations
+    durations.account(&add, 100);
+    stats.engine.reset();
+    durations.account(&add, 9);
+    durations.account(&mul, 2);
+    stats.engine.dump();
+    check(stats, "insn_duration/add", "9.00 cyc  (n=1, min=9, max=9)");
+    check(stats, "insn_duration/mul", "2.00 cyc  (n=1, min=2, max=2)");
+    check(stats, "insn_duration/all", "5.50 cyc  (n=2, min=2, max=9)");
+
+    // Without reset, durations accumulate over dumps
+    durations.account(&add, 1);
+    stats.engine.dump();
+    check(stats, "insn_duration/add", "5.00 cyc  (n=2, min=1, max=9)");
+    check(stats, "insn_duration/all", "4.00 cyc  (n=3, min=1, max=9)");
+
+    if (nb_errors)
+    {
+        printf("FAILED (%d errors)\n", nb_errors);
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
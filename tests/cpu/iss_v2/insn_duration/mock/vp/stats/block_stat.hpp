@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vp/stats/stats_engine.hpp>
+
+namespace vp
+{
+    class BlockStat
+    {
+    public:
+        StatsEngine *get_engine() { return &this->engine; }
+
+        void register_stat(StatCommon *stat, std::string name, std::string desc)
+        {
+            this->stats[name] = stat;
+            this->engine.register_stat(stat);
+        }
+
+        StatsEngine engine;
+        std::map<std::string, StatCommon *> stats;
+    };
+};
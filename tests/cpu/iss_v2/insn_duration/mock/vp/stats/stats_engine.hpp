@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2026 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <vp/stats/stats.hpp>
+
+namespace vp
+{
+    // Engine with the dump and reset sequences of the real one: pre-dump hooks run before
+    // the registered stats are read, and a reset resets every registered stat.
+    class StatsEngine
+    {
+    public:
+        bool is_enabled() { return true; }
+
+        void register_pre_dump(std::function<void()> callback)
+        {
+            this->pre_dump.push_back(callback);
+        }
+
+        void register_stat(StatCommon *stat) { this->stats.push_back(stat); }
+
+        void dump()
+        {
+            for (auto &callback : this->pre_dump) callback();
+        }
+
+        void reset()
+        {
+            for (StatCommon *stat : this->stats) stat->reset();
+        }
+
+    private:
+        std::vector<std::function<void()>> pre_dump;
+        std::vector<StatCommon *> stats;
+    };
+};
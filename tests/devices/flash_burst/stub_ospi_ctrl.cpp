@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Authors: Germain Haugou (germain.haugou@gmail.com)
+//
+// Octo-SPI controller stub comparing the burst path of an MX25 flash against its edge path.
+//
+// The flash is kept in its reset SPI mode, one bit per useful edge. Reads a schedule from
+// get_js_config()/schedule: a list of entries with
+//   { addr, size, is_write, probe, name }
+// A read is a 0x0C command (32 bits address, 8 latency cycles), a write is a write enable
+// followed by a 0x12 page program (32 bits address). Each transfer is run on the edge port,
+// then on the burst port, one entry every gap cycles so that the flash is no longer busy
+// with the previous program. Both go through chip select and the command and address phases
+// on the edge interface. For the data phase, the edge port is always clocked edge per edge,
+// while the burst port first tries the burst interface of the device and only falls back to
+// the edge interface if it is refused. With probe set, the burst port first tries a burst in
+// the other direction than the command, which the device must refuse. Each transfer is
+// printed as
+//   <port> <name> path=<burst|edge> cycles=<n> [data=<hex>]
+// so that the checker can compare the two ports.
+
+#include <vp/vp.hpp>
+#include <vp/itf/hyper.hpp>
+#include <utils/burst.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class StubOspiCtrl : public vp::Component
+{
+public:
+    StubOspiCtrl(vp::ComponentConf &conf);
+    void reset(bool active) override;
+
+private:
+    struct ScheduleEntry {
+        uint64_t addr;
+        uint64_t size;
+        bool is_write;
+        bool probe;
+        std::string name;
+    };
+
+    static void sync_cycle(vp::Block *__this, int data);
+    static void run_handler(vp::Block *__this, vp::ClockEvent *event);
+
+    void send(vp::HyperMaster *itf, uint64_t value, int nb_bits);
+    void transfer(const char *port_name, vp::HyperMaster *itf, BurstIf *burst,
+        ScheduleEntry *entry);
+
+    vp::HyperMaster edge_itf;
+    vp::HyperMaster burst_itf;
+    vp::ClockEvent run_event;
+    vp::Trace trace;
+    std::vector<ScheduleEntry *> schedule;
+    int64_t gap;
+    size_t current;
+    // Bits sent back by the device during the data phase of an edge read
+    std::vector<uint8_t> rx;
+};
+
+StubOspiCtrl::StubOspiCtrl(vp::ComponentConf &config)
+    : vp::Component(config),
+      run_event(this, &StubOspiCtrl::run_handler)
+{
+    this->traces.new_trace("trace", &this->trace, vp::DEBUG);
+
+    this->edge_itf.set_sync_cycle_meth(&StubOspiCtrl::sync_cycle);
+    this->new_master_port("edge", &this->edge_itf);
+    this->burst_itf.set_sync_cycle_meth(&StubOspiCtrl::sync_cycle);
+    this->new_master_port("burst", &this->burst_itf);
+
+    this->gap = this->get_js_config()->get_child_int("gap");
+
+    js::Config *schedule_cfg = this->get_js_config()->get("schedule");
+    if (schedule_cfg != NULL)
+    {
+        for (auto &item : schedule_cfg->get_elems())
+        {
+            ScheduleEntry *e = new ScheduleEntry();
+            e->addr = (uint64_t)item->get_int("addr");
+            e->size = (uint64_t)item->get_int("size");
+            e->is_write = item->get_child_bool("is_write");
+            e->probe = item->get_child_bool("probe");
+            e->name = item->get_child_str("name");
+            this->schedule.push_back(e);
+        }
+    }
+}
+
+void StubOspiCtrl::reset(bool active)
+{
+    if (!active)
+    {
+        this->current = 0;
+        this->run_event.enqueue(1);
+    }
+}
+
+void StubOspiCtrl::sync_cycle(vp::Block *__this, int data)
+{
+    StubOspiCtrl *_this = (StubOspiCtrl *)__this;
+    _this->rx.push_back(data);
+}
+
+void StubOspiCtrl::send(vp::HyperMaster *itf, uint64_t value, int nb_bits)
+{
+    // Most significant bit first, one bit per edge
+    for (int i = nb_bits - 1; i >= 0; i--)
+    {
+        itf->sync_cycle((value >> i) & 1);
+    }
+}
+
+void StubOspiCtrl::transfer(const char *port_name, vp::HyperMaster *itf, BurstIf *burst,
+    ScheduleEntry *entry)
+{
+    std::vector<uint8_t> data(entry->size);
+    if (entry->is_write)
+    {
+        for (uint64_t i = 0; i < entry->size; i++)
+        {
+            data[i] = (entry->addr + i) * 13 + 5;
+        }
+
+        // Write enable, the flash clears it after each program
+        itf->cs_sync(0, 0);
+        this->send(itf, 0x06, 8);
+        itf->cs_sync(0, 1);
+    }
+
+    // Chip select is active low
+    itf->cs_sync(0, 0);
+    this->send(itf, entry->is_write ? 0x12 : 0x0c, 8);
+    this->send(itf, entry->addr, 32);
+
+    if (burst != NULL && entry->probe)
+    {
+        std::vector<uint8_t> probe_data(entry->size);
+        int64_t cycles = burst->burst_access(probe_data.data(), entry->size, !entry->is_write);
+        printf("%s %s probe=%s\n", port_name, entry->name.c_str(),
+            cycles < 0 ? "refused" : "accepted");
+    }
+
+    const char *path = "burst";
+    int64_t cycles = burst != NULL ? burst->burst_access(data.data(), entry->size,
+        entry->is_write) : -1;
+    if (cycles < 0)
+    {
+        path = "edge";
+        if (entry->is_write)
+        {
+            cycles = entry->size * 8;
+            for (uint64_t i = 0; i < entry->size; i++)
+            {
+                this->send(itf, data[i], 8);
+            }
+        }
+        else
+        {
+            // The device sends nothing during the latency cycles, clock it until all the data
+            // bits are there and account the latency cycles with them
+            uint64_t nb_bits = entry->size * 8;
+            uint64_t max_cycles = nb_bits + 64;
+            this->rx.clear();
+            cycles = 0;
+            while (this->rx.size() < nb_bits && (uint64_t)cycles < max_cycles)
+            {
+                itf->sync_cycle(0);
+                cycles++;
+            }
+            if (this->rx.size() < nb_bits)
+            {
+                this->trace.force_warning("Device sent %d bits, expected %d\n",
+                    (int)this->rx.size(), (int)nb_bits);
+                this->rx.resize(nb_bits);
+            }
+            for (uint64_t i = 0; i < entry->size; i++)
+            {
+                uint8_t byte = 0;
+                for (int j = 0; j < 8; j++)
+                {
+                    byte = (byte << 1) | this->rx[i * 8 + j];
+                }
+                data[i] = byte;
+            }
+        }
+    }
+
+    itf->cs_sync(0, 1);
+
+    printf("%s %s path=%s cycles=%ld", port_name, entry->name.c_str(), path, cycles);
+    if (!entry->is_write)
+    {
+        printf(" data=");
+        for (uint8_t byte : data)
+        {
+            printf("%02x", byte);
+        }
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+void StubOspiCtrl::run_handler(vp::Block *__this, vp::ClockEvent *event)
+{
+    StubOspiCtrl *_this = (StubOspiCtrl *)__this;
+
+    if (_this->current == _this->schedule.size())
+    {
+        printf("DONE\n");
+        fflush(stdout);
+        _this->time.get_engine()->quit(0);
+        return;
+    }
+
+    BurstIf *burst = burst_if_get(&_this->burst_itf);
+    if (burst == NULL)
+    {
+        _this->trace.force_warning("Device on burst port has no burst interface\n");
+    }
+
+    ScheduleEntry *entry = _this->schedule[_this->current++];
+    _this->transfer("edge", &_this->edge_itf, NULL, entry);
+    _this->transfer("burst", &_this->burst_itf, burst, entry);
+
+    _this->run_event.enqueue(_this->gap > 0 ? _this->gap : 1);
+}
+
+extern "C" vp::Component *gv_new(vp::ComponentConf &config)
+{
+    return new StubOspiCtrl(config);
+}
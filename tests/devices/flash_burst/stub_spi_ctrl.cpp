@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Authors: Germain Haugou (germain.haugou@gmail.com)
+//
+// SPI controller stub comparing the burst path of a SPI flash against its edge path.
+//
+// Reads a schedule from get_js_config()/schedule: a list of entries with
+//   { cmd, addr, size, probe, name }
+// where cmd is single_read (0x03, 24 bits address), quad_read (0xEC, 32 bits address and mode
+// byte on 4 lines) or page_program (0x02, 24 bits address). Each transfer is run on the edge
+// port, then on the burst port, one entry every gap cycles. Both go through chip select and
+// the command and address phases on the edge interface, with one call per rising clock edge.
+// For the data phase, the edge port is always clocked edge per edge, while the burst port
+// first tries the burst interface of the device and only falls back to the edge interface if
+// it is refused. With probe set, the burst port first tries a burst in the other direction
+// than the command, which the device must refuse. Each transfer is printed as
+//   <port> <name> path=<burst|edge> cycles=<n> [data=<hex>]
+// so that the checker can compare the two ports.
+
+#include <vp/vp.hpp>
+#include <vp/itf/qspim.hpp>
+#include <vp/itf/wire.hpp>
+#include <utils/burst.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class StubSpiCtrl : public vp::Component
+{
+public:
+    StubSpiCtrl(vp::ComponentConf &conf);
+    void reset(bool active) override;
+
+private:
+    struct ScheduleEntry {
+        std::string cmd;
+        uint64_t addr;
+        uint64_t size;
+        bool probe;
+        std::string name;
+    };
+
+    static void sync(vp::Block *__this, int sck, int data_0, int data_1, int data_2, int data_3,
+        int mask);
+    static void run_handler(vp::Block *__this, vp::ClockEvent *event);
+
+    void send(vp::QspimMaster *itf, uint64_t value, int nb_bits, bool quad);
+    void transfer(const char *port_name, vp::QspimMaster *itf, vp::WireMaster<bool> *cs,
+        BurstIf *burst, ScheduleEntry *entry);
+
+    vp::QspimMaster edge_itf;
+    vp::WireMaster<bool> edge_cs_itf;
+    vp::QspimMaster burst_itf;
+    vp::WireMaster<bool> burst_cs_itf;
+    vp::ClockEvent run_event;
+    vp::Trace trace;
+    std::vector<ScheduleEntry *> schedule;
+    int64_t gap;
+    size_t current;
+    // Bits (single mode) or nibbles (quad mode) sent back by the device, one per edge
+    std::vector<uint8_t> rx;
+};
+
+StubSpiCtrl::StubSpiCtrl(vp::ComponentConf &config)
+    : vp::Component(config),
+      run_event(this, &StubSpiCtrl::run_handler)
+{
+    this->traces.new_trace("trace", &this->trace, vp::DEBUG);
+
+    this->edge_itf.set_sync_meth(&StubSpiCtrl::sync);
+    this->new_master_port("edge", &this->edge_itf);
+    this->new_master_port("edge_cs", &this->edge_cs_itf);
+    this->burst_itf.set_sync_meth(&StubSpiCtrl::sync);
+    this->new_master_port("burst", &this->burst_itf);
+    this->new_master_port("burst_cs", &this->burst_cs_itf);
+
+    this->gap = this->get_js_config()->get_child_int("gap");
+
+    js::Config *schedule_cfg = this->get_js_config()->get("schedule");
+    if (schedule_cfg != NULL)
+    {
+        for (auto &item : schedule_cfg->get_elems())
+        {
+            ScheduleEntry *e = new ScheduleEntry();
+            e->cmd = item->get_child_str("cmd");
+            e->addr = (uint64_t)item->get_int("addr");
+            e->size = (uint64_t)item->get_int("size");
+            e->probe = item->get_child_bool("probe");
+            e->name = item->get_child_str("name");
+            this->schedule.push_back(e);
+        }
+    }
+}
+
+void StubSpiCtrl::reset(bool active)
+{
+    if (!active)
+    {
+        this->current = 0;
+        this->run_event.enqueue(1);
+    }
+}
+
+void StubSpiCtrl::sync(vp::Block *__this, int sck, int data_0, int data_1, int data_2,
+    int data_3, int mask)
+{
+    StubSpiCtrl *_this = (StubSpiCtrl *)__this;
+    // In single mode the device only drives data_1
+    if (mask == 2)
+    {
+        _this->rx.push_back(data_1);
+    }
+    else
+    {
+        _this->rx.push_back(data_0 | (data_1 << 1) | (data_2 << 2) | (data_3 << 3));
+    }
+}
+
+void StubSpiCtrl::send(vp::QspimMaster *itf, uint64_t value, int nb_bits, bool quad)
+{
+    // Most significant bits first, on data_0 in single mode and on the 4 lines in quad mode
+    int width = quad ? 4 : 1;
+    for (int i = nb_bits - width; i >= 0; i -= width)
+    {
+        int bits = (value >> i) & ((1 << width) - 1);
+        itf->sync(1, bits & 1, (bits >> 1) & 1, (bits >> 2) & 1, (bits >> 3) & 1,
+            quad ? 0xf : 1);
+    }
+}
+
+void StubSpiCtrl::transfer(const char *port_name, vp::QspimMaster *itf,
+    vp::WireMaster<bool> *cs, BurstIf *burst, ScheduleEntry *entry)
+{
+    bool is_write = entry->cmd == "page_program";
+    bool quad = entry->cmd == "quad_read";
+
+    std::vector<uint8_t> data(entry->size);
+    if (is_write)
+    {
+        for (uint64_t i = 0; i < entry->size; i++)
+        {
+            data[i] = (entry->addr + i) * 13 + 5;
+        }
+    }
+
+    // The device gets ready for a new command when it is deselected
+    cs->sync(false);
+    cs->sync(true);
+
+    this->rx.clear();
+    if (entry->cmd == "single_read")
+    {
+        this->send(itf, 0x03, 8, false);
+        this->send(itf, entry->addr, 24, false);
+    }
+    else if (quad)
+    {
+        this->send(itf, 0xec, 8, false);
+        this->send(itf, entry->addr, 32, true);
+        this->send(itf, 0, 8, true);
+    }
+    else
+    {
+        this->send(itf, 0x02, 8, false);
+        this->send(itf, entry->addr, 24, false);
+    }
+
+    if (burst != NULL && entry->probe)
+    {
+        std::vector<uint8_t> probe_data(entry->size);
+        int64_t cycles = burst->burst_access(probe_data.data(), entry->size, !is_write);
+        printf("%s %s probe=%s\n", port_name, entry->name.c_str(),
+            cycles < 0 ? "refused" : "accepted");
+    }
+
+    const char *path = "burst";
+    int64_t cycles = burst != NULL ? burst->burst_access(data.data(), entry->size, is_write) : -1;
+    if (cycles < 0)
+    {
+        path = "edge";
+        int width = quad ? 4 : 1;
+        cycles = entry->size * 8 / width;
+        if (is_write)
+        {
+            for (uint64_t i = 0; i < entry->size; i++)
+            {
+                this->send(itf, data[i], 8, false);
+            }
+        }
+        else
+        {
+            // The edge completing the address phase has already brought the first bits of the
+            // data, so the data phase ends one edge before the last one clocked here, which
+            // brings the first bits of the next byte.
+            for (int64_t i = 0; i < cycles; i++)
+            {
+                itf->sync(1, 0, 0, 0, 0, quad ? 0xf : 1);
+            }
+            if (this->rx.size() < (size_t)cycles)
+            {
+                this->trace.force_warning("Device sent %d chunks, expected %d\n",
+                    (int)this->rx.size(), (int)cycles);
+                this->rx.resize(cycles);
+            }
+            for (uint64_t i = 0; i < entry->size; i++)
+            {
+                uint8_t byte = 0;
+                for (int j = 0; j < 8 / width; j++)
+                {
+                    byte = (byte << width) | this->rx[i * 8 / width + j];
+                }
+                data[i] = byte;
+            }
+        }
+    }
+
+    cs->sync(false);
+
+    printf("%s %s path=%s cycles=%ld", port_name, entry->name.c_str(), path, cycles);
+    if (!is_write)
+    {
+        printf(" data=");
+        for (uint8_t byte : data)
+        {
+            printf("%02x", byte);
+        }
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+void StubSpiCtrl::run_handler(vp::Block *__this, vp::ClockEvent *event)
+{
+    StubSpiCtrl *_this = (StubSpiCtrl *)__this;
+
+    if (_this->current == _this->schedule.size())
+    {
+        printf("DONE\n");
+        fflush(stdout);
+        _this->time.get_engine()->quit(0);
+        return;
+    }
+
+    BurstIf *burst = burst_if_get(&_this->burst_itf);
+    if (burst == NULL)
+    {
+        _this->trace.force_warning("Device on burst port has no burst interface\n");
+    }
+
+    ScheduleEntry *entry = _this->schedule[_this->current++];
+    _this->transfer("edge", &_this->edge_itf, &_this->edge_cs_itf, NULL, entry);
+    _this->transfer("burst", &_this->burst_itf, &_this->burst_cs_itf, burst, entry);
+
+    _this->run_event.enqueue(_this->gap > 0 ? _this->gap : 1);
+}
+
+extern "C" vp::Component *gv_new(vp::ComponentConf &config)
+{
+    return new StubSpiCtrl(config);
+}
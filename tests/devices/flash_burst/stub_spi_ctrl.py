@@ -0,0 +1,34 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+import gvsoc.systree
+
+
+class StubSpiCtrl(gvsoc.systree.Component):
+    """SPI controller stub driving two SPI flashes with the same transfers.
+
+    Each schedule entry is a dict with keys: cmd, addr, size, probe, name. The flash on the
+    edge port is only clocked edge per edge, while the one on the burst port gets the data
+    phase through its burst interface when it accepts it. One entry is run every gap cycles.
+    """
+    def __init__(self, parent: gvsoc.systree.Component, name: str, schedule: list,
+                 gap: int = 0):
+        super().__init__(parent, name)
+        self.add_sources(['stub_spi_ctrl.cpp'])
+        self.add_property('schedule', schedule)
+        self.add_property('gap', gap)
+
+    def o_EDGE(self, itf: gvsoc.systree.SlaveItf):
+        self.itf_bind('edge', itf, signature='qspim')
+
+    def o_EDGE_CS(self, itf: gvsoc.systree.SlaveItf):
+        self.itf_bind('edge_cs', itf, signature='wire<bool>')
+
+    def o_BURST(self, itf: gvsoc.systree.SlaveItf):
+        self.itf_bind('burst', itf, signature='qspim')
+
+    def o_BURST_CS(self, itf: gvsoc.systree.SlaveItf):
+        self.itf_bind('burst_cs', itf, signature='wire<bool>')
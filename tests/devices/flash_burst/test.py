@@ -0,0 +1,137 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+"""SPI and octo-SPI flash burst testbench.
+
+A stub controller runs the same transfers on two flashes of the same model, one only driven
+edge per edge (burst=False) and one getting the data phase through its burst interface
+(burst=True). The checker compares what both paths read back and the cycles they report.
+The flashes are instantiated without any preload file, so that they start from their
+default array content.
+"""
+
+from __future__ import annotations
+
+import gvsoc.systree
+import gvsoc.runner
+import vp.clock_domain
+from gvrun.parameter import TargetParameter
+
+from stub_spi_ctrl import StubSpiCtrl
+from stub_ospi_ctrl import StubOspiCtrl
+
+
+FLASH_SIZE = 0x10000
+
+# Enough cycles at 100MHz for an MX25 program of up to 256 bytes to complete
+MX25_PROGRAM_GAP = 20000
+
+
+class Spiflash(gvsoc.systree.Component):
+    def __init__(self, parent, name, size: int, burst: bool):
+        super().__init__(parent, name)
+        self.set_component('devices.spiflash.spiflash_impl')
+        self.add_property('size', size)
+        self.add_property('burst', burst)
+
+
+class Mx25(gvsoc.systree.Component):
+    def __init__(self, parent, name, size: int, burst: bool):
+        super().__init__(parent, name)
+        self.set_component('devices.flash.mx25uw6445g')
+        self.add_property('writeback', False)
+        self.add_property('size', size)
+        self.add_property('burst', burst)
+
+
+def _spi_entry(name: str, cmd: str, addr: int, size: int, probe: bool = False) -> dict:
+    return dict(name=name, cmd=cmd, addr=addr, size=size, probe=probe)
+
+
+def _ospi_entry(name: str, addr: int, size: int, is_write: bool, probe: bool = False) -> dict:
+    return dict(name=name, addr=addr, size=size, is_write=is_write, probe=probe)
+
+
+def build_case(case_name: str) -> dict:
+    if case_name == 'spiflash':
+        # Page programs at aligned and unaligned addresses, single and quad reads overlapping
+        # them and the untouched array, single byte reads, bursts first probed in the other
+        # direction, and a read ending at the end of the array, which the burst refuses since
+        # the edge path then reads past the end.
+        return {
+            'schedule': [
+                _spi_entry('w_aligned', 'page_program', 0x100, 16),
+                _spi_entry('w_unaligned', 'page_program', 0x133, 9),
+                _spi_entry('w_probe', 'page_program', 0x200, 4, probe=True),
+                _spi_entry('r_single', 'single_read', 0x100, 32),
+                _spi_entry('r_quad', 'quad_read', 0x12e, 16),
+                _spi_entry('r_single_byte', 'single_read', 0x134, 1),
+                _spi_entry('r_quad_byte', 'quad_read', 0x135, 1),
+                _spi_entry('r_erased', 'quad_read', 0x800, 7),
+                _spi_entry('r_single_probe', 'single_read', 0x104, 3, probe=True),
+                _spi_entry('r_quad_probe', 'quad_read', 0x200, 4, probe=True),
+                _spi_entry('r_end', 'single_read', FLASH_SIZE - 4, 4),
+            ],
+            'gap': 0,
+        }
+
+    if case_name == 'mx25':
+        # Programs at aligned and unaligned addresses and at the end of the array, reads
+        # overlapping them and the erased array, and bursts first probed in the other
+        # direction. Entries are spaced so that each program is over before the next command.
+        return {
+            'schedule': [
+                _ospi_entry('w_aligned', 0x100, 16, True),
+                _ospi_entry('w_unaligned', 0x133, 9, True, probe=True),
+                _ospi_entry('w_end', FLASH_SIZE - 16, 8, True),
+                _ospi_entry('r_aligned', 0x100, 64, False),
+                _ospi_entry('r_unaligned', 0x131, 13, False, probe=True),
+                _ospi_entry('r_byte', 0x134, 1, False),
+                _ospi_entry('r_end', FLASH_SIZE - 16, 16, False),
+            ],
+            'gap': MX25_PROGRAM_GAP,
+        }
+
+    raise ValueError(f'Unknown case: {case_name}')
+
+
+class Chip(gvsoc.systree.Component):
+    def __init__(self, parent, name=None):
+        super().__init__(parent, name)
+        case = TargetParameter(
+            self, name='case', value='spiflash',
+            description='Which flash burst test case to run', cast=str,
+        ).get_value()
+
+        spec = build_case(case)
+
+        clock = vp.clock_domain.Clock_domain(self, 'clock', frequency=100_000_000)
+
+        if case == 'spiflash':
+            flash_edge = Spiflash(self, 'flash_edge', size=FLASH_SIZE, burst=False)
+            flash_burst = Spiflash(self, 'flash_burst', size=FLASH_SIZE, burst=True)
+            ctrl = StubSpiCtrl(self, 'ctrl', schedule=spec['schedule'], gap=spec['gap'])
+
+            ctrl.o_EDGE(gvsoc.systree.SlaveItf(flash_edge, 'input', signature='qspim'))
+            ctrl.o_EDGE_CS(gvsoc.systree.SlaveItf(flash_edge, 'cs', signature='wire<bool>'))
+            ctrl.o_BURST(gvsoc.systree.SlaveItf(flash_burst, 'input', signature='qspim'))
+            ctrl.o_BURST_CS(gvsoc.systree.SlaveItf(flash_burst, 'cs', signature='wire<bool>'))
+        else:
+            flash_edge = Mx25(self, 'flash_edge', size=FLASH_SIZE, burst=False)
+            flash_burst = Mx25(self, 'flash_burst', size=FLASH_SIZE, burst=True)
+            ctrl = StubOspiCtrl(self, 'ctrl', schedule=spec['schedule'], gap=spec['gap'])
+
+            ctrl.o_EDGE(gvsoc.systree.SlaveItf(flash_edge, 'input', signature='hyper'))
+            ctrl.o_BURST(gvsoc.systree.SlaveItf(flash_burst, 'input', signature='hyper'))
+
+        for component in [flash_edge, flash_burst, ctrl]:
+            clock.o_CLOCK(component.i_CLOCK())
+
+
+class Target(gvsoc.runner.Target):
+    gapy_description = 'SPI and octo-SPI flash burst testbench'
+    model = Chip
+    name = 'test'
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Authors: Germain Haugou (germain.haugou@gmail.com)
+//
+// Hyperbus controller stub comparing the burst path of a device against its edge path.
+//
+// Reads a schedule from get_js_config()/schedule: a list of entries with
+//   { addr, size, is_write, reg, probe, name }
+// and runs each transfer on the edge port, then on the burst port. Both go through chip
+// select and the 6 command-address bytes on the edge interface. For the data phase, the
+// edge port is always clocked byte per byte, while the burst port first tries the burst
+// interface of the device and only falls back to the edge interface if it is refused. With
+// probe set, the burst port first tries a burst in the other direction than the command,
+// which the device must refuse. Written data is the same pattern on both ports. Each
+// transfer is printed as
+//   <port> <name> path=<burst|edge> cycles=<n> [data=<hex>]
+// so that the checker can compare the two ports.
+
+#include <vp/vp.hpp>
+#include <vp/itf/hyper.hpp>
+#include <utils/burst.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class StubHyperCtrl : public vp::Component
+{
+public:
+    StubHyperCtrl(vp::ComponentConf &conf);
+    void reset(bool active) override;
+
+private:
+    struct ScheduleEntry {
+        uint64_t addr;
+        uint64_t size;
+        bool is_write;
+        bool reg;
+        bool probe;
+        std::string name;
+    };
+
+    static void sync_cycle(vp::Block *__this, int data);
+    static void run_handler(vp::Block *__this, vp::ClockEvent *event);
+
+    void transfer(const char *port_name, vp::HyperMaster *itf, BurstIf *burst,
+        ScheduleEntry *entry);
+
+    vp::HyperMaster edge_itf;
+    vp::HyperMaster burst_itf;
+    vp::ClockEvent run_event;
+    vp::Trace trace;
+    std::vector<ScheduleEntry *> schedule;
+    // Bytes sent back by the device during the data phase of an edge read
+    std::vector<uint8_t> rx;
+};
+
+StubHyperCtrl::StubHyperCtrl(vp::ComponentConf &config)
+    : vp::Component(config),
+      run_event(this, &StubHyperCtrl::run_handler)
+{
+    this->traces.new_trace("trace", &this->trace, vp::DEBUG);
+
+    this->edge_itf.set_sync_cycle_meth(&StubHyperCtrl::sync_cycle);
+    this->new_master_port("edge", &this->edge_itf);
+    this->burst_itf.set_sync_cycle_meth(&StubHyperCtrl::sync_cycle);
+    this->new_master_port("burst", &this->burst_itf);
+
+    js::Config *schedule_cfg = this->get_js_config()->get("schedule");
+    if (schedule_cfg != NULL)
+    {
+        for (auto &item : schedule_cfg->get_elems())
+        {
+            ScheduleEntry *e = new ScheduleEntry();
+            e->addr = (uint64_t)item->get_int("addr");
+            e->size = (uint64_t)item->get_int("size");
+            e->is_write = item->get_child_bool("is_write");
+            e->reg = item->get_child_bool("reg");
+            e->probe = item->get_child_bool("probe");
+            e->name = item->get_child_str("name");
+            this->schedule.push_back(e);
+        }
+    }
+}
+
+void StubHyperCtrl::reset(bool active)
+{
+    if (!active)
+    {
+        this->run_event.enqueue(1);
+    }
+}
+
+void StubHyperCtrl::sync_cycle(vp::Block *__this, int data)
+{
+    StubHyperCtrl *_this = (StubHyperCtrl *)__this;
+    _this->rx.push_back(data);
+}
+
+void StubHyperCtrl::transfer(const char *port_name, vp::HyperMaster *itf, BurstIf *burst,
+    ScheduleEntry *entry)
+{
+    std::vector<uint8_t> data(entry->size);
+    if (entry->is_write)
+    {
+        for (uint64_t i = 0; i < entry->size; i++)
+        {
+            data[i] = (entry->addr + i) * 13 + 5;
+        }
+    }
+
+    // Command-address phase: linear burst, most significant byte first
+    uint64_t ca = (entry->addr & 7) | ((entry->addr >> 3) << 16) | (1ULL << 45) |
+        ((uint64_t)entry->reg << 46) | ((uint64_t)!entry->is_write << 47);
+
+    itf->cs_sync(0, 1);
+    for (int i = 5; i >= 0; i--)
+    {
+        itf->sync_cycle((ca >> (i * 8)) & 0xff);
+    }
+
+    if (burst != NULL && entry->probe)
+    {
+        std::vector<uint8_t> probe_data(entry->size);
+        int64_t cycles = burst->burst_access(probe_data.data(), entry->size, !entry->is_write);
+        printf("%s %s probe=%s\n", port_name, entry->name.c_str(),
+            cycles < 0 ? "refused" : "accepted");
+    }
+
+    const char *path = "burst";
+    int64_t cycles = burst != NULL ? burst->burst_access(data.data(), entry->size,
+        entry->is_write) : -1;
+    if (cycles < 0)
+    {
+        // One byte on each clock edge
+        path = "edge";
+        cycles = (entry->size + 1) / 2;
+        this->rx.clear();
+        for (uint64_t i = 0; i < entry->size; i++)
+        {
+            itf->sync_cycle(entry->is_write ? data[i] : 0);
+        }
+        if (!entry->is_write)
+        {
+            this->rx.resize(entry->size);
+            data = this->rx;
+        }
+    }
+
+    itf->cs_sync(0, 0);
+
+    printf("%s %s path=%s cycles=%ld", port_name, entry->name.c_str(), path, cycles);
+    if (!entry->is_write)
+    {
+        printf(" data=");
+        for (uint8_t byte : data)
+        {
+            printf("%02x", byte);
+        }
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+void StubHyperCtrl::run_handler(vp::Block *__this, vp::ClockEvent *event)
+{
+    StubHyperCtrl *_this = (StubHyperCtrl *)__this;
+    BurstIf *burst = burst_if_get(&_this->burst_itf);
+
+    if (burst == NULL)
+    {
+        _this->trace.force_warning("Device on burst port has no burst interface\n");
+    }
+
+    for (ScheduleEntry *entry : _this->schedule)
+    {
+        _this->transfer("edge", &_this->edge_itf, NULL, entry);
+        _this->transfer("burst", &_this->burst_itf, burst, entry);
+    }
+
+    printf("DONE\n");
+    fflush(stdout);
+    _this->time.get_engine()->quit(0);
+}
+
+extern "C" vp::Component *gv_new(vp::ComponentConf &config)
+{
+    return new StubHyperCtrl(config);
+}
@@ -0,0 +1,26 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+import gvsoc.systree
+
+
+class StubHyperCtrl(gvsoc.systree.Component):
+    """Hyperbus controller stub driving two devices with the same transfers.
+
+    Each schedule entry is a dict with keys: addr, size, is_write, reg, probe, name. The
+    device on the edge port is only clocked edge per edge, while the one on the burst port
+    gets the data phase through its burst interface when it accepts it.
+    """
+    def __init__(self, parent: gvsoc.systree.Component, name: str, schedule: list):
+        super().__init__(parent, name)
+        self.add_sources(['stub_hyper_ctrl.cpp'])
+        self.add_property('schedule', schedule)
+
+    def o_EDGE(self, itf: gvsoc.systree.SlaveItf):
+        self.itf_bind('edge', itf, signature='hyper')
+
+    def o_BURST(self, itf: gvsoc.systree.SlaveItf):
+        self.itf_bind('burst', itf, signature='hyper')
@@ -0,0 +1,83 @@
+# SPDX-FileCopyrightText: 2026 ETH Zurich, University of Bologna and EssilorLuxottica SAS
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Authors: Germain Haugou (germain.haugou@gmail.com)
+
+"""HyperRAM burst testbench.
+
+A stub hyperbus controller runs the same transfers on two HyperRAMs, one only driven edge
+per edge (burst=False) and one getting the data phase through its burst interface
+(burst=True). The checker compares what both paths read back and the cycles they report.
+"""
+
+from __future__ import annotations
+
+import gvsoc.systree
+import gvsoc.runner
+import vp.clock_domain
+from devices.hyperbus.hyperram import Hyperram
+from gvrun.parameter import TargetParameter
+
+from stub_hyper_ctrl import StubHyperCtrl
+
+
+RAM_SIZE = 0x1000
+
+
+def _entry(name: str, addr: int, size: int, is_write: bool, reg: bool = False,
+           probe: bool = False) -> dict:
+    return dict(name=name, addr=addr, size=size, is_write=is_write, reg=reg, probe=probe)
+
+
+def build_case(case_name: str) -> dict:
+    if case_name == 'compare':
+        # Writes then reads at aligned and unaligned addresses with odd and even sizes, reads
+        # overlapping several writes and the untouched array, a read whose burst is first
+        # probed in the write direction, and a register read which must stay on the edges.
+        return {
+            'schedule': [
+                _entry('w_aligned', 0x100, 64, True),
+                _entry('w_unaligned', 0x143, 17, True),
+                _entry('w_single', 0x200, 1, True),
+                _entry('r_aligned', 0x100, 64, False),
+                _entry('r_overlap', 0x13e, 32, False),
+                _entry('r_single', 0x200, 1, False),
+                _entry('r_erased', 0x800, 7, False),
+                _entry('r_probe', 0x104, 12, False, probe=True),
+                _entry('w_probe', 0x300, 5, True, probe=True),
+                _entry('r_after_probe', 0x300, 5, False),
+                _entry('r_reg', 0x0, 2, False, reg=True),
+            ],
+        }
+
+    raise ValueError(f'Unknown case: {case_name}')
+
+
+class Chip(gvsoc.systree.Component):
+    def __init__(self, parent, name=None):
+        super().__init__(parent, name)
+        case = TargetParameter(
+            self, name='case', value='compare',
+            description='Which hyperram burst test case to run', cast=str,
+        ).get_value()
+
+        spec = build_case(case)
+
+        clock = vp.clock_domain.Clock_domain(self, 'clock', frequency=100_000_000)
+
+        ram_edge = Hyperram(self, 'ram_edge', size=RAM_SIZE)
+        ram_burst = Hyperram(self, 'ram_burst', size=RAM_SIZE, burst=True)
+        ctrl = StubHyperCtrl(self, 'ctrl', schedule=spec['schedule'])
+
+        for component in [ram_edge, ram_burst, ctrl]:
+            clock.o_CLOCK(component.i_CLOCK())
+
+        ctrl.o_EDGE(gvsoc.systree.SlaveItf(ram_edge, 'input', signature='hyper'))
+        ctrl.o_BURST(gvsoc.systree.SlaveItf(ram_burst, 'input', signature='hyper'))
+
+
+class Target(gvsoc.runner.Target):
+    gapy_description = 'HyperRAM burst testbench'
+    model = Chip
+    name = 'test'
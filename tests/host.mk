@@ -0,0 +1,45 @@
+# Shared Makefile fragment for host-only tests, which compile a test
+# program straight against the model headers and run it on the
+# workstation, without going through the GVSoC build.
+#
+# Include from a test Makefile after setting:
+#   GVSOC_CORE — path to the gvsoc core repo root
+#   PROGRAM    — name of the test program, built as $(BUILDDIR)/$(PROGRAM)
+# and after writing the rule which builds $(BUILDDIR)/$(PROGRAM) with
+# $(HOST_CXX) (or $(HOST_CC) for C objects).
+# Optional:
+#   RUN_ARGS   — arguments given to the program by `run`
+#   HOST_FLAGS — flags the program can not be built without (-pthread,
+#                -fno-strict-aliasing...). They are appended to
+#                CFLAGS / CXXFLAGS, so overriding those from the command
+#                line only changes the optimization and debug flags.
+#   BUILDDIR   — build dir (default $(CURDIR)/build)
+#
+# A test whose `run` does more than starting the program can define
+# HOST_RUN_CUSTOM and provide its own `run` recipe.
+
+BUILDDIR ?= $(CURDIR)/build
+
+CFLAGS ?= -O2
+CXXFLAGS ?= -O2
+
+HOST_CPPFLAGS = -I$(GVSOC_CORE)/models
+HOST_CC = $(CC) $(CFLAGS) $(HOST_FLAGS) $(HOST_CPPFLAGS)
+HOST_CXX = $(CXX) $(CXXFLAGS) $(HOST_FLAGS) $(HOST_CPPFLAGS)
+
+build: $(BUILDDIR)/$(PROGRAM)
+
+all: build
+
+ifndef HOST_RUN_CUSTOM
+run: build
+	$(BUILDDIR)/$(PROGRAM) $(RUN_ARGS)
+endif
+
+$(BUILDDIR):
+	mkdir -p $(BUILDDIR)
+
+clean:
+	rm -rf $(BUILDDIR)
+
+.PHONY: build all run clean
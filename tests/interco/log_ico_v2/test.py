@@ -148,6 +148,31 @@ def build_case(case_name: str) -> dict:
             'targets': _ok_targets(1),
         }
 
+    if case_name == 'round_robin_fairness':
+        # Three masters on bank 0 and a fourth one on bank 2, all on the
+        # same cycle. Bank 2 is served on the first tick along with one
+        # of the bank 0 contenders, then bank 0 serves the two others on
+        # the following ticks, in round-robin order.
+        cfg = LogIcoConfig(nb_masters=4, nb_slaves=4, interleaving_width=4)
+        return {
+            'log_ico_config': cfg,
+            'masters': [
+                {'name': 'm0', 'schedule': [
+                    dict(cycle=10, addr=0x00, size=4, is_write=False, name='m0a'),
+                ]},
+                {'name': 'm1', 'schedule': [
+                    dict(cycle=10, addr=0x40, size=4, is_write=False, name='m1a'),
+                ]},
+                {'name': 'm2', 'schedule': [
+                    dict(cycle=10, addr=0x80, size=4, is_write=False, name='m2a'),
+                ]},
+                {'name': 'm3', 'schedule': [
+                    dict(cycle=10, addr=0x20, size=4, is_write=False, name='m3a'),
+                ]},
+            ],
+            'targets': _ok_targets(4),
+        }
+
     raise ValueError(f'Unknown case: {case_name}')
 
 
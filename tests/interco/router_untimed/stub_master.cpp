@@ -13,11 +13,17 @@
  * master remembers the request and re-sends it as soon as retry() fires. Each event
  * (SEND, DENY, RETRY, GRANT, RESP, DONE) is printed with the current cycle and the
  * entry name so the test can compare against a reference log.
+ *
+ * An entry with dmi=true is not sent, the master instead queries a direct memory
+ * interface grant for its address and prints it (DMI), together with the 32-bit word
+ * read through the grant at that address.
  */
 
 #include <vp/vp.hpp>
 #include <vp/itf/io_v2.hpp>
+#include <utils/dmi.hpp>
 #include <cstdio>
+#include <cstring>
 #include <deque>
 #include <string>
 
@@ -33,6 +39,7 @@ private:
         uint64_t addr;
         uint64_t size;
         bool is_write;
+        bool dmi;
         std::string name;
         vp::IoReq *req;     // owned
         uint8_t *data;      // owned
@@ -46,6 +53,7 @@ private:
     static void quit_handler(vp::Block *__this, vp::ClockEvent *event);
 
     void issue(ScheduleEntry *entry);
+    void dmi_query(ScheduleEntry *entry);
     ScheduleEntry *entry_from_req(vp::IoReq *req);
 
     vp::IoMaster out;
@@ -85,6 +93,7 @@ StubMaster::StubMaster(vp::ComponentConf &config)
             e->addr = (uint64_t)item->get_int("addr");
             e->size = (uint64_t)item->get_int("size");
             e->is_write = item->get_child_bool("is_write");
+            e->dmi = item->get_child_bool("dmi");
             e->name = item->get_child_str("name");
             if (e->name.empty()) e->name = "req" + std::to_string(this->schedule.size());
             e->data = new uint8_t[e->size];
@@ -121,7 +130,14 @@ void StubMaster::issue_handler(vp::Block *__this, vp::ClockEvent *event)
     if (_this->next_to_schedule >= _this->schedule.size()) return;
 
     ScheduleEntry *e = _this->schedule[_this->next_to_schedule++];
-    _this->issue(e);
+    if (e->dmi)
+    {
+        _this->dmi_query(e);
+    }
+    else
+    {
+        _this->issue(e);
+    }
 
     // Schedule next issue if any, else arm the quit event.
     if (_this->next_to_schedule < _this->schedule.size())
@@ -180,6 +196,25 @@ void StubMaster::issue(ScheduleEntry *entry)
     }
 }
 
+void StubMaster::dmi_query(ScheduleEntry *entry)
+{
+    int64_t now = this->clock.get_cycles();
+    DmiIf *dmi = dmi_if_get(&this->out);
+    DmiGrant grant;
+
+    if (dmi == nullptr || !dmi->dmi_get(entry->addr, grant, nullptr))
+    {
+        printf("[%ld] %s DMI name=%s ok=0\n", now, this->logname.c_str(), entry->name.c_str());
+        return;
+    }
+
+    uint32_t value;
+    memcpy(&value, grant.host + (entry->addr - grant.base), sizeof(value));
+    printf("[%ld] %s DMI name=%s ok=1 base=0x%lx size=0x%lx writable=%d value=0x%x\n",
+        now, this->logname.c_str(), entry->name.c_str(), grant.base, grant.size,
+        grant.writable ? 1 : 0, value);
+}
+
 void StubMaster::resp_handler(vp::Block *__this, vp::IoReq *req)
 {
     StubMaster *_this = (StubMaster *)__this;
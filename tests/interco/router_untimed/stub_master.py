@@ -11,14 +11,19 @@ class StubMaster(gvsoc.systree.Component):
     """io_v2 testbench initiator.
 
     Issues a pre-programmed schedule of requests. Each schedule entry is a dict with
-    keys: cycle, addr, size, is_write, name.
+    keys: cycle, addr, size, is_write, name, and optionally dmi, to query a direct
+    memory interface grant for addr instead of sending a request. The simulation quits
+    ``quit_after_cycles`` cycles after the last issue (default 100).
     """
     def __init__(self, parent: gvsoc.systree.Component, name: str,
-                 schedule: list | None = None, logname: str | None = None):
+                 schedule: list | None = None, logname: str | None = None,
+                 quit_after_cycles: int | None = None):
         super().__init__(parent, name)
         self.add_sources(['stub_master.cpp'])
         self.add_property('logname', logname or name)
         self.add_property('schedule', schedule or [])
+        if quit_after_cycles is not None:
+            self.add_property('quit_after_cycles', quit_after_cycles)
 
     def o_OUTPUT(self, itf: gvsoc.systree.SlaveItf):
         self.itf_bind('output', itf, signature='io_v2')
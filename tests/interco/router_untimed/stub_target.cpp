@@ -13,20 +13,25 @@
  *
  * "deny_then_done": returns DENIED for the first `deny_count` matching beats, then
  * behaves like "done". Useful for mid-burst stall tests.
+ *
+ * With dmi_size set, the target also grants direct memory interface access to its
+ * local range [0, dmi_size), in which each 32-bit word holds its own local address.
  */
 
 #include <vp/vp.hpp>
 #include <vp/itf/io_v2.hpp>
+#include <utils/dmi.hpp>
 #include <cstdio>
 #include <cstring>
 #include <deque>
 #include <string>
 #include <vector>
 
-class StubTarget : public vp::Component
+class StubTarget : public vp::Component, public DmiIf
 {
 public:
     StubTarget(vp::ComponentConf &conf);
+    bool dmi_get(uint64_t addr, DmiGrant &grant, DmiListener *listener) override;
 
 private:
     enum class Behavior { DONE, DONE_INVALID, GRANTED, DENIED, DENY_THEN_DONE, DENY_THEN_GRANTED };
@@ -56,6 +61,7 @@ private:
     struct Pending { vp::IoReq *req; int64_t due_cycle; };
     std::deque<Pending> pending_resps;
     std::deque<int64_t> pending_retries;
+    std::vector<uint32_t> dmi_mem;
 };
 
 StubTarget::StubTarget(vp::ComponentConf &config)
@@ -91,6 +97,28 @@ StubTarget::StubTarget(vp::ComponentConf &config)
             this->rules.push_back(r);
         }
     }
+
+    int64_t dmi_size = this->get_js_config()->get_child_int("dmi_size");
+    for (int64_t i = 0; i < dmi_size; i += 4)
+    {
+        this->dmi_mem.push_back((uint32_t)i);
+    }
+}
+
+bool StubTarget::dmi_get(uint64_t addr, DmiGrant &grant, DmiListener *listener)
+{
+    uint64_t size = this->dmi_mem.size() * 4;
+    printf("[%ld] %s DMI addr=0x%lx\n", this->clock.get_cycles(), this->logname.c_str(), addr);
+    if (addr >= size)
+    {
+        return false;
+    }
+    grant.base = 0;
+    grant.size = size;
+    grant.host = (uint8_t *)this->dmi_mem.data();
+    grant.latency = 0;
+    grant.writable = true;
+    return true;
 }
 
 StubTarget::Rule *StubTarget::rule_for(uint64_t addr)
@@ -8,12 +8,17 @@ import gvsoc.systree
 
 
 class StubTarget(gvsoc.systree.Component):
-    """io_v2 beat-mode testbench target."""
-    def __init__(self, parent, name, rules=None, logname=None):
+    """io_v2 beat-mode testbench target.
+
+    With ``dmi_size`` set, it also grants direct memory interface access to its local
+    range ``[0, dmi_size)``.
+    """
+    def __init__(self, parent, name, rules=None, logname=None, dmi_size=0):
         super().__init__(parent, name)
         self.add_sources(['stub_target.cpp'])
         self.add_property('logname', logname or name)
         self.add_property('rules', rules or [])
+        self.add_property('dmi_size', dmi_size)
 
     def i_INPUT(self):
         return gvsoc.systree.SlaveItf(self, 'input', signature='io_v2')
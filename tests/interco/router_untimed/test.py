@@ -61,6 +61,77 @@ def build_case(case_name: str) -> dict:
             'targets': [('t0', t0_base, window, rules)],
         }
 
+    if case_name == 'mapping_switch':
+        # Alternates between two targets, then straddles the end of t0 right after a
+        # hit on it. The remembered mapping must neither leak to t1 nor accept the
+        # straddling request.
+        t1_base = t0_base + 0x10_0000
+        return {
+            'schedule': [
+                dict(cycle=10, addr=t0_base + 0x100, size=4, is_write=False, name='r0'),
+                dict(cycle=11, addr=t0_base + 0x200, size=4, is_write=False, name='r1'),
+                dict(cycle=12, addr=t1_base + 0x100, size=4, is_write=False, name='r2'),
+                dict(cycle=13, addr=t0_base + 0x300, size=4, is_write=False, name='r3'),
+                dict(cycle=14, addr=t0_base + window - 2, size=4, is_write=False,
+                     name='straddle'),
+                dict(cycle=15, addr=0x2000_0000, size=4, is_write=False, name='bad'),
+            ],
+            'targets': [('t0', t0_base, window, ok), ('t1', t1_base, window, ok)],
+        }
+
+    if case_name == 'many_in_flight':
+        # Throughput benchmark: a long stream of requests all GRANTED with a long
+        # response delay, so that hundreds are in flight at the same time and the
+        # in-flight table has to grow, then drain.
+        rules = [dict(addr_min=0, addr_max=0xFFFF_FFFF_FFFF_FFFF,
+                      behavior='granted', resp_delay=500, retry_delay=0)]
+        return {
+            'schedule': [dict(cycle=10 + i, addr=t0_base + (i % 256) * 0x10, size=4,
+                              is_write=False, name=f'r{i}') for i in range(2000)],
+            'targets': [('t0', t0_base, window, rules)],
+            'quit_after_cycles': 1000,
+        }
+
+    if case_name == 'dmi_clip':
+        # Two adjacent targets granting more than their mapping. Each grant must be
+        # clipped to its own mapping and translated back to the master address space.
+        t1_base = t0_base + window
+        return {
+            'schedule': [
+                dict(cycle=10, addr=t0_base + 0x100, size=4, dmi=True, name='t0'),
+                dict(cycle=11, addr=t1_base + 0x10, size=4, dmi=True, name='t1'),
+                dict(cycle=12, addr=0x2000_0000, size=4, dmi=True, name='unmapped'),
+            ],
+            'targets': [('t0', t0_base, window, ok, 2 * window),
+                        ('t1', t1_base, window, ok, 2 * window)],
+        }
+
+    if case_name == 'dmi_default':
+        # A grant on the default mapping could cover the other mappings, it must be
+        # refused, while the sized mapping still grants.
+        return {
+            'schedule': [
+                dict(cycle=10, addr=0x100, size=4, dmi=True, name='default'),
+                dict(cycle=11, addr=t0_base + 0x100, size=4, dmi=True, name='t0'),
+                dict(cycle=12, addr=0x100, size=4, is_write=False, name='r0'),
+            ],
+            'targets': [('t0', t0_base, window, ok, window),
+                        ('def', 0, 0, ok, 4 * window)],
+        }
+
+    if case_name == 'dmi_overlap':
+        # Overlapping mappings can not be granted, whichever one the address hits
+        t1_base = t0_base + window // 2
+        return {
+            'schedule': [
+                dict(cycle=10, addr=t0_base + 0x100, size=4, dmi=True, name='t0'),
+                dict(cycle=11, addr=t0_base + window + 0x100, size=4, dmi=True, name='t1'),
+                dict(cycle=12, addr=t0_base + 0x100, size=4, is_write=False, name='r0'),
+            ],
+            'targets': [('t0', t0_base, window, ok, window),
+                        ('t1', t1_base, window, ok, window)],
+        }
+
     if case_name == 'out_of_mapping':
         return {
             'schedule': [dict(cycle=10, addr=0x2000_0000, size=4,
@@ -85,12 +156,14 @@ class Chip(gvsoc.systree.Component):
         router = Router(self, 'router', config=RouterConfig(kind='untimed'))
         clock.o_CLOCK(router.i_CLOCK())
 
-        master = StubMaster(self, 'master', schedule=spec['schedule'], logname='master')
+        master = StubMaster(self, 'master', schedule=spec['schedule'], logname='master',
+                            quit_after_cycles=spec.get('quit_after_cycles'))
         clock.o_CLOCK(master.i_CLOCK())
         master.o_OUTPUT(router.i_INPUT(0))
 
-        for (tname, base, size, rules) in spec['targets']:
-            tgt = StubTarget(self, tname, rules=rules, logname=tname)
+        for (tname, base, size, rules, *dmi_size) in spec['targets']:
+            tgt = StubTarget(self, tname, rules=rules, logname=tname,
+                             dmi_size=dmi_size[0] if dmi_size else 0)
             clock.o_CLOCK(tgt.i_CLOCK())
             router.o_MAP(tgt.i_INPUT(), RouterMapping(name=tname, base=base, size=size))
 
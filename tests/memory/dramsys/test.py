@@ -3,6 +3,9 @@
 Hooks a stub io v1 master directly to memory.dramsys.i_INPUT (no SoC, no CPU).
 Each test case is selected via the ``case`` TargetParameter, which picks a
 build_case dict with a schedule of io requests to fire.
+
+``native_<case>`` runs the v2 case ``<case>`` against the native
+memory.dram model instead of DRAMSys, with the same traffic.
 """
 
 from __future__ import annotations
@@ -11,6 +14,7 @@ import gvsoc.systree
 import gvsoc.runner
 import vp.clock_domain
 import memory.dramsys
+import memory.dram
 import interco.router_v2
 from gvrun.parameter import TargetParameter
 
@@ -19,6 +23,13 @@ from stub_master_v2 import StubMasterV2
 
 
 def build_case(case_name: str) -> dict:
+    if case_name.startswith('native_'):
+        # Same traffic as the DRAMSys v2 case, served by memory.dram.
+        spec = build_case(case_name[len('native_'):])
+        assert spec.get('version') == 2, "native cases only exist for v2 cases"
+        spec['native'] = True
+        return spec
+
     if case_name == 'read_basic':
         # Single 4-byte read at 0x0. DRAMSys returns whatever the backing
         # store holds (uninitialised, but the wrapper must successfully
@@ -211,6 +222,78 @@ def build_case(case_name: str) -> dict:
             ))
         return {'version': 2, 'schedule': schedule, 'with_router': True}
 
+    if case_name == 'v2_queue_full':
+        # Only run on the native model, with a 4-burst channel queue. A 256 B
+        # pattern is written, then three reads are sent on consecutive cycles:
+        # r0 (2 bursts), r1 (4 bursts), which does not fit next to r0 and must be
+        # denied, and r2 (8 bursts), which is bigger than the whole queue and is
+        # only accepted once the queue is empty.
+        beat_w = 32
+        size = 256
+        base = bytearray(((j * 13 + 17) & 0xFF) for j in range(size))
+        base[0] ^= 0xa5
+        nbeats = size // beat_w
+        schedule = []
+        for i in range(nbeats):
+            schedule.append(dict(
+                cycle=10 + i * 5,
+                addr=i * beat_w, size=beat_w, is_write=True,
+                name=f'w{i}', data_hex=bytes(base[i*beat_w:(i+1)*beat_w]).hex(),
+                burst_id=0,
+                is_first=(i == 0), is_last=(i == nbeats - 1),
+            ))
+        schedule += [
+            dict(cycle=1000, addr=0x0, size=64, is_write=False, name='r0', burst_id=1),
+            dict(cycle=1001, addr=0x40, size=128, is_write=False, name='r1', burst_id=2),
+            dict(cycle=1002, addr=0x0, size=256, is_write=False, name='r2', burst_id=3),
+        ]
+        return {'version': 2, 'schedule': schedule, 'dram_config': dict(queue_size=4)}
+
+    if case_name in ['v2_row_timing', 'v2_closed_page']:
+        # Only run on the native model, with refresh disabled. Three single-burst
+        # reads far enough apart not to interact: r_miss opens row 0 of bank 0,
+        # r_hit reads the same row again and r_conflict another row of the same
+        # bank. With the closed-page policy, the row is closed after each burst so
+        # the three reads cost the same.
+        schedule = [
+            dict(cycle=10, addr=0x0, size=32, is_write=False, name='r_miss', burst_id=0),
+            dict(cycle=200, addr=0x20, size=32, is_write=False, name='r_hit', burst_id=1),
+            dict(cycle=400, addr=0x8000, size=32, is_write=False, name='r_conflict',
+                burst_id=2),
+        ]
+        dram_config = dict(t_refi=0, open_page=case_name == 'v2_row_timing')
+        return {'version': 2, 'schedule': schedule, 'dram_config': dram_config}
+
+    if case_name == 'v2_frfcfs':
+        # Only run on the native model, with refresh disabled. r_open opens row 0 of
+        # bank 0, then r_stream keeps the scheduler busy on another bank group while
+        # r_conflict (row 1 of bank 0) and r_hit (row 0 of bank 0) are queued behind
+        # it. FR-FCFS must issue the younger r_hit first.
+        schedule = [
+            dict(cycle=10, addr=0x0, size=32, is_write=False, name='r_open', burst_id=0),
+            dict(cycle=200, addr=0x1000, size=256, is_write=False, name='r_stream',
+                burst_id=1),
+            dict(cycle=201, addr=0x8000, size=32, is_write=False, name='r_conflict',
+                burst_id=2),
+            dict(cycle=202, addr=0x20, size=32, is_write=False, name='r_hit', burst_id=3),
+        ]
+        return {'version': 2, 'schedule': schedule, 'dram_config': dict(t_refi=0)}
+
+    if case_name == 'v2_refresh':
+        # Only run on the native model, with a refresh every 1000 cycles lasting 100
+        # cycles. r_open opens row 0, r_stalled reads it again right after the
+        # refresh started and must wait for it, r_after reads it once the refresh
+        # is over.
+        schedule = [
+            dict(cycle=10, addr=0x0, size=32, is_write=False, name='r_open', burst_id=0),
+            dict(cycle=1005, addr=0x20, size=32, is_write=False, name='r_stalled',
+                burst_id=1),
+            dict(cycle=1300, addr=0x40, size=32, is_write=False, name='r_after',
+                burst_id=2),
+        ]
+        return {'version': 2, 'schedule': schedule,
+            'dram_config': dict(t_refi=1000, t_rfc=100)}
+
     raise ValueError(f'Unknown case: {case_name}')
 
 
@@ -228,7 +311,13 @@ class Chip(gvsoc.systree.Component):
 
         clock = vp.clock_domain.Clock_domain(self, 'clock', frequency=1_000_000_000)
 
-        ddr = memory.dramsys.Dramsys(self, 'ddr', version=version)
+        if spec.get('native', False):
+            # Default geometry: 32 B bursts, same beat width as the HBM2
+            # DRAMSys config the v2 cases are written for.
+            ddr = memory.dram.Dram(self, 'ddr',
+                config=memory.dram.DramConfig(**spec.get('dram_config', {})))
+        else:
+            ddr = memory.dramsys.Dramsys(self, 'ddr', version=version)
         clock.o_CLOCK(ddr.i_CLOCK())
 
         if version == 1:
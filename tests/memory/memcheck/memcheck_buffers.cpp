@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2020 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Differential test of the memcheck buffer index.
+ *
+ * Random buffers are added and removed both in the index and in a reference map with one
+ * bit per byte, which is how the memory models used to track them. After each operation,
+ * random accesses are checked in both, and for each invalid one the closest buffer must be
+ * the same.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+
+#include "memory/include/memcheck_buffers.hpp"
+
+#define MEM_SIZE (1 << 14)
+
+class Reference
+{
+public:
+    Reference(uint64_t size) : flags((size + 7) / 8, 0), size(size) {}
+
+    bool is_valid(uint64_t offset)
+    {
+        return (this->flags[offset >> 3] >> (offset & 7)) & 1;
+    }
+
+    void setup(uint64_t base, uint64_t size, bool enable)
+    {
+        for (uint64_t offset = base; offset < base + size; offset++)
+        {
+            if (enable)
+            {
+                this->flags[offset >> 3] |= 1 << (offset & 7);
+            }
+            else
+            {
+                this->flags[offset >> 3] &= ~(1 << (offset & 7));
+            }
+        }
+    }
+
+    // Same walk as the former implementation, byte by byte in both directions
+    void find_closest(uint64_t offset, uint64_t &distance, uint64_t &buffer_offset,
+        uint64_t &buffer_size)
+    {
+        uint64_t before_first = 0, before_last = 0, distance_before = 0;
+        for (uint64_t current = offset; current > 0; current--)
+        {
+            if (this->is_valid(current - 1))
+            {
+                before_last = before_first = current - 1;
+                distance_before = offset - before_last;
+                while (before_first > 0 && this->is_valid(before_first - 1)) before_first--;
+                break;
+            }
+        }
+
+        uint64_t after_first = 0, after_last = 0, distance_after = 0;
+        for (uint64_t current = offset; current < this->size; current++)
+        {
+            if (this->is_valid(current))
+            {
+                after_first = after_last = current;
+                distance_after = current - offset;
+                while (after_last + 1 < this->size && this->is_valid(after_last + 1)) after_last++;
+                break;
+            }
+        }
+
+        if (distance_before == 0 && distance_after == 0)
+        {
+            distance = 0;
+        }
+        else if (distance_before == 0 || (distance_after != 0 && distance_after < distance_before))
+        {
+            distance = distance_after;
+            buffer_offset = after_first;
+            buffer_size = after_last - after_first + 1;
+        }
+        else
+        {
+            distance = distance_before;
+            buffer_offset = before_first;
+            buffer_size = before_last - before_first + 1;
+        }
+    }
+
+private:
+    std::vector<uint8_t> flags;
+    uint64_t size;
+};
+
+static int run(int iterations, bool cache)
+{
+    Reference reference(MEM_SIZE);
+    MemcheckBuffers buffers(MEM_SIZE, cache);
+
+    srand(cache ? 2 : 1);
+
+    for (int i = 0; i < iterations; i++)
+    {
+        uint64_t base = rand() % (MEM_SIZE - 256);
+        uint64_t size = rand() % 200;
+        bool enable = rand() % 3 != 0;
+
+        reference.setup(base, size, enable);
+        if (enable)
+        {
+            buffers.add(base, size);
+        }
+        else
+        {
+            buffers.remove(base, size);
+        }
+
+        for (int j = 0; j < 16; j++)
+        {
+            uint64_t offset = rand() % (MEM_SIZE - 16);
+            uint64_t access_size = 1 << (rand() % 4);
+
+            uint64_t invalid_offset = 0;
+            bool is_valid = buffers.check(offset, access_size, invalid_offset);
+
+            uint64_t ref_invalid_offset = 0;
+            bool ref_is_valid = true;
+            for (uint64_t k = 0; k < access_size; k++)
+            {
+                if (!reference.is_valid(offset + k))
+                {
+                    ref_is_valid = false;
+                    ref_invalid_offset = offset + k;
+                    break;
+                }
+            }
+
+            if (is_valid != ref_is_valid || (!is_valid && invalid_offset != ref_invalid_offset))
+            {
+                printf("Check mismatch (iteration: %d, offset: 0x%lx, size: %ld)\n", i,
+                    offset, access_size);
+                return 1;
+            }
+
+            if (!is_valid)
+            {
+                uint64_t distance, buffer_offset = 0, buffer_size = 0;
+                uint64_t ref_distance, ref_buffer_offset = 0, ref_buffer_size = 0;
+                buffers.find_closest(invalid_offset, distance, buffer_offset, buffer_size);
+                reference.find_closest(invalid_offset, ref_distance, ref_buffer_offset,
+                    ref_buffer_size);
+
+                if (distance != ref_distance || (distance != 0 &&
+                    (buffer_offset != ref_buffer_offset || buffer_size != ref_buffer_size)))
+                {
+                    printf("Closest buffer mismatch (iteration: %d, offset: 0x%lx, "
+                        "got: %ld/0x%lx/0x%lx, expected: %ld/0x%lx/0x%lx)\n", i, invalid_offset,
+                        distance, buffer_offset, buffer_size, ref_distance, ref_buffer_offset,
+                        ref_buffer_size);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 20000;
+
+    if (run(iterations, false) || run(iterations, true))
+    {
+        printf("FAILED\n");
+        return 1;
+    }
+
+    printf("PASSED\n");
+    return 0;
+}
@@ -91,6 +91,16 @@ def build_case(case_name: str, work_dir: str) -> dict:
             ],
         }
 
+    if case_name == 'empty':
+        # 0-byte memory, e.g. an unused region of a generated platform. It
+        # must build with the default lazy store and refuse every access.
+        return {
+            'config': MemoryV3Config(size=0, latency=1),
+            'schedule': [
+                dict(cycle=10, addr=0x0, size=4, is_write=False, name='r_empty'),
+            ],
+        }
+
     if case_name == 'stim_file':
         # Preload the memory with 0xDEADBEEF at offset 0; the first read
         # should return those exact bytes (LE: ef be ad de).
@@ -103,6 +113,40 @@ def build_case(case_name: str, work_dir: str) -> dict:
             ],
         }
 
+    if case_name == 'sparse_large':
+        # 4 GiB memory: only usable because the lazy store allocates host
+        # pages on first write. A write near the top must read back, and
+        # an untouched location must read as zero.
+        return {
+            'config': MemoryV3Config(size=0x100000000, latency=1, init=False),
+            'schedule': [
+                dict(cycle=10, addr=0xfffff000, size=4, is_write=True,  name='w_top',
+                     data_hex='cafef00d'),
+                dict(cycle=20, addr=0xfffff000, size=4, is_write=False, name='r_top'),
+                dict(cycle=30, addr=0x80000000, size=4, is_write=False, name='r_untouched'),
+            ],
+        }
+
+    if case_name == 'stim_file_mapped':
+        # Stim file of one page plus 8 bytes: the first page is mapped
+        # copy-on-write, the last 8 bytes are read. The rest of the
+        # second page must keep the 0x57 poison, and a write over the
+        # mapped page must read back.
+        stim_path = _write_stim(work_dir, 'stim_file_mapped',
+                                  b'\x11\x22\x33\x44' + b'\x00' * 4092
+                                  + b'\x55\x66\x77\x88' + b'\x00' * 4)
+        return {
+            'config': MemoryV3Config(size=0x2000, latency=1, stim_file=stim_path),
+            'schedule': [
+                dict(cycle=10, addr=0x0,    size=4, is_write=False, name='r_page'),
+                dict(cycle=20, addr=0x1000, size=4, is_write=False, name='r_tail'),
+                dict(cycle=30, addr=0x1008, size=4, is_write=False, name='r_poison'),
+                dict(cycle=40, addr=0x0,    size=4, is_write=True,  name='w_page',
+                     data_hex='a1b2c3d4'),
+                dict(cycle=50, addr=0x0,    size=4, is_write=False, name='r_cow'),
+            ],
+        }
+
     raise ValueError(f'Unknown case: {case_name}')
 
 
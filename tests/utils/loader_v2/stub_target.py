@@ -12,13 +12,18 @@ class StubTarget(gvsoc.systree.Component):
 
     Accepts writes from the loader. Rules follow the same shape as the
     interco stub_target (addr_min/addr_max/behavior/resp_delay/retry_delay).
+    ``backdoor`` is an optional list of addr_min/addr_max ranges served by
+    a debug-memory backdoor.
     """
     def __init__(self, parent: gvsoc.systree.Component, name: str,
-                 rules: list | None = None, logname: str | None = None):
+                 rules: list | None = None, logname: str | None = None,
+                 backdoor: list | None = None):
         super().__init__(parent, name)
         self.add_sources(['stub_target.cpp'])
         self.add_property('logname', logname or name)
         self.add_property('rules', rules or [])
+        if backdoor:
+            self.add_property('backdoor', backdoor)
 
     def i_INPUT(self) -> gvsoc.systree.SlaveItf:
         return gvsoc.systree.SlaveItf(self, 'input', signature='io_v2')
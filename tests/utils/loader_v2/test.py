@@ -223,6 +223,33 @@ def build_case(case_name: str, work_dir: str) -> dict:
             'rules':  rules,
         }
 
+    if case_name == 'backdoor_load':
+        # Same segment layout as bss_fill, loaded through a backdoor covering
+        # the whole memory: data and bss land without any REQ on the port.
+        path = _ensure_elf(work_dir, 'backdoor_load', 0x1100, [
+            {'paddr': 0x1100, 'data': b'\xde\xad\xbe\xef', 'memsz': 16},
+        ])
+        return {
+            'binary':   path,
+            'backdoor': True,
+            'rules':    mem_ok,
+            'backdoor_ranges': [dict(addr_min=0, addr_max=0xFFFF_FFFF)],
+        }
+
+    if case_name == 'backdoor_fallback':
+        # Two segments, only the first one is covered by the backdoor. The
+        # second one must still be streamed through the port.
+        path = _ensure_elf(work_dir, 'backdoor_fallback', 0x2000, [
+            {'paddr': 0x2000, 'data': b'\x01\x02\x03\x04', 'memsz': 4},
+            {'paddr': 0x3000, 'data': b'\x05\x06\x07\x08', 'memsz': 4},
+        ])
+        return {
+            'binary':   path,
+            'backdoor': True,
+            'rules':    mem_ok,
+            'backdoor_ranges': [dict(addr_min=0x2000, addr_max=0x2FFF)],
+        }
+
     if case_name == 'missing_binary':
         # Non-existent binary path. The loader must log a warning and
         # not crash; no writes reach mem and no wire sync fires.
@@ -253,13 +280,14 @@ class Chip(gvsoc.systree.Component):
         clock = vp.clock_domain.Clock_domain(self, 'clock', frequency=100_000_000)
 
         loader_kwargs = dict(binary=spec['binary'])
-        for k in ('entry', 'entry_addr', 'fetchen_addr', 'fetchen_value'):
+        for k in ('entry', 'entry_addr', 'fetchen_addr', 'fetchen_value', 'backdoor'):
             if k in spec:
                 loader_kwargs[k] = spec[k]
         loader = ElfLoader(self, 'loader', **loader_kwargs)
         clock.o_CLOCK(loader.i_CLOCK())
 
-        mem = StubTarget(self, 'mem', rules=spec['rules'], logname='mem')
+        mem = StubTarget(self, 'mem', rules=spec['rules'], logname='mem',
+                         backdoor=spec.get('backdoor_ranges'))
         clock.o_CLOCK(mem.i_CLOCK())
         loader.o_OUT(mem.i_INPUT())
 